@@ -0,0 +1,105 @@
+// Measures the cost of one passing assertion, in nanoseconds.
+//
+// Usage: bench_assert [iterations]
+//
+// Every case runs a passing assertion with Verbosity::QUIET in a tight
+// loop, the way a Fortran test checks every element of a grid. The
+// "c_" cases go through the C bindings that Fortran calls. The
+// "policy" cases pass a verbosity unknown at compile time, as Fortran
+// does, to the default Assert and to Asserts whose policies make the
+// reporting branches and the thread-local context lookup disappear.
+#include "assert.hpp"
+#include "c_assert.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+    class NullLogger {
+    public:
+        static void log(const std::string &, const std::string &,
+                        const std::optional<std::string> & = std::nullopt) {}
+    };
+
+    template<typename Body>
+    void run_case(const char *name, long iterations, Body body) {
+        body(iterations / 10); // warm up
+        const auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        const auto elapsed = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count();
+        std::printf("%-28s %8.2f ns/assert\n", name, elapsed / static_cast<double>(iterations));
+    }
+}
+
+int main(int argc, char **argv) {
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 10'000'000;
+    Fortest::Assert<NullLogger> asserter;
+    Fortest::Assert<NullLogger, Fortest::QuietPasses> quiet_passes;
+    Fortest::Assert<NullLogger, Fortest::FixedVerbosity<Fortest::Verbosity::QUIET>, Fortest::LocalCounters> counting;
+
+    // Volatile inputs keep the compiler from folding the comparisons away.
+    volatile int int_value = 42;
+    volatile double double_value = 1.0;
+    volatile int verbosity_value = 1;
+    const std::string text(32, 'x');
+    const char *volatile c_text = text.c_str();
+
+    std::printf("%ld iterations per case\n", iterations);
+    run_case("int", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            const int value = int_value;
+            asserter.assert_equal(value, value);
+        }
+    });
+    run_case("double (abs tol)", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            const double value = double_value;
+            asserter.assert_equal(value, value + 1e-12, 1e-9);
+        }
+    });
+    run_case("string_view", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            asserter.assert_equal(std::string_view(c_text), std::string_view(c_text));
+        }
+    });
+    run_case("string copies (old path)", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) asserter.assert_equal(std::string(c_text), std::string(c_text));
+    });
+    run_case("policy: runtime", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            const double value = double_value;
+            asserter.assert_equal(value, value, 1e-9, 0.0, static_cast<Fortest::Verbosity>(verbosity_value));
+        }
+    });
+    run_case("policy: QuietPasses", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            const double value = double_value;
+            quiet_passes.assert_equal(value, value, 1e-9, 0.0, static_cast<Fortest::Verbosity>(verbosity_value));
+        }
+    });
+    run_case("policy: QUIET, local count", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            const double value = double_value;
+            counting.assert_equal(value, value, 1e-9, 0.0, static_cast<Fortest::Verbosity>(verbosity_value));
+        }
+    });
+    run_case("c_assert_equal_int", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) c_assert_equal_int(int_value, int_value, 0);
+    });
+    run_case("c_assert_equal_double", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) c_assert_equal_double(double_value, double_value, 1e-9, 0.0, 0);
+    });
+    run_case("c_assert_equal_string", iterations, [&](long n) {
+        for (long i = 0; i < n; ++i) c_assert_equal_string(c_text, c_text, 0);
+    });
+
+    if (asserter.get_num_failed() != 0 || quiet_passes.get_num_failed() != 0 || counting.get_num_failed() != 0 ||
+        fortest_assert()->get_num_failed() != 0) {
+        std::fprintf(stderr, "unexpected assertion failures\n");
+        return 1;
+    }
+    return 0;
+}
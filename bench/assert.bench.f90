@@ -0,0 +1,45 @@
+!> @brief Fortran side of fortest_bench: passing assertions made through the fortest module.
+!>
+!> @details
+!> Each routine makes `n` passing assertions the way a Fortran test
+!> does, through the generic `assert_equal` and its optional arguments,
+!> so the timings include the Fortran wrappers as well as the C calls.
+module fortest_bench_mod
+    use iso_c_binding, only : c_long, c_int, c_double
+    use fortest_assert, only : assert_equal, VERBOSITY_QUIET
+
+    implicit none
+    private
+
+    public :: bench_fortran_assert_int
+    public :: bench_fortran_assert_double
+
+contains
+
+    !> @brief Make `n` passing integer assertions.
+    !> @param n     Number of assertions.
+    !> @param value Value compared with itself.
+    subroutine bench_fortran_assert_int(n, value) bind(C, name = "fortest_bench_fortran_assert_int")
+        integer(c_long), value :: n
+        integer(c_int), value :: value
+        integer(c_long) :: i
+
+        do i = 1, n
+            call assert_equal(value, value, verbosity = VERBOSITY_QUIET)
+        end do
+    end subroutine bench_fortran_assert_int
+
+    !> @brief Make `n` passing double precision assertions with an absolute tolerance.
+    !> @param n     Number of assertions.
+    !> @param value Value compared with itself.
+    subroutine bench_fortran_assert_double(n, value) bind(C, name = "fortest_bench_fortran_assert_double")
+        integer(c_long), value :: n
+        real(c_double), value :: value
+        integer(c_long) :: i
+
+        do i = 1, n
+            call assert_equal(value, value, abs_tol = 1d-9, verbosity = VERBOSITY_QUIET)
+        end do
+    end subroutine bench_fortran_assert_double
+
+end module fortest_bench_mod
@@ -0,0 +1,312 @@
+// Measures the framework's own overhead, for tracking it between releases.
+//
+// Usage: fortest_bench [--json PATH] [--scale N] [--repetitions R]
+//
+// Every case does a number of operations per sample and reports the
+// median and minimum wall time per operation over R samples, and the
+// median CPU time of the benchmark thread:
+//
+//   registration:  c_register_test_n, c_register_tests_n and
+//                  c_register_parameterized_test_n with N tests or cases
+//                  (default 100000) into a new suite
+//   dispatch:      Test::run of an empty test, i.e. the fixture, timing
+//                  and assertion bookkeeping around every test body
+//   assert:        passing assertions through the C bindings and through
+//                  the Fortran `assert_equal` generic
+//   logger:        Logger::log and AsyncLogger::log of a PASS line into a
+//                  stream that discards it
+//   results_db:    ResultSink::push and the commit of the rows to SQLite
+//
+// With --json the results are also written as JSON, in the layout of
+// Google Benchmark's --benchmark_out, so its compare.py can diff two
+// releases.
+#include "FortestConfig.h"
+#include "assert.hpp"
+#include "async_logger.hpp"
+#include "c_assert.h"
+#include "c_test_session.h"
+#include "reporters.hpp"
+#include "result_sink.hpp"
+#include "test.hpp"
+#include "timing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+extern "C" {
+void fortest_bench_fortran_assert_int(long n, int value);
+void fortest_bench_fortran_assert_double(long n, double value);
+}
+
+namespace {
+    class NullLogger {
+    public:
+        static void log(const std::string &, const std::string &,
+                        const std::optional<std::string> & = std::nullopt) {}
+    };
+
+    /// Stream buffer that accepts and drops everything written to it.
+    class NullBuffer final : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+    };
+
+    /// Result of one case.
+    struct CaseResult {
+        std::string name;
+        long operations = 0;      //!< Operations per sample
+        std::size_t samples = 0;
+        double median_ns = 0.0;   //!< Wall time per operation
+        double min_ns = 0.0;      //!< Wall time per operation
+        double cpu_ns = 0.0;      //!< Median CPU time of the calling thread per operation
+    };
+
+    /**
+     * Runs the cases and collects their results.
+     *
+     * A case body performs `n` operations. Cases that can be repeated
+     * at no cost are warmed up with a tenth of a sample first; one-shot
+     * cases such as registration, whose every call leaves state behind,
+     * are not.
+     */
+    class Harness {
+        std::size_t m_samples;
+        std::vector<CaseResult> m_results;
+
+        /// Median of `values`, which are sorted in place.
+        static double median_of(std::vector<double> &values) {
+            std::sort(values.begin(), values.end());
+            const std::size_t mid = values.size() / 2;
+            return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+        }
+
+    public:
+        explicit Harness(std::size_t samples) : m_samples(std::max<std::size_t>(samples, 1)) {}
+
+        void run(const char *name, long operations, const std::function<void(long)> &body, bool warm_up = true) {
+            if (warm_up) body(std::max(operations / 10, 1L));
+            std::vector<double> per_op;
+            std::vector<double> cpu_per_op;
+            for (std::size_t s = 0; s < m_samples; ++s) {
+                const std::int64_t cpu_start = Fortest::Stopwatch::thread_cpu_ns();
+                const auto start = std::chrono::steady_clock::now();
+                body(operations);
+                const double elapsed = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - start).count();
+                const auto cpu = static_cast<double>(Fortest::Stopwatch::thread_cpu_ns() - cpu_start);
+                per_op.push_back(elapsed / static_cast<double>(operations));
+                cpu_per_op.push_back(cpu / static_cast<double>(operations));
+            }
+            const double median = median_of(per_op);
+            m_results.push_back({name, operations, per_op.size(), median, per_op.front(), median_of(cpu_per_op)});
+            std::printf("%-48s %10.2f ns/op (min %.2f, %ld ops x %zu)\n", name, median, per_op.front(),
+                        operations, per_op.size());
+            std::fflush(stdout);
+        }
+
+        /// Write the results as a Google Benchmark JSON document.
+        void write_json(const std::string &path, long scale) const {
+            using Fortest::JsonLinesReporter;
+            const auto info = Fortest::RunInfo::current();
+            std::ofstream out(path);
+            if (!out) throw std::runtime_error("Cannot write " + path);
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << Fortest::ResultSink::utc_timestamp(std::chrono::system_clock::now()) << "\",\n"
+                << "    \"host_name\": \"" << JsonLinesReporter::escape(info.hostname) << "\",\n"
+                << "    \"executable\": \"fortest_bench\",\n"
+                << "    \"fortest_version\": \"" << FORTEST_VERSION << "\",\n"
+                << "    \"git_sha\": \"" << JsonLinesReporter::escape(info.git_sha) << "\",\n"
+                << "    \"build_type\": \"" << JsonLinesReporter::escape(FORTEST_BENCH_BUILD_TYPE) << "\",\n"
+#ifdef FORTEST_RELEASE_ASSERTS
+                << "    \"release_asserts\": true,\n"
+#else
+                << "    \"release_asserts\": false,\n"
+#endif
+                << "    \"scale\": " << scale << ",\n"
+                << "    \"num_cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << "\n"
+                << "  },\n  \"benchmarks\": [";
+            for (std::size_t i = 0; i < m_results.size(); ++i) {
+                const CaseResult &r = m_results[i];
+                char numbers[256];
+                std::snprintf(numbers, sizeof(numbers),
+                              "\"iterations\": %ld, \"repetitions\": %zu, \"real_time\": %.4f, "
+                              "\"cpu_time\": %.4f, \"min_time\": %.4f, \"time_unit\": \"ns\", "
+                              "\"items_per_second\": %.6g",
+                              r.operations, r.samples, r.median_ns, r.cpu_ns, r.min_ns,
+                              r.median_ns > 0.0 ? 1e9 / r.median_ns : 0.0);
+                out << (i ? ",\n" : "\n") << "    {\"name\": \"" << JsonLinesReporter::escape(r.name)
+                    << "\", \"run_type\": \"iteration\", " << numbers << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+    };
+
+    void empty_test(void *, void *, void *) {}
+
+    void empty_parameterized_test(void *, void *, void *, int) {}
+
+    /// Register a suite under a new name; every registration sample needs an empty one.
+    std::string fresh_suite(const char *prefix) {
+        static int count = 0;
+        std::string name = std::string(prefix) + std::to_string(count++);
+        c_register_test_suite_n(name.data(), name.size());
+        return name;
+    }
+
+    void usage() {
+        std::fprintf(stderr, "Usage: fortest_bench [--json PATH] [--scale N] [--repetitions R]\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string json_path;
+    long scale = 100'000;
+    std::size_t repetitions = 5;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) json_path = argv[++i];
+        else if (arg == "--scale" && i + 1 < argc) scale = std::max(std::atol(argv[++i]), 10L);
+        else if (arg == "--repetitions" && i + 1 < argc) repetitions = std::max(std::strtoul(argv[++i], nullptr, 10), 1UL);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    const long assertions = scale * 100;
+
+    Harness harness(repetitions);
+    std::printf("scale %ld, %zu samples per case\n", scale, repetitions);
+
+    // Registration: names are built before the clock starts, as Fortran
+    // passes them in existing buffers.
+    std::vector<std::string> names(static_cast<std::size_t>(scale));
+    for (std::size_t i = 0; i < names.size(); ++i) names[i] = "test_" + std::to_string(i);
+    harness.run("registration: c_register_test_n", scale, [&](long n) {
+        const std::string suite = fresh_suite("registration_tests_");
+        for (long i = 0; i < n; ++i) {
+            const std::string &name = names[static_cast<std::size_t>(i)];
+            c_register_test_n(suite.data(), suite.size(), name.data(), name.size(),
+                              reinterpret_cast<void *>(&empty_test));
+        }
+    }, false);
+    {
+        // The fixed-width table a Fortran driver passes to register_tests.
+        constexpr std::size_t width = 32;
+        std::string test_table(names.size() * width, ' ');
+        for (std::size_t i = 0; i < names.size(); ++i) names[i].copy(test_table.data() + i * width, width);
+        const std::vector<void *> bodies(names.size(), reinterpret_cast<void *>(&empty_test));
+        // One table of suite names per sample, built before the clock starts.
+        std::vector<std::string> suite_tables(repetitions);
+        for (auto &table : suite_tables) {
+            std::string suite = fresh_suite("registration_table_");
+            suite.resize(width, ' ');
+            for (std::size_t i = 0; i < names.size(); ++i) table += suite;
+        }
+        std::size_t sample = 0;
+        harness.run("registration: c_register_tests_n", scale, [&](long n) {
+            c_register_tests_n(suite_tables[sample++].data(), width, test_table.data(), width, bodies.data(),
+                               static_cast<std::size_t>(n));
+        }, false);
+    }
+    std::vector<int> params(static_cast<std::size_t>(scale));
+    std::iota(params.begin(), params.end(), 1);
+    harness.run("registration: c_register_parameterized_test_n", scale, [&](long n) {
+        const std::string suite = fresh_suite("registration_cases_");
+        c_register_parameterized_test_n(suite.data(), suite.size(), "cases", 5,
+                                        reinterpret_cast<void *>(&empty_parameterized_test), params.data(),
+                                        static_cast<int>(n));
+    }, false);
+
+    // Dispatch: everything Test::run does around an empty body.
+    {
+        auto logger = std::make_shared<NullLogger>();
+        Fortest::Assert<NullLogger> asserter;
+        Fortest::Test test("empty", &empty_test);
+        harness.run("dispatch: Test::run", scale * 10, [&](long n) {
+            for (long i = 0; i < n; ++i) test.run(logger, asserter);
+        });
+    }
+
+    // Assertions, as Fortran tests make them: passing, at QUIET verbosity.
+    volatile int int_value = 42;
+    volatile double double_value = 1.0;
+    const std::string text(32, 'x');
+    harness.run("assert: c_assert_equal_int", assertions, [&](long n) {
+        for (long i = 0; i < n; ++i) c_assert_equal_int(int_value, int_value, 0);
+    });
+    harness.run("assert: c_assert_equal_double", assertions, [&](long n) {
+        for (long i = 0; i < n; ++i) c_assert_equal_double(double_value, double_value, 1e-9, 0.0, 0);
+    });
+    harness.run("assert: c_assert_equal_string_n", assertions, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            c_assert_equal_string_n(text.data(), text.size(), text.data(), text.size(), 0);
+        }
+    });
+    harness.run("assert: fortran assert_equal int", assertions, [&](long n) {
+        fortest_bench_fortran_assert_int(n, int_value);
+    });
+    harness.run("assert: fortran assert_equal double", assertions, [&](long n) {
+        fortest_bench_fortran_assert_double(n, double_value);
+    });
+
+    // Logger throughput; the formatting, locking and copying, not the terminal.
+    {
+        NullBuffer buffer;
+        std::ostream sink(&buffer);
+        Fortest::Logger logger(sink);
+        Fortest::AsyncLogger async_logger(sink);
+        const std::string line = "Test math_suite.test_addition (0.012 ms)";
+        harness.run("logger: Logger::log", scale * 10, [&](long n) {
+            for (long i = 0; i < n; ++i) logger.log(line, Fortest::Logger::Tag::Pass);
+        });
+        harness.run("logger: AsyncLogger::log", scale * 10, [&](long n) {
+            for (long i = 0; i < n; ++i) async_logger.log(line, Fortest::Logger::Tag::Pass);
+            async_logger.flush();
+        });
+    }
+
+    // Results database: one row per test result, committed in batches.
+    {
+        const auto path = std::filesystem::temp_directory_path() /
+                          ("fortest_bench_" + std::to_string(getpid()) + ".sqlite");
+        {
+            Fortest::ResultSink sink(path.string(), Fortest::RunInfo{}, Fortest::ResultSink::Options{});
+            Fortest::TestTiming timing;
+            timing.body_ns = 12'000;
+            harness.run("results_db: ResultSink::push", scale, [&](long n) {
+                for (long i = 0; i < n; ++i) {
+                    sink.push("bench_suite", names[static_cast<std::size_t>(i % 1000)], "PASS", timing);
+                }
+                sink.flush();
+            });
+        }
+        std::filesystem::remove(path);
+    }
+
+    if (fortest_assert()->get_num_failed() != 0) {
+        std::fprintf(stderr, "unexpected assertion failures\n");
+        return 1;
+    }
+    if (!json_path.empty()) {
+        harness.write_json(json_path, scale);
+        std::printf("wrote %s\n", json_path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include "array_compare.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Each entry point is compiled for several instruction sets and the best
+// one is picked when the library is loaded. Elsewhere the generic vectors
+// below map onto the native SIMD unit (NEON on AArch64).
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define FORTEST_SIMD_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FORTEST_SIMD_TARGETS
+#endif
+
+namespace Fortest {
+    namespace {
+        constexpr std::size_t vector_bytes = 64;
+        /// Values compared between two scans for failing offsets.
+        constexpr std::size_t block_size = 1024;
+
+        /// SIMD vector of U, and the matching comparison mask.
+        template<typename U>
+        struct Lanes {
+            static constexpr std::size_t width = vector_bytes / sizeof(U);
+            typedef U Vec __attribute__((vector_size(vector_bytes)));
+            using Int = std::conditional_t<sizeof(U) == 8, std::int64_t, std::int32_t>;
+            typedef Int Mask __attribute__((vector_size(vector_bytes)));
+        };
+
+        /// Load one vector of U from `width` consecutive values of Src.
+        template<typename Src, typename U>
+        [[gnu::always_inline]] inline void load(const Src *p, typename Lanes<U>::Vec &out) {
+            if constexpr (std::is_same_v<Src, U>) {
+                std::memcpy(&out, p, sizeof(out));
+            } else {
+                typedef Src SrcVec __attribute__((vector_size(sizeof(Src) * Lanes<U>::width)));
+                SrcVec in;
+                std::memcpy(&in, p, sizeof(in));
+                out = __builtin_convertvector(in, typename Lanes<U>::Vec);
+            }
+        }
+
+        /// Add the other lane of its complex value to every lane: |z|^2 from squares.
+        template<typename U>
+        [[gnu::always_inline]] inline void add_pairs(typename Lanes<U>::Vec &v) {
+            if constexpr (Lanes<U>::width == 8) {
+                v += __builtin_shufflevector(v, v, 1, 0, 3, 2, 5, 4, 7, 6);
+            } else {
+                v += __builtin_shufflevector(v, v, 1, 0, 3, 2, 5, 4, 7, 6,
+                                             9, 8, 11, 10, 13, 12, 15, 14);
+            }
+        }
+
+        template<typename U>
+        [[gnu::always_inline]] inline U magnitude(U x) { return x < 0 ? -x : x; }
+
+        /// Scalar reference of real_block(), for tails and offset scans.
+        template<typename Src, typename U>
+        [[gnu::always_inline]] inline bool real_element(Src e, Src a, U abs_tol, U rel_tol,
+                                                        U &max_abs, U &max_rel) {
+            const U ev = static_cast<U>(e);
+            const U av = static_cast<U>(a);
+            const U diff = magnitude(ev - av);
+            const U abs_e = magnitude(ev);
+            const U abs_a = magnitude(av);
+            const U scale = abs_e > abs_a ? abs_e : abs_a;
+            if (diff > max_abs) max_abs = diff;
+            const U rel = scale > 0 ? diff / scale : U(0);
+            if (rel > max_rel) max_rel = rel;
+            return (diff <= abs_tol) || (diff <= rel_tol * scale);
+        }
+
+        /// Count mismatches among n values (a multiple of the width); update the maxima.
+        template<typename Src, typename U>
+        [[gnu::always_inline]] inline std::size_t real_block(
+            const Src *e, const Src *a, std::size_t n, U abs_tol, U rel_tol,
+            typename Lanes<U>::Vec &max_abs, typename Lanes<U>::Vec &max_rel) {
+            using Vec = typename Lanes<U>::Vec;
+            using Mask = typename Lanes<U>::Mask;
+            Mask count{};
+            for (std::size_t i = 0; i < n; i += Lanes<U>::width) {
+                Vec ev, av;
+                load<Src, U>(e + i, ev);
+                load<Src, U>(a + i, av);
+                Vec diff = ev - av;
+                diff = diff < 0 ? -diff : diff;
+                const Vec abs_e = ev < 0 ? -ev : ev;
+                const Vec abs_a = av < 0 ? -av : av;
+                const Vec scale = abs_e > abs_a ? abs_e : abs_a;
+                const Mask match = (diff <= abs_tol) | (diff <= rel_tol * scale);
+                count += match + 1; // matching lanes are -1
+                max_abs = diff > max_abs ? diff : max_abs;
+                const Vec rel = scale > 0 ? diff / scale : Vec{};
+                max_rel = rel > max_rel ? rel : max_rel;
+            }
+            std::size_t total = 0;
+            for (std::size_t l = 0; l < Lanes<U>::width; ++l) total += static_cast<std::size_t>(count[l]);
+            return total;
+        }
+
+        /// Scalar reference of complex_block(); works on squared moduli.
+        template<typename U>
+        [[gnu::always_inline]] inline bool complex_element(const U *e, const U *a, U abs_tol2, U rel_tol2,
+                                                           U &max_abs2, U &max_rel2) {
+            const U dr = e[0] - a[0];
+            const U di = e[1] - a[1];
+            const U diff2 = dr * dr + di * di;
+            const U e2 = e[0] * e[0] + e[1] * e[1];
+            const U a2 = a[0] * a[0] + a[1] * a[1];
+            const U scale2 = e2 > a2 ? e2 : a2;
+            if (diff2 > max_abs2) max_abs2 = diff2;
+            const U rel2 = scale2 > 0 ? diff2 / scale2 : U(0);
+            if (rel2 > max_rel2) max_rel2 = rel2;
+            return (diff2 <= abs_tol2) || (diff2 <= rel_tol2 * scale2);
+        }
+
+        /// Count mismatching complex values among n interleaved values.
+        template<typename U>
+        [[gnu::always_inline]] inline std::size_t complex_block(
+            const U *e, const U *a, std::size_t n, U abs_tol2, U rel_tol2,
+            typename Lanes<U>::Vec &max_abs2, typename Lanes<U>::Vec &max_rel2) {
+            using Vec = typename Lanes<U>::Vec;
+            using Mask = typename Lanes<U>::Mask;
+            Mask count{};
+            for (std::size_t i = 0; i < n; i += Lanes<U>::width) {
+                Vec ev, av;
+                load<U, U>(e + i, ev);
+                load<U, U>(a + i, av);
+                const Vec d = ev - av;
+                Vec diff2 = d * d;
+                add_pairs<U>(diff2);
+                Vec e2 = ev * ev;
+                add_pairs<U>(e2);
+                Vec a2 = av * av;
+                add_pairs<U>(a2);
+                const Vec scale2 = e2 > a2 ? e2 : a2;
+                const Mask match = (diff2 <= abs_tol2) | (diff2 <= rel_tol2 * scale2);
+                count += match + 1;
+                max_abs2 = diff2 > max_abs2 ? diff2 : max_abs2;
+                const Vec rel2 = scale2 > 0 ? diff2 / scale2 : Vec{};
+                max_rel2 = rel2 > max_rel2 ? rel2 : max_rel2;
+            }
+            std::size_t total = 0;
+            for (std::size_t l = 0; l < Lanes<U>::width; ++l) total += static_cast<std::size_t>(count[l]);
+            return total / 2; // both lanes of a value agree
+        }
+
+        void record_failure(ArrayComparison &result, std::size_t index, std::size_t max_reported) {
+            if (result.first_failures.empty()) result.first_failures.reserve(max_reported);
+            result.first_failures.push_back(index);
+        }
+
+        template<typename U>
+        [[gnu::always_inline]] inline U lane_max(const typename Lanes<U>::Vec &v, U init) {
+            for (std::size_t l = 0; l < Lanes<U>::width; ++l) init = v[l] > init ? v[l] : init;
+            return init;
+        }
+
+        template<typename Src, typename U>
+        [[gnu::always_inline]] inline ArrayComparison compare_real(
+            const Src *e, const Src *a, std::size_t n, double abs_tol, double rel_tol,
+            std::size_t max_reported) {
+            ArrayComparison result;
+            result.size = n;
+            const U at = static_cast<U>(abs_tol);
+            const U rt = static_cast<U>(rel_tol);
+            typename Lanes<U>::Vec max_abs{}, max_rel{};
+            U scalar_abs = 0, scalar_rel = 0;
+
+            const std::size_t vector_end = n - n % Lanes<U>::width;
+            std::size_t i = 0;
+            while (i < vector_end) {
+                const std::size_t len = std::min(block_size, vector_end - i);
+                const std::size_t m = real_block<Src, U>(e + i, a + i, len, at, rt, max_abs, max_rel);
+                result.mismatches += m;
+                for (std::size_t j = i; m != 0 && j < i + len &&
+                                        result.first_failures.size() < max_reported; ++j) {
+                    U ignore_abs = 0, ignore_rel = 0;
+                    if (!real_element(e[j], a[j], at, rt, ignore_abs, ignore_rel)) {
+                        record_failure(result, j, max_reported);
+                    }
+                }
+                i += len;
+            }
+            for (; i < n; ++i) {
+                if (!real_element(e[i], a[i], at, rt, scalar_abs, scalar_rel)) {
+                    ++result.mismatches;
+                    if (result.first_failures.size() < max_reported) record_failure(result, i, max_reported);
+                }
+            }
+            result.max_abs_error = static_cast<double>(lane_max<U>(max_abs, scalar_abs));
+            result.max_rel_error = static_cast<double>(lane_max<U>(max_rel, scalar_rel));
+            return result;
+        }
+
+        template<typename U>
+        [[gnu::always_inline]] inline ArrayComparison compare_complex(
+            const std::complex<U> *expected, const std::complex<U> *actual, std::size_t n,
+            double abs_tol, double rel_tol, std::size_t max_reported) {
+            // std::complex is laid out as two consecutive values.
+            const U *e = reinterpret_cast<const U *>(expected);
+            const U *a = reinterpret_cast<const U *>(actual);
+            ArrayComparison result;
+            result.size = n;
+            const U at2 = static_cast<U>(abs_tol * abs_tol);
+            const U rt2 = static_cast<U>(rel_tol * rel_tol);
+            typename Lanes<U>::Vec max_abs2{}, max_rel2{};
+            U scalar_abs2 = 0, scalar_rel2 = 0;
+
+            const std::size_t values = 2 * n;
+            const std::size_t vector_end = values - values % Lanes<U>::width;
+            std::size_t i = 0;
+            while (i < vector_end) {
+                const std::size_t len = std::min(block_size, vector_end - i);
+                const std::size_t m = complex_block<U>(e + i, a + i, len, at2, rt2, max_abs2, max_rel2);
+                result.mismatches += m;
+                for (std::size_t j = i; m != 0 && j < i + len &&
+                                        result.first_failures.size() < max_reported; j += 2) {
+                    U ignore_abs = 0, ignore_rel = 0;
+                    if (!complex_element(e + j, a + j, at2, rt2, ignore_abs, ignore_rel)) {
+                        record_failure(result, j / 2, max_reported);
+                    }
+                }
+                i += len;
+            }
+            for (; i < values; i += 2) {
+                if (!complex_element(e + i, a + i, at2, rt2, scalar_abs2, scalar_rel2)) {
+                    ++result.mismatches;
+                    if (result.first_failures.size() < max_reported) record_failure(result, i / 2, max_reported);
+                }
+            }
+            result.max_abs_error = std::sqrt(static_cast<double>(lane_max<U>(max_abs2, scalar_abs2)));
+            result.max_rel_error = std::sqrt(static_cast<double>(lane_max<U>(max_rel2, scalar_rel2)));
+            return result;
+        }
+    } // namespace
+
+    FORTEST_SIMD_TARGETS
+    ArrayComparison compare_arrays(std::span<const int> expected, std::span<const int> actual,
+                                   double abs_tol, double rel_tol, std::size_t max_reported) {
+        return compare_real<int, double>(expected.data(), actual.data(),
+                                         std::min(expected.size(), actual.size()),
+                                         abs_tol, rel_tol, max_reported);
+    }
+
+    FORTEST_SIMD_TARGETS
+    ArrayComparison compare_arrays(std::span<const float> expected, std::span<const float> actual,
+                                   double abs_tol, double rel_tol, std::size_t max_reported) {
+        return compare_real<float, float>(expected.data(), actual.data(),
+                                          std::min(expected.size(), actual.size()),
+                                          abs_tol, rel_tol, max_reported);
+    }
+
+    FORTEST_SIMD_TARGETS
+    ArrayComparison compare_arrays(std::span<const double> expected, std::span<const double> actual,
+                                   double abs_tol, double rel_tol, std::size_t max_reported) {
+        return compare_real<double, double>(expected.data(), actual.data(),
+                                            std::min(expected.size(), actual.size()),
+                                            abs_tol, rel_tol, max_reported);
+    }
+
+    FORTEST_SIMD_TARGETS
+    ArrayComparison compare_arrays(std::span<const std::complex<float>> expected,
+                                   std::span<const std::complex<float>> actual,
+                                   double abs_tol, double rel_tol, std::size_t max_reported) {
+        return compare_complex<float>(expected.data(), actual.data(),
+                                      std::min(expected.size(), actual.size()),
+                                      abs_tol, rel_tol, max_reported);
+    }
+
+    FORTEST_SIMD_TARGETS
+    ArrayComparison compare_arrays(std::span<const std::complex<double>> expected,
+                                   std::span<const std::complex<double>> actual,
+                                   double abs_tol, double rel_tol, std::size_t max_reported) {
+        return compare_complex<double>(expected.data(), actual.data(),
+                                       std::min(expected.size(), actual.size()),
+                                       abs_tol, rel_tol, max_reported);
+    }
+} // namespace Fortest
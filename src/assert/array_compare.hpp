@@ -0,0 +1,73 @@
+#ifndef FORTEST_ARRAY_COMPARE_HPP
+#define FORTEST_ARRAY_COMPARE_HPP
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Fortest {
+    /// Number of failing indices an ArrayComparison keeps by default.
+    inline constexpr std::size_t default_reported_mismatches = 10;
+
+    /**
+     * @brief Outcome of an element-wise comparison of two arrays.
+     *
+     * @details
+     * Element `i` matches when `|expected[i] - actual[i]| <= abs_tol` or
+     * `|expected[i] - actual[i]| <= rel_tol * max(|expected[i]|, |actual[i]|)`,
+     * the same rule as the scalar `Assert::assert_equal`. NaN never
+     * matches. For complex values `|.|` is the modulus.
+     */
+    struct ArrayComparison {
+        std::size_t size = 0;                    //!< Number of elements compared
+        std::size_t mismatches = 0;              //!< Elements outside the tolerances
+        double max_abs_error = 0.0;              //!< Largest |expected - actual|, NaN excluded
+        double max_rel_error = 0.0;              //!< Largest error relative to max(|expected|, |actual|)
+        std::vector<std::size_t> first_failures; //!< Zero-based offsets of the first mismatches
+
+        /// @brief Whether every element matched.
+        [[nodiscard]] bool passed() const noexcept { return mismatches == 0; }
+    };
+
+    /**
+     * @brief Compare two equally sized arrays element by element.
+     *
+     * The comparison runs in SIMD blocks; on x86-64 the widest of
+     * AVX-512, AVX2 and SSE2 supported by the CPU is chosen at run time.
+     * A passing comparison does not allocate.
+     *
+     * @param expected Expected values.
+     * @param actual Actual values; must have the size of `expected`.
+     * @param abs_tol Absolute tolerance; 0 with `rel_tol` 0 requires exact equality.
+     * @param rel_tol Relative tolerance.
+     * @param max_reported How many failing offsets to keep.
+     */
+    ArrayComparison compare_arrays(std::span<const int> expected, std::span<const int> actual,
+                                   double abs_tol = 0.0, double rel_tol = 0.0,
+                                   std::size_t max_reported = default_reported_mismatches);
+
+    /// @copydoc compare_arrays(std::span<const int>, std::span<const int>, double, double, std::size_t)
+    ArrayComparison compare_arrays(std::span<const float> expected, std::span<const float> actual,
+                                   double abs_tol = 0.0, double rel_tol = 0.0,
+                                   std::size_t max_reported = default_reported_mismatches);
+
+    /// @copydoc compare_arrays(std::span<const int>, std::span<const int>, double, double, std::size_t)
+    ArrayComparison compare_arrays(std::span<const double> expected, std::span<const double> actual,
+                                   double abs_tol = 0.0, double rel_tol = 0.0,
+                                   std::size_t max_reported = default_reported_mismatches);
+
+    /// @copydoc compare_arrays(std::span<const int>, std::span<const int>, double, double, std::size_t)
+    ArrayComparison compare_arrays(std::span<const std::complex<float>> expected,
+                                   std::span<const std::complex<float>> actual,
+                                   double abs_tol = 0.0, double rel_tol = 0.0,
+                                   std::size_t max_reported = default_reported_mismatches);
+
+    /// @copydoc compare_arrays(std::span<const int>, std::span<const int>, double, double, std::size_t)
+    ArrayComparison compare_arrays(std::span<const std::complex<double>> expected,
+                                   std::span<const std::complex<double>> actual,
+                                   double abs_tol = 0.0, double rel_tol = 0.0,
+                                   std::size_t max_reported = default_reported_mismatches);
+} // namespace Fortest
+
+#endif // FORTEST_ARRAY_COMPARE_HPP
@@ -1,12 +1,30 @@
 #ifndef ASSERT_HPP
 #define ASSERT_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <concepts>
+#include <cstdint>
 #include <ranges>
+#include <span>
+#include "array_compare.hpp"
 #include "assert_logger.hpp"
+#include "events.hpp"
+#include "fork_guard.hpp"
+#include "memory_usage.hpp"
+#include "snapshot_store.hpp"
 
 namespace Fortest {
     enum class Verbosity {
@@ -15,10 +33,372 @@ namespace Fortest {
         ALL = 2
     };
 
-    template<typename LoggerType = AssertLogger>
+    namespace detail {
+        /// Assertion counts of one thread; written by that thread only,
+        /// with plain loads and stores, and read by any thread.
+        struct CounterShard {
+            std::atomic<int> passed{0};
+            std::atomic<int> failed{0};
+            std::vector<std::string> failures; ///< First failure messages; appended under the shards' mutex
+
+            static void increment(std::atomic<int> &count) noexcept {
+                count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        };
+
+        /// A thread's cached shard of the counters with id `owner`.
+        struct CounterShardCache {
+            std::uint64_t owner = 0;
+            CounterShard *shard = nullptr;
+        };
+
+        /// @brief Assertion counts of the threads sharing one set of counters with its home thread.
+        ///
+        /// @details
+        /// Each thread, e.g. of an OpenMP parallel region, counts into a
+        /// shard of its own, found through a small thread-local cache and
+        /// written by that thread alone, so counting is a plain increment.
+        /// A failing thread also keeps its first failure messages. Read
+        /// and reset the shards while their threads do not count, as at
+        /// the end of a parallel region and between tests.
+        class ThreadShards {
+            struct Shards {
+                std::mutex mutex;
+                ForkGuard fork_guard{mutex};
+                std::deque<CounterShard> shards;
+                std::vector<std::pair<std::thread::id, CounterShard *>> owners;
+            };
+
+            static inline std::atomic<std::uint64_t> s_next_id{1};
+            /// Shards of the counters this thread used last, most recent first.
+            static inline thread_local std::array<CounterShardCache, 4> s_cache{};
+
+            const std::uint64_t m_id = s_next_id.fetch_add(1, std::memory_order_relaxed);
+            std::atomic<Shards *> m_shards{nullptr}; ///< Created by the first thread that counts
+
+            /// @brief The shards, created on first use.
+            Shards &shards() {
+                Shards *existing = m_shards.load(std::memory_order_acquire);
+                if (existing) return *existing;
+                auto created = std::make_unique<Shards>();
+                if (m_shards.compare_exchange_strong(existing, created.get(), std::memory_order_acq_rel)) {
+                    return *created.release();
+                }
+                return *existing;
+            }
+
+            /// @brief The calling thread's shard, created on first use.
+            CounterShard &local() {
+                auto hit = std::find_if(s_cache.begin(), s_cache.end(),
+                                        [this](const CounterShardCache &entry) { return entry.owner == m_id; });
+                CounterShardCache entry;
+                if (hit != s_cache.end()) {
+                    entry = *hit;
+                } else {
+                    hit = s_cache.end() - 1;
+                    const auto self = std::this_thread::get_id();
+                    Shards &all = shards();
+                    std::lock_guard lock(all.mutex);
+                    const auto owner = std::find_if(all.owners.begin(), all.owners.end(),
+                                                    [self](const auto &o) { return o.first == self; });
+                    if (owner != all.owners.end()) {
+                        entry = {m_id, owner->second};
+                    } else {
+                        entry = {m_id, &all.shards.emplace_back()};
+                        all.owners.emplace_back(self, entry.shard);
+                    }
+                }
+                std::move_backward(s_cache.begin(), hit, hit + 1);
+                s_cache[0] = entry;
+                return *entry.shard;
+            }
+
+        public:
+            /// Failure messages kept per thread; later failures are only counted.
+            static constexpr std::size_t max_messages = 8;
+
+            ThreadShards() = default;
+            ThreadShards(const ThreadShards &) = delete;
+            ThreadShards &operator=(const ThreadShards &) = delete;
+            ~ThreadShards() { delete m_shards.load(std::memory_order_acquire); }
+
+            /// @brief Count a passed assertion of the calling thread.
+            [[gnu::noinline]] void pass() { CounterShard::increment(local().passed); }
+
+            /// @brief Count a failed assertion of the calling thread and keep its message.
+            template<typename MakeMessage>
+            [[gnu::noinline, gnu::cold]] void fail(MakeMessage &&make_message) {
+                CounterShard &shard = local();
+                CounterShard::increment(shard.failed);
+                if (shard.failures.size() >= max_messages) return;
+                std::string message = make_message();
+                std::lock_guard lock(shards().mutex);
+                shard.failures.push_back(std::move(message));
+            }
+
+            /// @brief Assertions counted by the shards, passed and failed.
+            [[nodiscard]] std::pair<int, int> totals() const {
+                Shards *all = m_shards.load(std::memory_order_acquire);
+                if (!all) return {0, 0};
+                std::lock_guard lock(all->mutex);
+                std::pair<int, int> totals;
+                for (const auto &s: all->shards) {
+                    totals.first += s.passed.load(std::memory_order_relaxed);
+                    totals.second += s.failed.load(std::memory_order_relaxed);
+                }
+                return totals;
+            }
+
+            /// @brief The kept failure messages, one line each, e.g. `\n    thread 2: condition is false`.
+            [[nodiscard]] std::string failure_report() const {
+                Shards *all = m_shards.load(std::memory_order_acquire);
+                if (!all) return {};
+                std::lock_guard lock(all->mutex);
+                std::string report;
+                std::size_t thread = 0;
+                for (const auto &s: all->shards) {
+                    ++thread;
+                    const std::string prefix = "\n    thread " + std::to_string(thread) + ": ";
+                    for (const auto &message: s.failures) report += prefix + message;
+                    const int more = s.failed.load(std::memory_order_relaxed) - static_cast<int>(s.failures.size());
+                    if (more > 0) report += prefix + std::to_string(more) + " more failed assertions";
+                }
+                return report;
+            }
+
+            /// @brief Zero the counts and drop the messages.
+            void reset() {
+                Shards *all = m_shards.load(std::memory_order_acquire);
+                if (!all) return;
+                std::lock_guard lock(all->mutex);
+                for (auto &s: all->shards) {
+                    s.passed.store(0, std::memory_order_relaxed);
+                    s.failed.store(0, std::memory_order_relaxed);
+                    s.failures.clear();
+                }
+            }
+        };
+    }
+
+    /// @brief Assertion counters of one test, bound to the threads that run it.
+    ///
+    /// @details
+    /// While a context is bound, every Assert used on that thread counts
+    /// into the context instead of into its own members. The parallel
+    /// scheduler binds one context per running test so that concurrent
+    /// tests, including `c_assert_*` calls coming from Fortran through
+    /// the global Assert, never share counters.
+    ///
+    /// The thread that created the context counts into `num_passed` and
+    /// `num_failed`. Threads the test starts, such as the threads of an
+    /// OpenMP parallel region, count toward the test once they bind the
+    /// test's context themselves, e.g. `Binding binding(parent)` with the
+    /// `current()` context of the thread that started them; each counts
+    /// into a shard of its own and keeps its failure messages for the
+    /// test's report.
+    class AssertContext {
+        static inline thread_local AssertContext *s_current = nullptr;
+
+        const void *m_home = thread_key();
+        detail::ThreadShards m_threads;
+
+    public:
+        int num_passed{}; ///< Assertions that passed on the creating thread while bound
+        int num_failed{}; ///< Assertions that failed on the creating thread while bound
+
+        AssertContext() = default;
+        AssertContext(const AssertContext &) = delete;
+        AssertContext &operator=(const AssertContext &) = delete;
+
+        /// @brief Context bound to the calling thread, or nullptr.
+        [[nodiscard]] static AssertContext *current() noexcept { return s_current; }
+
+        /// @brief Address unique to the calling thread, as cheap to get as current().
+        [[nodiscard]] static const void *thread_key() noexcept { return &s_current; }
+
+        /// @brief Bind `context`, which may be nullptr, to the calling thread.
+        /// @return The context bound before.
+        static AssertContext *exchange(AssertContext *context) noexcept { return std::exchange(s_current, context); }
+
+        /// @brief Count a passed assertion of the calling thread.
+        void pass() {
+            if (thread_key() == m_home) [[likely]] {
+                ++num_passed;
+            } else {
+                m_threads.pass();
+            }
+        }
+
+        /// @brief Count a failed assertion of the calling thread; other threads keep its message.
+        template<typename MakeMessage>
+        void fail(MakeMessage &&make_message) {
+            if (thread_key() == m_home) {
+                ++num_failed;
+            } else {
+                m_threads.fail(make_message);
+            }
+        }
+
+        /// @brief Passed assertions of all threads bound to the context.
+        [[nodiscard]] int passed() const { return num_passed + m_threads.totals().first; }
+
+        /// @brief Failed assertions of all threads bound to the context.
+        [[nodiscard]] int failed() const { return num_failed + m_threads.totals().second; }
+
+        /// @brief Zero the counts of all threads; the other threads must not be counting.
+        void reset() {
+            num_passed = num_failed = 0;
+            m_threads.reset();
+        }
+
+        /// @brief Failure messages of the threads other than the creating one, one line each.
+        [[nodiscard]] std::string thread_failure_report() const { return m_threads.failure_report(); }
+
+        /// @brief RAII guard binding a context to the calling thread.
+        ///
+        /// Restores the previously bound context on destruction.
+        class Binding {
+            AssertContext *m_previous;
+
+        public:
+            explicit Binding(AssertContext &context) noexcept : m_previous(exchange(&context)) {}
+
+            /// @brief Bind `context`, e.g. the current() context of a parent thread; nullptr unbinds.
+            explicit Binding(AssertContext *context) noexcept : m_previous(exchange(context)) {}
+
+            ~Binding() { exchange(m_previous); }
+
+            Binding(const Binding &) = delete;
+            Binding &operator=(const Binding &) = delete;
+        };
+    };
+
+    /// @brief Verbosity policy: report as each call's Verbosity argument asks (the default).
+    struct RuntimeVerbosity {
+        static constexpr bool reports_passes(Verbosity verbosity) noexcept { return verbosity == Verbosity::ALL; }
+        static constexpr bool reports_failures(Verbosity verbosity) noexcept { return verbosity != Verbosity::QUIET; }
+    };
+
+    /// @brief Verbosity policy: never report passes; report failures as the call asks.
+    ///
+    /// Used by release builds (FORTEST_RELEASE_ASSERTS): the pass path
+    /// is a counter increment whatever the caller's verbosity.
+    struct QuietPasses {
+        static constexpr bool reports_passes(Verbosity) noexcept { return false; }
+        static constexpr bool reports_failures(Verbosity verbosity) noexcept { return verbosity != Verbosity::QUIET; }
+    };
+
+    /// @brief Verbosity policy: ignore the Verbosity arguments and always report at `Fixed`.
+    template<Verbosity Fixed>
+    struct FixedVerbosity {
+        static constexpr bool reports_passes(Verbosity) noexcept { return Fixed == Verbosity::ALL; }
+        static constexpr bool reports_failures(Verbosity) noexcept { return Fixed != Verbosity::QUIET; }
+    };
+
+    /// @brief Counter policy: count into the AssertContext bound to the calling thread,
+    /// or into itself when none is (the default; required inside test sessions).
+    ///
+    /// @details
+    /// Without a bound context, the thread that created the counters
+    /// counts into plain members, as it always did, and other threads,
+    /// e.g. the OpenMP threads of a parallel region inside a serially
+    /// run test, count into detail::ThreadShards. Read the counts once
+    /// the threads that assert have joined, as they have at the end of a
+    /// parallel region and of a test.
+    ///
+    /// A thread that runs no test of its own and has no context bound
+    /// while the tests run concurrently counts into the counters, not
+    /// toward any test: bind the test's context on it (see AssertContext).
+    class ContextCounters {
+        int m_passed = 0;
+        int m_failed = 0;
+        const void *m_home = AssertContext::thread_key();
+        detail::ThreadShards m_threads;
+
+    public:
+        void pass() {
+            if (auto *ctx = AssertContext::current()) {
+                ctx->pass();
+            } else if (AssertContext::thread_key() == m_home) [[likely]] {
+                ++m_passed;
+            } else {
+                m_threads.pass();
+            }
+        }
+
+        /// @brief Count a failure; `make_message()` gives its message if a thread report keeps it.
+        template<typename MakeMessage>
+        void fail(MakeMessage &&make_message) {
+            if (auto *ctx = AssertContext::current()) {
+                ctx->fail(make_message);
+            } else if (AssertContext::thread_key() == m_home) {
+                ++m_failed;
+            } else {
+                m_threads.fail(make_message);
+            }
+        }
+
+        [[nodiscard]] int passed() const {
+            if (auto *ctx = AssertContext::current()) return ctx->passed();
+            return m_passed + m_threads.totals().first;
+        }
+
+        [[nodiscard]] int failed() const {
+            if (auto *ctx = AssertContext::current()) return ctx->failed();
+            return m_failed + m_threads.totals().second;
+        }
+
+        void reset() {
+            if (auto *ctx = AssertContext::current()) {
+                ctx->reset();
+                return;
+            }
+            m_passed = m_failed = 0;
+            m_threads.reset();
+        }
+
+        /// @brief Failure messages of threads other than the counting test's own, one line each.
+        [[nodiscard]] std::string thread_failure_report() const {
+            if (auto *ctx = AssertContext::current()) return ctx->thread_failure_report();
+            return m_threads.failure_report();
+        }
+    };
+
+    /// @brief Counter policy: plain member counters, without the thread-local lookup.
+    ///
+    /// For an Assert used by one thread outside a session, e.g. in a
+    /// hand-written performance test.
+    class LocalCounters {
+        int m_passed{};
+        int m_failed{};
+
+    public:
+        void pass() noexcept { ++m_passed; }
+        template<typename MakeMessage>
+        void fail(MakeMessage &&) noexcept { ++m_failed; }
+        [[nodiscard]] int passed() const noexcept { return m_passed; }
+        [[nodiscard]] int failed() const noexcept { return m_failed; }
+        void reset() noexcept { m_passed = m_failed = 0; }
+        [[nodiscard]] std::string thread_failure_report() const { return {}; }
+    };
+
+#ifdef FORTEST_RELEASE_ASSERTS
+    using DefaultVerbosityPolicy = QuietPasses;
+#else
+    using DefaultVerbosityPolicy = RuntimeVerbosity;
+#endif
+
+    /// @brief Assertion engine.
+    ///
+    /// @tparam LoggerType Receives the reported assertions.
+    /// @tparam VerbosityPolicy Decides which assertions are reported;
+    ///         with a policy that ignores the Verbosity argument, the
+    ///         reporting branches fold away at compile time.
+    /// @tparam CounterPolicy Counts passed and failed assertions.
+    template<typename LoggerType = AssertLogger, typename VerbosityPolicy = DefaultVerbosityPolicy,
+             typename CounterPolicy = ContextCounters>
     class Assert {
-        int m_num_passed{};
-        int m_num_failed{};
+        CounterPolicy m_counts;
         std::shared_ptr<LoggerType> m_logger; ///< internal logger
 
         template<typename Value>
@@ -50,13 +430,79 @@ namespace Fortest {
             }
         }
 
+        template<typename T, typename Tol>
+        static bool values_equal(const T &expected, const T &actual, Tol abs_tol, Tol rel_tol) {
+            if constexpr (std::is_floating_point_v<T>) {
+                auto diff = std::abs(expected - actual);
+                return (diff <= abs_tol) ||
+                       (diff <= rel_tol * std::max(std::abs(expected), std::abs(actual)));
+            } else {
+                return expected == actual;
+            }
+        }
+
+        /// @brief "(i,j,...)" 1-based column-major subscripts, or "[offset]" without a shape.
+        static std::string element_name(std::size_t offset, std::span<const std::int64_t> shape) {
+            if (shape.empty()) {
+                return "[" + std::to_string(offset) + "]";
+            }
+            std::string name = "(";
+            for (std::size_t d = 0; d < shape.size(); ++d) {
+                const auto extent = static_cast<std::size_t>(std::max<std::int64_t>(shape[d], 1));
+                if (d > 0) name += ",";
+                name += std::to_string(offset % extent + 1);
+                offset /= extent;
+            }
+            return name + ")";
+        }
+
+        /// @brief Count an assertion and report it if the verbosity asks for it.
+        ///
+        /// A passing assertion below `Verbosity::ALL` only increments a
+        /// counter: `make_message` runs, and allocates, only for an
+        /// assertion that is actually reported. A failed assertion is
+        /// also published on the event bus if anything subscribes to it.
+        template<typename MakeMessage>
+        void record(bool pass, Verbosity verbosity, MakeMessage &&make_message) {
+            if (pass) [[likely]] {
+                if (VerbosityPolicy::reports_passes(verbosity)) [[unlikely]] {
+                    report(make_message(true), "PASS");
+                }
+                m_counts.pass();
+            } else {
+                const bool reporting = VerbosityPolicy::reports_failures(verbosity);
+                const bool publishing = EventBus::global().has_subscribers();
+                std::string msg;
+                if (reporting || publishing) {
+                    msg = make_message(false);
+                    if (reporting) report(msg, "FAIL");
+                    if (publishing) publish_failure(msg);
+                }
+                m_counts.fail([&] { return reporting || publishing ? msg : make_message(false); });
+            }
+        }
+
+        /// @brief Hand a message to the logger; kept out of line of the pass path.
+        [[gnu::noinline, gnu::cold]] void report(const std::string &msg, const char *tag) {
+            m_logger->log(msg, tag);
+        }
+
+        /// @brief Publish a failed assertion on the event bus.
+        [[gnu::noinline, gnu::cold]] static void publish_failure(std::string_view msg) {
+            EventBus::global().publish(Event{.kind = EventKind::AssertionFailed,
+                                             .text = msg,
+                                             .time = std::chrono::system_clock::now()});
+        }
+
     public:
         template<typename... Args>
         explicit Assert(Args&&... args)
             : m_logger(std::make_shared<LoggerType>(std::forward<Args>(args)...)) {}
 
 
+        /// @brief Equality check for non-string values.
         template<typename T>
+            requires (!std::convertible_to<const T &, std::string_view>)
         void assert_equal(
             const T &expected,
             const T &actual,
@@ -64,34 +510,38 @@ namespace Fortest {
             std::conditional_t<std::is_floating_point_v<T>, T, double> rel_tol = 0,
             Verbosity verbosity = Verbosity::QUIET
         ) {
-            bool pass = false;
-
-            if constexpr (std::is_floating_point_v<T>) {
-                auto diff = std::abs(expected - actual);
-                pass = (diff <= abs_tol) ||
-                       (diff <= rel_tol * std::max(std::abs(expected), std::abs(actual)));
-            } else {
-                pass = (expected == actual);
-            }
+            const bool pass = values_equal(expected, actual, abs_tol, rel_tol);
+            record(pass, verbosity, [&](bool passed) {
+                return passed
+                           ? "values are equal (" + to_string_repr(expected) +
+                             " == " + to_string_repr(actual) + ")"
+                           : "values are not equal (" + to_string_repr(expected) +
+                             " != " + to_string_repr(actual) + ")";
+            });
+        }
 
-            if (pass) {
-                if (verbosity == Verbosity::ALL) {
-                    auto msg = "values are equal (" + to_string_repr(expected) +
-                               " == " + to_string_repr(actual) + ")";
-                    m_logger->log(msg, "PASS");
-                }
-                ++m_num_passed;
-            } else {
-                if (verbosity != Verbosity::QUIET) {
-                    m_logger->log(
-                        "values are not equal (" + to_string_repr(expected) +
-                        " != " + to_string_repr(actual) + ")", "FAIL");
-                }
-                ++m_num_failed;
-            }
+        /// @brief Equality check for strings; compares views, never copies.
+        void assert_equal(
+            std::string_view expected,
+            std::string_view actual,
+            double abs_tol = 0,
+            double rel_tol = 0,
+            Verbosity verbosity = Verbosity::QUIET
+        ) {
+            (void) abs_tol;
+            (void) rel_tol;
+            record(expected == actual, verbosity, [&](bool passed) {
+                return passed
+                           ? "values are equal (" + to_string_repr(expected) +
+                             " == " + to_string_repr(actual) + ")"
+                           : "values are not equal (" + to_string_repr(expected) +
+                             " != " + to_string_repr(actual) + ")";
+            });
         }
 
+        /// @brief Inequality check for non-string values.
         template<typename T>
+            requires (!std::convertible_to<const T &, std::string_view>)
         void assert_not_equal(
             const T &expected,
             const T &actual,
@@ -99,65 +549,244 @@ namespace Fortest {
             std::conditional_t<std::is_floating_point_v<T>, T, double> rel_tol = 0,
             Verbosity verbosity = Verbosity::QUIET
         ) {
-            bool pass = false;
+            const bool pass = !values_equal(expected, actual, abs_tol, rel_tol);
+            record(pass, verbosity, [&](bool passed) {
+                return passed
+                           ? "values are not equal (" + to_string_repr(expected) +
+                             " != " + to_string_repr(actual) + ")"
+                           : "values are equal (" + to_string_repr(expected) +
+                             " == " + to_string_repr(actual) + ")";
+            });
+        }
+
+        /// @brief Inequality check for strings; compares views, never copies.
+        void assert_not_equal(
+            std::string_view expected,
+            std::string_view actual,
+            double abs_tol = 0,
+            double rel_tol = 0,
+            Verbosity verbosity = Verbosity::QUIET
+        ) {
+            (void) abs_tol;
+            (void) rel_tol;
+            record(expected != actual, verbosity, [&](bool passed) {
+                return passed
+                           ? "values are not equal (" + to_string_repr(expected) +
+                             " != " + to_string_repr(actual) + ")"
+                           : "values are equal (" + to_string_repr(expected) +
+                             " == " + to_string_repr(actual) + ")";
+            });
+        }
 
-            if constexpr (std::is_floating_point_v<T>) {
-                auto diff = std::abs(expected - actual);
-                bool nearly_equal = (diff <= abs_tol) ||
-                                    (diff <= rel_tol * std::max(std::abs(expected), std::abs(actual)));
-                pass = !nearly_equal;
-            } else {
-                pass = (expected != actual);
+        /**
+         * @brief Element-wise equality of two arrays, counted as one assertion.
+         *
+         * Compares with compare_arrays(); on failure the report names the
+         * number of mismatches, the largest errors and the first failing
+         * elements. Arrays of different sizes always fail.
+         *
+         * @param expected Expected values.
+         * @param actual Actual values.
+         * @param abs_tol Absolute tolerance.
+         * @param rel_tol Relative tolerance.
+         * @param verbosity When to log the result.
+         * @param shape Extents of a column-major (Fortran) array, used to
+         *        name failing elements by 1-based subscripts; empty names
+         *        them by 0-based offset.
+         * @return The comparison, for callers that inspect the errors.
+         */
+        template<typename T>
+        ArrayComparison assert_array_equal(
+            std::span<const T> expected,
+            std::span<const T> actual,
+            double abs_tol = 0,
+            double rel_tol = 0,
+            Verbosity verbosity = Verbosity::QUIET,
+            std::span<const std::int64_t> shape = {}
+        ) {
+            if (expected.size() != actual.size()) [[unlikely]] {
+                ArrayComparison result;
+                result.size = std::min(expected.size(), actual.size());
+                result.mismatches = std::max(expected.size(), actual.size()) - result.size;
+                record(false, verbosity, [&](bool) {
+                    return "array sizes differ (" + std::to_string(expected.size()) +
+                           " != " + std::to_string(actual.size()) + ")";
+                });
+                return result;
             }
-
-            if (pass) {
-                if (verbosity == Verbosity::ALL) {
-                    m_logger->log(
-                        "values are not equal (" + to_string_repr(expected) +
-                        " != " + to_string_repr(actual) + ")", "PASS");
+            ArrayComparison result = compare_arrays(expected, actual, abs_tol, rel_tol);
+            record(result.passed(), verbosity, [&](bool passed) {
+                if (passed) {
+                    return "arrays are equal (" + std::to_string(result.size) + " elements)";
                 }
-                ++m_num_passed;
-            } else {
-                if (verbosity != Verbosity::QUIET) {
-                    m_logger->log(
-                        "values are equal (" + to_string_repr(expected) +
-                        " == " + to_string_repr(actual) + ")", "FAIL");
+                std::ostringstream oss;
+                oss << "arrays differ in " << result.mismatches << " of " << result.size
+                    << " elements (max abs error " << result.max_abs_error
+                    << ", max rel error " << result.max_rel_error << ")";
+                const char *separator = "; first: ";
+                for (const auto offset: result.first_failures) {
+                    oss << separator << element_name(offset, shape) << " expected "
+                        << to_string_repr(expected[offset]) << " actual "
+                        << to_string_repr(actual[offset]);
+                    separator = ", ";
                 }
-                ++m_num_failed;
-            }
+                return oss.str();
+            });
+            return result;
         }
 
-        void assert_true(bool condition, Verbosity verbosity = Verbosity::QUIET) {
-            if (condition) {
-                if (verbosity == Verbosity::ALL) {
-                    m_logger->log("condition is true", "PASS");
+        /**
+         * @brief Compare an array with its recorded snapshot, counted as one assertion.
+         *
+         * The first run, or any run with updating requested (see
+         * SnapshotStore::configure()), records `actual` as snapshot `name`
+         * and passes. Later runs compare element-wise as
+         * assert_array_equal() does; a snapshot of another element type or
+         * shape fails.
+         *
+         * @param name Snapshot name, unique among the tests of the store.
+         * @param actual Actual values.
+         * @param abs_tol Absolute tolerance.
+         * @param rel_tol Relative tolerance.
+         * @param verbosity When to log the result.
+         * @param shape Extents of a column-major (Fortran) array; stored
+         *        with the snapshot and used to name failing elements.
+         *        Empty means a one-dimensional array.
+         * @param store Where snapshots are kept.
+         * @return The comparison; empty when the snapshot was recorded.
+         */
+        template<typename T>
+        ArrayComparison assert_matches_snapshot(
+            std::string_view name,
+            std::span<const T> actual,
+            double abs_tol = 0,
+            double rel_tol = 0,
+            Verbosity verbosity = Verbosity::QUIET,
+            std::span<const std::int64_t> shape = {},
+            const SnapshotStore &store = SnapshotStore::global()
+        ) {
+            const std::int64_t flat_shape[] = {static_cast<std::int64_t>(actual.size())};
+            const auto stored_shape = shape.empty() ? std::span<const std::int64_t>(flat_shape) : shape;
+            const SnapshotCheck<T> check = store.check(name, actual, stored_shape, abs_tol, rel_tol);
+            const ArrayComparison &result = check.comparison;
+            record(check.error.empty() && result.passed(), verbosity, [&](bool passed) {
+                if (!check.error.empty()) return check.error;
+                if (check.recorded) {
+                    return "snapshot '" + std::string(name) + "' recorded (" + std::to_string(result.size) +
+                           " elements)";
                 }
-                ++m_num_passed;
-            } else {
-                if (verbosity != Verbosity::QUIET) {
-                    m_logger->log("condition is false", "FAIL");
+                if (passed) {
+                    return "array matches snapshot '" + std::string(name) + "' (" + std::to_string(result.size) +
+                           " elements)";
+                }
+                std::ostringstream oss;
+                oss << "array differs from snapshot '" << name << "' in " << result.mismatches << " of "
+                    << result.size << " elements (max abs error " << result.max_abs_error
+                    << ", max rel error " << result.max_rel_error << ")";
+                const char *separator = "; first: ";
+                for (std::size_t i = 0; i < result.first_failures.size(); ++i) {
+                    const auto offset = result.first_failures[i];
+                    oss << separator << element_name(offset, shape) << " expected "
+                        << to_string_repr(check.expected_at_failures[i]) << " actual "
+                        << to_string_repr(actual[offset]);
+                    separator = ", ";
                 }
-                ++m_num_failed;
+                return oss.str();
+            });
+            return result;
+        }
+
+        /**
+         * @brief Check that one call of `call` takes at most `max_seconds` of wall time.
+         *
+         * Timed with a monotonic clock; the message of a failure gives
+         * both durations. Catches performance regressions of code whose
+         * duration has a hard bound; register_benchmark() with a baseline
+         * compares against past runs instead.
+         *
+         * @return The measured duration in seconds.
+         */
+        template<typename Call>
+        double assert_duration_below(Call &&call, double max_seconds, Verbosity verbosity = Verbosity::QUIET) {
+            const auto start = std::chrono::steady_clock::now();
+            std::forward<Call>(call)();
+            const double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            record(seconds <= max_seconds, verbosity, [&](bool passed) {
+                return "call took " + to_string_repr(seconds) + " s (" + (passed ? "<= " : "> ") +
+                       "limit " + to_string_repr(max_seconds) + " s)";
+            });
+            return seconds;
+        }
+
+        /**
+         * @brief Check that the current test's peak resident memory grew by at most `max_bytes`.
+         *
+         * The growth is measured from the resident set at the start of
+         * the test body when memory tracking is on (see MemoryTracking);
+         * otherwise `max_bytes` limits the peak of the whole process.
+         * Resident memory belongs to the process, so with tracking on the
+         * peak is not measured while another test body runs in it, and
+         * the assertion fails; run such a test serially or in a forked
+         * child.
+         *
+         * @return The measured growth in bytes, or MemoryUsage::peak_not_measured.
+         */
+        std::int64_t assert_max_memory(std::int64_t max_bytes, Verbosity verbosity = Verbosity::QUIET) {
+            const std::int64_t used = MemoryTracking::peak_growth_bytes();
+            if (used == MemoryUsage::peak_not_measured) {
+                record(false, verbosity, [](bool) {
+                    return std::string("peak resident memory not measured: other tests ran in the same "
+                                       "process; run serially or with process isolation");
+                });
+                return used;
             }
+            record(used <= max_bytes, verbosity, [&](bool passed) {
+                return "peak resident memory grew by " + std::to_string(used) + " bytes (" +
+                       (passed ? "<= " : "> ") + "limit " + std::to_string(max_bytes) + " bytes)";
+            });
+            return used;
+        }
+
+        /// @brief Record a passed assertion whose check the caller made.
+        void pass(const std::string &what, Verbosity verbosity = Verbosity::QUIET) {
+            record(true, verbosity, [&](bool) { return what; });
+        }
+
+        /// @brief Record a failed assertion whose reason the caller determined.
+        void fail(const std::string &reason, Verbosity verbosity = Verbosity::QUIET) {
+            record(false, verbosity, [&](bool) { return reason; });
+        }
+
+        void assert_true(bool condition, Verbosity verbosity = Verbosity::QUIET) {
+            record(condition, verbosity, [](bool passed) {
+                return std::string(passed ? "condition is true" : "condition is false");
+            });
         }
 
         void assert_false(bool condition, Verbosity verbosity = Verbosity::QUIET) {
-            if (!condition) {
-                if (verbosity == Verbosity::ALL) {
-                    m_logger->log("condition is false", "PASS");
-                }
-                ++m_num_passed;
-            } else {
-                if (verbosity != Verbosity::QUIET) {
-                    m_logger->log("condition is true", "FAIL");
-                }
-                ++m_num_failed;
-            }
+            record(!condition, verbosity, [](bool passed) {
+                return std::string(passed ? "condition is false" : "condition is true");
+            });
         }
 
-        int get_num_passed() const { return m_num_passed; }
-        int get_num_failed() const { return m_num_failed; }
-        void reset() { m_num_passed = m_num_failed = 0; }
+        /// @brief Passed assertions (of the bound AssertContext, if any and counted there).
+        int get_num_passed() const { return m_counts.passed(); }
+
+        /// @brief Failed assertions (of the bound AssertContext, if any and counted there).
+        int get_num_failed() const { return m_counts.failed(); }
+
+        /// @brief Reset the counters (of the bound AssertContext, if any and counted there).
+        void reset() { m_counts.reset(); }
+
+        /**
+         * @brief Failure messages of the other threads counting toward the current test, one line each.
+         *
+         * Empty unless a thread other than the test's own failed an
+         * assertion, e.g. inside an OpenMP parallel region; the messages
+         * are kept whatever the verbosity.
+         */
+        [[nodiscard]] std::string thread_failure_report() const { return m_counts.thread_failure_report(); }
 
         /// @brief Access the underlying logger.
         std::shared_ptr<LoggerType> get_logger() const { return m_logger; }
@@ -5,7 +5,23 @@
 !> implementations for consistency and integration with the Fortest
 !> framework. Supported assertions include:
 !> - Equality and inequality for integers, reals, doubles, and strings
+!> - Element-wise equality of whole integer, real, double and complex
+!>   arrays of rank 1 to 7, checked in one call (`assert_equal`)
 !> - Boolean checks (`assert_true`, `assert_false`)
+!> - Wall-time limits of a procedure call (`assert_duration_below`)
+!> - Resident memory limits of the running test (`assert_max_memory`)
+!> - Comparison of arrays with snapshots recorded by an earlier run
+!>   (`assert_matches_snapshot`)
+!>
+!> Assertions on threads a test starts, e.g. in an OpenMP parallel
+!> region, count toward the test once the thread binds its context:
+!>
+!>     context = assert_context()
+!>     !$omp parallel
+!>     call bind_assert_context(context)
+!>     ...
+!>     call unbind_assert_context()
+!>     !$omp end parallel
 !>
 !> Verbosity control:
 !> - 0 = QUIET     (no output, even on failure)
@@ -15,8 +31,9 @@
 !> Each routine accepts an optional `verbosity` argument to override
 !> the global default.
 module fortest_assert
-    use iso_c_binding, only : c_int, c_float, c_double, c_ptr
-    use f_c_string_t_mod, only : f_c_string_t
+    use iso_c_binding, only : c_int, c_int64_t, c_size_t, c_char, c_float, c_double, &
+            c_float_complex, c_double_complex, c_ptr, c_loc, c_funptr, c_funloc
+    use procedure_interfaces_mod, only : timed_proc
 
     implicit none
     private
@@ -25,11 +42,31 @@ module fortest_assert
     public :: assert_not_equal
     public :: assert_true
     public :: assert_false
+    public :: assert_duration_below
+    public :: assert_max_memory
+    public :: assert_matches_snapshot
+    public :: assert_context
+    public :: bind_assert_context
+    public :: unbind_assert_context
 
     integer, parameter, public :: VERBOSITY_QUIET = 0
     integer, parameter, public :: VERBOSITY_FAIL_ONLY = 1
     integer, parameter, public :: VERBOSITY_ALL = 2
 
+    !> Failing elements an array_report_t can name.
+    integer, parameter, public :: ARRAY_REPORT_INDICES = 10
+
+    !> @brief Outcome of an array assertion (mirrors `fortest_array_report`).
+    type, bind(C), public :: array_report_t
+        integer(c_int64_t) :: size            !! Elements compared
+        integer(c_int64_t) :: mismatches      !! Elements outside the tolerances
+        real(c_double) :: max_abs_error       !! Largest absolute error
+        real(c_double) :: max_rel_error       !! Largest relative error
+        integer(c_int64_t) :: num_reported    !! Valid entries of first_failures
+        !> 1-based positions, in array element order, of the first mismatches
+        integer(c_int64_t) :: first_failures(ARRAY_REPORT_INDICES)
+    end type array_report_t
+
     !> @brief Assert equality of two values.
     interface assert_equal
         module procedure assert_equal_int
@@ -37,6 +74,41 @@ module fortest_assert
         module procedure assert_equal_float
         module procedure assert_equal_double
         module procedure assert_equal_string
+        module procedure assert_equal_int_r1
+        module procedure assert_equal_int_r2
+        module procedure assert_equal_int_r3
+        module procedure assert_equal_int_r4
+        module procedure assert_equal_int_r5
+        module procedure assert_equal_int_r6
+        module procedure assert_equal_int_r7
+        module procedure assert_equal_float_r1
+        module procedure assert_equal_float_r2
+        module procedure assert_equal_float_r3
+        module procedure assert_equal_float_r4
+        module procedure assert_equal_float_r5
+        module procedure assert_equal_float_r6
+        module procedure assert_equal_float_r7
+        module procedure assert_equal_double_r1
+        module procedure assert_equal_double_r2
+        module procedure assert_equal_double_r3
+        module procedure assert_equal_double_r4
+        module procedure assert_equal_double_r5
+        module procedure assert_equal_double_r6
+        module procedure assert_equal_double_r7
+        module procedure assert_equal_complex_float_r1
+        module procedure assert_equal_complex_float_r2
+        module procedure assert_equal_complex_float_r3
+        module procedure assert_equal_complex_float_r4
+        module procedure assert_equal_complex_float_r5
+        module procedure assert_equal_complex_float_r6
+        module procedure assert_equal_complex_float_r7
+        module procedure assert_equal_complex_double_r1
+        module procedure assert_equal_complex_double_r2
+        module procedure assert_equal_complex_double_r3
+        module procedure assert_equal_complex_double_r4
+        module procedure assert_equal_complex_double_r5
+        module procedure assert_equal_complex_double_r6
+        module procedure assert_equal_complex_double_r7
     end interface assert_equal
 
     !> @brief Assert inequality of two values.
@@ -48,6 +120,45 @@ module fortest_assert
         module procedure assert_not_equal_string
     end interface assert_not_equal
 
+    !> @brief Assert that an array matches its recorded snapshot.
+    interface assert_matches_snapshot
+        module procedure assert_matches_snapshot_int_r1
+        module procedure assert_matches_snapshot_int_r2
+        module procedure assert_matches_snapshot_int_r3
+        module procedure assert_matches_snapshot_int_r4
+        module procedure assert_matches_snapshot_int_r5
+        module procedure assert_matches_snapshot_int_r6
+        module procedure assert_matches_snapshot_int_r7
+        module procedure assert_matches_snapshot_float_r1
+        module procedure assert_matches_snapshot_float_r2
+        module procedure assert_matches_snapshot_float_r3
+        module procedure assert_matches_snapshot_float_r4
+        module procedure assert_matches_snapshot_float_r5
+        module procedure assert_matches_snapshot_float_r6
+        module procedure assert_matches_snapshot_float_r7
+        module procedure assert_matches_snapshot_double_r1
+        module procedure assert_matches_snapshot_double_r2
+        module procedure assert_matches_snapshot_double_r3
+        module procedure assert_matches_snapshot_double_r4
+        module procedure assert_matches_snapshot_double_r5
+        module procedure assert_matches_snapshot_double_r6
+        module procedure assert_matches_snapshot_double_r7
+        module procedure assert_matches_snapshot_complex_float_r1
+        module procedure assert_matches_snapshot_complex_float_r2
+        module procedure assert_matches_snapshot_complex_float_r3
+        module procedure assert_matches_snapshot_complex_float_r4
+        module procedure assert_matches_snapshot_complex_float_r5
+        module procedure assert_matches_snapshot_complex_float_r6
+        module procedure assert_matches_snapshot_complex_float_r7
+        module procedure assert_matches_snapshot_complex_double_r1
+        module procedure assert_matches_snapshot_complex_double_r2
+        module procedure assert_matches_snapshot_complex_double_r3
+        module procedure assert_matches_snapshot_complex_double_r4
+        module procedure assert_matches_snapshot_complex_double_r5
+        module procedure assert_matches_snapshot_complex_double_r6
+        module procedure assert_matches_snapshot_complex_double_r7
+    end interface assert_matches_snapshot
+
 contains
 
     !> @brief Assert that two integers are equal.
@@ -173,14 +284,14 @@ contains
         character(len = *), intent(in) :: expected, actual
         integer(c_int), intent(in), optional :: verbosity
         integer(c_int) :: verbosity_level
-        type(f_c_string_t) :: f_c_string_expected, f_c_string_actual
-        integer :: status
         interface
-            subroutine c_assert_equal_string(expected, actual, verbosity) bind(C)
-                import :: c_ptr, c_int
-                type(c_ptr), value, intent(in) :: expected, actual
+            subroutine c_assert_equal_string_n(expected, expected_len, actual, actual_len, verbosity) &
+                    bind(C, name = "c_assert_equal_string_n")
+                import :: c_char, c_size_t, c_int
+                character(kind = c_char), intent(in) :: expected(*), actual(*)
+                integer(c_size_t), value :: expected_len, actual_len
                 integer(c_int), value :: verbosity
-            end subroutine c_assert_equal_string
+            end subroutine c_assert_equal_string_n
         end interface
 
         ! Default verbosity to FAIL_ONLY if not provided
@@ -188,13 +299,10 @@ contains
         if (present(verbosity)) then
             verbosity_level = verbosity
         end if
-        f_c_string_expected = f_c_string_t(expected)
-        f_c_string_actual = f_c_string_t(actual)
-        status = f_c_string_expected%to_c()
-        status = f_c_string_actual%to_c()
-        call c_assert_equal_string(&
-                f_c_string_expected%get_c_string(), &
-                f_c_string_actual%get_c_string(), &
+        ! Pass the buffers themselves; trailing blanks are excluded by length.
+        call c_assert_equal_string_n(&
+                expected, len_trim(expected, kind = c_size_t), &
+                actual, len_trim(actual, kind = c_size_t), &
                 verbosity_level)
     end subroutine assert_equal_string
 
@@ -317,14 +425,14 @@ contains
         character(len = *), intent(in) :: expected, actual
         integer(c_int), intent(in), optional :: verbosity
         integer(c_int) :: verbosity_level
-        type(f_c_string_t) :: f_c_string_expected, f_c_string_actual
-        integer :: status
         interface
-            subroutine c_assert_not_equal_string(expected, actual, verbosity) bind(C)
-                import :: c_ptr, c_int
-                type(c_ptr), value, intent(in) :: expected, actual
+            subroutine c_assert_not_equal_string_n(expected, expected_len, actual, actual_len, verbosity) &
+                    bind(C, name = "c_assert_not_equal_string_n")
+                import :: c_char, c_size_t, c_int
+                character(kind = c_char), intent(in) :: expected(*), actual(*)
+                integer(c_size_t), value :: expected_len, actual_len
                 integer(c_int), value :: verbosity
-            end subroutine c_assert_not_equal_string
+            end subroutine c_assert_not_equal_string_n
         end interface
 
         ! Default verbosity to FAIL_ONLY if not provided
@@ -332,13 +440,10 @@ contains
         if (present(verbosity)) then
             verbosity_level = verbosity
         end if
-        f_c_string_expected = f_c_string_t(expected)
-        f_c_string_actual = f_c_string_t(actual)
-        status = f_c_string_expected%to_c()
-        status = f_c_string_actual%to_c()
-        call c_assert_not_equal_string(&
-                f_c_string_expected%get_c_string(), &
-                f_c_string_actual%get_c_string(), &
+        ! Pass the buffers themselves; trailing blanks are excluded by length.
+        call c_assert_not_equal_string_n(&
+                expected, len_trim(expected, kind = c_size_t), &
+                actual, len_trim(actual, kind = c_size_t), &
                 verbosity_level)
     end subroutine assert_not_equal_string
 
@@ -391,4 +496,1187 @@ contains
         call c_assert_false(i_condition, verbosity_level)
     end subroutine assert_false
 
+    !> @brief Assert that one call of a procedure takes at most `max_seconds`.
+    !> @param proc Procedure to call and time.
+    !> @param max_seconds Wall-time limit in seconds.
+    !> @param verbosity Verbosity level (optional).
+    subroutine assert_duration_below(proc, max_seconds, verbosity)
+        procedure(timed_proc) :: proc
+        real(c_double), intent(in) :: max_seconds
+        integer(c_int), intent(in), optional :: verbosity
+        integer(c_int) :: verbosity_level
+        interface
+            subroutine c_assert_duration_below(proc, max_seconds, verbosity) &
+                    bind(C, name = "c_assert_duration_below")
+                import :: c_funptr, c_double, c_int
+                type(c_funptr), value :: proc
+                real(c_double), value :: max_seconds
+                integer(c_int), value :: verbosity
+            end subroutine c_assert_duration_below
+        end interface
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) then
+            verbosity_level = verbosity
+        end if
+        call c_assert_duration_below(c_funloc(proc), max_seconds, verbosity_level)
+    end subroutine assert_duration_below
+
+    !> @brief Assert that the running test's peak resident memory grew by at most `max_bytes`.
+    !>
+    !> The growth is measured from the start of the test when memory
+    !> tracking is on (`FORTEST_TRACK_MEMORY=1`); otherwise `max_bytes`
+    !> limits the peak of the whole process.
+    !> @param max_bytes Limit in bytes.
+    !> @param verbosity Verbosity level (optional).
+    subroutine assert_max_memory(max_bytes, verbosity)
+        integer(c_int64_t), intent(in) :: max_bytes
+        integer(c_int), intent(in), optional :: verbosity
+        integer(c_int) :: verbosity_level
+        interface
+            subroutine c_assert_max_memory(max_bytes, verbosity) bind(C, name = "c_assert_max_memory")
+                import :: c_int64_t, c_int
+                integer(c_int64_t), value :: max_bytes
+                integer(c_int), value :: verbosity
+            end subroutine c_assert_max_memory
+        end interface
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) then
+            verbosity_level = verbosity
+        end if
+        call c_assert_max_memory(max_bytes, verbosity_level)
+    end subroutine assert_max_memory
+
+    !> @brief Assertion context of the test running on the calling thread.
+    !> @return Handle for bind_assert_context; c_null_ptr outside parallel runs.
+    function assert_context() result(context)
+        type(c_ptr) :: context
+        interface
+            function c_assert_context() bind(C, name = "c_assert_context") result(context)
+                import :: c_ptr
+                type(c_ptr) :: context
+            end function c_assert_context
+        end interface
+        context = c_assert_context()
+    end function assert_context
+
+    !> @brief Count the calling thread's assertions toward a test until unbind_assert_context.
+    !> @param context Result of assert_context on the test's own thread.
+    subroutine bind_assert_context(context)
+        type(c_ptr), intent(in) :: context
+        interface
+            subroutine c_bind_assert_context(context) bind(C, name = "c_bind_assert_context")
+                import :: c_ptr
+                type(c_ptr), value :: context
+            end subroutine c_bind_assert_context
+        end interface
+        call c_bind_assert_context(context)
+    end subroutine bind_assert_context
+
+    !> @brief Undo the last bind_assert_context of the calling thread.
+    subroutine unbind_assert_context()
+        interface
+            subroutine c_unbind_assert_context() bind(C, name = "c_unbind_assert_context")
+            end subroutine c_unbind_assert_context
+        end interface
+        call c_unbind_assert_context()
+    end subroutine unbind_assert_context
+
+    !> @brief Compare two contiguous integer arrays in one C call.
+    !> @param expected Address of the expected values.
+    !> @param actual   Address of the actual values.
+    !> @param expected_shape Shape of the expected array.
+    !> @param actual_shape   Shape of the actual array.
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine assert_array_int(expected, actual, expected_shape, actual_shape, verbosity, report)
+        type(c_ptr), intent(in) :: expected, actual
+        integer(c_int64_t), intent(in) :: expected_shape(:), actual_shape(:)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        interface
+            subroutine c_assert_equal_array_int(expected, actual, expected_shape, actual_shape, rank, &
+                    verbosity, report) bind(C, name = "c_assert_equal_array_int")
+                import :: c_ptr, c_int, c_int64_t, array_report_t
+                type(c_ptr), value :: expected, actual
+                integer(c_int64_t), intent(in) :: expected_shape(*), actual_shape(*)
+                integer(c_int), value :: rank
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_equal_array_int
+        end interface
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_equal_array_int(expected, actual, expected_shape, actual_shape, &
+                int(size(expected_shape), c_int), verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine assert_array_int
+
+    !> @brief Assert that two rank-1 integer arrays are equal element by element.
+    subroutine assert_equal_int_r1(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:), actual(:)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r1
+
+    !> @brief Assert that two rank-2 integer arrays are equal element by element.
+    subroutine assert_equal_int_r2(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :), actual(:, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r2
+
+    !> @brief Assert that two rank-3 integer arrays are equal element by element.
+    subroutine assert_equal_int_r3(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :, :), actual(:, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r3
+
+    !> @brief Assert that two rank-4 integer arrays are equal element by element.
+    subroutine assert_equal_int_r4(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :, :, :), actual(:, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r4
+
+    !> @brief Assert that two rank-5 integer arrays are equal element by element.
+    subroutine assert_equal_int_r5(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :, :, :, :), actual(:, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r5
+
+    !> @brief Assert that two rank-6 integer arrays are equal element by element.
+    subroutine assert_equal_int_r6(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :, :, :, :, :), actual(:, :, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r6
+
+    !> @brief Assert that two rank-7 integer arrays are equal element by element.
+    subroutine assert_equal_int_r7(expected, actual, verbosity, report)
+        integer(c_int), intent(in), target, contiguous :: expected(:, :, :, :, :, :, :), actual(:, :, :, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_int(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_equal_int_r7
+
+    !> @brief Compare two contiguous real (single precision) arrays in one C call.
+    !> @param expected Address of the expected values.
+    !> @param actual   Address of the actual values.
+    !> @param expected_shape Shape of the expected array.
+    !> @param actual_shape   Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine assert_array_float(expected, actual, expected_shape, actual_shape, abs_tol, rel_tol, verbosity, report)
+        type(c_ptr), intent(in) :: expected, actual
+        integer(c_int64_t), intent(in) :: expected_shape(:), actual_shape(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_float) :: a_tol, r_tol
+        interface
+            subroutine c_assert_equal_array_float(expected, actual, expected_shape, actual_shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_equal_array_float")
+                import :: c_ptr, c_int, c_int64_t, array_report_t, c_float
+                type(c_ptr), value :: expected, actual
+                integer(c_int64_t), intent(in) :: expected_shape(*), actual_shape(*)
+                integer(c_int), value :: rank
+                real(c_float), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_equal_array_float
+        end interface
+        a_tol = 0.0_c_float
+        r_tol = 0.0_c_float
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_equal_array_float(expected, actual, expected_shape, actual_shape, &
+                int(size(expected_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine assert_array_float
+
+    !> @brief Assert that two rank-1 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r1(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:), actual(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r1
+
+    !> @brief Assert that two rank-2 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r2(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :), actual(:, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r2
+
+    !> @brief Assert that two rank-3 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r3(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :, :), actual(:, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r3
+
+    !> @brief Assert that two rank-4 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r4(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :, :, :), actual(:, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r4
+
+    !> @brief Assert that two rank-5 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r5(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :, :, :, :), actual(:, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r5
+
+    !> @brief Assert that two rank-6 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r6(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :, :, :, :, :), actual(:, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r6
+
+    !> @brief Assert that two rank-7 real (single precision) arrays are equal element by element.
+    subroutine assert_equal_float_r7(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_float), intent(in), target, contiguous :: expected(:, :, :, :, :, :, :), actual(:, :, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_float_r7
+
+    !> @brief Compare two contiguous double precision arrays in one C call.
+    !> @param expected Address of the expected values.
+    !> @param actual   Address of the actual values.
+    !> @param expected_shape Shape of the expected array.
+    !> @param actual_shape   Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine assert_array_double(expected, actual, expected_shape, actual_shape, abs_tol, rel_tol, verbosity, report)
+        type(c_ptr), intent(in) :: expected, actual
+        integer(c_int64_t), intent(in) :: expected_shape(:), actual_shape(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_double) :: a_tol, r_tol
+        interface
+            subroutine c_assert_equal_array_double(expected, actual, expected_shape, actual_shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_equal_array_double")
+                import :: c_ptr, c_int, c_int64_t, array_report_t, c_double
+                type(c_ptr), value :: expected, actual
+                integer(c_int64_t), intent(in) :: expected_shape(*), actual_shape(*)
+                integer(c_int), value :: rank
+                real(c_double), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_equal_array_double
+        end interface
+        a_tol = 0.0_c_double
+        r_tol = 0.0_c_double
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_equal_array_double(expected, actual, expected_shape, actual_shape, &
+                int(size(expected_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine assert_array_double
+
+    !> @brief Assert that two rank-1 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r1(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:), actual(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r1
+
+    !> @brief Assert that two rank-2 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r2(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :), actual(:, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r2
+
+    !> @brief Assert that two rank-3 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r3(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :, :), actual(:, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r3
+
+    !> @brief Assert that two rank-4 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r4(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :, :, :), actual(:, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r4
+
+    !> @brief Assert that two rank-5 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r5(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :, :, :, :), actual(:, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r5
+
+    !> @brief Assert that two rank-6 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r6(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :, :, :, :, :), actual(:, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r6
+
+    !> @brief Assert that two rank-7 double precision arrays are equal element by element.
+    subroutine assert_equal_double_r7(expected, actual, abs_tol, rel_tol, verbosity, report)
+        real(c_double), intent(in), target, contiguous :: expected(:, :, :, :, :, :, :), actual(:, :, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_double_r7
+
+    !> @brief Compare two contiguous single precision complex arrays in one C call.
+    !> @param expected Address of the expected values.
+    !> @param actual   Address of the actual values.
+    !> @param expected_shape Shape of the expected array.
+    !> @param actual_shape   Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine assert_array_complex_float(expected, actual, expected_shape, actual_shape, abs_tol, rel_tol, verbosity, report)
+        type(c_ptr), intent(in) :: expected, actual
+        integer(c_int64_t), intent(in) :: expected_shape(:), actual_shape(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_float) :: a_tol, r_tol
+        interface
+            subroutine c_assert_equal_array_complex_float(expected, actual, expected_shape, actual_shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_equal_array_complex_float")
+                import :: c_ptr, c_int, c_int64_t, array_report_t, c_float
+                type(c_ptr), value :: expected, actual
+                integer(c_int64_t), intent(in) :: expected_shape(*), actual_shape(*)
+                integer(c_int), value :: rank
+                real(c_float), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_equal_array_complex_float
+        end interface
+        a_tol = 0.0_c_float
+        r_tol = 0.0_c_float
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_equal_array_complex_float(expected, actual, expected_shape, actual_shape, &
+                int(size(expected_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine assert_array_complex_float
+
+    !> @brief Assert that two rank-1 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r1(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:), actual(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r1
+
+    !> @brief Assert that two rank-2 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r2(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :), actual(:, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r2
+
+    !> @brief Assert that two rank-3 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r3(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :, :), actual(:, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r3
+
+    !> @brief Assert that two rank-4 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r4(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :, :, :), actual(:, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r4
+
+    !> @brief Assert that two rank-5 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r5(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :, :, :, :), actual(:, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r5
+
+    !> @brief Assert that two rank-6 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r6(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :, :, :, :, :), actual(:, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r6
+
+    !> @brief Assert that two rank-7 single precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_float_r7(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_float_complex), intent(in), target, contiguous :: expected(:, :, :, :, :, :, :), actual(:, :, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_float(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_float_r7
+
+    !> @brief Compare two contiguous double precision complex arrays in one C call.
+    !> @param expected Address of the expected values.
+    !> @param actual   Address of the actual values.
+    !> @param expected_shape Shape of the expected array.
+    !> @param actual_shape   Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine assert_array_complex_double(expected, actual, expected_shape, actual_shape, abs_tol, rel_tol, verbosity, report)
+        type(c_ptr), intent(in) :: expected, actual
+        integer(c_int64_t), intent(in) :: expected_shape(:), actual_shape(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_double) :: a_tol, r_tol
+        interface
+            subroutine c_assert_equal_array_complex_double(expected, actual, expected_shape, actual_shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_equal_array_complex_double")
+                import :: c_ptr, c_int, c_int64_t, array_report_t, c_double
+                type(c_ptr), value :: expected, actual
+                integer(c_int64_t), intent(in) :: expected_shape(*), actual_shape(*)
+                integer(c_int), value :: rank
+                real(c_double), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_equal_array_complex_double
+        end interface
+        a_tol = 0.0_c_double
+        r_tol = 0.0_c_double
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_equal_array_complex_double(expected, actual, expected_shape, actual_shape, &
+                int(size(expected_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine assert_array_complex_double
+
+    !> @brief Assert that two rank-1 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r1(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:), actual(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r1
+
+    !> @brief Assert that two rank-2 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r2(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :), actual(:, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r2
+
+    !> @brief Assert that two rank-3 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r3(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :, :), actual(:, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r3
+
+    !> @brief Assert that two rank-4 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r4(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :, :, :), actual(:, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r4
+
+    !> @brief Assert that two rank-5 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r5(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :, :, :, :), actual(:, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r5
+
+    !> @brief Assert that two rank-6 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r6(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :, :, :, :, :), actual(:, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r6
+
+    !> @brief Assert that two rank-7 double precision complex arrays are equal element by element.
+    subroutine assert_equal_complex_double_r7(expected, actual, abs_tol, rel_tol, verbosity, report)
+        complex(c_double_complex), intent(in), target, contiguous :: expected(:, :, :, :, :, :, :), actual(:, :, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call assert_array_complex_double(c_loc(expected), c_loc(actual), shape(expected, kind = c_int64_t), &
+                shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_equal_complex_double_r7
+
+    !> @brief Compare a contiguous integer array with snapshot `name` in one C call.
+    !> @param name     Snapshot name; trailing blanks are ignored.
+    !> @param actual   Address of the actual values.
+    !> @param actual_shape Shape of the actual array.
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine snapshot_int(name, actual, actual_shape, verbosity, report)
+        character(len = *), intent(in) :: name
+        type(c_ptr), intent(in) :: actual
+        integer(c_int64_t), intent(in) :: actual_shape(:)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        interface
+            subroutine c_assert_matches_snapshot_int(name, name_len, actual, shape, rank, &
+                    verbosity, report) bind(C, name = "c_assert_matches_snapshot_int")
+                import :: c_char, c_size_t, c_ptr, c_int, c_int64_t, array_report_t
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+                type(c_ptr), value :: actual
+                integer(c_int64_t), intent(in) :: shape(*)
+                integer(c_int), value :: rank
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_matches_snapshot_int
+        end interface
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_matches_snapshot_int(name, len_trim(name, kind = c_size_t), actual, actual_shape, &
+                int(size(actual_shape), c_int), verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine snapshot_int
+
+    !> @brief Assert that a rank-1 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r1(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r1
+
+    !> @brief Assert that a rank-2 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r2(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r2
+
+    !> @brief Assert that a rank-3 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r3(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r3
+
+    !> @brief Assert that a rank-4 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r4(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r4
+
+    !> @brief Assert that a rank-5 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r5(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r5
+
+    !> @brief Assert that a rank-6 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r6(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r6
+
+    !> @brief Assert that a rank-7 integer array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_int_r7(name, actual, verbosity, report)
+        character(len = *), intent(in) :: name
+        integer(c_int), intent(in), target, contiguous :: actual(:, :, :, :, :, :, :)
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_int(name, c_loc(actual), shape(actual, kind = c_int64_t), verbosity, report)
+    end subroutine assert_matches_snapshot_int_r7
+
+    !> @brief Compare a contiguous real (single precision) array with snapshot `name` in one C call.
+    !> @param name     Snapshot name; trailing blanks are ignored.
+    !> @param actual   Address of the actual values.
+    !> @param actual_shape Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine snapshot_float(name, actual, actual_shape, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        type(c_ptr), intent(in) :: actual
+        integer(c_int64_t), intent(in) :: actual_shape(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_float) :: a_tol, r_tol
+        interface
+            subroutine c_assert_matches_snapshot_float(name, name_len, actual, shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_matches_snapshot_float")
+                import :: c_char, c_size_t, c_ptr, c_int, c_int64_t, array_report_t, c_float
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+                type(c_ptr), value :: actual
+                integer(c_int64_t), intent(in) :: shape(*)
+                integer(c_int), value :: rank
+                real(c_float), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_matches_snapshot_float
+        end interface
+        a_tol = 0.0_c_float
+        r_tol = 0.0_c_float
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_matches_snapshot_float(name, len_trim(name, kind = c_size_t), actual, actual_shape, &
+                int(size(actual_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine snapshot_float
+
+    !> @brief Assert that a rank-1 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r1(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r1
+
+    !> @brief Assert that a rank-2 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r2(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r2
+
+    !> @brief Assert that a rank-3 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r3(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r3
+
+    !> @brief Assert that a rank-4 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r4(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r4
+
+    !> @brief Assert that a rank-5 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r5(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r5
+
+    !> @brief Assert that a rank-6 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r6(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r6
+
+    !> @brief Assert that a rank-7 real (single precision) array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_float_r7(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_float), intent(in), target, contiguous :: actual(:, :, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_float_r7
+
+    !> @brief Compare a contiguous double precision array with snapshot `name` in one C call.
+    !> @param name     Snapshot name; trailing blanks are ignored.
+    !> @param actual   Address of the actual values.
+    !> @param actual_shape Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine snapshot_double(name, actual, actual_shape, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        type(c_ptr), intent(in) :: actual
+        integer(c_int64_t), intent(in) :: actual_shape(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_double) :: a_tol, r_tol
+        interface
+            subroutine c_assert_matches_snapshot_double(name, name_len, actual, shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_matches_snapshot_double")
+                import :: c_char, c_size_t, c_ptr, c_int, c_int64_t, array_report_t, c_double
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+                type(c_ptr), value :: actual
+                integer(c_int64_t), intent(in) :: shape(*)
+                integer(c_int), value :: rank
+                real(c_double), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_matches_snapshot_double
+        end interface
+        a_tol = 0.0_c_double
+        r_tol = 0.0_c_double
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_matches_snapshot_double(name, len_trim(name, kind = c_size_t), actual, actual_shape, &
+                int(size(actual_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine snapshot_double
+
+    !> @brief Assert that a rank-1 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r1(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r1
+
+    !> @brief Assert that a rank-2 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r2(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r2
+
+    !> @brief Assert that a rank-3 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r3(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r3
+
+    !> @brief Assert that a rank-4 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r4(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r4
+
+    !> @brief Assert that a rank-5 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r5(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r5
+
+    !> @brief Assert that a rank-6 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r6(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r6
+
+    !> @brief Assert that a rank-7 double precision array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_double_r7(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        real(c_double), intent(in), target, contiguous :: actual(:, :, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_double_r7
+
+    !> @brief Compare a contiguous single precision complex array with snapshot `name` in one C call.
+    !> @param name     Snapshot name; trailing blanks are ignored.
+    !> @param actual   Address of the actual values.
+    !> @param actual_shape Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine snapshot_complex_float(name, actual, actual_shape, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        type(c_ptr), intent(in) :: actual
+        integer(c_int64_t), intent(in) :: actual_shape(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_float) :: a_tol, r_tol
+        interface
+            subroutine c_assert_matches_snapshot_complex_float(name, name_len, actual, shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_matches_snapshot_complex_float")
+                import :: c_char, c_size_t, c_ptr, c_int, c_int64_t, array_report_t, c_float
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+                type(c_ptr), value :: actual
+                integer(c_int64_t), intent(in) :: shape(*)
+                integer(c_int), value :: rank
+                real(c_float), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_matches_snapshot_complex_float
+        end interface
+        a_tol = 0.0_c_float
+        r_tol = 0.0_c_float
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_matches_snapshot_complex_float(name, len_trim(name, kind = c_size_t), actual, actual_shape, &
+                int(size(actual_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine snapshot_complex_float
+
+    !> @brief Assert that a rank-1 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r1(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r1
+
+    !> @brief Assert that a rank-2 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r2(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r2
+
+    !> @brief Assert that a rank-3 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r3(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r3
+
+    !> @brief Assert that a rank-4 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r4(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r4
+
+    !> @brief Assert that a rank-5 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r5(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r5
+
+    !> @brief Assert that a rank-6 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r6(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r6
+
+    !> @brief Assert that a rank-7 single precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_float_r7(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_float_complex), intent(in), target, contiguous :: actual(:, :, :, :, :, :, :)
+        real(c_float), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_float(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_float_r7
+
+    !> @brief Compare a contiguous double precision complex array with snapshot `name` in one C call.
+    !> @param name     Snapshot name; trailing blanks are ignored.
+    !> @param actual   Address of the actual values.
+    !> @param actual_shape Shape of the actual array.
+    !> @param abs_tol  Absolute tolerance (optional).
+    !> @param rel_tol  Relative tolerance (optional).
+    !> @param verbosity Verbosity level (optional).
+    !> @param report   Mismatch count, largest errors and first failures (optional).
+    subroutine snapshot_complex_double(name, actual, actual_shape, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        type(c_ptr), intent(in) :: actual
+        integer(c_int64_t), intent(in) :: actual_shape(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        type(array_report_t) :: result
+        integer(c_int) :: verbosity_level
+        real(c_double) :: a_tol, r_tol
+        interface
+            subroutine c_assert_matches_snapshot_complex_double(name, name_len, actual, shape, rank, abs_tol, rel_tol, &
+                    verbosity, report) bind(C, name = "c_assert_matches_snapshot_complex_double")
+                import :: c_char, c_size_t, c_ptr, c_int, c_int64_t, array_report_t, c_double
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+                type(c_ptr), value :: actual
+                integer(c_int64_t), intent(in) :: shape(*)
+                integer(c_int), value :: rank
+                real(c_double), value :: abs_tol, rel_tol
+                integer(c_int), value :: verbosity
+                type(array_report_t), intent(out) :: report
+            end subroutine c_assert_matches_snapshot_complex_double
+        end interface
+        a_tol = 0.0_c_double
+        r_tol = 0.0_c_double
+        if (present(abs_tol)) a_tol = abs_tol
+        if (present(rel_tol)) r_tol = rel_tol
+        verbosity_level = VERBOSITY_FAIL_ONLY
+        if (present(verbosity)) verbosity_level = verbosity
+
+        call c_assert_matches_snapshot_complex_double(name, len_trim(name, kind = c_size_t), actual, actual_shape, &
+                int(size(actual_shape), c_int), a_tol, r_tol, verbosity_level, result)
+        if (present(report)) report = result
+    end subroutine snapshot_complex_double
+
+    !> @brief Assert that a rank-1 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r1(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r1
+
+    !> @brief Assert that a rank-2 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r2(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r2
+
+    !> @brief Assert that a rank-3 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r3(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r3
+
+    !> @brief Assert that a rank-4 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r4(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r4
+
+    !> @brief Assert that a rank-5 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r5(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r5
+
+    !> @brief Assert that a rank-6 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r6(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r6
+
+    !> @brief Assert that a rank-7 double precision complex array matches its recorded snapshot.
+    subroutine assert_matches_snapshot_complex_double_r7(name, actual, abs_tol, rel_tol, verbosity, report)
+        character(len = *), intent(in) :: name
+        complex(c_double_complex), intent(in), target, contiguous :: actual(:, :, :, :, :, :, :)
+        real(c_double), intent(in), optional :: abs_tol, rel_tol
+        integer(c_int), intent(in), optional :: verbosity
+        type(array_report_t), intent(out), optional :: report
+        call snapshot_complex_double(name, c_loc(actual), shape(actual, kind = c_int64_t), abs_tol, rel_tol, verbosity, report)
+    end subroutine assert_matches_snapshot_complex_double_r7
+
 end module fortest_assert
@@ -5,8 +5,16 @@
 #include "g_logging.hpp"
 #include "g_assert.hpp"
 
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 /// @file c_assert.hpp
 /// @brief C bindings for the Fortest assertion framework with verbosity.
@@ -22,12 +30,51 @@
 /// - 1 = FAIL_ONLY (default, print only on failures)
 /// - 2 = ALL       (print on pass and fail)
 
+/// Failing elements a fortest_array_report can name.
+#define FORTEST_ARRAY_REPORT_INDICES 10
+
+extern "C" {
+///
+/// @brief Result of an array assertion, filled for the caller.
+///
+/// Mirrors `array_report_t` in the Fortran `fortest_assert` module.
+///
+typedef struct fortest_array_report {
+    int64_t size;          ///< Elements compared
+    int64_t mismatches;    ///< Elements outside the tolerances
+    double max_abs_error;  ///< Largest absolute error
+    double max_rel_error;  ///< Largest relative error
+    int64_t num_reported;  ///< Valid entries of first_failures
+    int64_t first_failures[FORTEST_ARRAY_REPORT_INDICES]; ///< 1-based positions in array element order
+} fortest_array_report;
+}
+
+namespace Fortest::detail {
+    /// @brief Shared body of the c_assert_equal_array_* functions.
+    template<typename T>
+    void c_assert_array(const T *expected, const T *actual,
+                        const int64_t *expected_shape, const int64_t *actual_shape, int rank,
+                        double abs_tol, double rel_tol, int verbosity,
+                        fortest_array_report *report);
+
+    /// @brief Shared body of the c_assert_matches_snapshot_* functions.
+    template<typename T>
+    void c_assert_snapshot(const char *name, std::size_t name_len, const T *actual,
+                           const int64_t *shape, int rank, double abs_tol, double rel_tol,
+                           int verbosity, fortest_array_report *report);
+
+    /// @brief Copy an array comparison into the report handed to C.
+    void fill_array_report(const ArrayComparison &result, fortest_array_report *report);
+}
+
 extern "C" {
-inline auto fortest_logger() {
+// Both return references: no shared_ptr copy, and no atomic refcount
+// traffic, on the per-assertion path.
+inline auto &fortest_logger() {
     return Fortest::GlobalAssertLogger::instance();
 }
 
-inline auto fortest_assert() {
+inline auto &fortest_assert() {
     return Fortest::GlobalAssert::instance();
 }
 
@@ -76,6 +123,83 @@ void c_assert_false(const int condition, const int verbosity) {
     }
 }
 
+///
+/// @brief Assert that one call of a procedure takes at most `max_seconds`.
+/// @param proc_ptr    Function pointer: void(*)().
+/// @param max_seconds Wall-time limit in seconds.
+/// @param verbosity   Verbosity level (0=QUIET, 1=FAIL_ONLY, 2=ALL).
+///
+void c_assert_duration_below(void *proc_ptr, const double max_seconds, const int verbosity) {
+    try {
+        auto proc = reinterpret_cast<void(*)()>(proc_ptr);
+        fortest_assert()->assert_duration_below(
+            proc, max_seconds,
+            static_cast<Fortest::Verbosity>(verbosity)
+        );
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_duration_below");
+    }
+}
+
+///
+/// @brief Assert that the current test's peak resident memory grew by at most `max_bytes`.
+/// @param max_bytes Limit in bytes.
+/// @param verbosity Verbosity level (0=QUIET, 1=FAIL_ONLY, 2=ALL).
+///
+void c_assert_max_memory(const int64_t max_bytes, const int verbosity) {
+    try {
+        fortest_assert()->assert_max_memory(
+            max_bytes,
+            static_cast<Fortest::Verbosity>(verbosity)
+        );
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_max_memory");
+    }
+}
+
+///
+/// @brief Previous contexts of the c_bind_assert_context() calls of the calling thread.
+///
+inline std::vector<Fortest::AssertContext *> &fortest_bound_contexts() {
+    static thread_local std::vector<Fortest::AssertContext *> previous;
+    return previous;
+}
+
+///
+/// @brief Assertion context of the test running on the calling thread, or NULL.
+///
+/// Hand it to c_bind_assert_context() on the threads the test starts,
+/// e.g. in an OpenMP parallel region, so that their assertions count
+/// toward the test.
+///
+void *c_assert_context() {
+    return Fortest::AssertContext::current();
+}
+
+///
+/// @brief Count the calling thread's assertions toward `context` until c_unbind_assert_context().
+/// @param context Result of c_assert_context() on the test's thread; NULL counts
+///        toward the test run without workers.
+///
+void c_bind_assert_context(void *context) {
+    try {
+        fortest_bound_contexts().push_back(
+            Fortest::AssertContext::exchange(static_cast<Fortest::AssertContext *>(context)));
+    } catch (...) {
+        fortest_c_assert_fatal("c_bind_assert_context");
+    }
+}
+
+///
+/// @brief Undo the last c_bind_assert_context() of the calling thread.
+///
+void c_unbind_assert_context() {
+    auto &previous = fortest_bound_contexts();
+    if (previous.empty()) return;
+    Fortest::AssertContext::exchange(previous.back());
+    previous.pop_back();
+}
+
 ///
 /// @brief Assert that two integers are equal.
 /// @param expected Expected integer value.
@@ -147,8 +271,8 @@ void c_assert_equal_float(const float expected, const float actual,
 void c_assert_equal_string(const char *expected, const char *actual, const int verbosity) {
     try {
         fortest_assert()->assert_equal(
-            std::string(expected),
-            std::string(actual),
+            std::string_view(expected),
+            std::string_view(actual),
 
             0.0, 0.0,
             static_cast<Fortest::Verbosity>(verbosity)
@@ -158,6 +282,34 @@ void c_assert_equal_string(const char *expected, const char *actual, const int v
     }
 }
 
+///
+/// @brief Assert that two strings of known length are equal.
+///
+/// The strings are viewed in place, so a Fortran `character` buffer
+/// needs neither trimming into a copy nor a null terminator.
+///
+/// @param expected     Expected string; need not be null terminated.
+/// @param expected_len Length of `expected` in bytes.
+/// @param actual       Actual string; need not be null terminated.
+/// @param actual_len   Length of `actual` in bytes.
+/// @param verbosity    Verbosity level (0=QUIET, 1=FAIL_ONLY, 2=ALL).
+///
+void c_assert_equal_string_n(const char *expected, const std::size_t expected_len,
+                             const char *actual, const std::size_t actual_len,
+                             const int verbosity) {
+    try {
+        fortest_assert()->assert_equal(
+            std::string_view(expected, expected_len),
+            std::string_view(actual, actual_len),
+
+            0.0, 0.0,
+            static_cast<Fortest::Verbosity>(verbosity)
+        );
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_string_n");
+    }
+}
+
 ///
 /// @brief Assert that two integers are not equal.
 /// @param expected First integer value.
@@ -229,8 +381,8 @@ void c_assert_not_equal_float(const float expected, const float actual,
 void c_assert_not_equal_string(const char *expected, const char *actual, const int verbosity) {
     try {
         fortest_assert()->assert_not_equal(
-            std::string(expected),
-            std::string(actual),
+            std::string_view(expected),
+            std::string_view(actual),
 
             0.0, 0.0,
             static_cast<Fortest::Verbosity>(verbosity)
@@ -239,6 +391,294 @@ void c_assert_not_equal_string(const char *expected, const char *actual, const i
         fortest_c_assert_fatal("c_assert_not_equal_string");
     }
 }
+
+///
+/// @brief Assert that two strings of known length are not equal.
+///
+/// The strings are viewed in place, so a Fortran `character` buffer
+/// needs neither trimming into a copy nor a null terminator.
+///
+/// @param expected     Expected string; need not be null terminated.
+/// @param expected_len Length of `expected` in bytes.
+/// @param actual       Actual string; need not be null terminated.
+/// @param actual_len   Length of `actual` in bytes.
+/// @param verbosity    Verbosity level (0=QUIET, 1=FAIL_ONLY, 2=ALL).
+///
+void c_assert_not_equal_string_n(const char *expected, const std::size_t expected_len,
+                                 const char *actual, const std::size_t actual_len,
+                                 const int verbosity) {
+    try {
+        fortest_assert()->assert_not_equal(
+            std::string_view(expected, expected_len),
+            std::string_view(actual, actual_len),
+
+            0.0, 0.0,
+            static_cast<Fortest::Verbosity>(verbosity)
+        );
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_not_equal_string_n");
+    }
+}
+
+///
+/// @brief Assert that two integer arrays are equal, element by element.
+///
+/// The whole array crosses the language boundary in one call and counts
+/// as one assertion. Arrays are contiguous and in Fortran element order.
+///
+/// @param expected Expected values.
+/// @param actual Actual values.
+/// @param expected_shape Extents of the expected array (`rank` values).
+/// @param actual_shape Extents of the actual array; a different shape fails.
+/// @param rank Number of dimensions; 0 compares a single value.
+/// @param verbosity Verbosity level (0=QUIET, 1=FAIL_ONLY, 2=ALL).
+/// @param report Receives the mismatch count, the largest errors and the
+///        first failing positions; may be null.
+///
+void c_assert_equal_array_int(const int *expected, const int *actual,
+                              const int64_t *expected_shape, const int64_t *actual_shape,
+                              const int rank,
+                              const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_array(expected, actual, expected_shape, actual_shape, rank,
+                                        0.0, 0.0, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_array_int");
+    }
+}
+
+///
+/// @brief Assert that two float arrays are equal within tolerances.
+/// @see c_assert_equal_array_int for the common parameters.
+/// @param abs_tol Absolute tolerance.
+/// @param rel_tol Relative tolerance.
+///
+void c_assert_equal_array_float(const float *expected, const float *actual,
+                                const int64_t *expected_shape, const int64_t *actual_shape,
+                                const int rank,
+                                const float abs_tol, const float rel_tol,
+                                const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_array(expected, actual, expected_shape, actual_shape, rank,
+                                        abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_array_float");
+    }
+}
+
+///
+/// @brief Assert that two double arrays are equal within tolerances.
+/// @see c_assert_equal_array_float
+///
+void c_assert_equal_array_double(const double *expected, const double *actual,
+                                 const int64_t *expected_shape, const int64_t *actual_shape,
+                                 const int rank,
+                                 const double abs_tol, const double rel_tol,
+                                 const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_array(expected, actual, expected_shape, actual_shape, rank,
+                                        abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_array_double");
+    }
+}
+
+///
+/// @brief Assert that two single precision complex arrays are equal within tolerances.
+///
+/// Values are interleaved (real, imaginary); sizes count complex values.
+/// Errors are moduli of the difference.
+/// @see c_assert_equal_array_float
+///
+void c_assert_equal_array_complex_float(const float *expected, const float *actual,
+                                        const int64_t *expected_shape, const int64_t *actual_shape,
+                                        const int rank,
+                                        const float abs_tol, const float rel_tol,
+                                        const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_array(reinterpret_cast<const std::complex<float> *>(expected),
+                                        reinterpret_cast<const std::complex<float> *>(actual),
+                                        expected_shape, actual_shape, rank,
+                                        abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_array_complex_float");
+    }
+}
+
+///
+/// @brief Assert that two double precision complex arrays are equal within tolerances.
+/// @see c_assert_equal_array_complex_float
+///
+void c_assert_equal_array_complex_double(const double *expected, const double *actual,
+                                         const int64_t *expected_shape, const int64_t *actual_shape,
+                                         const int rank,
+                                         const double abs_tol, const double rel_tol,
+                                         const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_array(reinterpret_cast<const std::complex<double> *>(expected),
+                                        reinterpret_cast<const std::complex<double> *>(actual),
+                                        expected_shape, actual_shape, rank,
+                                        abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_equal_array_complex_double");
+    }
+}
+
+///
+/// @brief Assert that an integer array matches its recorded snapshot.
+///
+/// The first run records the array as snapshot `name` (in the directory
+/// set by FORTEST_SNAPSHOT_DIR) and passes; later runs compare with it.
+///
+/// @param name Snapshot name (not null-terminated).
+/// @param name_len Length of `name`.
+/// @param actual First element of the array, in array element order.
+/// @param shape Extents of the array (`rank` values); the snapshot must have the same.
+/// @param rank Number of dimensions.
+/// @param verbosity Verbosity level.
+/// @param report Receives the comparison, as for c_assert_equal_array_int; may be null.
+///
+void c_assert_matches_snapshot_int(const char *name, const size_t name_len, const int *actual,
+                                   const int64_t *shape, const int rank,
+                                   const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_snapshot(name, name_len, actual, shape, rank,
+                                           0.0, 0.0, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_matches_snapshot_int");
+    }
+}
+
+///
+/// @brief Assert that a float array matches its recorded snapshot within tolerances.
+/// @param abs_tol Absolute tolerance.
+/// @param rel_tol Relative tolerance.
+/// @see c_assert_matches_snapshot_int for the other parameters.
+///
+void c_assert_matches_snapshot_float(const char *name, const size_t name_len, const float *actual,
+                                     const int64_t *shape, const int rank,
+                                     const float abs_tol, const float rel_tol,
+                                     const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_snapshot(name, name_len, actual, shape, rank,
+                                           abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_matches_snapshot_float");
+    }
+}
+
+///
+/// @brief Assert that a double array matches its recorded snapshot within tolerances.
+/// @see c_assert_matches_snapshot_int
+///
+void c_assert_matches_snapshot_double(const char *name, const size_t name_len, const double *actual,
+                                      const int64_t *shape, const int rank,
+                                      const double abs_tol, const double rel_tol,
+                                      const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_snapshot(name, name_len, actual, shape, rank,
+                                           abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_matches_snapshot_double");
+    }
+}
+
+///
+/// @brief Assert that a single precision complex array matches its snapshot within tolerances.
+///
+/// Values are interleaved (real, imaginary); the shape counts complex values.
+/// @see c_assert_matches_snapshot_int
+///
+void c_assert_matches_snapshot_complex_float(const char *name, const size_t name_len, const float *actual,
+                                             const int64_t *shape, const int rank,
+                                             const float abs_tol, const float rel_tol,
+                                             const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_snapshot(name, name_len, reinterpret_cast<const std::complex<float> *>(actual), shape, rank,
+                                           abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_matches_snapshot_complex_float");
+    }
+}
+
+///
+/// @brief Assert that a double precision complex array matches its snapshot within tolerances.
+/// @see c_assert_matches_snapshot_complex_float
+///
+void c_assert_matches_snapshot_complex_double(const char *name, const size_t name_len, const double *actual,
+                                              const int64_t *shape, const int rank,
+                                              const double abs_tol, const double rel_tol,
+                                              const int verbosity, fortest_array_report *report) {
+    try {
+        Fortest::detail::c_assert_snapshot(name, name_len, reinterpret_cast<const std::complex<double> *>(actual), shape, rank,
+                                           abs_tol, rel_tol, verbosity, report);
+    } catch (...) {
+        fortest_c_assert_fatal("c_assert_matches_snapshot_complex_double");
+    }
+}
 } // extern "C"
 
+template<typename T>
+void Fortest::detail::c_assert_array(const T *expected, const T *actual,
+                                     const int64_t *expected_shape, const int64_t *actual_shape,
+                                     const int rank, const double abs_tol, const double rel_tol,
+                                     const int verbosity, fortest_array_report *report) {
+    const std::span<const int64_t> e_shape(expected_shape, static_cast<std::size_t>(std::max(rank, 0)));
+    const std::span<const int64_t> a_shape(actual_shape, static_cast<std::size_t>(std::max(rank, 0)));
+    const auto elements = [](std::span<const int64_t> shape) {
+        int64_t n = 1;
+        for (const auto extent: shape) n *= std::max<int64_t>(extent, 0);
+        return static_cast<std::size_t>(n);
+    };
+    const auto level = static_cast<Fortest::Verbosity>(verbosity);
+    Fortest::ArrayComparison result;
+    if (!std::ranges::equal(e_shape, a_shape)) {
+        const auto name = [](std::span<const int64_t> shape) {
+            std::string text = "(";
+            for (std::size_t d = 0; d < shape.size(); ++d) {
+                text += (d > 0 ? "," : "") + std::to_string(shape[d]);
+            }
+            return text + ")";
+        };
+        fortest_assert()->fail("array shapes differ (" + name(e_shape) + " != " + name(a_shape) + ")", level);
+        result.mismatches = std::max(elements(e_shape), elements(a_shape));
+    } else {
+        result = fortest_assert()->assert_array_equal(
+            std::span<const T>(expected, elements(e_shape)),
+            std::span<const T>(actual, elements(a_shape)),
+            abs_tol, rel_tol, level, a_shape);
+    }
+    fill_array_report(result, report);
+}
+
+template<typename T>
+void Fortest::detail::c_assert_snapshot(const char *name, const std::size_t name_len, const T *actual,
+                                        const int64_t *shape, const int rank, const double abs_tol,
+                                        const double rel_tol, const int verbosity,
+                                        fortest_array_report *report) {
+    const std::span<const int64_t> extents(shape, static_cast<std::size_t>(std::max(rank, 0)));
+    int64_t n = 1;
+    for (const auto extent: extents) n *= std::max<int64_t>(extent, 0);
+    const auto result = fortest_assert()->assert_matches_snapshot(
+        std::string_view(name, name_len), std::span<const T>(actual, static_cast<std::size_t>(n)),
+        abs_tol, rel_tol, static_cast<Fortest::Verbosity>(verbosity), extents);
+    fill_array_report(result, report);
+}
+
+inline void Fortest::detail::fill_array_report(const ArrayComparison &result, fortest_array_report *report) {
+    if (!report) return;
+    report->size = static_cast<int64_t>(result.size);
+    report->mismatches = static_cast<int64_t>(result.mismatches);
+    report->max_abs_error = result.max_abs_error;
+    report->max_rel_error = result.max_rel_error;
+    report->num_reported = 0;
+    for (const auto offset: result.first_failures) {
+        if (report->num_reported == FORTEST_ARRAY_REPORT_INDICES) break;
+        report->first_failures[report->num_reported++] = static_cast<int64_t>(offset) + 1;
+    }
+    for (auto i = report->num_reported; i < FORTEST_ARRAY_REPORT_INDICES; ++i) {
+        report->first_failures[i] = 0;
+    }
+}
+
 #endif // C_ASSERT_HPP
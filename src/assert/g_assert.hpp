@@ -1,7 +1,13 @@
 #ifndef G_ASSERT_HPP
 #define G_ASSERT_HPP
 
+#include <cstddef>
+#include <iostream>
+#include <memory>
+
 #include "assert.hpp"      // Assert class
+#include "async_writer.hpp"
+#include "g_logging.hpp"
 #include "global_base.hpp" // SingletonBase class
 
 namespace Fortest {
@@ -22,6 +28,41 @@ namespace Fortest {
         /// @brief Hidden constructor for singleton use only.
         GlobalAssert() = default;
     };
+
+    /// @brief Writer shared by the global loggers while async logging is on.
+    inline std::shared_ptr<AsyncWriter> &global_async_writer() {
+        static std::shared_ptr<AsyncWriter> writer;
+        return writer;
+    }
+
+    /// @brief Switch the global loggers to or from asynchronous output.
+    ///
+    /// `GlobalLogger`, `GlobalAssertLogger` and the logger of
+    /// `GlobalAssert` all write to `std::cout`; when enabled they share
+    /// one AsyncWriter, so their messages keep their relative order.
+    /// Disabling flushes pending output and returns to direct writes.
+    ///
+    /// @param enabled Whether to write through a background thread.
+    /// @param capacity Ring buffer size in bytes.
+    inline void set_async_logging(bool enabled,
+                                  std::size_t capacity = AsyncWriter::default_capacity) {
+        auto &writer = global_async_writer();
+        if (enabled == static_cast<bool>(writer)) {
+            return;
+        }
+        writer = enabled ? std::make_shared<AsyncWriter>(std::cout, capacity) : nullptr;
+        GlobalLogger::instance()->set_async_writer(writer);
+        GlobalAssertLogger::instance()->set_async_writer(writer);
+        GlobalAssert::instance()->get_logger()->set_async_writer(writer);
+    }
+
+    /// @brief Block until the global loggers' output has reached `std::cout`.
+    inline void flush_global_loggers() {
+        if (const auto &writer = global_async_writer()) {
+            writer->flush();
+        }
+        std::cout.flush();
+    }
 }
 
 #endif // G_ASSERT_HPP
@@ -0,0 +1,212 @@
+#include "snapshot_store.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+#ifdef FORTEST_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace Fortest {
+    namespace {
+        constexpr std::array<char, 8> magic{'F', 'T', 'S', 'N', 'A', 'P', '0', '1'};
+
+        /// How a chunk is stored.
+        enum Codec : std::uint32_t {
+            Raw = 0,            ///< Values as they are in memory
+            ShuffledDeflate = 1 ///< Bytes grouped by position in the value, then deflated
+        };
+
+        /// Fixed part of the file header; the shape follows it.
+        struct Header {
+            std::array<char, 8> magic;
+            std::uint32_t type;
+            std::uint32_t rank;
+            std::uint64_t num_elements;
+            std::uint64_t chunk_elements;
+            std::uint64_t num_chunks;
+            std::uint64_t index_offset;
+        };
+
+        /// Largest rank of a Fortran array.
+        constexpr std::uint32_t max_rank = 15;
+
+        /// @brief Group byte k of every value together, for k = 0 .. element_bytes - 1.
+        void shuffle(std::span<const std::byte> in, std::size_t element_bytes, std::byte *out) {
+            const std::size_t n = in.size() / element_bytes;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t k = 0; k < element_bytes; ++k) {
+                    out[k * n + i] = in[i * element_bytes + k];
+                }
+            }
+        }
+
+        /// @brief Inverse of shuffle().
+        void unshuffle(const std::byte *in, std::size_t element_bytes, std::span<std::byte> out) {
+            const std::size_t n = out.size() / element_bytes;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t k = 0; k < element_bytes; ++k) {
+                    out[i * element_bytes + k] = in[k * n + i];
+                }
+            }
+        }
+
+        template<typename T>
+        void put(std::ofstream &out, const T &value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        template<typename T>
+        void get(std::ifstream &in, T &value) {
+            in.read(reinterpret_cast<char *>(&value), sizeof(value));
+        }
+    } // namespace
+
+    struct SnapshotStore::Reader::File {
+        std::ifstream in;
+    };
+
+    SnapshotStore::Reader::Reader(const std::filesystem::path &path) : m_file(std::make_unique<File>()) {
+        auto &in = m_file->in;
+        in.open(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open snapshot file '" + path.string() + "'");
+        Header header{};
+        get(in, header);
+        if (!in || header.magic != magic || header.rank > max_rank || header.chunk_elements == 0) {
+            throw std::runtime_error("'" + path.string() + "' is not a snapshot file");
+        }
+        m_type = static_cast<SnapshotType>(header.type);
+        m_shape.resize(header.rank);
+        for (auto &extent: m_shape) get(in, extent);
+        m_num_elements = header.num_elements;
+        m_chunk_elements = header.chunk_elements;
+        switch (m_type) {
+            case SnapshotType::Int32:
+            case SnapshotType::Float32: m_element_bytes = 4; break;
+            case SnapshotType::Float64:
+            case SnapshotType::ComplexFloat32: m_element_bytes = 8; break;
+            case SnapshotType::ComplexFloat64: m_element_bytes = 16; break;
+            default: throw std::runtime_error("snapshot file '" + path.string() + "' has an unknown type");
+        }
+        if (header.num_chunks != (m_num_elements + m_chunk_elements - 1) / m_chunk_elements) {
+            throw std::runtime_error("snapshot file '" + path.string() + "' is corrupt");
+        }
+        m_index.resize(header.num_chunks);
+        in.seekg(static_cast<std::streamoff>(header.index_offset));
+        for (auto &entry: m_index) {
+            get(in, entry.offset);
+            get(in, entry.stored_bytes);
+            get(in, entry.codec);
+        }
+        if (!in) throw std::runtime_error("snapshot file '" + path.string() + "' is truncated");
+    }
+
+    SnapshotStore::Reader::~Reader() = default;
+
+    void SnapshotStore::Reader::read_chunk(std::size_t c, std::span<std::byte> out) {
+        const Entry &entry = m_index.at(c);
+        auto &in = m_file->in;
+        m_stored.resize(entry.stored_bytes);
+        in.seekg(static_cast<std::streamoff>(entry.offset));
+        in.read(reinterpret_cast<char *>(m_stored.data()), static_cast<std::streamsize>(m_stored.size()));
+        if (!in) throw std::runtime_error("snapshot chunk " + std::to_string(c) + " is truncated");
+
+        if (entry.codec == Raw) {
+            if (entry.stored_bytes != out.size()) {
+                throw std::runtime_error("snapshot chunk " + std::to_string(c) + " has the wrong size");
+            }
+            std::memcpy(out.data(), m_stored.data(), out.size());
+            return;
+        }
+#ifdef FORTEST_HAVE_ZLIB
+        if (entry.codec == ShuffledDeflate) {
+            std::vector<std::byte> shuffled(out.size());
+            uLongf length = static_cast<uLongf>(shuffled.size());
+            if (::uncompress(reinterpret_cast<Bytef *>(shuffled.data()), &length,
+                             reinterpret_cast<const Bytef *>(m_stored.data()),
+                             static_cast<uLong>(m_stored.size())) != Z_OK ||
+                length != shuffled.size()) {
+                throw std::runtime_error("snapshot chunk " + std::to_string(c) + " is corrupt");
+            }
+            unshuffle(shuffled.data(), m_element_bytes, out);
+            return;
+        }
+#endif
+        throw std::runtime_error("snapshot chunk " + std::to_string(c) +
+                                 " is compressed; rebuild Fortest with zlib to read it");
+    }
+
+    void SnapshotStore::write(const std::filesystem::path &path, SnapshotType type,
+                              std::span<const std::int64_t> shape, std::span<const std::byte> values,
+                              std::size_t element_bytes, std::size_t chunk_elements) {
+        if (!path.parent_path().empty()) std::filesystem::create_directories(path.parent_path());
+        // Unique per process and thread, so concurrent writers never share a file.
+        const std::filesystem::path temporary =
+            path.string() + ".tmp" + std::to_string(::getpid()) + "_" +
+            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("cannot write snapshot file '" + temporary.string() + "'");
+
+            const std::size_t num_elements = values.size() / element_bytes;
+            Header header{magic, static_cast<std::uint32_t>(type), static_cast<std::uint32_t>(shape.size()),
+                          num_elements, chunk_elements,
+                          (num_elements + chunk_elements - 1) / chunk_elements, 0};
+            put(out, header);
+            for (const auto extent: shape) put(out, extent);
+
+            std::vector<std::byte> shuffled;
+            std::vector<std::byte> packed;
+            struct Entry {
+                std::uint64_t offset;
+                std::uint32_t stored_bytes;
+                std::uint32_t codec;
+            };
+            std::vector<Entry> index;
+            index.reserve(header.num_chunks);
+            const std::size_t chunk_bytes = chunk_elements * element_bytes;
+            for (std::size_t begin = 0; begin < values.size(); begin += chunk_bytes) {
+                const auto chunk = values.subspan(begin, std::min(chunk_bytes, values.size() - begin));
+                std::span<const std::byte> stored = chunk;
+                Codec codec = Raw;
+#ifdef FORTEST_HAVE_ZLIB
+                shuffled.resize(chunk.size());
+                shuffle(chunk, element_bytes, shuffled.data());
+                packed.resize(::compressBound(static_cast<uLong>(chunk.size())));
+                uLongf length = static_cast<uLongf>(packed.size());
+                if (::compress2(reinterpret_cast<Bytef *>(packed.data()), &length,
+                                reinterpret_cast<const Bytef *>(shuffled.data()),
+                                static_cast<uLong>(shuffled.size()), Z_BEST_SPEED) == Z_OK &&
+                    length < chunk.size()) {
+                    stored = std::span<const std::byte>(packed.data(), length);
+                    codec = ShuffledDeflate;
+                }
+#endif
+                const auto offset = static_cast<std::uint64_t>(out.tellp());
+                out.write(reinterpret_cast<const char *>(stored.data()), static_cast<std::streamsize>(stored.size()));
+                index.push_back({offset, static_cast<std::uint32_t>(stored.size()), codec});
+            }
+
+            header.index_offset = static_cast<std::uint64_t>(out.tellp());
+            for (const auto &entry: index) {
+                put(out, entry.offset);
+                put(out, entry.stored_bytes);
+                put(out, entry.codec);
+            }
+            out.seekp(0);
+            put(out, header);
+            out.flush();
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary);
+                throw std::runtime_error("cannot write snapshot file '" + temporary.string() + "'");
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    }
+} // namespace Fortest
@@ -0,0 +1,250 @@
+#ifndef FORTEST_SNAPSHOT_STORE_HPP
+#define FORTEST_SNAPSHOT_STORE_HPP
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "array_compare.hpp"
+#include "fork_guard.hpp"
+
+namespace Fortest {
+    /// Element types a snapshot can hold; stored in the snapshot file.
+    enum class SnapshotType : std::uint32_t {
+        Int32 = 1,
+        Float32 = 2,
+        Float64 = 3,
+        ComplexFloat32 = 4,
+        ComplexFloat64 = 5
+    };
+
+    /// @brief Snapshot type of the element type `T`.
+    template<typename T>
+    [[nodiscard]] constexpr SnapshotType snapshot_type_of() noexcept {
+        if constexpr (std::is_same_v<T, int>) return SnapshotType::Int32;
+        else if constexpr (std::is_same_v<T, float>) return SnapshotType::Float32;
+        else if constexpr (std::is_same_v<T, double>) return SnapshotType::Float64;
+        else if constexpr (std::is_same_v<T, std::complex<float>>) return SnapshotType::ComplexFloat32;
+        else {
+            static_assert(std::is_same_v<T, std::complex<double>>, "unsupported snapshot element type");
+            return SnapshotType::ComplexFloat64;
+        }
+    }
+
+    /**
+     * @brief Outcome of comparing an array with its snapshot.
+     *
+     * Exactly one of three things happened: the snapshot was recorded,
+     * it could not be compared (`error` says why), or `comparison`
+     * holds the element-wise result.
+     */
+    template<typename T>
+    struct SnapshotCheck {
+        bool recorded = false;           //!< No snapshot existed, or updating was requested; the array was stored
+        std::string error;               //!< Why the array could not be compared; empty otherwise
+        ArrayComparison comparison;      //!< Element-wise result, offsets into the whole array
+        std::vector<T> expected_at_failures; //!< Snapshot values at comparison.first_failures
+    };
+
+    /**
+     * @brief Reads and writes array snapshots for golden-file assertions.
+     *
+     * @details
+     * Every snapshot is one file, `<directory>/<name>.snap`, holding the
+     * element type, the shape, and the values in chunks of about
+     * `chunk_bytes` each, followed by an index of the chunks. With zlib
+     * available (`FORTEST_HAVE_ZLIB`) a chunk is byte-shuffled (all first
+     * bytes of the values, then all second bytes, ...) and deflated, and
+     * kept raw if that does not make it smaller; floating-point fields
+     * with smooth exponents shrink well this way.
+     *
+     * Comparing streams the snapshot chunk by chunk through the SIMD
+     * comparison kernel, so a multi-GB field never needs a second copy
+     * in memory. Snapshots are written to a temporary file and renamed,
+     * so a crashing or concurrent test never leaves a partial one.
+     *
+     * Thread-safe; the configuration is meant to be set before the tests run.
+     */
+    class SnapshotStore {
+    public:
+        /// Target size of an uncompressed chunk.
+        static constexpr std::size_t default_chunk_bytes = std::size_t{1} << 20;
+
+        /// Largest chunk; the index stores chunk sizes in 32 bits.
+        static constexpr std::size_t max_chunk_bytes = std::size_t{1} << 30;
+
+        /// Number of expected values a SnapshotCheck keeps, as ArrayComparison's offsets.
+        static constexpr std::size_t reported_mismatches = default_reported_mismatches;
+
+        /// @param directory Where snapshot files live; created on the first write.
+        explicit SnapshotStore(std::filesystem::path directory = "fortest_snapshots")
+            : m_directory(std::move(directory)) {}
+
+        /// @brief The store used by the assertions; configured by TestSession::run().
+        static SnapshotStore &global() {
+            static SnapshotStore store;
+            return store;
+        }
+
+        /**
+         * @brief Choose the directory and whether existing snapshots are overwritten.
+         * @param directory Where snapshot files live.
+         * @param update Record every checked array instead of comparing it.
+         * @param chunk_bytes Uncompressed size of the chunks of new snapshots.
+         */
+        void configure(std::filesystem::path directory, bool update = false,
+                       std::size_t chunk_bytes = default_chunk_bytes) {
+            std::lock_guard lock(m_mutex);
+            m_directory = std::move(directory);
+            m_update = update;
+            m_chunk_bytes = std::clamp<std::size_t>(chunk_bytes, 1, max_chunk_bytes);
+        }
+
+        /// @brief Directory of the snapshot files.
+        [[nodiscard]] std::filesystem::path directory() const {
+            std::lock_guard lock(m_mutex);
+            return m_directory;
+        }
+
+        /// @brief File holding the snapshot `name`; characters unsafe in file names become `_`.
+        [[nodiscard]] std::filesystem::path path_of(std::string_view name) const {
+            std::string file(name);
+            for (char &c: file) {
+                const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                                  (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+                if (!safe) c = '_';
+            }
+            return directory() / (file + ".snap");
+        }
+
+        /**
+         * @brief Compare `actual` with the snapshot `name`, recording it if there is none.
+         *
+         * @param name Snapshot name, unique among the tests using the store.
+         * @param actual Values in array element (column-major) order.
+         * @param shape Extents of the array; the snapshot must have the same.
+         * @param abs_tol Absolute tolerance, as for compare_arrays().
+         * @param rel_tol Relative tolerance.
+         */
+        template<typename T>
+        SnapshotCheck<T> check(std::string_view name, std::span<const T> actual,
+                               std::span<const std::int64_t> shape, double abs_tol = 0.0,
+                               double rel_tol = 0.0) const {
+            SnapshotCheck<T> check;
+            const std::filesystem::path path = path_of(name);
+            bool update;
+            std::size_t chunk_bytes;
+            {
+                std::lock_guard lock(m_mutex);
+                update = m_update;
+                chunk_bytes = m_chunk_bytes;
+            }
+            try {
+                if (update || !std::filesystem::exists(path)) {
+                    const std::size_t chunk_elements = std::max<std::size_t>(chunk_bytes / sizeof(T), 1);
+                    write(path, snapshot_type_of<T>(), shape, std::as_bytes(actual), sizeof(T), chunk_elements);
+                    check.recorded = true;
+                    check.comparison.size = actual.size();
+                    return check;
+                }
+                Reader reader(path);
+                if (reader.type() != snapshot_type_of<T>()) {
+                    check.error = "snapshot '" + std::string(name) + "' holds another element type";
+                    return check;
+                }
+                if (!std::ranges::equal(reader.shape(), shape) || reader.num_elements() != actual.size()) {
+                    check.error = "snapshot '" + std::string(name) + "' has shape " + shape_name(reader.shape()) +
+                                  ", array has " + shape_name(shape);
+                    return check;
+                }
+                std::vector<T> expected(reader.chunk_elements());
+                ArrayComparison &total = check.comparison;
+                for (std::size_t c = 0; c < reader.num_chunks(); ++c) {
+                    const std::size_t begin = c * reader.chunk_elements();
+                    const std::size_t count = std::min(reader.chunk_elements(), actual.size() - begin);
+                    reader.read_chunk(c, std::as_writable_bytes(std::span<T>(expected.data(), count)));
+                    const ArrayComparison part = compare_arrays(std::span<const T>(expected.data(), count),
+                                                                actual.subspan(begin, count), abs_tol, rel_tol,
+                                                                reported_mismatches - total.first_failures.size());
+                    total.size += part.size;
+                    total.mismatches += part.mismatches;
+                    total.max_abs_error = std::max(total.max_abs_error, part.max_abs_error);
+                    total.max_rel_error = std::max(total.max_rel_error, part.max_rel_error);
+                    for (const auto offset: part.first_failures) {
+                        total.first_failures.push_back(begin + offset);
+                        check.expected_at_failures.push_back(expected[offset]);
+                    }
+                }
+            } catch (const std::exception &e) {
+                check.error = e.what();
+            }
+            return check;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        ForkGuard m_fork_guard{m_mutex};
+        std::filesystem::path m_directory;
+        bool m_update = false;
+        std::size_t m_chunk_bytes = default_chunk_bytes;
+
+        /// Streaming access to the chunks of one snapshot file.
+        class Reader {
+        public:
+            /// @throws std::runtime_error if the file is missing or malformed.
+            explicit Reader(const std::filesystem::path &path);
+            ~Reader();
+            Reader(const Reader &) = delete;
+            Reader &operator=(const Reader &) = delete;
+
+            [[nodiscard]] SnapshotType type() const noexcept { return m_type; }
+            [[nodiscard]] std::span<const std::int64_t> shape() const noexcept { return m_shape; }
+            [[nodiscard]] std::size_t num_elements() const noexcept { return m_num_elements; }
+            [[nodiscard]] std::size_t chunk_elements() const noexcept { return m_chunk_elements; }
+            [[nodiscard]] std::size_t num_chunks() const noexcept { return m_index.size(); }
+
+            /// @brief Decode chunk `c` into `out`, which holds exactly its values.
+            void read_chunk(std::size_t c, std::span<std::byte> out);
+
+        private:
+            struct Entry {
+                std::uint64_t offset;
+                std::uint32_t stored_bytes;
+                std::uint32_t codec;
+            };
+            struct File;
+            std::unique_ptr<File> m_file;
+            SnapshotType m_type{};
+            std::vector<std::int64_t> m_shape;
+            std::size_t m_num_elements = 0;
+            std::size_t m_element_bytes = 0;
+            std::size_t m_chunk_elements = 1;
+            std::vector<Entry> m_index;
+            std::vector<std::byte> m_stored; //!< Reused buffer of the encoded chunk
+        };
+
+        /// @brief Write a snapshot file atomically.
+        static void write(const std::filesystem::path &path, SnapshotType type,
+                          std::span<const std::int64_t> shape, std::span<const std::byte> values,
+                          std::size_t element_bytes, std::size_t chunk_elements);
+
+        [[nodiscard]] static std::string shape_name(std::span<const std::int64_t> shape) {
+            std::string text = "(";
+            for (std::size_t d = 0; d < shape.size(); ++d) {
+                text += (d > 0 ? "," : "") + std::to_string(shape[d]);
+            }
+            return text + ")";
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_SNAPSHOT_STORE_HPP
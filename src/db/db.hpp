@@ -1,6 +1,7 @@
 #ifndef FORTEST_DB_HPP
 #define FORTEST_DB_HPP
 #include <sqlite3.h>
+#include <stdexcept>
 #include <string>
 
 class SqliteDb {
@@ -0,0 +1,405 @@
+#ifndef FORTEST_REPORTERS_HPP
+#define FORTEST_REPORTERS_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "events.hpp"
+#include "result_sink.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Publishes every result row as a TestFinished event.
+     *
+     * Suites push their rows here, so that the results database, the
+     * reports and any other subscriber of the bus receive them; the
+     * tests they start become TestStarted events.
+     */
+    class EventPublisher final : public ResultConsumer {
+        EventBus &m_bus;
+
+    public:
+        using ResultConsumer::push;
+
+        explicit EventPublisher(EventBus &bus = EventBus::global()) : m_bus(bus) {}
+
+        void push(ResultRow row) override {
+            m_bus.publish(Event{.kind = EventKind::TestFinished,
+                                .suite = row.suite_name,
+                                .test = row.test_name,
+                                .status = row.status,
+                                .timing = &row.timing,
+                                .benchmark = row.benchmark ? &*row.benchmark : nullptr,
+                                .time = row.finished_at});
+        }
+
+        void start(std::string_view suite_name, std::string_view test_name) override {
+            if (!m_bus.has_subscribers()) return;
+            m_bus.publish(Event{.kind = EventKind::TestStarted,
+                                .suite = suite_name,
+                                .test = test_name,
+                                .time = std::chrono::system_clock::now()});
+        }
+    };
+
+    /**
+     * @brief Subscribes a ResultConsumer to an EventBus.
+     *
+     * Every TestFinished event becomes a row pushed to the consumer;
+     * other events are ignored.
+     */
+    class ResultEvents final : public EventSink {
+        std::shared_ptr<ResultConsumer> m_consumer;
+
+    public:
+        explicit ResultEvents(std::shared_ptr<ResultConsumer> consumer) : m_consumer(std::move(consumer)) {}
+
+        void on_event(const Event &event) override {
+            if (event.kind != EventKind::TestFinished) return;
+            m_consumer->push(ResultRow{std::string(event.suite), std::string(event.test), event.status,
+                                       event.timing ? *event.timing : TestTiming{}, event.time,
+                                       event.benchmark ? std::optional(*event.benchmark) : std::nullopt});
+        }
+
+        void flush() override { m_consumer->flush(); }
+    };
+
+    /**
+     * @brief Base of the reporters that write result rows to a file as they arrive.
+     *
+     * @details
+     * Every row is written and flushed to the operating system before
+     * push() returns, and nothing is kept in memory, so a run of any
+     * length needs constant memory and a crash of the test binary
+     * leaves the report of every test that finished before it.
+     * push() is thread-safe; rows appear in push order.
+     */
+    class StreamReporter : public ResultConsumer {
+    public:
+        using ResultConsumer::push;
+
+        StreamReporter(const StreamReporter &) = delete;
+        StreamReporter &operator=(const StreamReporter &) = delete;
+
+        ~StreamReporter() override {
+            if (m_file) std::fclose(m_file);
+        }
+
+        void push(ResultRow row) final {
+            std::lock_guard lock(m_mutex);
+            ++m_num_tests;
+            if (is_failure(row.status)) ++m_num_failures;
+            write_row(row);
+            std::fflush(m_file);
+        }
+
+        void flush() override {
+            std::lock_guard lock(m_mutex);
+            std::fflush(m_file);
+        }
+
+        /// @brief Rows written so far.
+        [[nodiscard]] std::size_t num_tests() const {
+            std::lock_guard lock(m_mutex);
+            return m_num_tests;
+        }
+
+    protected:
+        mutable std::mutex m_mutex;
+        std::FILE *m_file = nullptr;
+        std::size_t m_num_tests = 0;
+        std::size_t m_num_failures = 0;
+        const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+        /// @throws std::runtime_error if `path` cannot be created.
+        explicit StreamReporter(const std::string &path) : m_file(std::fopen(path.c_str(), "w")) {
+            if (!m_file) {
+                throw std::runtime_error("Cannot create report '" + path + "': " + std::strerror(errno));
+            }
+        }
+
+        /// @brief Write one row; called with the mutex held.
+        virtual void write_row(const ResultRow &row) = 0;
+
+        /// @brief Write `text` at the current position.
+        void write(std::string_view text) { std::fwrite(text.data(), 1, text.size(), m_file); }
+
+        /// @brief Seconds since the reporter was created.
+        [[nodiscard]] double elapsed_seconds() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+        [[nodiscard]] static bool is_failure(std::string_view status) noexcept {
+            return status == "FAIL" || status == "CRASH" || status == "TIMEOUT";
+        }
+
+        /// @brief Total duration of a row in seconds.
+        [[nodiscard]] static double seconds(const TestTiming &timing) noexcept {
+            return static_cast<double>(timing.total_ns()) * 1e-9;
+        }
+
+        /// @brief `printf` into a string.
+        template<typename... Args>
+        [[nodiscard]] static std::string format(const char *pattern, Args... args) {
+            const int n = std::snprintf(nullptr, 0, pattern, args...);
+            std::string text(static_cast<std::size_t>(n > 0 ? n : 0), '\0');
+            std::snprintf(text.data(), text.size() + 1, pattern, args...);
+            return text;
+        }
+    };
+
+    /**
+     * @brief JUnit XML report, as read by CI servers.
+     *
+     * @details
+     * All results form one `<testsuite name="fortest">`; every test is a
+     * `<testcase>` whose `classname` is its Fortest suite. FAIL becomes a
+     * `<failure>`, CRASH and TIMEOUT an `<error>`, CACHED a `<skipped>` with
+     * the message "cached".
+     *
+     * The closing tags are rewritten after every test case and the
+     * counts in the `<testsuite>` element are updated in place (they are
+     * zero-padded to a fixed width), so the file is well-formed XML
+     * with correct totals after every test, not only at the end.
+     */
+    class JUnitReporter final : public StreamReporter {
+        long m_counts_offset = 0; //!< Where the fixed-width `<testsuite>` start tag begins
+        long m_end_of_cases = 0;  //!< Where the next test case overwrites the closing tags
+
+    public:
+        /// @throws std::runtime_error if `path` cannot be created.
+        explicit JUnitReporter(const std::string &path, const RunInfo &info = RunInfo::current())
+            : StreamReporter(path) {
+            write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+            m_counts_offset = std::ftell(m_file);
+            write_counts();
+            write(format(" timestamp=\"%s\" hostname=\"%s\">\n",
+                         ResultSink::utc_timestamp(std::chrono::system_clock::now()).c_str(),
+                         escape(info.hostname).c_str()));
+            if (!info.git_sha.empty()) {
+                write("    <properties>\n      <property name=\"git_sha\" value=\"" + escape(info.git_sha) +
+                      "\"/>\n    </properties>\n");
+            }
+            end_cases();
+            std::fflush(m_file);
+        }
+
+        /// @brief XML with `&`, `<`, `>`, `"` and `'` escaped.
+        [[nodiscard]] static std::string escape(std::string_view text) {
+            std::string out;
+            out.reserve(text.size());
+            for (const char c: text) {
+                switch (c) {
+                    case '&': out += "&amp;"; break;
+                    case '<': out += "&lt;"; break;
+                    case '>': out += "&gt;"; break;
+                    case '"': out += "&quot;"; break;
+                    case '\'': out += "&apos;"; break;
+                    default: out += c;
+                }
+            }
+            return out;
+        }
+
+    private:
+        void write_counts() {
+            write(format("  <testsuite name=\"fortest\" tests=\"%010zu\" failures=\"%010zu\" time=\"%016.6f\"",
+                         m_num_tests, m_num_failures, elapsed_seconds()));
+        }
+
+        /// @brief Write the closing tags after the last test case.
+        void end_cases() {
+            m_end_of_cases = std::ftell(m_file);
+            write("  </testsuite>\n</testsuites>\n");
+        }
+
+        void write_row(const ResultRow &row) override {
+            std::fseek(m_file, m_end_of_cases, SEEK_SET);
+            std::string text = format("    <testcase classname=\"%s\" name=\"%s\" time=\"%.6f\"",
+                                      escape(row.suite_name).c_str(), escape(row.test_name).c_str(),
+                                      seconds(row.timing));
+            const std::string_view status = row.status;
+            if (status == "PASS") {
+                text += "/>\n";
+            } else if (status == "FAIL") {
+                text += ">\n      <failure type=\"FAIL\" message=\"assertion failed\"/>\n    </testcase>\n";
+            } else if (status == "CRASH") {
+                text += ">\n      <error type=\"CRASH\" message=\"test crashed\"/>\n    </testcase>\n";
+            } else if (status == "TIMEOUT") {
+                text += ">\n      <error type=\"TIMEOUT\" message=\"test timed out\"/>\n    </testcase>\n";
+            } else if (status == "CACHED") {
+                text += ">\n      <skipped message=\"cached\"/>\n    </testcase>\n";
+            } else {
+                text += ">\n      <skipped/>\n    </testcase>\n";
+            }
+            write(text);
+            end_cases();
+            std::fseek(m_file, m_counts_offset, SEEK_SET);
+            write_counts();
+        }
+    };
+
+    /**
+     * @brief JSON Lines report: one JSON object per line.
+     *
+     * @details
+     * The first line is a `session_start` event with the run's metadata,
+     * then one `result` event per test or parameter case, and a final
+     * `session_end` event with the totals. A file without `session_end`
+     * comes from a run that did not finish.
+     *
+     * Every `result` has `suite`, `test`, `status`, `finished_at` and the
+     * durations `duration_ms`, `setup_ms`, `body_ms`, `teardown_ms` and
+     * `cpu_ms`; benchmarks add a `benchmark` object with their statistics.
+     */
+    class JsonLinesReporter final : public StreamReporter {
+    public:
+        /// @throws std::runtime_error if `path` cannot be created.
+        explicit JsonLinesReporter(const std::string &path, const RunInfo &info = RunInfo::current())
+            : StreamReporter(path) {
+            write("{\"event\":\"session_start\",\"timestamp\":\"" +
+                  ResultSink::utc_timestamp(std::chrono::system_clock::now()) + "\",\"git_sha\":\"" +
+                  escape(info.git_sha) + "\",\"hostname\":\"" + escape(info.hostname) + "\"}\n");
+            std::fflush(m_file);
+        }
+
+        ~JsonLinesReporter() override {
+            std::lock_guard lock(m_mutex);
+            write(format("{\"event\":\"session_end\",\"timestamp\":\"%s\",\"tests\":%zu,\"failures\":%zu,"
+                         "\"duration_ms\":%.3f}\n",
+                         ResultSink::utc_timestamp(std::chrono::system_clock::now()).c_str(),
+                         m_num_tests, m_num_failures, elapsed_seconds() * 1e3));
+        }
+
+        /// @brief JSON string contents with quotes, backslashes and control characters escaped.
+        [[nodiscard]] static std::string escape(std::string_view text) {
+            std::string out;
+            out.reserve(text.size());
+            for (const char c: text) {
+                switch (c) {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\t': out += "\\t"; break;
+                    case '\r': out += "\\r"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            out += format("\\u%04x", static_cast<unsigned>(c));
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+            return out;
+        }
+
+    private:
+        void write_row(const ResultRow &row) override {
+            const TestTiming &t = row.timing;
+            std::string text = "{\"event\":\"result\",\"suite\":\"" + escape(row.suite_name) + "\",\"test\":\"" +
+                               escape(row.test_name) + "\",\"status\":\"" + row.status + "\",\"finished_at\":\"" +
+                               ResultSink::utc_timestamp(row.finished_at) + "\"";
+            text += format(",\"duration_ms\":%.6f,\"setup_ms\":%.6f,\"body_ms\":%.6f,\"teardown_ms\":%.6f,"
+                           "\"cpu_ms\":%.6f",
+                           TestTiming::to_ms(t.total_ns()), TestTiming::to_ms(t.setup_ns),
+                           TestTiming::to_ms(t.body_ns), TestTiming::to_ms(t.teardown_ns),
+                           TestTiming::to_ms(t.cpu_ns));
+            if (const auto &b = row.benchmark) {
+                text += format(",\"benchmark\":{\"iterations\":%zu,\"repetitions\":%zu,\"min_ns\":%.3f,"
+                               "\"median_ns\":%.3f,\"mean_ns\":%.3f,\"stddev_ns\":%.3f,\"throughput\":%.6g}",
+                               b->iterations, b->repetitions, b->min_ns, b->median_ns, b->mean_ns, b->stddev_ns,
+                               b->throughput);
+            }
+            write(text + "}\n");
+        }
+    };
+
+    /**
+     * @brief Test Anything Protocol (version 13) report.
+     *
+     * One `ok` or `not ok` line per test or parameter case, named
+     * `suite.test` and followed by its duration or failure status, or a
+     * `SKIP` directive for tests not run or cached; the
+     * plan `1..N` comes last, once the number of tests is known, so a
+     * report without a plan comes from a run that did not finish.
+     */
+    class TapReporter final : public StreamReporter {
+    public:
+        /// @throws std::runtime_error if `path` cannot be created.
+        explicit TapReporter(const std::string &path) : StreamReporter(path) {
+            write("TAP version 13\n");
+            std::fflush(m_file);
+        }
+
+        ~TapReporter() override {
+            std::lock_guard lock(m_mutex);
+            write(format("1..%zu\n", m_num_tests));
+        }
+
+    private:
+        void write_row(const ResultRow &row) override {
+            const std::string_view status = row.status;
+            // '#' starts a TAP directive, so it cannot appear in a description.
+            std::string name = row.suite_name + "." + row.test_name;
+            for (char &c: name) {
+                if (c == '#' || c == '\n') c = '_';
+            }
+            if (status == "PASS") {
+                write(format("ok %zu - %s # time=%.3fms\n", m_num_tests, name.c_str(),
+                             TestTiming::to_ms(row.timing.total_ns())));
+            } else if (is_failure(status)) {
+                write(format("not ok %zu - %s # %s\n", m_num_tests, name.c_str(), row.status));
+            } else if (status == "CACHED") {
+                write(format("ok %zu - %s # SKIP cached\n", m_num_tests, name.c_str()));
+            } else {
+                write(format("ok %zu - %s # SKIP not run\n", m_num_tests, name.c_str()));
+            }
+        }
+    };
+
+    /**
+     * @brief Create the reporter described by `spec`, `format:path`.
+     *
+     * The formats are `junit`, `jsonl` and `tap`.
+     *
+     * @throws std::invalid_argument for an unknown format or a missing path.
+     * @throws std::runtime_error if the file cannot be created.
+     */
+    [[nodiscard]] inline std::unique_ptr<StreamReporter> make_reporter(std::string_view spec) {
+        const auto colon = spec.find(':');
+        if (colon == std::string_view::npos || colon + 1 == spec.size()) {
+            throw std::invalid_argument("Report '" + std::string(spec) + "' is not of the form format:path");
+        }
+        const std::string_view kind = spec.substr(0, colon);
+        const std::string path(spec.substr(colon + 1));
+        if (kind == "junit") return std::make_unique<JUnitReporter>(path);
+        if (kind == "jsonl") return std::make_unique<JsonLinesReporter>(path);
+        if (kind == "tap") return std::make_unique<TapReporter>(path);
+        throw std::invalid_argument("Unknown report format '" + std::string(kind) + "' (junit, jsonl or tap)");
+    }
+
+    /// @brief Reporters for a comma-separated list of `format:path` specs; see make_reporter().
+    [[nodiscard]] inline std::vector<std::unique_ptr<StreamReporter>> make_reporters(std::string_view specs) {
+        std::vector<std::unique_ptr<StreamReporter>> reporters;
+        while (!specs.empty()) {
+            const auto comma = specs.find(',');
+            const std::string_view spec = specs.substr(0, comma);
+            if (!spec.empty()) reporters.push_back(make_reporter(spec));
+            if (comma == std::string_view::npos) break;
+            specs.remove_prefix(comma + 1);
+        }
+        return reporters;
+    }
+} // namespace Fortest
+
+#endif // FORTEST_REPORTERS_HPP
@@ -0,0 +1,484 @@
+#ifndef FORTEST_RESULT_SINK_HPP
+#define FORTEST_RESULT_SINK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "benchmark.hpp"
+#include "db.hpp"
+#include "results_schema.hpp"
+#include "timing.hpp"
+
+namespace Fortest {
+    /// One row of the `results` table, before names are resolved to ids.
+    struct ResultRow {
+        std::string suite_name; //!< Suite the test belongs to
+        std::string test_name;  //!< Test or parameter case name
+        const char *status;     //!< Status name with static storage, e.g. "PASS"
+        TestTiming timing;      //!< Measured durations
+        std::chrono::system_clock::time_point finished_at; //!< When the result was produced
+        std::optional<BenchmarkStats> benchmark;             //!< Statistics, if the test is a benchmark
+    };
+
+    /**
+     * @brief Receives the result rows of a session run.
+     *
+     * Suites push one row per finished test or parameter case, from any
+     * number of threads at once.
+     */
+    class ResultConsumer {
+    public:
+        virtual ~ResultConsumer() = default;
+
+        /// @brief Accept one result row. Thread-safe.
+        virtual void push(ResultRow row) = 0;
+
+        /// @brief Make the rows pushed so far durable, where the consumer stores them.
+        virtual void flush() {}
+
+        /// @brief Note that a test or parameter case is about to run. Thread-safe; ignored by default.
+        virtual void start(std::string_view /*suite_name*/, std::string_view /*test_name*/) {}
+
+        /// @brief Accept the result of a test that has just finished.
+        void push(std::string suite_name, std::string test_name, const char *status,
+                  const TestTiming &timing, std::optional<BenchmarkStats> benchmark = std::nullopt) {
+            push(ResultRow{std::move(suite_name), std::move(test_name), status, timing,
+                           std::chrono::system_clock::now(), std::move(benchmark)});
+        }
+    };
+
+    /// @brief Keeps result rows in memory, e.g. until they are sent to the process writing the database.
+    class ResultBuffer final : public ResultConsumer {
+        std::mutex m_mutex;
+        std::vector<ResultRow> m_rows;
+
+    public:
+        using ResultConsumer::push;
+
+        void push(ResultRow row) override {
+            std::lock_guard lock(m_mutex);
+            m_rows.push_back(std::move(row));
+        }
+
+        /// @brief The rows pushed so far, in push order; the buffer is left empty.
+        [[nodiscard]] std::vector<ResultRow> take() {
+            std::lock_guard lock(m_mutex);
+            return std::exchange(m_rows, {});
+        }
+    };
+
+    /// Metadata stored with every run.
+    struct RunInfo {
+        std::string git_sha;  //!< Commit under test; empty if unknown
+        std::string hostname; //!< Machine running the tests
+
+        /**
+         * @brief Describe the current process.
+         *
+         * The git sha is taken from `FORTEST_GIT_SHA`, or from the CI
+         * variables `GITHUB_SHA` and `CI_COMMIT_SHA`.
+         */
+        [[nodiscard]] static RunInfo current() {
+            RunInfo info;
+            for (const char *name : {"FORTEST_GIT_SHA", "GITHUB_SHA", "CI_COMMIT_SHA"}) {
+                if (const char *value = std::getenv(name); value && *value) {
+                    info.git_sha = value;
+                    break;
+                }
+            }
+            char host[256] = {};
+            if (gethostname(host, sizeof(host) - 1) == 0) {
+                info.hostname = host;
+            }
+            return info;
+        }
+    };
+
+    /**
+     * @brief Batched, transactional writer of one session run's results.
+     *
+     * @details
+     * Opening a sink records a new row in `runs`; destroying it commits
+     * the remaining results and stamps the run's finish time. Suites and
+     * tests are resolved to their ids on first use and cached.
+     *
+     * The statements are prepared once, the database runs in WAL mode
+     * with `synchronous=NORMAL`, and rows are written in batches, one
+     * transaction each, instead of one autocommit fsync per test.
+     *
+     * push() is safe to call from any number of threads: rows go onto a
+     * lock-free list, and a batch is committed by whichever producer
+     * notices that `batch_size` rows are pending or that `flush_interval`
+     * has elapsed since the last commit (unless another thread is already
+     * committing). flush() and the destructor commit everything pending.
+     */
+    class ResultSink final : public ResultConsumer {
+    public:
+        using ResultConsumer::push;
+
+        /// When pending rows are committed.
+        struct Options {
+            std::size_t batch_size = 256;                              //!< Rows per transaction
+            std::chrono::milliseconds flush_interval{200};             //!< Maximum age of a pending row
+        };
+
+        /**
+         * @brief Open (or create) a results database and start a run.
+         * @param path Path of the SQLite file.
+         * @param info Metadata of the run.
+         * @param options Batching policy.
+         * @throws std::runtime_error if the database cannot be opened or prepared.
+         */
+        ResultSink(const std::string &path, const RunInfo &info, Options options)
+            : m_db(path), m_options(options), m_run_id(begin_run(m_db, info)),
+              m_insert_result(m_db.get(),
+                              "INSERT INTO results (run_id, test_id, status, duration_ms, "
+                              "setup_ns, body_ns, teardown_ns, cpu_ns, finished_at) "
+                              "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);"),
+              m_insert_benchmark(m_db.get(),
+                                 "INSERT INTO benchmarks (result_id, iterations, repetitions, min_ns, "
+                                 "median_ns, mean_ns, stddev_ns, throughput) VALUES (?, ?, ?, ?, ?, ?, ?, ?);"),
+              m_insert_memory(m_db.get(),
+                              "INSERT INTO memory_usage (result_id, rss_delta_bytes, peak_rss_bytes) "
+                              "VALUES (?, ?, ?);"),
+              m_insert_counters(m_db.get(),
+                                "INSERT INTO perf_counters (result_id, cycles, instructions, cache_references, "
+                                "cache_misses, branch_misses, flops) VALUES (?, ?, ?, ?, ?, ?, ?);"),
+              m_insert_suite(m_db.get(), "INSERT OR IGNORE INTO suites (name) VALUES (?);"),
+              m_select_suite(m_db.get(), "SELECT id FROM suites WHERE name = ?;"),
+              m_insert_test(m_db.get(), "INSERT OR IGNORE INTO tests (suite_id, name) VALUES (?, ?);"),
+              m_select_test(m_db.get(), "SELECT id FROM tests WHERE suite_id = ? AND name = ?;"),
+              m_last_flush(std::chrono::steady_clock::now()) {}
+
+        /// @brief Open a results database for a run of the current process.
+        explicit ResultSink(const std::string &path) : ResultSink(path, RunInfo::current(), Options{}) {}
+
+        ResultSink(const ResultSink &) = delete;
+        ResultSink &operator=(const ResultSink &) = delete;
+
+        /// @brief Commit pending rows and finish the run; errors are reported on stderr.
+        ~ResultSink() override {
+            try {
+                flush();
+                SqliteStmt stmt(m_db.get(), "UPDATE runs SET finished_at = ? WHERE id = ?;");
+                const std::string now = utc_timestamp(std::chrono::system_clock::now());
+                sqlite3_bind_text(stmt.get(), 1, now.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int64(stmt.get(), 2, m_run_id);
+                stmt.step();
+            } catch (const std::exception &e) {
+                std::cerr << "[FORTEST] Failed to write test results: " << e.what() << std::endl;
+            }
+            discard(m_head.exchange(nullptr, std::memory_order_acquire));
+        }
+
+        /**
+         * @brief Queue one result row.
+         *
+         * Never blocks on another producer; may commit a batch on the
+         * calling thread.
+         */
+        void push(ResultRow row) override {
+            // Count first so a concurrent commit never subtracts an uncounted row.
+            const std::size_t pending = m_pending.fetch_add(1, std::memory_order_relaxed) + 1;
+            auto *node = new Node{std::move(row), m_head.load(std::memory_order_relaxed)};
+            while (!m_head.compare_exchange_weak(node->next, node,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+            }
+            if (pending >= m_options.batch_size || interval_elapsed()) {
+                std::unique_lock lock(m_write_mutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    write_pending();
+                }
+            }
+        }
+
+        /**
+         * @brief Commit every row pushed so far.
+         * @throws std::runtime_error on SQLite errors.
+         */
+        void flush() override {
+            std::lock_guard lock(m_write_mutex);
+            write_pending();
+        }
+
+        /**
+         * @brief Record the fingerprint of a suite's code for this run.
+         * @throws std::runtime_error on SQLite errors.
+         */
+        void record_fingerprint(const std::string &suite_name, const std::string &fingerprint) {
+            std::lock_guard lock(m_write_mutex);
+            SqliteStmt stmt(m_db.get(),
+                            "INSERT OR REPLACE INTO suite_fingerprints (run_id, suite_id, fingerprint)"
+                            " VALUES (?, ?, ?);");
+            sqlite3_bind_int64(stmt.get(), 1, m_run_id);
+            sqlite3_bind_int64(stmt.get(), 2, suite_id(suite_name));
+            sqlite3_bind_text(stmt.get(), 3, fingerprint.c_str(), -1, SQLITE_TRANSIENT);
+            step_done(stmt);
+        }
+
+        /**
+         * @brief Record the cache key under which a test ran in this run, whatever its result.
+         * @throws std::runtime_error on SQLite errors.
+         */
+        void record_cache_key(const std::string &suite_name, const std::string &test_name,
+                              const std::string &cache_key) {
+            std::lock_guard lock(m_write_mutex);
+            SqliteStmt stmt(m_db.get(),
+                            "INSERT OR REPLACE INTO test_cache_keys (run_id, test_id, cache_key)"
+                            " VALUES (?, ?, ?);");
+            sqlite3_bind_int64(stmt.get(), 1, m_run_id);
+            sqlite3_bind_int64(stmt.get(), 2, test_id(suite_name, test_name));
+            sqlite3_bind_text(stmt.get(), 3, cache_key.c_str(), -1, SQLITE_TRANSIENT);
+            step_done(stmt);
+        }
+
+        /// @brief Number of rows pushed but not yet committed.
+        [[nodiscard]] std::size_t pending() const noexcept {
+            return m_pending.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Id of this run in the `runs` table.
+        [[nodiscard]] std::int64_t run_id() const noexcept { return m_run_id; }
+
+        /// @brief Underlying database, e.g. for queries after a flush().
+        [[nodiscard]] const SqliteDb &db() const noexcept { return m_db; }
+
+        /// @brief Format a time point as ISO-8601 UTC with milliseconds.
+        [[nodiscard]] static std::string utc_timestamp(std::chrono::system_clock::time_point tp) {
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                tp.time_since_epoch()).count();
+            const std::time_t seconds = static_cast<std::time_t>(ms / 1000);
+            std::tm utc{};
+            gmtime_r(&seconds, &utc);
+            char text[32];
+            const std::size_t n = std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S", &utc);
+            std::snprintf(text + n, sizeof(text) - n, ".%03dZ", static_cast<int>(ms % 1000));
+            return text;
+        }
+
+    private:
+        struct Node {
+            ResultRow row;
+            Node *next;
+        };
+
+        SqliteDb m_db;
+        Options m_options;
+        std::int64_t m_run_id;
+        // Statements and id caches are guarded by m_write_mutex.
+        SqliteStmt m_insert_result;
+        SqliteStmt m_insert_benchmark;
+        SqliteStmt m_insert_memory;
+        SqliteStmt m_insert_counters;
+        SqliteStmt m_insert_suite;
+        SqliteStmt m_select_suite;
+        SqliteStmt m_insert_test;
+        SqliteStmt m_select_test;
+        std::map<std::string, std::int64_t, std::less<>> m_suite_ids;
+        std::map<std::pair<std::int64_t, std::string>, std::int64_t> m_test_ids;
+
+        std::atomic<Node *> m_head{nullptr};          //!< Pending rows, newest first
+        std::atomic<std::size_t> m_pending{0};
+        std::mutex m_write_mutex;                     //!< One committer at a time
+        std::atomic<std::chrono::steady_clock::time_point> m_last_flush;
+
+        static std::int64_t begin_run(const SqliteDb &db, const RunInfo &info) {
+            // Concurrent test binaries may share the database.
+            sqlite3_busy_timeout(db.get(), 10000);
+            db.exec("PRAGMA journal_mode=WAL;");
+            db.exec("PRAGMA synchronous=NORMAL;");
+            create_results_schema(db);
+            SqliteStmt stmt(db.get(),
+                            "INSERT INTO runs (started_at, git_sha, hostname) VALUES (?, ?, ?);");
+            const std::string now = utc_timestamp(std::chrono::system_clock::now());
+            sqlite3_bind_text(stmt.get(), 1, now.c_str(), -1, SQLITE_TRANSIENT);
+            bind_optional_text(stmt.get(), 2, info.git_sha);
+            bind_optional_text(stmt.get(), 3, info.hostname);
+            if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+                throw std::runtime_error(std::string("Failed to record test run: ") +
+                                         sqlite3_errmsg(db.get()));
+            }
+            return sqlite3_last_insert_rowid(db.get());
+        }
+
+        static void bind_optional_text(sqlite3_stmt *stmt, int index, const std::string &text) {
+            if (text.empty()) {
+                sqlite3_bind_null(stmt, index);
+            } else {
+                sqlite3_bind_text(stmt, index, text.c_str(), -1, SQLITE_TRANSIENT);
+            }
+        }
+
+        [[nodiscard]] bool interval_elapsed() const noexcept {
+            return std::chrono::steady_clock::now() - m_last_flush.load(std::memory_order_relaxed) >=
+                   m_options.flush_interval;
+        }
+
+        static void discard(Node *node) noexcept {
+            while (node) {
+                delete std::exchange(node, node->next);
+            }
+        }
+
+        /// @brief Run a statement that must not return rows.
+        void step_done(SqliteStmt &stmt) {
+            const int rc = sqlite3_step(stmt.get());
+            stmt.reset();
+            if (rc != SQLITE_DONE) {
+                throw std::runtime_error(std::string("Failed to write test result: ") +
+                                         sqlite3_errmsg(m_db.get()));
+            }
+        }
+
+        /// @brief Run a single-id lookup.
+        std::int64_t step_id(SqliteStmt &stmt) {
+            const bool found = stmt.step();
+            const std::int64_t id = found ? sqlite3_column_int64(stmt.get(), 0) : 0;
+            stmt.reset();
+            if (!found) {
+                throw std::runtime_error(std::string("Failed to resolve test id: ") +
+                                         sqlite3_errmsg(m_db.get()));
+            }
+            return id;
+        }
+
+        std::int64_t suite_id(const std::string &name) {
+            if (auto it = m_suite_ids.find(name); it != m_suite_ids.end()) {
+                return it->second;
+            }
+            sqlite3_bind_text(m_insert_suite.get(), 1, name.c_str(), -1, SQLITE_STATIC);
+            step_done(m_insert_suite);
+            sqlite3_bind_text(m_select_suite.get(), 1, name.c_str(), -1, SQLITE_STATIC);
+            const std::int64_t id = step_id(m_select_suite);
+            m_suite_ids.emplace(name, id);
+            return id;
+        }
+
+        std::int64_t test_id(const std::string &suite_name, const std::string &test_name) {
+            const std::int64_t suite = suite_id(suite_name);
+            auto key = std::make_pair(suite, test_name);
+            if (auto it = m_test_ids.find(key); it != m_test_ids.end()) {
+                return it->second;
+            }
+            sqlite3_bind_int64(m_insert_test.get(), 1, suite);
+            sqlite3_bind_text(m_insert_test.get(), 2, test_name.c_str(), -1, SQLITE_STATIC);
+            step_done(m_insert_test);
+            sqlite3_bind_int64(m_select_test.get(), 1, suite);
+            sqlite3_bind_text(m_select_test.get(), 2, test_name.c_str(), -1, SQLITE_STATIC);
+            const std::int64_t id = step_id(m_select_test);
+            m_test_ids.emplace(std::move(key), id);
+            return id;
+        }
+
+        /// @brief Commit the pending rows in one transaction; m_write_mutex must be held.
+        void write_pending() {
+            Node *list = m_head.exchange(nullptr, std::memory_order_acquire);
+            m_last_flush.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+            if (!list) return;
+
+            // Restore push order.
+            Node *ordered = nullptr;
+            std::size_t count = 0;
+            while (list) {
+                Node *next = list->next;
+                list->next = ordered;
+                ordered = list;
+                list = next;
+                ++count;
+            }
+            m_pending.fetch_sub(count, std::memory_order_relaxed);
+
+            try {
+                m_db.exec("BEGIN;");
+                for (Node *node = ordered; node; node = node->next) {
+                    insert(node->row);
+                }
+                m_db.exec("COMMIT;");
+            } catch (...) {
+                sqlite3_exec(m_db.get(), "ROLLBACK;", nullptr, nullptr, nullptr);
+                // Ids created by the rolled-back transaction no longer exist.
+                m_suite_ids.clear();
+                m_test_ids.clear();
+                discard(ordered);
+                throw;
+            }
+            discard(ordered);
+        }
+
+        void insert(const ResultRow &row) {
+            const std::int64_t test = test_id(row.suite_name, row.test_name);
+            const std::string finished = utc_timestamp(row.finished_at);
+            sqlite3_stmt *stmt = m_insert_result.get();
+            sqlite3_bind_int64(stmt, 1, m_run_id);
+            sqlite3_bind_int64(stmt, 2, test);
+            sqlite3_bind_text(stmt, 3, row.status, -1, SQLITE_STATIC);
+            sqlite3_bind_double(stmt, 4, TestTiming::to_ms(row.timing.total_ns()));
+            sqlite3_bind_int64(stmt, 5, row.timing.setup_ns);
+            sqlite3_bind_int64(stmt, 6, row.timing.body_ns);
+            sqlite3_bind_int64(stmt, 7, row.timing.teardown_ns);
+            sqlite3_bind_int64(stmt, 8, row.timing.cpu_ns);
+            sqlite3_bind_text(stmt, 9, finished.c_str(), -1, SQLITE_STATIC);
+            step_done(m_insert_result);
+            const sqlite3_int64 result_id = sqlite3_last_insert_rowid(m_db.get());
+
+            if (row.timing.memory.measured) {
+                stmt = m_insert_memory.get();
+                sqlite3_bind_int64(stmt, 1, result_id);
+                sqlite3_bind_int64(stmt, 2, row.timing.memory.rss_delta_bytes);
+                if (row.timing.memory.has_peak()) {
+                    sqlite3_bind_int64(stmt, 3, row.timing.memory.peak_rss_bytes);
+                } else {
+                    sqlite3_bind_null(stmt, 3);
+                }
+                step_done(m_insert_memory);
+            }
+            const PerfCounts &counters = row.timing.counters;
+            if (counters.measured()) {
+                stmt = m_insert_counters.get();
+                sqlite3_bind_int64(stmt, 1, result_id);
+                for (std::size_t e = 0; e < PerfCounts::NumEvents; ++e) {
+                    const auto event = static_cast<PerfCounts::Event>(e);
+                    const int index = static_cast<int>(e) + 2;
+                    if (counters.has(event)) {
+                        sqlite3_bind_int64(stmt, index, counters[event]);
+                    } else {
+                        sqlite3_bind_null(stmt, index);
+                    }
+                }
+                step_done(m_insert_counters);
+            }
+            if (!row.benchmark) return;
+
+            const BenchmarkStats &stats = *row.benchmark;
+            stmt = m_insert_benchmark.get();
+            sqlite3_bind_int64(stmt, 1, result_id);
+            sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(stats.iterations));
+            sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(stats.repetitions));
+            sqlite3_bind_double(stmt, 4, stats.min_ns);
+            sqlite3_bind_double(stmt, 5, stats.median_ns);
+            sqlite3_bind_double(stmt, 6, stats.mean_ns);
+            sqlite3_bind_double(stmt, 7, stats.stddev_ns);
+            sqlite3_bind_double(stmt, 8, stats.throughput);
+            step_done(m_insert_benchmark);
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_RESULT_SINK_HPP
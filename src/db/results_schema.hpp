@@ -0,0 +1,105 @@
+#ifndef FORTEST_RESULTS_SCHEMA_HPP
+#define FORTEST_RESULTS_SCHEMA_HPP
+
+#include "db.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Create the normalized results schema if it does not exist.
+     *
+     * @details
+     * - `runs`: one row per TestSession::run(), with git sha, hostname
+     *   and start/finish timestamps.
+     * - `suites` and `tests`: one row per distinct suite and test name,
+     *   shared by all runs.
+     * - `results`: one row per test (or parameter case) per run.
+     * - `benchmarks`: statistics of a benchmark's result, one row per
+     *   `results` row of a benchmark; times are nanoseconds per call.
+     * - `memory_usage`: resident memory of a result's test body, one row
+     *   per `results` row tracked with MemoryTracking; the peak is NULL
+     *   when the body overlapped another test in the same process.
+     * - `perf_counters`: hardware events of a result's test body, one row
+     *   per `results` row counted with PerfCounters; events the machine
+     *   did not count are NULL.
+     * - `suite_fingerprints`: fingerprint of each suite's code per run,
+     *   for runs that skip unchanged suites.
+     * - `test_cache_keys`: cache key of each cacheable test that ran, per
+     *   run, for runs that report unchanged tests as CACHED.
+     *
+     * Timestamps are ISO-8601 UTC strings with millisecond precision.
+     * The indexes make the history of one test, or all results of one
+     * run, a single indexed lookup.
+     */
+    inline void create_results_schema(const SqliteDb &db) {
+        db.exec("CREATE TABLE IF NOT EXISTS runs ("
+                "  id INTEGER PRIMARY KEY,"
+                "  started_at TEXT NOT NULL,"
+                "  finished_at TEXT,"
+                "  git_sha TEXT,"
+                "  hostname TEXT"
+                ");"
+                "CREATE TABLE IF NOT EXISTS suites ("
+                "  id INTEGER PRIMARY KEY,"
+                "  name TEXT NOT NULL UNIQUE"
+                ");"
+                "CREATE TABLE IF NOT EXISTS tests ("
+                "  id INTEGER PRIMARY KEY,"
+                "  suite_id INTEGER NOT NULL REFERENCES suites(id),"
+                "  name TEXT NOT NULL,"
+                "  UNIQUE (suite_id, name)"
+                ");"
+                "CREATE TABLE IF NOT EXISTS results ("
+                "  id INTEGER PRIMARY KEY,"
+                "  run_id INTEGER NOT NULL REFERENCES runs(id),"
+                "  test_id INTEGER NOT NULL REFERENCES tests(id),"
+                "  status TEXT NOT NULL,"
+                "  duration_ms REAL,"
+                "  setup_ns INTEGER,"
+                "  body_ns INTEGER,"
+                "  teardown_ns INTEGER,"
+                "  cpu_ns INTEGER,"
+                "  finished_at TEXT"
+                ");"
+                "CREATE TABLE IF NOT EXISTS benchmarks ("
+                "  result_id INTEGER PRIMARY KEY REFERENCES results(id),"
+                "  iterations INTEGER NOT NULL,"
+                "  repetitions INTEGER NOT NULL,"
+                "  min_ns REAL,"
+                "  median_ns REAL,"
+                "  mean_ns REAL,"
+                "  stddev_ns REAL,"
+                "  throughput REAL"
+                ");"
+                "CREATE TABLE IF NOT EXISTS memory_usage ("
+                "  result_id INTEGER PRIMARY KEY REFERENCES results(id),"
+                "  rss_delta_bytes INTEGER,"
+                "  peak_rss_bytes INTEGER"
+                ");"
+                "CREATE TABLE IF NOT EXISTS perf_counters ("
+                "  result_id INTEGER PRIMARY KEY REFERENCES results(id),"
+                "  cycles INTEGER,"
+                "  instructions INTEGER,"
+                "  cache_references INTEGER,"
+                "  cache_misses INTEGER,"
+                "  branch_misses INTEGER,"
+                "  flops INTEGER"
+                ");"
+                "CREATE TABLE IF NOT EXISTS suite_fingerprints ("
+                "  run_id INTEGER NOT NULL REFERENCES runs(id),"
+                "  suite_id INTEGER NOT NULL REFERENCES suites(id),"
+                "  fingerprint TEXT NOT NULL,"
+                "  PRIMARY KEY (suite_id, run_id)"
+                ");"
+                "CREATE TABLE IF NOT EXISTS test_cache_keys ("
+                "  run_id INTEGER NOT NULL REFERENCES runs(id),"
+                "  test_id INTEGER NOT NULL REFERENCES tests(id),"
+                "  cache_key TEXT NOT NULL,"
+                "  PRIMARY KEY (test_id, run_id)"
+                ");"
+                "CREATE INDEX IF NOT EXISTS results_by_test ON results (test_id, run_id);"
+                "CREATE INDEX IF NOT EXISTS results_by_run ON results (run_id);"
+                "CREATE INDEX IF NOT EXISTS test_cache_keys_by_key ON test_cache_keys (cache_key, run_id);");
+    }
+} // namespace Fortest
+
+#endif // FORTEST_RESULTS_SCHEMA_HPP
@@ -0,0 +1,203 @@
+#ifndef FORTEST_TEST_HISTORY_HPP
+#define FORTEST_TEST_HISTORY_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "db.hpp"
+#include "results_schema.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Expected duration and last outcome of every test, from past runs in a results database.
+     *
+     * @details
+     * A test's expected duration is the mean `duration_ms` of its last
+     * few recorded results (tests that did not run are ignored). A
+     * parameterized test is recorded per case, as `name [param=...]`;
+     * its duration as a whole is the sum of its cases' durations, and it
+     * failed last time if any case did.
+     *
+     * Suites also keep the fingerprint recorded by the latest run that
+     * ran them (see ResultSink::record_fingerprint()), and benchmarks the
+     * statistics of their last few passing runs, their baseline. The
+     * cache keys whose latest result passed (see
+     * ResultSink::record_cache_key()) are kept as a set.
+     *
+     * The history is read once, when loaded; later runs do not change it.
+     */
+    class TestHistory {
+        std::unordered_map<std::string, double> m_duration_ms; //!< By key()
+        std::unordered_map<std::string, bool> m_failed;        //!< Latest result failed, by key()
+        std::unordered_map<std::string, std::string> m_fingerprints; //!< By suite name
+        std::unordered_map<std::string, std::vector<BenchmarkStats>> m_benchmarks; //!< Passing runs, by key()
+        std::unordered_set<std::string> m_cache_keys; //!< Cache keys whose latest result passed
+
+        [[nodiscard]] static std::string key(std::string_view suite_name, std::string_view test_name) {
+            std::string text;
+            text.reserve(suite_name.size() + test_name.size() + 1);
+            text.append(suite_name);
+            text.push_back('\0');
+            text.append(test_name);
+            return text;
+        }
+
+    public:
+        /// Results per test that are averaged by default.
+        static constexpr std::size_t default_window = 5;
+
+        /**
+         * @brief Read the history of every test.
+         *
+         * A missing database yields an empty history; nothing is created.
+         *
+         * @param path Path of the results database.
+         * @param window Number of most recent results averaged per test.
+         * @throws std::runtime_error if the database exists but cannot be read.
+         */
+        [[nodiscard]] static TestHistory load(const std::string &path, std::size_t window = default_window) {
+            TestHistory history;
+            std::error_code error;
+            if (path.empty() || !std::filesystem::exists(path, error)) return history;
+
+            SqliteDb db(path);
+            sqlite3_busy_timeout(db.get(), 10000);
+            create_results_schema(db);
+            SqliteStmt stmt(db.get(),
+                            "SELECT suites.name, tests.name, AVG(recent.duration_ms) FROM ("
+                            "  SELECT test_id, duration_ms,"
+                            "         ROW_NUMBER() OVER (PARTITION BY test_id ORDER BY run_id DESC) AS n"
+                            "  FROM results WHERE duration_ms IS NOT NULL AND status NOT IN ('NONE', 'CACHED')"
+                            ") AS recent"
+                            " JOIN tests ON tests.id = recent.test_id"
+                            " JOIN suites ON suites.id = tests.suite_id"
+                            " WHERE recent.n <= ? GROUP BY recent.test_id;");
+            sqlite3_bind_int64(stmt.get(), 1, static_cast<sqlite3_int64>(window));
+
+            std::unordered_map<std::string, double> cases; // Sums per parameterized test
+            while (stmt.step()) {
+                const std::string_view suite_name = stmt.column_text(0);
+                const std::string_view test_name = stmt.column_text(1);
+                const double ms = sqlite3_column_double(stmt.get(), 2);
+                history.m_duration_ms[key(suite_name, test_name)] = ms;
+                if (const auto pos = test_name.find(" [param="); pos != std::string_view::npos) {
+                    cases[key(suite_name, test_name.substr(0, pos))] += ms;
+                }
+            }
+            for (auto &[name, ms] : cases) history.m_duration_ms.try_emplace(name, ms);
+
+            SqliteStmt latest(db.get(),
+                              "SELECT suites.name, tests.name, results.status IN ('FAIL', 'CRASH', 'TIMEOUT')"
+                              " FROM results"
+                              " JOIN (SELECT test_id, MAX(run_id) AS run_id FROM results GROUP BY test_id)"
+                              "   AS last ON last.test_id = results.test_id AND last.run_id = results.run_id"
+                              " JOIN tests ON tests.id = results.test_id"
+                              " JOIN suites ON suites.id = tests.suite_id;");
+            while (latest.step()) {
+                const std::string_view suite_name = latest.column_text(0);
+                const std::string_view test_name = latest.column_text(1);
+                const bool failed = sqlite3_column_int(latest.get(), 2) != 0;
+                history.m_failed[key(suite_name, test_name)] |= failed;
+                if (const auto pos = test_name.find(" [param="); pos != std::string_view::npos) {
+                    history.m_failed[key(suite_name, test_name.substr(0, pos))] |= failed;
+                }
+            }
+
+            SqliteStmt fingerprints(db.get(),
+                                    "SELECT suites.name, f.fingerprint FROM suite_fingerprints AS f"
+                                    " JOIN suites ON suites.id = f.suite_id"
+                                    " WHERE f.run_id = (SELECT MAX(run_id) FROM suite_fingerprints"
+                                    "                   WHERE suite_id = f.suite_id);");
+            while (fingerprints.step()) {
+                history.m_fingerprints.emplace(fingerprints.column_text(0), fingerprints.column_text(1));
+            }
+
+            SqliteStmt cache_keys(db.get(),
+                                  "SELECT k.cache_key FROM test_cache_keys AS k"
+                                  " JOIN results ON results.run_id = k.run_id AND results.test_id = k.test_id"
+                                  " WHERE k.run_id = (SELECT MAX(run_id) FROM test_cache_keys"
+                                  "                   WHERE cache_key = k.cache_key)"
+                                  "   AND results.status = 'PASS';");
+            while (cache_keys.step()) history.m_cache_keys.emplace(cache_keys.column_text(0));
+
+            SqliteStmt benchmarks(db.get(),
+                                  "SELECT suites.name, tests.name, recent.iterations, recent.repetitions,"
+                                  "       recent.min_ns, recent.median_ns, recent.mean_ns, recent.stddev_ns,"
+                                  "       recent.throughput FROM ("
+                                  "  SELECT results.test_id, benchmarks.*,"
+                                  "         ROW_NUMBER() OVER (PARTITION BY results.test_id"
+                                  "                            ORDER BY results.run_id DESC) AS n"
+                                  "  FROM benchmarks JOIN results ON results.id = benchmarks.result_id"
+                                  "  WHERE results.status = 'PASS'"
+                                  ") AS recent"
+                                  " JOIN tests ON tests.id = recent.test_id"
+                                  " JOIN suites ON suites.id = tests.suite_id"
+                                  " WHERE recent.n <= ? ORDER BY recent.test_id, recent.n;");
+            sqlite3_bind_int64(benchmarks.get(), 1, static_cast<sqlite3_int64>(window));
+            while (benchmarks.step()) {
+                BenchmarkStats stats;
+                stats.iterations = static_cast<std::size_t>(sqlite3_column_int64(benchmarks.get(), 2));
+                stats.repetitions = static_cast<std::size_t>(sqlite3_column_int64(benchmarks.get(), 3));
+                stats.min_ns = sqlite3_column_double(benchmarks.get(), 4);
+                stats.median_ns = sqlite3_column_double(benchmarks.get(), 5);
+                stats.mean_ns = sqlite3_column_double(benchmarks.get(), 6);
+                stats.stddev_ns = sqlite3_column_double(benchmarks.get(), 7);
+                stats.throughput = sqlite3_column_double(benchmarks.get(), 8);
+                history.m_benchmarks[key(benchmarks.column_text(0), benchmarks.column_text(1))].push_back(stats);
+            }
+            return history;
+        }
+
+        /// @brief Expected duration of a test or parameterized test in milliseconds, if it has run before.
+        [[nodiscard]] std::optional<double> duration_ms(std::string_view suite_name,
+                                                        std::string_view test_name) const {
+            const auto it = m_duration_ms.find(key(suite_name, test_name));
+            if (it == m_duration_ms.end()) return std::nullopt;
+            return it->second;
+        }
+
+        /**
+         * @brief Whether the latest result of a test failed, crashed or timed out.
+         * @return std::nullopt if the test has no recorded result.
+         */
+        [[nodiscard]] std::optional<bool> last_failed(std::string_view suite_name,
+                                                      std::string_view test_name) const {
+            const auto it = m_failed.find(key(suite_name, test_name));
+            if (it == m_failed.end()) return std::nullopt;
+            return it->second;
+        }
+
+        /// @brief Fingerprint of a suite when it last ran, if one was recorded.
+        [[nodiscard]] std::optional<std::string> fingerprint(const std::string &suite_name) const {
+            const auto it = m_fingerprints.find(suite_name);
+            if (it == m_fingerprints.end()) return std::nullopt;
+            return it->second;
+        }
+
+        /// @brief Statistics of the last passing runs of a benchmark, newest first; empty if none.
+        [[nodiscard]] std::vector<BenchmarkStats> benchmark_baseline(std::string_view suite_name,
+                                                                     std::string_view test_name) const {
+            const auto it = m_benchmarks.find(key(suite_name, test_name));
+            if (it == m_benchmarks.end()) return {};
+            return it->second;
+        }
+
+        /// @brief Whether the latest result under `cache_key` passed; see TestSuite::set_cacheable().
+        [[nodiscard]] bool passed_with(const std::string &cache_key) const {
+            return m_cache_keys.contains(cache_key);
+        }
+
+        /// @brief Number of tests and parameter cases with a history.
+        [[nodiscard]] std::size_t size() const noexcept { return m_duration_ms.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_duration_ms.empty(); }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_TEST_HISTORY_HPP
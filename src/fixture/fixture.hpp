@@ -1,7 +1,9 @@
 #ifndef FORTEST_FIXTURE_HPP
 #define FORTEST_FIXTURE_HPP
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <mutex>
 
 namespace Fortest {
     /// @brief Generic function type for setup/teardown with untyped arguments.
@@ -67,6 +69,63 @@ namespace Fortest {
         [[nodiscard]] T* get_args() const noexcept { return m_args; }
     };
 
+    /// @brief The fixtures a test runs with, one per scope; any may be null.
+    ///
+    /// The fixtures are owned elsewhere, normally by the test suite, so
+    /// tests sharing them hold no copies.
+    struct FixtureSet {
+        const Fixture<void> *test = nullptr;    ///< Set up and torn down around the test.
+        const Fixture<void> *suite = nullptr;   ///< Provides the suite arguments.
+        const Fixture<void> *session = nullptr; ///< Provides the session arguments.
+    };
+
+    /// @brief Lazily set-up lifetime of a fixture shared by several tests.
+    ///
+    /// A run opens it with the number of users holding a share, usually
+    /// one for the whole batch of tests. The fixture is set up by the
+    /// first acquire(), just before a test actually runs, so a fixture
+    /// whose tests are all filtered out or skipped is never set up. It is
+    /// torn down by the release() of the last share, which a parallel run
+    /// makes when its last test finishes rather than at the end of the
+    /// session. acquire() and release() are thread-safe; concurrent users
+    /// wait until the setup has finished.
+    class SharedFixture {
+        std::mutex m_mutex;
+        const Fixture<void> *m_fixture = nullptr; ///< Fixture of the open run; may be null.
+        std::size_t m_shares = 0;                  ///< Shares not yet released.
+        bool m_active = false;                     ///< Whether the fixture is set up.
+
+    public:
+        /// @brief Start a run of `shares` users of `fixture`; nothing is set up yet.
+        void open(const Fixture<void> *fixture, std::size_t shares) {
+            std::lock_guard lock(m_mutex);
+            if (!m_active) m_fixture = fixture;
+            m_shares += shares;
+        }
+
+        /// @brief Set the fixture up unless it already is.
+        void acquire() {
+            std::lock_guard lock(m_mutex);
+            if (m_active) return;
+            if (m_fixture) m_fixture->setup();
+            m_active = true;
+        }
+
+        /// @brief Give back one share; the last one tears a set-up fixture down.
+        void release() {
+            std::lock_guard lock(m_mutex);
+            if (m_shares == 0 || --m_shares > 0) return;
+            if (m_active && m_fixture) m_fixture->teardown();
+            m_active = false;
+        }
+
+        /// @brief Whether the fixture is currently set up.
+        [[nodiscard]] bool active() {
+            std::lock_guard lock(m_mutex);
+            return m_active;
+        }
+    };
+
 } // namespace Fortest
 
 #endif //FORTEST_FIXTURE_HPP
@@ -0,0 +1,157 @@
+#ifndef FORTEST_MAPPED_FILE_HPP
+#define FORTEST_MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "fixture.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * @details
+     * Nothing is copied: pages are read from the page cache as the
+     * tests touch them, and every process mapping the same file, such
+     * as the forked children of an isolated run, shares those pages.
+     * The mapping is page aligned, so arrays stored at the start of the
+     * file suit the vectorized array assertions.
+     */
+    class MappedFile {
+        const void *m_data = nullptr;
+        std::size_t m_size = 0;
+
+    public:
+        MappedFile() = default;
+
+        /// @brief Map `path`; see open().
+        explicit MappedFile(const std::string &path) { open(path); }
+
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Map `path` read-only, replacing any previous mapping.
+         *
+         * An empty file maps to no data and a size of zero.
+         *
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+        void open(const std::string &path) {
+            close();
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) fail("open", path, errno);
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const int error = errno;
+                ::close(fd);
+                fail("stat", path, error);
+            }
+            const auto size = static_cast<std::size_t>(info.st_size);
+            if (size > 0) {
+                void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                if (data == MAP_FAILED) {
+                    const int error = errno;
+                    ::close(fd);
+                    fail("map", path, error);
+                }
+                m_data = data;
+                m_size = size;
+            }
+            // The mapping keeps the file's pages; the descriptor is not needed.
+            ::close(fd);
+        }
+
+        /// @brief Unmap the file, if mapped.
+        void close() noexcept {
+            if (m_data) ::munmap(const_cast<void *>(m_data), m_size);
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        /// @brief First byte of the file; nullptr if nothing is mapped.
+        [[nodiscard]] const void *data() const noexcept { return m_data; }
+
+        /// @brief Size of the file in bytes.
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+        /// @brief The file as an array of `T`; trailing bytes that do not fill a `T` are left out.
+        template<typename T>
+        [[nodiscard]] std::span<const T> as() const noexcept {
+            return {static_cast<const T *>(m_data), m_size / sizeof(T)};
+        }
+
+    private:
+        [[noreturn]] static void fail(const char *what, const std::string &path, int error) {
+            throw std::runtime_error("Cannot " + std::string(what) + " golden data file '" + path +
+                                     "': " + std::strerror(error));
+        }
+    };
+
+    /**
+     * @brief Where a golden data fixture publishes its mapping.
+     *
+     * The fixture's arguments point at it, so tests read it from their
+     * suite (or session, test) arguments. Mirrors `golden_data_t` in the
+     * Fortran `fortest_test_session` module, whose `data` goes straight
+     * to `c_f_pointer`.
+     */
+    struct MappedView {
+        const void *data = nullptr; ///< First byte of the file; null while not set up
+        std::size_t size = 0;       ///< Size of the file in bytes
+    };
+
+    /**
+     * @brief Fixture mapping a reference data file read-only while it is set up.
+     *
+     * Setup maps `path` and fills `view`; teardown unmaps it and clears
+     * `view`. With a suite scope the file is mapped once for all tests
+     * of the suite, and an isolated run maps it in the parent, so its
+     * children inherit the mapping instead of reading the file again.
+     *
+     * @param path File to map.
+     * @param view Receives the mapping; must outlive the fixture's use.
+     * @param scope Scope of the fixture.
+     */
+    [[nodiscard]] inline Fixture<void> mapped_file_fixture(std::string path, MappedView *view,
+                                                           Scope scope = Scope::Suite) {
+        auto file = std::make_shared<MappedFile>();
+        return Fixture<void>(
+            [file, path = std::move(path)](void *args) {
+                file->open(path);
+                *static_cast<MappedView *>(args) = {file->data(), file->size()};
+            },
+            [file](void *args) {
+                *static_cast<MappedView *>(args) = {};
+                file->close();
+            },
+            view, scope);
+    }
+} // namespace Fortest
+
+#endif // FORTEST_MAPPED_FILE_HPP
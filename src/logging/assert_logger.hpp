@@ -1,16 +1,30 @@
 #ifndef FORTEST_ASSERT_LOGGER_HPP
 #define FORTEST_ASSERT_LOGGER_HPP
 
+#include <array>
+#include <cstddef>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
 #include <optional>
 
+#include "async_writer.hpp"
+#include "fork_guard.hpp"
+
 namespace Fortest {
     /// @brief Logger specifically tailored for assertions.
     ///
     /// Provides clear, consistent reporting of assertion results,
     /// with optional ANSI colors and internal storage of results.
+    /// Like Logger, it can hand its output to an AsyncWriter.
+    ///
+    /// Only the most recent entries are kept (see set_max_entries()),
+    /// so long runs with many assertions do not grow without bound;
+    /// the pass and fail counts cover every logged result.
     class AssertLogger {
     public:
         enum class Color {
@@ -20,6 +34,9 @@ namespace Fortest {
             YELLOW
         };
 
+        /// Entries kept by default.
+        static constexpr std::size_t default_max_entries = 1024;
+
         struct Entry {
             std::string tag; ///< PASS/FAIL/etc.
             std::string msg; ///< Assertion message.
@@ -36,7 +53,8 @@ namespace Fortest {
 
         /// @brief Log an assertion result.
         ///
-        /// This function is designed to be called by the Assert class.
+        /// This function is designed to be called by the Assert class and
+        /// is safe to call from concurrently running tests.
         /// @param msg The assertion message.
         /// @param tag Must be "PASS" or "FAIL" (others treated as INFO).
         /// @param border Optional border string (not used currently).
@@ -45,39 +63,87 @@ namespace Fortest {
             const std::string &tag,
             const std::optional<std::string> &border = std::nullopt
         ) {
-            m_entries.push_back({tag, msg});
-            if (border.has_value()) {
+            (void) border;
+            const bool pass = tag == "PASS";
+            const bool fail = !pass && tag == "FAIL";
+            std::lock_guard lock(m_mutex);
+            if (m_max_entries > 0) {
+                if (m_entries.size() >= m_max_entries) m_entries.pop_front();
+                m_entries.push_back({tag, msg});
             }
-            if (tag == "PASS") {
+            if (pass) {
+                ++m_passes;
                 write("PASS", msg, Color::GREEN);
-            } else if (tag == "FAIL") {
-                write("FAIL", msg, Color::RED);
+            } else if (fail) {
+                ++m_fails;
+                write("FAIL", msg, Color::RED, true);
             } else {
                 write(tag, msg, Color::YELLOW);
             }
         }
 
-        /// @brief Retrieve all log entries so far.
-        [[nodiscard]] const std::vector<Entry> &entries() const { return m_entries; }
+        /// @brief Keep at most `max_entries` entries, dropping the oldest; 0 keeps none.
+        void set_max_entries(std::size_t max_entries) {
+            std::lock_guard lock(m_mutex);
+            m_max_entries = max_entries;
+            while (m_entries.size() > m_max_entries) m_entries.pop_front();
+        }
+
+        /// @brief Route output through an asynchronous writer.
+        ///
+        /// Failed assertions are still on the stream when log() returns.
+        /// @param writer Writer draining to this logger's stream, or nullptr
+        ///        to write synchronously again.
+        void set_async_writer(std::shared_ptr<AsyncWriter> writer) {
+            std::lock_guard lock(m_mutex);
+            if (m_async) m_async->flush();
+            m_async = std::move(writer);
+        }
+
+        /// @brief The attached asynchronous writer, or nullptr.
+        [[nodiscard]] std::shared_ptr<AsyncWriter> get_async_writer() const {
+            std::lock_guard lock(m_mutex);
+            return m_async;
+        }
+
+        /// @brief Block until all output logged so far has reached the stream.
+        void flush() {
+            std::lock_guard lock(m_mutex);
+            if (m_async) {
+                m_async->flush();
+            } else {
+                m_out.flush();
+            }
+        }
+
+        /// @brief Retrieve the most recent log entries, oldest first.
+        [[nodiscard]] const std::deque<Entry> &entries() const { return m_entries; }
 
         /// @brief Print a summary of results.
         void print_summary() const {
-            int passes = 0, fails = 0;
-            for (auto &e: m_entries) {
-                if (e.tag == "PASS") ++passes;
-                if (e.tag == "FAIL") ++fails;
+            std::lock_guard lock(m_mutex);
+            const std::string summary = "Assertions Summary: " + std::to_string(m_passes) +
+                                        " passed, " + std::to_string(m_fails) + " failed\n";
+            if (m_async) {
+                m_async->write(summary);
+            } else {
+                m_out << summary;
             }
-            m_out << "Assertions Summary: "
-                    << passes << " passed, "
-                    << fails << " failed\n";
         }
 
     private:
         std::ostream &m_out;
         bool m_use_color;
-        std::vector<Entry> m_entries;
+        std::deque<Entry> m_entries;
+        std::size_t m_max_entries = default_max_entries;
+        std::size_t m_passes = 0;
+        std::size_t m_fails = 0;
+        mutable std::mutex m_mutex;
+        ForkGuard m_fork_guard{m_mutex};
 
-        static std::string color_code(Color c) {
+        std::shared_ptr<AsyncWriter> m_async;
+
+        static constexpr std::string_view color_code(Color c) {
             switch (c) {
                 case Color::RED: return "\033[31m";
                 case Color::GREEN: return "\033[32m";
@@ -86,12 +152,21 @@ namespace Fortest {
             }
         }
 
-        void write(const std::string &tag, const std::string &msg, Color c) {
-            if (m_use_color) {
-                m_out << color_code(c) << "[ASSERT][" << tag << "] "
-                        << msg << "\033[0m\n";
-            } else {
-                m_out << "[ASSERT][" << tag << "] " << msg << "\n";
+        void write(std::string_view tag, const std::string &msg, Color c, bool urgent = false) {
+            std::array<std::string_view, 6> parts{
+                color_code(c), "[ASSERT][", tag, "] ", msg, "\033[0m\n"
+            };
+            std::span<const std::string_view> line(parts);
+            if (!m_use_color) {
+                parts[5] = "\n";
+                line = line.subspan(1);
+            }
+            if (m_async) {
+                m_async->write(line, urgent);
+                return;
+            }
+            for (const auto part: line) {
+                m_out.write(part.data(), static_cast<std::streamsize>(part.size()));
             }
         }
     };
@@ -0,0 +1,74 @@
+#ifndef FORTEST_ASYNC_LOGGER_HPP
+#define FORTEST_ASYNC_LOGGER_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "assert_logger.hpp"
+#include "async_writer.hpp"
+#include "logging.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Logger whose output is written by a background thread.
+     *
+     * Formats exactly like Logger, but copies every message into the
+     * preallocated ring buffer of its own AsyncWriter instead of writing
+     * to the stream. Failures are flushed before log() returns, and the
+     * remaining output is flushed on destruction, at exit and on
+     * `std::terminate`.
+     */
+    class AsyncLogger : public Logger {
+    public:
+        /**
+         * @brief Construct an asynchronous logger.
+         *
+         * @param out The output stream; must outlive the logger.
+         * @param capacity Ring buffer size in bytes.
+         * @param border An optional border string to surround log messages.
+         * @param color The default color for log messages.
+         */
+        explicit AsyncLogger(
+            std::ostream &out = std::cout,
+            std::size_t capacity = AsyncWriter::default_capacity,
+            std::string border = "",
+            Color color = Color::DEFAULT
+        )
+            : Logger(out, std::move(border), color) {
+            set_async_writer(std::make_shared<AsyncWriter>(out, capacity));
+        }
+    };
+
+    /**
+     * @brief AssertLogger whose output is written by a background thread.
+     *
+     * Failed assertions are flushed before log() returns.
+     */
+    class AsyncAssertLogger : public AssertLogger {
+    public:
+        /**
+         * @brief Construct an asynchronous assertion logger.
+         *
+         * @param out Stream to write logs; must outlive the logger.
+         * @param use_color Whether to print ANSI colors.
+         * @param capacity Ring buffer size in bytes.
+         */
+        explicit AsyncAssertLogger(
+            std::ostream &out = std::cout,
+            bool use_color = true,
+            std::size_t capacity = AsyncWriter::default_capacity
+        )
+            : AssertLogger(out, use_color) {
+            set_async_writer(std::make_shared<AsyncWriter>(out, capacity));
+        }
+    };
+
+    static_assert(LoggerLike<AsyncLogger>);
+    static_assert(LoggerLike<AsyncAssertLogger>);
+} // namespace Fortest
+
+#endif // FORTEST_ASYNC_LOGGER_HPP
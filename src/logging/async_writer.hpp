@@ -0,0 +1,278 @@
+#ifndef FORTEST_ASYNC_WRITER_HPP
+#define FORTEST_ASYNC_WRITER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "fork_guard.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Buffered, asynchronous writer for log output.
+     *
+     * @details
+     * Producers copy already formatted pieces of a message into a ring
+     * buffer that is allocated once, at construction; a background thread
+     * drains the buffer to the underlying stream. A log call therefore
+     * costs a short critical section and a memcpy instead of a formatted
+     * stream write, and messages from concurrent tests are never torn.
+     *
+     * Output is never lost:
+     * - write() with `urgent` set, used for failures, returns only once
+     *   the message has reached the stream.
+     * - Every live writer is flushed at exit, when `std::terminate` is
+     *   called, and before `fork()`. A forked child writes synchronously,
+     *   because the background thread does not exist there.
+     * - A message larger than the whole buffer is written directly, after
+     *   everything queued before it.
+     */
+    class AsyncWriter {
+    public:
+        /// Ring buffer size used when none is given.
+        static constexpr std::size_t default_capacity = std::size_t{1} << 20;
+
+        /**
+         * @brief Start a writer draining to `out`.
+         * @param out Stream receiving the output; must outlive the writer.
+         * @param capacity Ring buffer size in bytes (at least 256).
+         */
+        explicit AsyncWriter(std::ostream &out, std::size_t capacity = default_capacity)
+            : m_out(out), m_ring(std::max<std::size_t>(capacity, 256)) {
+            m_thread = std::make_unique<std::thread>([this] { drain_loop(); });
+            Registry::get().add(this);
+        }
+
+        AsyncWriter(const AsyncWriter &) = delete;
+        AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+        /// @brief Flush everything and stop the background thread.
+        ~AsyncWriter() {
+            Registry::get().remove(this);
+            if (m_detached) {
+                // Forked child: the thread object describes a thread of the parent.
+                m_out.flush();
+                (void) m_thread.release();
+                return;
+            }
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_not_empty.notify_all();
+            m_thread->join();
+        }
+
+        /**
+         * @brief Queue one message made of consecutive pieces.
+         *
+         * The pieces are copied into the ring buffer as one unit. Blocks
+         * only while the buffer is full.
+         *
+         * @param pieces Parts of the message, written back to back.
+         * @param urgent Wait until the message has reached the stream.
+         */
+        void write(std::span<const std::string_view> pieces, bool urgent = false) {
+            std::size_t size = 0;
+            for (const auto piece: pieces) size += piece.size();
+
+            std::unique_lock lock(m_mutex);
+            if (m_detached) {
+                write_pieces(pieces);
+                if (urgent) m_out.flush();
+                return;
+            }
+            if (size > m_ring.size()) {
+                // Too large to queue: write it in order, once the queue is empty.
+                m_drained.wait(lock, [&] { return m_tail == m_head; });
+                write_pieces(pieces);
+                m_out.flush();
+                return;
+            }
+            m_not_full.wait(lock, [&] { return m_ring.size() - (m_head - m_tail) >= size; });
+            for (const auto piece: pieces) copy_in(piece);
+            const std::uint64_t end = m_head;
+            lock.unlock();
+            m_not_empty.notify_one();
+
+            if (urgent) {
+                lock.lock();
+                m_drained.wait(lock, [&] { return m_tail >= end; });
+            }
+        }
+
+        /// @brief Queue a single piece of text.
+        void write(std::string_view text, bool urgent = false) {
+            write(std::span<const std::string_view>(&text, 1), urgent);
+        }
+
+        /// @brief Block until everything queued so far has reached the stream.
+        void flush() {
+            std::unique_lock lock(m_mutex);
+            if (m_detached) {
+                m_out.flush();
+                return;
+            }
+            const std::uint64_t end = m_head;
+            m_drained.wait(lock, [&] { return m_tail >= end; });
+        }
+
+        /// @brief Ring buffer size in bytes.
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_ring.size(); }
+
+        /// @brief Flush every live writer; used at exit and before fork().
+        static void flush_all() {
+            Registry::get().for_each([](AsyncWriter &writer) { writer.flush(); });
+        }
+
+    private:
+        std::ostream &m_out;
+        std::vector<char> m_ring;      //!< Preallocated message storage
+        std::uint64_t m_head = 0;      //!< Bytes ever queued
+        std::uint64_t m_tail = 0;      //!< Bytes ever written to the stream
+        bool m_stop = false;
+        bool m_detached = false;       //!< In a forked child: write synchronously
+        std::mutex m_mutex;
+        std::condition_variable m_not_empty;
+        std::condition_variable m_not_full;
+        std::condition_variable m_drained;
+        std::unique_ptr<std::thread> m_thread;
+
+        void copy_in(std::string_view piece) {
+            const std::size_t cap = m_ring.size();
+            const std::size_t start = static_cast<std::size_t>(m_head % cap);
+            const std::size_t first = std::min(piece.size(), cap - start);
+            std::copy_n(piece.data(), first, m_ring.data() + start);
+            std::copy_n(piece.data() + first, piece.size() - first, m_ring.data());
+            m_head += piece.size();
+        }
+
+        void write_pieces(std::span<const std::string_view> pieces) {
+            for (const auto piece: pieces) {
+                m_out.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+            }
+        }
+
+        void drain_loop() {
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_not_empty.wait(lock, [&] { return m_stop || m_head != m_tail; });
+                if (m_head == m_tail) {
+                    return; // stopped and drained
+                }
+                // Producers only write into free space, so [tail, head) stays stable unlocked.
+                const std::uint64_t head = m_head;
+                const std::size_t cap = m_ring.size();
+                const std::size_t start = static_cast<std::size_t>(m_tail % cap);
+                const std::size_t size = static_cast<std::size_t>(head - m_tail);
+                const std::size_t first = std::min(size, cap - start);
+                lock.unlock();
+                m_out.write(m_ring.data() + start, static_cast<std::streamsize>(first));
+                if (size > first) {
+                    m_out.write(m_ring.data(), static_cast<std::streamsize>(size - first));
+                }
+                m_out.flush();
+                lock.lock();
+                m_tail = head;
+                m_not_full.notify_all();
+                m_drained.notify_all();
+            }
+        }
+
+        /// Live writers, flushed at exit, on terminate and around fork().
+        class Registry {
+            std::mutex m_mutex;
+            std::vector<AsyncWriter *> m_writers;
+            std::terminate_handler m_previous = nullptr;
+
+            Registry() {
+                m_previous = std::set_terminate(on_terminate);
+                std::atexit([] { flush_all(); });
+                // Inside the guarded mutexes: loggers hold theirs while they write here.
+                ForkGuard::on_fork(prepare_fork, parent_after_fork, child_after_fork);
+            }
+
+            [[noreturn]] static void on_terminate() {
+                auto &registry = get();
+                if (registry.m_mutex.try_lock()) {
+                    for (auto *writer: registry.m_writers) writer->flush_for_terminate();
+                    registry.m_mutex.unlock();
+                }
+                if (registry.m_previous) registry.m_previous();
+                std::abort();
+            }
+
+            static void prepare_fork() {
+                auto &registry = get();
+                registry.m_mutex.lock();
+                for (auto *writer: registry.m_writers) {
+                    writer->flush();
+                    writer->m_mutex.lock();
+                }
+            }
+
+            static void parent_after_fork() {
+                auto &registry = get();
+                for (auto *writer: registry.m_writers) writer->m_mutex.unlock();
+                registry.m_mutex.unlock();
+            }
+
+            static void child_after_fork() {
+                auto &registry = get();
+                for (auto *writer: registry.m_writers) {
+                    writer->m_detached = true;
+                    writer->m_mutex.unlock();
+                }
+                registry.m_mutex.unlock();
+            }
+
+        public:
+            static Registry &get() {
+                // Never destroyed: writers may outlive static destruction order.
+                static auto *registry = new Registry();
+                return *registry;
+            }
+
+            void add(AsyncWriter *writer) {
+                std::lock_guard lock(m_mutex);
+                m_writers.push_back(writer);
+            }
+
+            void remove(AsyncWriter *writer) {
+                std::lock_guard lock(m_mutex);
+                std::erase(m_writers, writer);
+            }
+
+            template<typename Fn>
+            void for_each(Fn fn) {
+                std::lock_guard lock(m_mutex);
+                for (auto *writer: m_writers) fn(*writer);
+            }
+        };
+
+        /// @brief Best-effort flush that gives up instead of deadlocking.
+        void flush_for_terminate() noexcept {
+            std::unique_lock lock(m_mutex, std::try_to_lock);
+            if (!lock.owns_lock()) return;
+            if (m_detached) {
+                m_out.flush();
+                return;
+            }
+            const std::uint64_t end = m_head;
+            m_drained.wait_for(lock, std::chrono::seconds(1), [&] { return m_tail >= end; });
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_ASYNC_WRITER_HPP
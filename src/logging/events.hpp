@@ -0,0 +1,275 @@
+#ifndef FORTEST_EVENTS_HPP
+#define FORTEST_EVENTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "fork_guard.hpp"
+#include "logging.hpp"
+#include "timing.hpp"
+
+namespace Fortest {
+    /// What an Event reports.
+    enum class EventKind : std::uint8_t {
+        SessionStarted,  ///< A run begins; `value` is the number of suites
+        RunPlanned,      ///< The tests of a run are chosen; `plan` describes them
+        SuiteStarted,    ///< The tests of `suite` are about to start
+        TestStarted,     ///< A test or parameter case is about to run
+        TestFinished,    ///< A test or parameter case finished with `status` after `timing`
+        AssertionFailed, ///< An assertion failed; `text` is its message
+        SessionFinished  ///< A run ended; `value` is the number of failed tests
+    };
+
+    /// @brief The tests a run is about to start, for progress estimates.
+    struct RunPlan {
+        std::int64_t tests = 0;       //!< Tests and parameter cases whose results the run publishes
+        std::int64_t expected_ns = 0; //!< Their summed expected duration from past runs; 0 if unknown
+        std::int64_t workers = 1;     //!< Tests running at a time
+    };
+
+    /**
+     * @brief One typed event, as published on an EventBus.
+     *
+     * Names and text are views, valid only while the event is
+     * dispatched: a sink that keeps them copies them. Nothing is
+     * formatted for an event; sinks that need text build it.
+     */
+    struct Event {
+        EventKind kind{};                              //!< What happened
+        std::string_view suite;                        //!< Suite of a suite or test event
+        std::string_view test;                         //!< Test or parameter case of a test event
+        const char *status = "";                       //!< Status name with static storage, e.g. "PASS"
+        const TestTiming *timing = nullptr;            //!< Durations of a finished test
+        const BenchmarkStats *benchmark = nullptr;     //!< Statistics of a finished benchmark, if any
+        const RunPlan *plan = nullptr;                 //!< Tests of a planned run
+        std::int64_t value = 0;                        //!< Numeric payload; see EventKind
+        std::string_view text;                         //!< Message of an assertion event
+        std::chrono::system_clock::time_point time{};  //!< When the event happened
+    };
+
+    /// @brief Receives the events of an EventBus; on_event() may be called from any thread.
+    class EventSink {
+    public:
+        virtual ~EventSink() = default;
+
+        /// @brief Handle one event. Must be thread-safe.
+        virtual void on_event(const Event &event) = 0;
+
+        /// @brief Make the events handled so far durable, where the sink stores them.
+        virtual void flush() {}
+    };
+
+    /**
+     * @brief Delivers typed events to the subscribed sinks.
+     *
+     * @details
+     * The subscriber list is copied on write, so publishing takes a
+     * snapshot of it and calls the sinks without holding a lock; sinks
+     * subscribed or unsubscribed meanwhile take effect for the next
+     * event. Without subscribers, publish() is a single atomic load.
+     *
+     * TestSession publishes the session, suite and test events of its
+     * runs on the global bus, and Assert publishes failed assertions.
+     * A forked child drops the subscribers it inherited: they belong to
+     * the parent, which publishes the results of its children.
+     */
+    class EventBus {
+        using Sinks = std::vector<std::shared_ptr<EventSink>>;
+
+        mutable std::mutex m_mutex;
+        std::shared_ptr<const Sinks> m_sinks = std::make_shared<const Sinks>();
+        std::atomic<bool> m_active{false};
+        // The sinks belong to the parent: a forked child publishes nothing.
+        ForkGuard m_fork_guard{m_mutex, [this] {
+            m_sinks = std::make_shared<const Sinks>();
+            m_active.store(false, std::memory_order_relaxed);
+        }};
+
+    public:
+        /// Unsubscribes a sink when destroyed.
+        class Subscription {
+            EventBus *m_bus = nullptr;
+            const EventSink *m_sink = nullptr;
+
+        public:
+            Subscription() = default;
+            Subscription(EventBus &bus, const EventSink *sink) : m_bus(&bus), m_sink(sink) {}
+            Subscription(Subscription &&other) noexcept
+                : m_bus(std::exchange(other.m_bus, nullptr)), m_sink(other.m_sink) {}
+            Subscription &operator=(Subscription &&other) noexcept {
+                if (this != &other) {
+                    reset();
+                    m_bus = std::exchange(other.m_bus, nullptr);
+                    m_sink = other.m_sink;
+                }
+                return *this;
+            }
+            ~Subscription() { reset(); }
+
+            /// @brief Unsubscribe now.
+            void reset() {
+                if (m_bus) std::exchange(m_bus, nullptr)->unsubscribe(m_sink);
+            }
+        };
+
+        /// @brief The bus of the test framework.
+        static EventBus &global() {
+            static EventBus bus;
+            return bus;
+        }
+
+        /// @brief Deliver later events to `sink` until it is unsubscribed; null is ignored.
+        void subscribe(std::shared_ptr<EventSink> sink) {
+            if (!sink) return;
+            std::lock_guard lock(m_mutex);
+            auto sinks = std::make_shared<Sinks>(*m_sinks);
+            sinks->push_back(std::move(sink));
+            m_sinks = std::move(sinks);
+            m_active.store(true, std::memory_order_release);
+        }
+
+        /// @brief Subscribe `sink` until the returned subscription is destroyed.
+        [[nodiscard]] Subscription scoped(std::shared_ptr<EventSink> sink) {
+            const EventSink *key = sink.get();
+            subscribe(std::move(sink));
+            return {*this, key};
+        }
+
+        /// @brief Stop delivering events to `sink`.
+        void unsubscribe(const EventSink *sink) {
+            std::lock_guard lock(m_mutex);
+            auto sinks = std::make_shared<Sinks>(*m_sinks);
+            std::erase_if(*sinks, [sink](const auto &s) { return s.get() == sink; });
+            m_active.store(!sinks->empty(), std::memory_order_release);
+            m_sinks = std::move(sinks);
+        }
+
+        /// @brief Whether any sink is subscribed; lets publishers skip building events.
+        [[nodiscard]] bool has_subscribers() const noexcept { return m_active.load(std::memory_order_acquire); }
+
+        /// @brief Hand `event` to every subscribed sink, in subscription order.
+        void publish(const Event &event) const {
+            if (!has_subscribers()) return;
+            std::shared_ptr<const Sinks> sinks;
+            {
+                std::lock_guard lock(m_mutex);
+                sinks = m_sinks;
+            }
+            for (const auto &sink: *sinks) sink->on_event(event);
+        }
+    };
+
+    /**
+     * @brief Metrics sink: counts events without formatting anything.
+     *
+     * Lock-free; read the counts at any time, e.g. from a progress display.
+     */
+    class EventCounter final : public EventSink {
+        std::atomic<std::int64_t> m_suites{0};
+        std::atomic<std::int64_t> m_passed{0};
+        std::atomic<std::int64_t> m_failed{0};
+        std::atomic<std::int64_t> m_crashed{0};
+        std::atomic<std::int64_t> m_timed_out{0};
+        std::atomic<std::int64_t> m_cached{0};
+        std::atomic<std::int64_t> m_failed_assertions{0};
+        std::atomic<std::int64_t> m_body_ns{0};
+
+    public:
+        void on_event(const Event &event) override {
+            switch (event.kind) {
+                case EventKind::SuiteStarted:
+                    m_suites.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case EventKind::TestFinished: {
+                    const std::string_view status = event.status;
+                    if (status == "PASS") m_passed.fetch_add(1, std::memory_order_relaxed);
+                    else if (status == "FAIL") m_failed.fetch_add(1, std::memory_order_relaxed);
+                    else if (status == "CRASH") m_crashed.fetch_add(1, std::memory_order_relaxed);
+                    else if (status == "TIMEOUT") m_timed_out.fetch_add(1, std::memory_order_relaxed);
+                    else if (status == "CACHED") m_cached.fetch_add(1, std::memory_order_relaxed);
+                    if (event.timing) m_body_ns.fetch_add(event.timing->body_ns, std::memory_order_relaxed);
+                    break;
+                }
+                case EventKind::AssertionFailed:
+                    m_failed_assertions.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        [[nodiscard]] std::int64_t suites() const noexcept { return m_suites.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t passed() const noexcept { return m_passed.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t failed() const noexcept { return m_failed.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t crashed() const noexcept { return m_crashed.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t timed_out() const noexcept { return m_timed_out.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t cached() const noexcept { return m_cached.load(std::memory_order_relaxed); }
+
+        /// @brief Finished tests and parameter cases, whatever their status.
+        [[nodiscard]] std::int64_t finished() const noexcept {
+            return passed() + failed() + crashed() + timed_out() + cached();
+        }
+
+        [[nodiscard]] std::int64_t failed_assertions() const noexcept {
+            return m_failed_assertions.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Summed body time of the finished tests.
+        [[nodiscard]] std::int64_t body_ns() const noexcept { return m_body_ns.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Text sink: formats events as log lines of a Logger.
+     *
+     * The console output of a session comes from its own logger; this
+     * sink sends the same information elsewhere, e.g. to a log file.
+     */
+    class LoggerEventSink final : public EventSink {
+        std::shared_ptr<Logger> m_logger;
+
+    public:
+        explicit LoggerEventSink(std::shared_ptr<Logger> logger) : m_logger(std::move(logger)) {}
+
+        void on_event(const Event &event) override {
+            switch (event.kind) {
+                case EventKind::SessionStarted:
+                    m_logger->log("Starting test session: " + std::to_string(event.value) + " suites",
+                                  Logger::Tag::Info);
+                    break;
+                case EventKind::RunPlanned:
+                    m_logger->log("Planned " + std::to_string(event.plan ? event.plan->tests : 0) + " tests",
+                                  Logger::Tag::Info);
+                    break;
+                case EventKind::SuiteStarted:
+                    m_logger->log("Running test suite: " + std::string(event.suite), Logger::Tag::Info);
+                    break;
+                case EventKind::TestStarted:
+                    break;
+                case EventKind::TestFinished: {
+                    std::string line = std::string(event.suite) + "." + std::string(event.test);
+                    if (event.timing) line += " " + event.timing->summary();
+                    m_logger->log(line, Logger::tag_of(event.status));
+                    break;
+                }
+                case EventKind::AssertionFailed:
+                    m_logger->log(std::string(event.text), Logger::Tag::Fail);
+                    break;
+                case EventKind::SessionFinished:
+                    m_logger->log("Finished test session: " + std::to_string(event.value) + " failed",
+                                  Logger::Tag::Info);
+                    break;
+            }
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_EVENTS_HPP
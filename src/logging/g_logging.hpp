@@ -2,6 +2,7 @@
 #define G_LOGGING_HPP
 #include "global_base.hpp"
 #include "logging.hpp"
+#include "assert_logger.hpp"
 
 namespace Fortest {
 
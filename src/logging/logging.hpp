@@ -1,13 +1,21 @@
 #ifndef LOGGING_HPP
 #define LOGGING_HPP
 
+#include <array>
 #include <concepts>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <optional>
 
+#include "async_writer.hpp"
+#include "fork_guard.hpp"
+
 namespace Fortest {
     /**
      * @brief Concept to define a Logger-like interface.
@@ -31,7 +39,9 @@ namespace Fortest {
      *
      * The Logger class provides functionality to log messages with different
      * tags (e.g., PASS, FAIL, INFO) and optional borders. It supports color
-     * formatting for terminal output.
+     * formatting for terminal output. Output goes straight to the stream,
+     * or, once an AsyncWriter is attached, into the writer's ring buffer
+     * to be written by its background thread.
      */
     class Logger {
     public:
@@ -64,11 +74,56 @@ namespace Fortest {
             : m_out(m_out), m_border(std::move(m_border)), m_color(m_color) {
         }
 
+        /**
+         * @brief Tags with their own format; any other tag logs the bare message.
+         */
+        enum class Tag {
+            Pass, /**< PASS, green. */
+            Fail, /**< FAIL, red; written before log() returns. */
+            Crash, /**< CRASH, magenta; written before log() returns. */
+            Timeout, /**< TIMEOUT, yellow; written before log() returns. */
+            Info, /**< INFO, default color. */
+            True, /**< TRUE, green. */
+            False, /**< FALSE, red. */
+            Plain /**< No label and no color. */
+        };
+
+        /**
+         * @brief The Tag named by a tag string; unknown names are Tag::Plain.
+         */
+        static constexpr Tag tag_of(std::string_view tag) noexcept {
+            if (tag == "PASS") return Tag::Pass;
+            if (tag == "FAIL") return Tag::Fail;
+            if (tag == "CRASH") return Tag::Crash;
+            if (tag == "TIMEOUT") return Tag::Timeout;
+            if (tag == "INFO") return Tag::Info;
+            if (tag == "TRUE") return Tag::True;
+            if (tag == "FALSE") return Tag::False;
+            return Tag::Plain;
+        }
+
+        /**
+         * @brief The name of a Tag, as it is printed.
+         */
+        static constexpr std::string_view tag_name(Tag tag) noexcept {
+            switch (tag) {
+                case Tag::Pass: return "PASS";
+                case Tag::Fail: return "FAIL";
+                case Tag::Crash: return "CRASH";
+                case Tag::Timeout: return "TIMEOUT";
+                case Tag::Info: return "INFO";
+                case Tag::True: return "TRUE";
+                case Tag::False: return "FALSE";
+                default: return "PLAIN";
+            }
+        }
+
         /**
          * @brief Logs a message with a specific tag and optional border.
          *
          * Depending on the tag, the message is formatted with a specific color.
-         * Supported tags include PASS, FAIL, INFO, TRUE, and FALSE.
+         * Supported tags include PASS, FAIL, CRASH, TIMEOUT, INFO, TRUE, and FALSE.
+         * Safe to call concurrently; each message is written as a unit.
          *
          * @param msg The message to log.
          * @param tag The tag associated with the message.
@@ -79,21 +134,60 @@ namespace Fortest {
             const std::string &tag,
             const std::optional<std::string> &border = std::nullopt
         ) {
+            const Tag parsed = tag_of(tag);
+            std::lock_guard lock(m_mutex);
             m_last_msg = msg;
             m_last_tag = tag;
+            write_tagged(msg, parsed, border);
+        }
 
-            if (tag == "PASS") {
-                log_with_format("PASS", msg, Color::GREEN, border);
-            } else if (tag == "FAIL") {
-                log_with_format("FAIL", msg, Color::RED, border);
-            } else if (tag == "INFO") {
-                log_with_format("INFO", msg, Color::DEFAULT, border);
-            } else if (tag == "TRUE") {
-                log_with_format("TRUE", msg, Color::GREEN, border);
-            } else if (tag == "FALSE") {
-                log_with_format("FALSE", msg, Color::RED, border);
+        /**
+         * @brief Logs a message with a typed tag, without comparing tag strings.
+         *
+         * @param msg The message to log.
+         * @param tag The tag associated with the message.
+         * @param border An optional border string to override the default border.
+         */
+        void log(
+            const std::string &msg,
+            Tag tag,
+            const std::optional<std::string> &border = std::nullopt
+        ) {
+            std::lock_guard lock(m_mutex);
+            m_last_msg = msg;
+            m_last_tag = tag_name(tag);
+            write_tagged(msg, tag, border);
+        }
+
+        /**
+         * @brief Route output through an asynchronous writer.
+         *
+         * Failures (FAIL, CRASH, TIMEOUT) are still on the stream when
+         * log() returns; other messages are written by the writer's
+         * background thread.
+         *
+         * @param writer Writer draining to this logger's stream, or nullptr
+         *        to write synchronously again.
+         */
+        void set_async_writer(std::shared_ptr<AsyncWriter> writer) {
+            std::lock_guard lock(m_mutex);
+            if (m_async) m_async->flush();
+            m_async = std::move(writer);
+        }
+
+        /// @brief The attached asynchronous writer, or nullptr.
+        [[nodiscard]] std::shared_ptr<AsyncWriter> get_async_writer() const {
+            std::lock_guard lock(m_mutex);
+            return m_async;
+        }
+
+        /// @brief Block until all output logged so far has reached the stream.
+        void flush() {
+            std::lock_guard lock(m_mutex);
+            if (m_async) {
+                m_async->flush();
             } else {
-                m_out << msg << '\n';
+                m_out.flush();
             }
         }
 
@@ -101,9 +195,9 @@ namespace Fortest {
          * @brief Converts a Color enum value to its corresponding ANSI escape code.
          *
          * @param c The Color enum value.
-         * @return The ANSI escape code as a string.
+         * @return The ANSI escape code.
          */
-        static std::string color_to_code(Color c) {
+        static constexpr std::string_view color_to_code(Color c) {
             switch (c) {
                 case Color::RED: return "\033[31m";
                 case Color::GREEN: return "\033[32m";
@@ -141,6 +235,45 @@ namespace Fortest {
 
         std::string m_last_msg; /**< The last logged message. */
         std::string m_last_tag; /**< The tag associated with the last logged message. */
+        std::shared_ptr<AsyncWriter> m_async; /**< Optional asynchronous backend. */
+        mutable std::mutex m_mutex; /**< Serializes concurrent log calls. */
+        ForkGuard m_fork_guard{m_mutex}; /**< Keeps log() usable in forked children. */
+
+        /**
+         * @brief Write one message, given as consecutive pieces.
+         *
+         * @param parts The pieces of the message.
+         * @param urgent Whether an asynchronous writer must flush before returning.
+         */
+        void emit(std::span<const std::string_view> parts, bool urgent) {
+            if (m_async) {
+                m_async->write(parts, urgent);
+                return;
+            }
+            for (const auto part: parts) {
+                m_out.write(part.data(), static_cast<std::streamsize>(part.size()));
+            }
+        }
+
+        /**
+         * @brief Write one message in the format of its tag.
+         */
+        void write_tagged(const std::string &msg, Tag tag, const std::optional<std::string> &border) {
+            switch (tag) {
+                case Tag::Pass: log_with_format("PASS", msg, Color::GREEN, border); break;
+                case Tag::Fail: log_with_format("FAIL", msg, Color::RED, border, true); break;
+                case Tag::Crash: log_with_format("CRASH", msg, Color::MAGENTA, border, true); break;
+                case Tag::Timeout: log_with_format("TIMEOUT", msg, Color::YELLOW, border, true); break;
+                case Tag::Info: log_with_format("INFO", msg, Color::DEFAULT, border); break;
+                case Tag::True: log_with_format("TRUE", msg, Color::GREEN, border); break;
+                case Tag::False: log_with_format("FALSE", msg, Color::RED, border); break;
+                case Tag::Plain: {
+                    const std::array<std::string_view, 2> parts{msg, "\n"};
+                    emit(parts, false);
+                    break;
+                }
+            }
+        }
 
         /**
          * @brief Logs a message with a specific format and color.
@@ -149,30 +282,52 @@ namespace Fortest {
          * @param msg The message to log.
          * @param color The color to use for the message.
          * @param border_override An optional border string to override the default border.
+         * @param urgent Whether the message reports a failure.
          */
         void log_with_format(
-            const std::string &label,
+            std::string_view label,
             const std::string &msg,
             Color color,
-            const std::optional<std::string> &border_override
+            const std::optional<std::string> &border_override,
+            bool urgent = false
         ) {
             m_color = color;
-            std::string color_code = color_to_code(m_color);
-            std::string reset_code = "\033[0m";
+            constexpr std::string_view reset_code = "\033[0m";
+            const std::string_view color_code = color_to_code(m_color);
 
             // pick effective border
-            const std::string &effective_border =
+            const std::string_view effective_border =
                     border_override.has_value() ? *border_override : m_border;
 
+            std::array<std::string_view, 14> parts;
+            std::size_t n = 0;
             if (!effective_border.empty()) {
-                m_out << color_code << effective_border << reset_code << '\n';
+                for (auto part: {color_code, effective_border, reset_code, std::string_view("\n")}) {
+                    parts[n++] = part;
+                }
+            }
+            for (auto part: {color_code, std::string_view("["), label, std::string_view("] "),
+                             std::string_view(msg), reset_code, std::string_view("\n")}) {
+                parts[n++] = part;
             }
-            m_out << color_code << "[" << label << "] " << msg << reset_code << '\n';
-            if (!effective_border.empty() && !m_border.empty() ) {
-                m_out << color_code << reset_code << '\n';
+            if (!effective_border.empty() && !m_border.empty()) {
+                for (auto part: {color_code, reset_code, std::string_view("\n")}) {
+                    parts[n++] = part;
+                }
             }
+            emit(std::span(parts.data(), n), urgent);
         }
     };
+
+    /**
+     * @brief Separator logged before every test.
+     *
+     * A single shared instance, so that logging it allocates nothing.
+     */
+    inline const std::optional<std::string> &test_border() {
+        static const std::optional<std::string> border{"\n" + std::string(40, '=')};
+        return border;
+    }
 }
 
 #endif // LOGGING_HPP
@@ -0,0 +1,374 @@
+#ifndef FORTEST_PROGRESS_HPP
+#define FORTEST_PROGRESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "events.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Live progress of a run, built from its events.
+     *
+     * @details
+     * Handling an event takes a short critical section and copies a name
+     * only when a test starts or is among the slowest; nothing is
+     * formatted until a snapshot is taken. With a path, a background
+     * thread writes the snapshot in the Prometheus text format every
+     * `interval` and once more when the session finishes, replacing the
+     * file atomically so readers never see a partial one. The file suits
+     * the textfile collector of the Prometheus node exporter, or
+     * `watch cat`.
+     *
+     * Running tests occupy numbered worker slots: a test takes the lowest
+     * free slot when it starts and frees it when it finishes, so threads
+     * and forked children are shown alike.
+     */
+    class ProgressMonitor final : public EventSink {
+    public:
+        /// A test or parameter case that has started and not yet finished.
+        struct Running {
+            std::size_t worker = 0;     //!< Slot of the test
+            std::string suite;          //!< Suite of the test
+            std::string test;           //!< Test or parameter case
+            std::int64_t elapsed_ns = 0; //!< Time since it started
+        };
+
+        /// A finished test, by duration.
+        struct Finished {
+            std::string suite;         //!< Suite of the test
+            std::string test;          //!< Test or parameter case
+            std::int64_t total_ns = 0; //!< Its setup, body and teardown time
+        };
+
+        /// Progress at one instant.
+        struct Snapshot {
+            bool running = false;             //!< Whether the session is still running
+            std::int64_t planned = 0;         //!< Tests and parameter cases the run publishes results of
+            std::int64_t passed = 0;          //!< Finished with PASS
+            std::int64_t failed = 0;          //!< Finished with FAIL
+            std::int64_t crashed = 0;         //!< Finished with CRASH
+            std::int64_t timed_out = 0;       //!< Finished with TIMEOUT
+            std::int64_t cached = 0;          //!< Reported as CACHED without running
+            std::int64_t failed_assertions = 0; //!< Failed assertions so far
+            std::int64_t elapsed_ns = 0;      //!< Time since the session started
+            std::int64_t eta_ns = -1;         //!< Expected time until the last test finishes; -1 if unknown
+            std::vector<Running> workers;     //!< Running tests, by worker slot
+            std::vector<Finished> slowest;    //!< Slowest finished tests, slowest first
+
+            /// @brief Finished tests and parameter cases, whatever their status.
+            [[nodiscard]] std::int64_t finished() const noexcept {
+                return passed + failed + crashed + timed_out + cached;
+            }
+
+            /// @brief Planned tests that have not finished; 0 if the plan is unknown.
+            [[nodiscard]] std::int64_t remaining() const noexcept { return std::max<std::int64_t>(planned - finished(), 0); }
+        };
+
+        /**
+         * @brief Follow a run, writing snapshots to `path` if it is not empty.
+         * @param path File receiving the snapshots; empty keeps them in memory only.
+         * @param interval Time between two writes of the file.
+         * @param num_slowest Number of slowest tests kept.
+         */
+        explicit ProgressMonitor(std::filesystem::path path = {},
+                                 std::chrono::milliseconds interval = std::chrono::seconds(1),
+                                 std::size_t num_slowest = 10)
+            : m_path(std::move(path)), m_interval(std::max(interval, std::chrono::milliseconds(1))),
+              m_num_slowest(num_slowest) {
+            if (!m_path.empty()) m_writer = std::thread([this] { write_loop(); });
+        }
+
+        ProgressMonitor(const ProgressMonitor &) = delete;
+        ProgressMonitor &operator=(const ProgressMonitor &) = delete;
+
+        /// @brief Stop the background thread, after writing a last snapshot.
+        ~ProgressMonitor() override {
+            if (!m_writer.joinable()) return;
+            {
+                std::lock_guard lock(m_wake_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            m_writer.join();
+        }
+
+        void on_event(const Event &event) override {
+            const auto now = std::chrono::steady_clock::now();
+            std::lock_guard lock(m_mutex);
+            switch (event.kind) {
+                case EventKind::SessionStarted:
+                    reset(now);
+                    break;
+                case EventKind::RunPlanned:
+                    if (event.plan) m_plan = *event.plan;
+                    break;
+                case EventKind::TestStarted:
+                    start(event.suite, event.test, now);
+                    break;
+                case EventKind::TestFinished:
+                    finish(event, now);
+                    break;
+                case EventKind::AssertionFailed:
+                    ++m_failed_assertions;
+                    break;
+                case EventKind::SessionFinished:
+                    m_running = false;
+                    m_finished_at = now;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        /// @brief Write the current snapshot now, if there is a path.
+        void flush() override {
+            if (!m_path.empty()) write();
+        }
+
+        /// @brief The progress of the run so far.
+        [[nodiscard]] Snapshot snapshot() const {
+            const auto now = std::chrono::steady_clock::now();
+            std::lock_guard lock(m_mutex);
+            Snapshot s;
+            s.running = m_running;
+            s.planned = m_plan.tests;
+            s.passed = m_passed;
+            s.failed = m_failed;
+            s.crashed = m_crashed;
+            s.timed_out = m_timed_out;
+            s.cached = m_cached;
+            s.failed_assertions = m_failed_assertions;
+            s.elapsed_ns = ns_between(m_started_at, m_running ? now : m_finished_at);
+            s.eta_ns = eta_ns(s);
+            for (std::size_t w = 0; w < m_slots.size(); ++w) {
+                const Slot &slot = m_slots[w];
+                if (slot.busy) s.workers.push_back({w, slot.suite, slot.test, ns_between(slot.started_at, now)});
+            }
+            s.slowest = m_slowest;
+            return s;
+        }
+
+        /// @brief `snapshot` in the Prometheus text exposition format.
+        [[nodiscard]] static std::string prometheus(const Snapshot &snapshot) {
+            std::string out;
+            const auto metric = [&out](std::string_view name, std::string_view type, std::string_view help) {
+                out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+                out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+            };
+            const auto sample = [&out](std::string_view name, std::string_view labels, const std::string &value) {
+                out.append(name);
+                if (!labels.empty()) out.append("{").append(labels).append("}");
+                out.append(" ").append(value).append("\n");
+            };
+            const auto seconds = [](std::int64_t ns) { return format_double(static_cast<double>(ns) * 1e-9); };
+
+            metric("fortest_session_running", "gauge", "Whether the test session is running.");
+            sample("fortest_session_running", "", snapshot.running ? "1" : "0");
+            metric("fortest_tests_planned", "gauge", "Tests and parameter cases of the run.");
+            sample("fortest_tests_planned", "", std::to_string(snapshot.planned));
+            metric("fortest_tests_finished", "gauge", "Finished tests and parameter cases by status.");
+            sample("fortest_tests_finished", "status=\"PASS\"", std::to_string(snapshot.passed));
+            sample("fortest_tests_finished", "status=\"FAIL\"", std::to_string(snapshot.failed));
+            sample("fortest_tests_finished", "status=\"CRASH\"", std::to_string(snapshot.crashed));
+            sample("fortest_tests_finished", "status=\"TIMEOUT\"", std::to_string(snapshot.timed_out));
+            sample("fortest_tests_finished", "status=\"CACHED\"", std::to_string(snapshot.cached));
+            metric("fortest_tests_remaining", "gauge", "Planned tests and parameter cases not yet finished.");
+            sample("fortest_tests_remaining", "", std::to_string(snapshot.remaining()));
+            metric("fortest_failed_assertions", "gauge", "Failed assertions so far.");
+            sample("fortest_failed_assertions", "", std::to_string(snapshot.failed_assertions));
+            metric("fortest_elapsed_seconds", "gauge", "Time since the session started.");
+            sample("fortest_elapsed_seconds", "", seconds(snapshot.elapsed_ns));
+            metric("fortest_eta_seconds", "gauge", "Expected time until the last test finishes; NaN if unknown.");
+            sample("fortest_eta_seconds", "", snapshot.eta_ns < 0 ? "NaN" : seconds(snapshot.eta_ns));
+            metric("fortest_running_test_seconds", "gauge", "Time the test of each busy worker has been running.");
+            for (const Running &r : snapshot.workers) {
+                sample("fortest_running_test_seconds",
+                       "worker=\"" + std::to_string(r.worker) + "\",suite=\"" + label_value(r.suite) +
+                           "\",test=\"" + label_value(r.test) + "\"",
+                       seconds(r.elapsed_ns));
+            }
+            metric("fortest_slowest_test_seconds", "gauge", "Durations of the slowest finished tests.");
+            for (std::size_t i = 0; i < snapshot.slowest.size(); ++i) {
+                const Finished &f = snapshot.slowest[i];
+                sample("fortest_slowest_test_seconds",
+                       "rank=\"" + std::to_string(i + 1) + "\",suite=\"" + label_value(f.suite) + "\",test=\"" +
+                           label_value(f.test) + "\"",
+                       seconds(f.total_ns));
+            }
+            return out;
+        }
+
+        /// @brief Write the current snapshot to the path, through a temporary file.
+        void write() const {
+            const std::string text = prometheus(snapshot());
+            std::lock_guard lock(m_write_mutex);
+            std::filesystem::path temporary = m_path;
+            temporary += ".tmp";
+            {
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                if (!(out << text)) return;
+            }
+            std::error_code error;
+            std::filesystem::rename(temporary, m_path, error);
+        }
+
+    private:
+        /// A worker slot.
+        struct Slot {
+            bool busy = false;
+            std::string suite;
+            std::string test;
+            std::chrono::steady_clock::time_point started_at{};
+        };
+
+        std::filesystem::path m_path;
+        std::chrono::milliseconds m_interval;
+        std::size_t m_num_slowest;
+
+        mutable std::mutex m_mutex;
+        bool m_running = false;
+        std::chrono::steady_clock::time_point m_started_at = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point m_finished_at = m_started_at;
+        RunPlan m_plan{.workers = 0};
+        std::int64_t m_passed = 0;
+        std::int64_t m_failed = 0;
+        std::int64_t m_crashed = 0;
+        std::int64_t m_timed_out = 0;
+        std::int64_t m_cached = 0;
+        std::int64_t m_failed_assertions = 0;
+        std::int64_t m_done_ns = 0;
+        std::vector<Slot> m_slots;
+        std::vector<Finished> m_slowest;
+
+        mutable std::mutex m_write_mutex;
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake;
+        bool m_stop = false;
+        std::thread m_writer;
+
+        [[nodiscard]] static std::int64_t ns_between(std::chrono::steady_clock::time_point from,
+                                                     std::chrono::steady_clock::time_point to) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+        }
+
+        void reset(std::chrono::steady_clock::time_point now) {
+            m_running = true;
+            m_started_at = m_finished_at = now;
+            m_plan = RunPlan{.workers = 0};
+            m_passed = m_failed = m_crashed = m_timed_out = m_cached = m_failed_assertions = m_done_ns = 0;
+            for (Slot &slot : m_slots) slot.busy = false;
+            m_slowest.clear();
+        }
+
+        void start(std::string_view suite, std::string_view test, std::chrono::steady_clock::time_point now) {
+            auto slot = std::find_if(m_slots.begin(), m_slots.end(), [](const Slot &s) { return !s.busy; });
+            if (slot == m_slots.end()) slot = m_slots.emplace(m_slots.end());
+            slot->busy = true;
+            slot->suite.assign(suite);
+            slot->test.assign(test);
+            slot->started_at = now;
+        }
+
+        void finish(const Event &event, std::chrono::steady_clock::time_point now) {
+            const std::string_view status = event.status;
+            if (status == "PASS") ++m_passed;
+            else if (status == "FAIL") ++m_failed;
+            else if (status == "CRASH") ++m_crashed;
+            else if (status == "TIMEOUT") ++m_timed_out;
+            else if (status == "CACHED") ++m_cached;
+
+            std::int64_t total_ns = 0;
+            const auto slot = std::find_if(m_slots.begin(), m_slots.end(), [&](const Slot &s) {
+                return s.busy && s.test == event.test && s.suite == event.suite;
+            });
+            if (slot != m_slots.end()) {
+                slot->busy = false;
+                total_ns = ns_between(slot->started_at, now);
+            }
+            // Forked tests report their own durations; in-process ones match their slot's.
+            if (event.timing) total_ns = event.timing->total_ns();
+            m_done_ns += total_ns;
+
+            if (m_num_slowest == 0) return;
+            if (m_slowest.size() == m_num_slowest && total_ns <= m_slowest.back().total_ns) return;
+            const auto at = std::upper_bound(m_slowest.begin(), m_slowest.end(), total_ns,
+                                             [](std::int64_t ns, const Finished &f) { return ns > f.total_ns; });
+            m_slowest.insert(at, Finished{std::string(event.suite), std::string(event.test), total_ns});
+            if (m_slowest.size() > m_num_slowest) m_slowest.pop_back();
+        }
+
+        /**
+         * @brief Expected time until the last planned test finishes.
+         *
+         * The expected work of the plan, from past runs, less the work
+         * done so far, or while that is exceeded, the remaining tests at
+         * the mean duration of the finished ones; shared by the workers.
+         */
+        [[nodiscard]] std::int64_t eta_ns(const Snapshot &s) const {
+            if (!m_running) return 0;
+            if (m_plan.tests <= 0) return -1;
+            const std::int64_t finished = s.finished();
+            if (finished >= m_plan.tests) return 0;
+            std::int64_t work_ns = 0;
+            if (m_plan.expected_ns > m_done_ns) {
+                work_ns = m_plan.expected_ns - m_done_ns;
+            } else if (finished > 0) {
+                work_ns = static_cast<std::int64_t>(static_cast<double>(m_done_ns) / static_cast<double>(finished) *
+                                                    static_cast<double>(m_plan.tests - finished));
+            } else {
+                return -1;
+            }
+            const std::int64_t workers = m_plan.workers > 0
+                                             ? m_plan.workers
+                                             : std::max<std::int64_t>(static_cast<std::int64_t>(m_slots.size()), 1);
+            return work_ns / workers;
+        }
+
+        void write_loop() {
+            std::unique_lock lock(m_wake_mutex);
+            while (!m_wake.wait_for(lock, m_interval, [this] { return m_stop; })) {
+                lock.unlock();
+                write();
+                lock.lock();
+            }
+            // Also when the session ended before this thread first waited.
+            lock.unlock();
+            write();
+        }
+
+        [[nodiscard]] static std::string format_double(double value) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof buffer, "%.6f", value);
+            return buffer;
+        }
+
+        /// @brief `text` escaped as a Prometheus label value.
+        [[nodiscard]] static std::string label_value(std::string_view text) {
+            std::string out;
+            out.reserve(text.size());
+            for (const char c : text) {
+                if (c == '\\') out += "\\\\";
+                else if (c == '"') out += "\\\"";
+                else if (c == '\n') out += "\\n";
+                else out += c;
+            }
+            return out;
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_PROGRESS_HPP
@@ -0,0 +1 @@
+#include "c_mpi.h"
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef FORTEST_C_MPI_H
+#define FORTEST_C_MPI_H
+
+#include <mpi.h>
+
+#include "c_test_session.h"
+#include "mpi_case_distributor.hpp"
+#include "mpi_session_distribution.hpp"
+
+extern "C" {
+
+/**
+ * @brief Share the cases of every parameterized test of the global
+ * session among the ranks of a communicator.
+ *
+ * Every rank must register the same tests and run the session. Each
+ * case then runs on one rank only, and the results of all ranks are
+ * merged into every rank's session.
+ *
+ * @param comm Fortran handle of the communicator (`MPI_Fint`), e.g.
+ *             `MPI_COMM_WORLD` or `comm%MPI_VAL` with `mpi_f08`.
+ */
+void c_distribute_parameterized_tests(MPI_Fint comm) {
+    try {
+        Fortest::GlobalTestSession::instance().set_case_distribution(
+            Fortest::mpi_case_distribution(MPI_Comm_f2c(comm)));
+    } catch (...) {
+        fortest_fatal_terminate("c_distribute_parameterized_tests");
+    }
+}
+
+/**
+ * @brief Share all tests of the global session among the ranks of a communicator.
+ *
+ * Every rank must register the same tests and run the session. Each
+ * regular test runs on one rank, collective tests on all of them, and
+ * parameterized cases are shared as by c_distribute_parameterized_tests().
+ * Every rank then reports the same results, so c_get_session_status()
+ * gives the same exit code everywhere; only rank 0 logs the session and
+ * writes the results database.
+ *
+ * @param comm Fortran handle of the communicator (`MPI_Fint`).
+ */
+void c_distribute_tests(MPI_Fint comm) {
+    try {
+        Fortest::GlobalTestSession::instance().set_distribution(
+            std::make_shared<Fortest::MpiSessionDistribution>(MPI_Comm_f2c(comm)));
+    } catch (...) {
+        fortest_fatal_terminate("c_distribute_tests");
+    }
+}
+
+} // extern "C"
+
+#endif // FORTEST_C_MPI_H
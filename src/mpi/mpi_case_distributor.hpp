@@ -0,0 +1,167 @@
+#ifndef FORTEST_MPI_CASE_DISTRIBUTOR_HPP
+#define FORTEST_MPI_CASE_DISTRIBUTOR_HPP
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "case_distributor.hpp"
+#include "status_counts.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Serializes the MPI calls made by the distributors of a process.
+     *
+     * Workers of a thread pool draw chunks concurrently, so running with
+     * more than one worker needs at least `MPI_THREAD_SERIALIZED`.
+     */
+    inline std::mutex &mpi_call_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    /**
+     * @brief Shares the cases of a parameterized test among the ranks of a communicator.
+     *
+     * @details
+     * The next unclaimed case lives in an MPI window on rank 0. Workers
+     * on every rank claim guided chunks from it with `MPI_Fetch_and_op`,
+     * so ranks that drew cheap cases simply come back for more. Once the
+     * local workers are done, merge() combines the statuses with an
+     * `MPI_Allreduce`: every case ran on exactly one rank and is NONE on
+     * the others, so the most severe status per case is the real one.
+     * Durations are summed over the ranks.
+     *
+     * Construction and merge() are collective over the communicator, so
+     * every rank must run the same parameterized tests in the same order.
+     */
+    class MpiCaseDistributor final : public CaseDistributor {
+        MPI_Comm m_comm;
+        MPI_Win m_window = MPI_WIN_NULL;
+        std::int64_t *m_next = nullptr;  //!< First unclaimed case; allocated on rank 0 only
+        std::size_t m_num_cases;
+        std::size_t m_workers;           //!< Workers on all ranks
+        std::size_t m_chunk;
+        std::size_t m_claimed = 0;       //!< End of this rank's last claim, to size the next
+
+        void check(int code, const char *call) const {
+            if (code != MPI_SUCCESS) {
+                throw std::runtime_error(std::string("MpiCaseDistributor: ") + call + " failed");
+            }
+        }
+
+    public:
+        /**
+         * @param comm Communicator whose ranks share the cases.
+         * @param num_cases Number of cases of the test.
+         * @param workers Number of workers on each rank.
+         * @param chunk Fixed chunk size, or 0 for guided sizing.
+         * @throws std::runtime_error if several workers are requested and
+         *         MPI does not allow calls from more than one thread.
+         */
+        MpiCaseDistributor(MPI_Comm comm, std::size_t num_cases, std::size_t workers, std::size_t chunk)
+            : m_comm(comm), m_num_cases(num_cases), m_chunk(chunk) {
+            std::lock_guard lock(mpi_call_mutex());
+            int rank = 0;
+            int size = 1;
+            MPI_Comm_rank(comm, &rank);
+            MPI_Comm_size(comm, &size);
+            m_workers = workers * static_cast<std::size_t>(size);
+            if (workers > 1) {
+                int provided = MPI_THREAD_SINGLE;
+                MPI_Query_thread(&provided);
+                if (provided < MPI_THREAD_SERIALIZED) {
+                    throw std::runtime_error(
+                        "MpiCaseDistributor: several workers per rank need MPI_THREAD_SERIALIZED");
+                }
+            }
+            const MPI_Aint bytes = rank == 0 ? sizeof(std::int64_t) : 0;
+            check(MPI_Win_allocate(bytes, sizeof(std::int64_t), MPI_INFO_NULL, comm, &m_next, &m_window),
+                  "MPI_Win_allocate");
+            MPI_Win_lock_all(0, m_window);
+            if (rank == 0) {
+                *m_next = 0;
+                MPI_Win_sync(m_window);
+            }
+            MPI_Barrier(comm);
+        }
+
+        // A window still open here means merge() was skipped, e.g. by an
+        // exception; freeing it is collective and could hang, so it is left
+        // to MPI_Finalize.
+        ~MpiCaseDistributor() override = default;
+
+        MpiCaseDistributor(const MpiCaseDistributor &) = delete;
+        MpiCaseDistributor &operator=(const MpiCaseDistributor &) = delete;
+
+        std::optional<CaseChunk> next() override {
+            std::lock_guard lock(mpi_call_mutex());
+            if (m_window == MPI_WIN_NULL) return std::nullopt;
+            const std::size_t remaining = m_num_cases - std::min(m_claimed, m_num_cases);
+            const auto take = static_cast<std::int64_t>(guided_chunk_size(remaining, m_workers, m_chunk));
+            std::int64_t begin = 0;
+            MPI_Fetch_and_op(&take, &begin, MPI_INT64_T, 0, 0, MPI_SUM, m_window);
+            MPI_Win_flush(0, m_window);
+            const auto first = static_cast<std::size_t>(begin);
+            m_claimed = first + static_cast<std::size_t>(take);
+            if (first >= m_num_cases) return std::nullopt;
+            return CaseChunk{first, std::min(m_claimed, m_num_cases)};
+        }
+
+        [[nodiscard]] bool is_distributed() const noexcept override { return true; }
+
+        void merge(ParameterizedTest &test) override {
+            std::lock_guard lock(mpi_call_mutex());
+            if (m_window != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(m_window);
+                MPI_Win_free(&m_window);
+            }
+
+            test.prepare_results();
+            const auto &statuses = test.get_case_statuses();
+            std::vector<std::uint8_t> severities(statuses.size());
+            for (std::size_t k = 0; k < statuses.size(); ++k) severities[k] = status_severity(statuses[k]);
+            constexpr std::size_t max_count = std::numeric_limits<int>::max();
+            for (std::size_t offset = 0; offset < severities.size(); offset += max_count) {
+                const auto count = static_cast<int>(std::min(max_count, severities.size() - offset));
+                check(MPI_Allreduce(MPI_IN_PLACE, severities.data() + offset, count, MPI_UINT8_T,
+                                    MPI_MAX, m_comm), "MPI_Allreduce");
+            }
+
+            const TestTiming &local = test.get_total_timing();
+            std::array<std::int64_t, 4> ns{local.setup_ns, local.body_ns, local.teardown_ns, local.cpu_ns};
+            check(MPI_Allreduce(MPI_IN_PLACE, ns.data(), static_cast<int>(ns.size()), MPI_INT64_T,
+                                MPI_SUM, m_comm), "MPI_Allreduce");
+
+            std::vector<ParameterizedTest::Status> merged(severities.size());
+            for (std::size_t k = 0; k < merged.size(); ++k) {
+                merged[k] = status_from_severity<ParameterizedTest::Status>(severities[k]);
+            }
+            test.assign_results(std::move(merged), TestTiming{ns[0], ns[1], ns[2], ns[3]});
+        }
+    };
+
+    /**
+     * @brief Factory sharing parameterized test cases among the ranks of `comm`.
+     *
+     * Pass it to TestSession::set_case_distribution(). The communicator
+     * must stay valid while the session runs.
+     */
+    [[nodiscard]] inline CaseDistributorFactory mpi_case_distribution(MPI_Comm comm) {
+        return [comm](std::size_t num_cases, std::size_t workers, std::size_t chunk) {
+            return std::make_unique<MpiCaseDistributor>(comm, num_cases, workers, chunk);
+        };
+    }
+} // namespace Fortest
+
+#endif // FORTEST_MPI_CASE_DISTRIBUTOR_HPP
@@ -0,0 +1,66 @@
+!> @page fortest_mpi MPI Support
+!>
+!> @brief Share the work of a test session among MPI ranks.
+!>
+!> Available when Fortest is configured with `FORTEST_ENABLE_MPI=ON`;
+!> link against `fortest_mpi`. MPI must be initialized by the test
+!> program before the session runs.
+module fortest_mpi
+    use iso_c_binding, only : c_int
+    implicit none
+    private
+
+    public :: distribute_tests
+    public :: distribute_parameterized_tests
+
+contains
+
+    !> @brief Run the session's tests spread over the ranks of a communicator.
+    !>
+    !> Each test runs on one rank, chosen by `FORTEST_DISTRIBUTION`
+    !> (`round_robin` or `cost`); tests registered with
+    !> `collective = .true.` run on every rank, and parameterized cases are
+    !> shared as by distribute_parameterized_tests(). Afterwards every rank
+    !> holds the results of all ranks, so `finalize` exits with the same
+    !> status everywhere. Only rank 0 logs the session and writes the
+    !> results database.
+    !>
+    !> @param comm Communicator whose ranks share the session, as an integer
+    !>             handle (`MPI_COMM_WORLD`, or `comm%MPI_VAL` with `mpi_f08`)
+    subroutine distribute_tests(comm)
+        integer, intent(in) :: comm
+
+        interface
+            subroutine c_distribute_tests(comm) bind(C, name = "c_distribute_tests")
+                import :: c_int
+                integer(c_int), value :: comm
+            end subroutine c_distribute_tests
+        end interface
+
+        call c_distribute_tests(int(comm, c_int))
+    end subroutine distribute_tests
+
+    !> @brief Run every case of the session's parameterized tests on one rank only.
+    !>
+    !> Ranks claim chunks of cases while the tests run, so ranks that drew
+    !> cheap cases take more. The statuses of all ranks are merged
+    !> afterwards, and every rank reports the same results. All ranks must
+    !> register the same tests and call `run`.
+    !>
+    !> @param comm Communicator whose ranks share the cases, as an integer
+    !>             handle (`MPI_COMM_WORLD`, or `comm%MPI_VAL` with `mpi_f08`)
+    subroutine distribute_parameterized_tests(comm)
+        integer, intent(in) :: comm
+
+        interface
+            subroutine c_distribute_parameterized_tests(comm) &
+                    bind(C, name = "c_distribute_parameterized_tests")
+                import :: c_int
+                integer(c_int), value :: comm
+            end subroutine c_distribute_parameterized_tests
+        end interface
+
+        call c_distribute_parameterized_tests(int(comm, c_int))
+    end subroutine distribute_parameterized_tests
+
+end module fortest_mpi
@@ -0,0 +1,209 @@
+#ifndef FORTEST_MPI_SESSION_DISTRIBUTION_HPP
+#define FORTEST_MPI_SESSION_DISTRIBUTION_HPP
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi_case_distributor.hpp"
+#include "session_distribution.hpp"
+#include "test.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Shares the tests of a session among the ranks of a communicator.
+     *
+     * @details
+     * Results are combined with `MPI_Allreduce` and result rows are sent
+     * to rank 0 with one `MPI_Gatherv`, so only rank 0 touches the results
+     * database. The cases of parameterized tests are shared with an
+     * MpiCaseDistributor.
+     *
+     * MPI must be initialized before the session runs and the
+     * communicator must stay valid until it has finished.
+     */
+    class MpiSessionDistribution final : public SessionDistribution {
+        MPI_Comm m_comm;
+        std::size_t m_rank = 0;
+        std::size_t m_size = 1;
+
+        void check(int code, const char *call) const {
+            if (code != MPI_SUCCESS) {
+                throw std::runtime_error(std::string("MpiSessionDistribution: ") + call + " failed");
+            }
+        }
+
+        static void append(std::vector<char> &bytes, const void *data, std::size_t size) {
+            const auto *first = static_cast<const char *>(data);
+            bytes.insert(bytes.end(), first, first + size);
+        }
+
+        static void append_string(std::vector<char> &bytes, const std::string &text) {
+            const auto size = static_cast<std::uint64_t>(text.size());
+            append(bytes, &size, sizeof(size));
+            append(bytes, text.data(), text.size());
+        }
+
+        /// Reads back what append() wrote, in the same order.
+        struct Reader {
+            const char *cursor;
+
+            template<typename T>
+            T read() {
+                T value;
+                std::memcpy(&value, cursor, sizeof(T));
+                cursor += sizeof(T);
+                return value;
+            }
+
+            std::string read_string() {
+                const auto size = read<std::uint64_t>();
+                std::string text(cursor, size);
+                cursor += size;
+                return text;
+            }
+        };
+
+        /// @brief Status name with static storage for a status byte.
+        static const char *status_name(std::uint8_t status) {
+            return Test::status_name(static_cast<Test::Status>(status));
+        }
+
+        static std::uint8_t status_value(const char *name) {
+            for (std::uint8_t value = 0; value < StatusCounts::num_statuses; ++value) {
+                if (std::strcmp(name, status_name(value)) == 0) return value;
+            }
+            return static_cast<std::uint8_t>(Test::Status::NONE);
+        }
+
+        static std::vector<char> serialize(const std::vector<ResultRow> &rows) {
+            std::vector<char> bytes;
+            for (const auto &row : rows) {
+                append_string(bytes, row.suite_name);
+                append_string(bytes, row.test_name);
+                const std::uint8_t status = status_value(row.status);
+                append(bytes, &status, sizeof(status));
+                const std::int64_t ns[4] = {row.timing.setup_ns, row.timing.body_ns,
+                                            row.timing.teardown_ns, row.timing.cpu_ns};
+                append(bytes, ns, sizeof(ns));
+                const std::int64_t finished = std::chrono::duration_cast<std::chrono::microseconds>(
+                    row.finished_at.time_since_epoch()).count();
+                append(bytes, &finished, sizeof(finished));
+                const std::uint8_t has_benchmark = row.benchmark.has_value();
+                append(bytes, &has_benchmark, sizeof(has_benchmark));
+                if (has_benchmark) {
+                    const BenchmarkStats &stats = *row.benchmark;
+                    const std::uint64_t counts[2] = {stats.iterations, stats.repetitions};
+                    const double values[5] = {stats.min_ns, stats.median_ns, stats.mean_ns, stats.stddev_ns,
+                                              stats.throughput};
+                    append(bytes, counts, sizeof(counts));
+                    append(bytes, values, sizeof(values));
+                }
+            }
+            return bytes;
+        }
+
+        static void deserialize(const char *first, const char *last, std::vector<ResultRow> &rows) {
+            Reader in{first};
+            while (in.cursor < last) {
+                ResultRow row;
+                row.suite_name = in.read_string();
+                row.test_name = in.read_string();
+                row.status = status_name(in.read<std::uint8_t>());
+                row.timing.setup_ns = in.read<std::int64_t>();
+                row.timing.body_ns = in.read<std::int64_t>();
+                row.timing.teardown_ns = in.read<std::int64_t>();
+                row.timing.cpu_ns = in.read<std::int64_t>();
+                row.finished_at = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::microseconds(in.read<std::int64_t>())));
+                if (in.read<std::uint8_t>()) {
+                    BenchmarkStats stats;
+                    stats.iterations = in.read<std::uint64_t>();
+                    stats.repetitions = in.read<std::uint64_t>();
+                    stats.min_ns = in.read<double>();
+                    stats.median_ns = in.read<double>();
+                    stats.mean_ns = in.read<double>();
+                    stats.stddev_ns = in.read<double>();
+                    stats.throughput = in.read<double>();
+                    row.benchmark = stats;
+                }
+                rows.push_back(std::move(row));
+            }
+        }
+
+    public:
+        /// @param comm Communicator whose ranks share the session.
+        explicit MpiSessionDistribution(MPI_Comm comm) : m_comm(comm) {
+            int rank = 0;
+            int size = 1;
+            check(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+            check(MPI_Comm_size(comm, &size), "MPI_Comm_size");
+            m_rank = static_cast<std::size_t>(rank);
+            m_size = static_cast<std::size_t>(size);
+        }
+
+        [[nodiscard]] std::size_t rank() const noexcept override { return m_rank; }
+        [[nodiscard]] std::size_t size() const noexcept override { return m_size; }
+
+        void max_reduce(std::span<std::int64_t> values) override {
+            std::lock_guard lock(mpi_call_mutex());
+            constexpr std::size_t max_count = std::numeric_limits<int>::max();
+            for (std::size_t offset = 0; offset < values.size(); offset += max_count) {
+                const auto count = static_cast<int>(std::min(max_count, values.size() - offset));
+                check(MPI_Allreduce(MPI_IN_PLACE, values.data() + offset, count, MPI_INT64_T, MPI_MAX,
+                                    m_comm), "MPI_Allreduce");
+            }
+        }
+
+        /**
+         * @copydoc SessionDistribution::gather
+         * @throws std::runtime_error if the rows of all ranks exceed 2 GiB.
+         */
+        [[nodiscard]] std::vector<ResultRow> gather(std::vector<ResultRow> rows) override {
+            std::lock_guard lock(mpi_call_mutex());
+            const std::vector<char> bytes = serialize(rows);
+            const auto local = static_cast<std::int64_t>(bytes.size());
+
+            // Every rank learns the total, so all of them agree whether it fits.
+            std::vector<std::int64_t> sizes(m_size);
+            check(MPI_Allgather(&local, 1, MPI_INT64_T, sizes.data(), 1, MPI_INT64_T, m_comm),
+                  "MPI_Allgather");
+            std::vector<int> counts(m_size);
+            std::vector<int> displacements(m_size);
+            std::int64_t total = 0;
+            for (std::size_t r = 0; r < m_size; ++r) {
+                if (total + sizes[r] > std::numeric_limits<int>::max()) {
+                    throw std::runtime_error("MpiSessionDistribution: result rows exceed 2 GiB");
+                }
+                counts[r] = static_cast<int>(sizes[r]);
+                displacements[r] = static_cast<int>(total);
+                total += sizes[r];
+            }
+
+            std::vector<char> all(is_aggregator() ? static_cast<std::size_t>(total) : 0);
+            check(MPI_Gatherv(bytes.data(), static_cast<int>(local), MPI_CHAR, all.data(), counts.data(),
+                              displacements.data(), MPI_CHAR, 0, m_comm), "MPI_Gatherv");
+
+            std::vector<ResultRow> gathered;
+            if (is_aggregator()) deserialize(all.data(), all.data() + all.size(), gathered);
+            return gathered;
+        }
+
+        [[nodiscard]] CaseDistributorFactory case_distribution() override {
+            return mpi_case_distribution(m_comm);
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_MPI_SESSION_DISTRIBUTION_HPP
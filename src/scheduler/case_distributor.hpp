@@ -0,0 +1,105 @@
+#ifndef FORTEST_CASE_DISTRIBUTOR_HPP
+#define FORTEST_CASE_DISTRIBUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "parameterized_test.hpp"
+
+namespace Fortest {
+    /// Half-open range `[begin, end)` of case numbers of a parameterized test.
+    struct CaseChunk {
+        std::size_t begin = 0; //!< First case
+        std::size_t end = 0;   //!< One past the last case
+    };
+
+    /**
+     * @brief Size of the next chunk under guided self-scheduling.
+     *
+     * @details
+     * Chunks start large and shrink as the cases run out, in proportion
+     * to the remaining work per worker, so workers that drew expensive
+     * cases are not left behind by one last oversized chunk while the
+     * others idle. A positive `fixed` chunk size replaces the rule.
+     *
+     * @param remaining Cases not handed out yet.
+     * @param workers Workers drawing chunks, across all processes.
+     * @param fixed Constant chunk size, or 0 for guided sizing.
+     */
+    [[nodiscard]] inline std::size_t guided_chunk_size(std::size_t remaining, std::size_t workers,
+                                                       std::size_t fixed = 0) noexcept {
+        const std::size_t size = fixed > 0 ? fixed : remaining / (2 * std::max<std::size_t>(workers, 1));
+        return std::clamp<std::size_t>(size, 1, std::max<std::size_t>(remaining, 1));
+    }
+
+    /**
+     * @brief Hands out the cases of one parameterized test in chunks.
+     *
+     * @details
+     * Every worker running the test calls next() until it returns
+     * std::nullopt. A distributed implementation shares the cases with
+     * other processes: each process runs only the chunks it drew, and
+     * merge() then gathers the results of all of them into the test.
+     */
+    class CaseDistributor {
+    public:
+        virtual ~CaseDistributor() = default;
+
+        /// @brief Next chunk for the calling worker, or std::nullopt once all are taken. Thread-safe.
+        virtual std::optional<CaseChunk> next() = 0;
+
+        /// @brief Whether other processes run part of the cases.
+        [[nodiscard]] virtual bool is_distributed() const noexcept { return false; }
+
+        /**
+         * @brief Gather the results of all processes into `test`.
+         *
+         * Called once, after every local worker has finished. Collective
+         * for a distributed implementation: all processes must merge
+         * their tests in the same order.
+         */
+        virtual void merge(ParameterizedTest &test) { (void) test; }
+    };
+
+    /// @brief Chunks of the cases of a test, shared by the workers of this process.
+    class LocalCaseDistributor final : public CaseDistributor {
+        std::atomic<std::size_t> m_next{0}; //!< First case not handed out
+        std::size_t m_num_cases;
+        std::size_t m_workers;
+        std::size_t m_chunk;
+
+    public:
+        /**
+         * @param num_cases Number of cases of the test.
+         * @param workers Number of workers drawing chunks.
+         * @param chunk Fixed chunk size, or 0 for guided sizing.
+         */
+        LocalCaseDistributor(std::size_t num_cases, std::size_t workers, std::size_t chunk = 0) noexcept
+            : m_num_cases(num_cases), m_workers(workers), m_chunk(chunk) {}
+
+        std::optional<CaseChunk> next() override {
+            std::size_t begin = m_next.load(std::memory_order_relaxed);
+            std::size_t end;
+            do {
+                if (begin >= m_num_cases) return std::nullopt;
+                end = begin + guided_chunk_size(m_num_cases - begin, m_workers, m_chunk);
+            } while (!m_next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+            return CaseChunk{begin, std::min(end, m_num_cases)};
+        }
+    };
+
+    /**
+     * @brief Creates the distributor of one run of a parameterized test.
+     *
+     * Arguments: the number of cases, the number of local workers, and
+     * the fixed chunk size (0 for guided sizing).
+     */
+    using CaseDistributorFactory =
+        std::function<std::unique_ptr<CaseDistributor>(std::size_t, std::size_t, std::size_t)>;
+} // namespace Fortest
+
+#endif // FORTEST_CASE_DISTRIBUTOR_HPP
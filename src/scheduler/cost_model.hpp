@@ -0,0 +1,56 @@
+#ifndef FORTEST_COST_MODEL_HPP
+#define FORTEST_COST_MODEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Fortest {
+    /**
+     * @brief Expected duration of a test in milliseconds, or std::nullopt if unknown.
+     *
+     * Arguments: the suite name and the name of a test, parameterized
+     * test, or parameter case (`name [param=...]`).
+     */
+    using TestCostModel = std::function<std::optional<double>(std::string_view, std::string_view)>;
+
+    /**
+     * @brief Replace unknown costs by an estimate.
+     *
+     * @param known Expected durations, std::nullopt where unknown.
+     * @param estimate_ms Cost of the unknown ones; 0 or less uses the
+     *        mean of the known costs (1 if none is known).
+     */
+    [[nodiscard]] inline std::vector<double> resolve_costs(std::span<const std::optional<double>> known,
+                                                           double estimate_ms = 0.0) {
+        if (estimate_ms <= 0.0) {
+            double sum = 0.0;
+            std::size_t count = 0;
+            for (const auto &cost : known) {
+                if (cost) {
+                    sum += *cost;
+                    ++count;
+                }
+            }
+            estimate_ms = count > 0 ? sum / static_cast<double>(count) : 1.0;
+        }
+        std::vector<double> costs(known.size());
+        for (std::size_t i = 0; i < known.size(); ++i) costs[i] = known[i].value_or(estimate_ms);
+        return costs;
+    }
+
+    /// @brief Indices of `costs` from the largest to the smallest; ties keep their order.
+    [[nodiscard]] inline std::vector<std::size_t> longest_first(std::span<const double> costs) {
+        std::vector<std::size_t> order(costs.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) { return costs[a] > costs[b]; });
+        return order;
+    }
+} // namespace Fortest
+
+#endif // FORTEST_COST_MODEL_HPP
@@ -0,0 +1,340 @@
+#ifndef FORTEST_FORK_RUNNER_HPP
+#define FORTEST_FORK_RUNNER_HPP
+
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Fortest {
+    /**
+     * @brief Runs jobs in forked child processes.
+     *
+     * @details
+     * Every job forks a child that executes the job body and streams
+     * fixed-size records back to the parent over a pipe. The parent keeps
+     * at most `max_children` children alive, enforces an optional
+     * wall-clock timeout, and reports how each child ended. A segfault,
+     * `error stop`, or any other abnormal exit only takes down the child,
+     * and legacy code with global state (COMMON blocks, SAVE variables)
+     * can run in parallel because every child has its own copy of it.
+     *
+     * The parent may run other threads while it forks. The locks a
+     * child can take, those of the loggers, the event bus and the thread
+     * pools, are held across fork() by their ForkGuard, so a child never
+     * inherits one that is locked forever.
+     *
+     * Completions are delivered on the thread that calls wait().
+     */
+    class ForkRunner {
+    public:
+        /// How a child process ended.
+        enum class Outcome {
+            Exited,   ///< Finished the job and reported all records
+            Crashed,  ///< Died by a signal or exited before finishing
+            TimedOut, ///< Killed after exceeding the timeout
+            Cancelled ///< Never started: the stop condition held before its turn
+        };
+
+        /// One (key, value) pair reported by a child.
+        struct Record {
+            std::int32_t key;
+            std::int64_t value;
+        };
+
+        /// Everything the parent learns about a finished job.
+        struct Result {
+            Outcome outcome = Outcome::Crashed;
+            int exit_code = 0;                //!< Exit code, if the child exited
+            int signal = 0;                   //!< Terminating signal, if any
+            std::int64_t wall_ns = 0;         //!< Wall time from fork to reaping
+            std::vector<Record> records;      //!< Records received before the end
+        };
+
+        /// Child-side handle used by a job body to report records.
+        class Writer {
+            int m_fd;
+
+        public:
+            explicit Writer(int fd) noexcept : m_fd(fd) {}
+
+            /// @brief Send one record to the parent.
+            void write(std::int32_t key, std::int64_t value) const {
+                const Record record{key, value};
+                write_all(&record, sizeof(record));
+            }
+
+            /// @brief Mark the job as complete; sent by the runner after the body.
+            void finish() const { write(end_key, 0); }
+
+        private:
+            void write_all(const void *data, std::size_t size) const {
+                const auto *bytes = static_cast<const char *>(data);
+                while (size > 0) {
+                    const ssize_t n = ::write(m_fd, bytes, size);
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        ::_exit(child_write_failed);
+                    }
+                    bytes += n;
+                    size -= static_cast<std::size_t>(n);
+                }
+            }
+        };
+
+        /// Runs in the child; reports results through the writer.
+        using Body = std::function<void(const Writer &)>;
+        /// Runs in the parent once the child has ended.
+        using Completion = std::function<void(const Result &)>;
+        /// Runs in the parent right before the child is forked, e.g. to set up state it inherits.
+        using Prepare = std::function<void()>;
+
+        /**
+         * @brief Create a runner.
+         * @param max_children Maximum number of concurrent children (at least one).
+         * @param timeout_seconds Per-job wall-clock limit; 0 disables it.
+         */
+        explicit ForkRunner(std::size_t max_children, double timeout_seconds = 0.0)
+            : m_max_children(max_children == 0 ? 1 : max_children),
+              m_timeout(std::chrono::duration<double>(timeout_seconds)) {}
+
+        ForkRunner(const ForkRunner &) = delete;
+        ForkRunner &operator=(const ForkRunner &) = delete;
+
+        /**
+         * @brief Queue a job; it starts during wait().
+         * @param timeout_seconds Wall-clock limit of this job, overriding the
+         *        runner's; 0 disables it.
+         * @param prepare Called before the job's child is forked; not for cancelled jobs.
+         */
+        void submit(Body body, Completion completion, std::optional<double> timeout_seconds = std::nullopt,
+                    Prepare prepare = {}) {
+            const auto timeout = timeout_seconds ? std::chrono::duration<double>(*timeout_seconds) : m_timeout;
+            m_queue.push_back({std::move(body), std::move(completion), timeout, std::move(prepare)});
+        }
+
+        /**
+         * @brief Stop starting jobs once `condition` holds.
+         *
+         * Checked before every launch. Queued jobs are then completed with
+         * Outcome::Cancelled without forking; running children finish.
+         * An empty condition (the default) never stops.
+         */
+        void stop_when(std::function<bool()> condition) { m_stop_condition = std::move(condition); }
+
+        /**
+         * @brief Run every queued job and deliver its completion.
+         *
+         * Completions may submit further jobs; wait() returns once the
+         * queue is empty and no child is running.
+         */
+        void wait() {
+            while (!m_queue.empty() || !m_running.empty()) {
+                while (!m_queue.empty() && m_running.size() < m_max_children) {
+                    Job job = std::move(m_queue.front());
+                    m_queue.pop_front();
+                    if (m_stop_condition && m_stop_condition()) {
+                        job.completion(Result{.outcome = Outcome::Cancelled});
+                    } else {
+                        if (job.prepare) job.prepare();
+                        launch(std::move(job));
+                    }
+                }
+                poll_children();
+            }
+        }
+
+    private:
+        static constexpr std::int32_t end_key = std::numeric_limits<std::int32_t>::min();
+        static constexpr int child_exception = 3;
+        static constexpr int child_write_failed = 4;
+
+        struct Job {
+            Body body;
+            Completion completion;
+            std::chrono::duration<double> timeout;
+            Prepare prepare;
+        };
+
+        struct Child {
+            pid_t pid = -1;
+            int fd = -1;
+            Completion completion;
+            std::chrono::steady_clock::time_point started;
+            std::chrono::duration<double> timeout{}; //!< Wall-clock limit; 0 disables it
+            std::string buffer;     //!< Bytes read but not yet parsed
+            Result result;
+            bool finished = false;  //!< End record received
+            bool eof = false;       //!< Pipe closed by the child
+            bool killed = false;    //!< Killed for exceeding the timeout
+        };
+
+        std::size_t m_max_children;
+        std::chrono::duration<double> m_timeout;
+        std::deque<Job> m_queue;
+        std::vector<Child> m_running;
+        std::function<bool()> m_stop_condition;
+
+        void launch(Job job) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                throw std::runtime_error("ForkRunner: pipe() failed: " +
+                                         std::string(std::strerror(errno)));
+            }
+            // Anything buffered now would otherwise be written twice.
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+
+            const pid_t pid = ::fork();
+            if (pid < 0) {
+                ::close(fds[0]);
+                ::close(fds[1]);
+                throw std::runtime_error("ForkRunner: fork() failed: " +
+                                         std::string(std::strerror(errno)));
+            }
+            if (pid == 0) {
+                ::close(fds[0]);
+                for (const auto &child : m_running) {
+                    if (!child.eof) ::close(child.fd);
+                }
+                run_child(job.body, Writer(fds[1]));
+            }
+            ::close(fds[1]);
+
+            Child child;
+            child.pid = pid;
+            child.fd = fds[0];
+            child.completion = std::move(job.completion);
+            child.timeout = job.timeout;
+            child.started = std::chrono::steady_clock::now();
+            m_running.push_back(std::move(child));
+        }
+
+        [[noreturn]] static void run_child(const Body &body, const Writer &writer) {
+            int code = 0;
+            try {
+                body(writer);
+                writer.finish();
+            } catch (const std::exception &e) {
+                std::cerr << "[FORTEST] Exception in forked job: " << e.what() << std::endl;
+                code = child_exception;
+            } catch (...) {
+                std::cerr << "[FORTEST] Unknown exception in forked job" << std::endl;
+                code = child_exception;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            ::_exit(code);
+        }
+
+        void poll_children() {
+            std::vector<pollfd> fds;
+            fds.reserve(m_running.size());
+            for (const auto &child : m_running) {
+                fds.push_back({child.eof ? -1 : child.fd, POLLIN, 0});
+            }
+            const int rc = ::poll(fds.data(), fds.size(), 20);
+            if (rc < 0 && errno != EINTR) {
+                throw std::runtime_error("ForkRunner: poll() failed: " +
+                                         std::string(std::strerror(errno)));
+            }
+
+            for (std::size_t i = 0; i < m_running.size(); ++i) {
+                if (fds[i].revents != 0) {
+                    drain(m_running[i]);
+                }
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < m_running.size();) {
+                Child &child = m_running[i];
+                if (!child.killed && child.timeout.count() > 0 && now - child.started > child.timeout) {
+                    ::kill(child.pid, SIGKILL);
+                    child.killed = true;
+                }
+                if (child.eof && reap(child)) {
+                    Child done = std::move(child);
+                    m_running.erase(m_running.begin() + static_cast<std::ptrdiff_t>(i));
+                    done.completion(done.result);
+                } else {
+                    ++i;
+                }
+            }
+        }
+
+        void drain(Child &child) {
+            // One read per poll() wake-up: the pipe is blocking.
+            char chunk[4096];
+            ssize_t n;
+            do {
+                n = ::read(child.fd, chunk, sizeof(chunk));
+            } while (n < 0 && errno == EINTR);
+            if (n <= 0) {
+                child.eof = true;
+                ::close(child.fd);
+            } else {
+                child.buffer.append(chunk, static_cast<std::size_t>(n));
+            }
+            std::size_t offset = 0;
+            while (child.buffer.size() - offset >= sizeof(Record)) {
+                Record record{};
+                std::memcpy(&record, child.buffer.data() + offset, sizeof(Record));
+                offset += sizeof(Record);
+                if (record.key == end_key) {
+                    child.finished = true;
+                } else {
+                    child.result.records.push_back(record);
+                }
+            }
+            child.buffer.erase(0, offset);
+        }
+
+        /// @brief Collect the child's exit status; false if it is still running.
+        bool reap(Child &child) {
+            int status = 0;
+            pid_t rc;
+            do {
+                rc = ::waitpid(child.pid, &status, child.killed ? 0 : WNOHANG);
+            } while (rc < 0 && errno == EINTR);
+            if (rc == 0) {
+                return false;
+            }
+            Result &result = child.result;
+            result.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - child.started).count();
+            if (child.killed) {
+                result.outcome = Outcome::TimedOut;
+                result.signal = SIGKILL;
+            } else if (WIFSIGNALED(status)) {
+                result.outcome = Outcome::Crashed;
+                result.signal = WTERMSIG(status);
+            } else {
+                result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 0;
+                result.outcome = (child.finished && result.exit_code == 0)
+                                     ? Outcome::Exited
+                                     : Outcome::Crashed;
+            }
+            return true;
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_FORK_RUNNER_HPP
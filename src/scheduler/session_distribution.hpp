@@ -0,0 +1,156 @@
+#ifndef FORTEST_SESSION_DISTRIBUTION_HPP
+#define FORTEST_SESSION_DISTRIBUTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "case_distributor.hpp"
+#include "cost_model.hpp"
+#include "result_sink.hpp"
+#include "run_options.hpp"
+#include "timing.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Shares the tests of a session among cooperating processes.
+     *
+     * @details
+     * Every process registers the same tests and runs the same session.
+     * Each regular test is owned by one process, which alone runs it;
+     * collective tests run on all of them, and the cases of
+     * parameterized tests are shared through case_distribution(). After
+     * the run the results are combined with max_reduce(), so every
+     * process ends up with the same statuses and exit code, and the
+     * result rows are collected on the aggregator with gather(). Only the
+     * aggregator logs progress and writes the results database.
+     *
+     * max_reduce(), gather() and the distributors made by
+     * case_distribution() are collective: all processes call them in the
+     * same order.
+     */
+    class SessionDistribution {
+    public:
+        virtual ~SessionDistribution() = default;
+
+        /// @brief Number of this process, in `[0, size())`.
+        [[nodiscard]] virtual std::size_t rank() const noexcept = 0;
+
+        /// @brief Number of processes sharing the session.
+        [[nodiscard]] virtual std::size_t size() const noexcept = 0;
+
+        /// @brief Whether this process logs and writes the results: rank 0.
+        [[nodiscard]] bool is_aggregator() const noexcept { return rank() == 0; }
+
+        /// @brief Replace `values` by their element-wise maximum over all processes. Collective.
+        virtual void max_reduce(std::span<std::int64_t> values) = 0;
+
+        /**
+         * @brief Collect the result rows of all processes on the aggregator. Collective.
+         * @return On the aggregator, the rows of every process in rank
+         *         order; elsewhere nothing.
+         */
+        [[nodiscard]] virtual std::vector<ResultRow> gather(std::vector<ResultRow> rows) = 0;
+
+        /// @brief Distributors sharing the cases of parameterized tests among the processes.
+        [[nodiscard]] virtual CaseDistributorFactory case_distribution() = 0;
+    };
+
+    /**
+     * @brief Layout of a TestTiming in the values combined by SessionDistribution::max_reduce().
+     *
+     * @details
+     * Every field combines by its maximum: durations take the slowest
+     * process, and a process that did not run the test packs `absent`
+     * values, which lose to every real one. The memory growth is signed,
+     * so it must come from a single process; the others pack it absent.
+     * The bitmask of counted events is spread over one 0/1 flag per
+     * event, so the maximum of the flags is the bitwise OR of the masks
+     * and the events counted by any process all stay present.
+     */
+    struct ReducedTiming {
+        /// Values per timing: durations, memory usage, a flag per event, then the event counts.
+        static constexpr std::size_t size = 7 + 2 * PerfCounts::NumEvents;
+        /// Value of a field this process does not report, below every real one.
+        static constexpr std::int64_t absent = std::numeric_limits<std::int64_t>::min();
+
+        /**
+         * @brief Pack `timing` into `out[0, size)`.
+         * @param reports_delta Whether this process gives the memory growth.
+         */
+        static void pack(std::int64_t *out, const TestTiming &timing, bool reports_delta) noexcept {
+            out[0] = timing.setup_ns;
+            out[1] = timing.body_ns;
+            out[2] = timing.teardown_ns;
+            out[3] = timing.cpu_ns;
+            out[4] = timing.memory.measured;
+            out[5] = reports_delta ? timing.memory.rss_delta_bytes : absent;
+            out[6] = timing.memory.peak_rss_bytes;
+            for (std::size_t e = 0; e < PerfCounts::NumEvents; ++e) {
+                out[7 + e] = (timing.counters.counted >> e) & 1U;
+                out[7 + PerfCounts::NumEvents + e] = timing.counters.values[e];
+            }
+        }
+
+        /// @brief Pack the timing of a test this process did not run.
+        static void pack_absent(std::int64_t *out) noexcept { std::fill_n(out, size, absent); }
+
+        /// @brief The timing combined from `in[0, size)`; fields no process reported are zero.
+        [[nodiscard]] static TestTiming unpack(const std::int64_t *in) noexcept {
+            const auto value = [in](std::size_t field) { return in[field] == absent ? 0 : in[field]; };
+            TestTiming timing{value(0), value(1), value(2), value(3)};
+            timing.memory = MemoryUsage{value(5), value(6), value(4) != 0};
+            for (std::size_t e = 0; e < PerfCounts::NumEvents; ++e) {
+                if (value(7 + e) != 0) timing.counters.counted |= 1U << e;
+                timing.counters.values[e] = value(7 + PerfCounts::NumEvents + e);
+            }
+            return timing;
+        }
+    };
+
+    /**
+     * @brief Assign every test to the process that runs it.
+     *
+     * @details
+     * Round robin deals the tests out in order. Cost-based assignment is
+     * the longest-processing-time-first greedy rule: tests are taken from
+     * the most to the least expensive and each goes to the process with
+     * the least work so far, which keeps the slowest process within 4/3
+     * of the optimum. Ties keep the order of the tests, so every process
+     * computes the same assignment from the same costs.
+     *
+     * @param costs Expected duration of each test; ignored by round robin.
+     * @param num_ranks Number of processes.
+     * @param policy How to assign the tests.
+     * @return Owning process of each test.
+     */
+    [[nodiscard]] inline std::vector<std::size_t> assign_owners(std::span<const double> costs,
+                                                                std::size_t num_ranks,
+                                                                RunOptions::Distribution policy) {
+        num_ranks = std::max<std::size_t>(num_ranks, 1);
+        std::vector<std::size_t> owners(costs.size());
+        if (policy == RunOptions::Distribution::RoundRobin) {
+            for (std::size_t i = 0; i < owners.size(); ++i) owners[i] = i % num_ranks;
+            return owners;
+        }
+
+        using Load = std::pair<double, std::size_t>; // (work so far, rank)
+        std::priority_queue<Load, std::vector<Load>, std::greater<>> loads;
+        for (std::size_t rank = 0; rank < num_ranks; ++rank) loads.emplace(0.0, rank);
+        for (const std::size_t test : longest_first(costs)) {
+            auto [load, rank] = loads.top();
+            loads.pop();
+            owners[test] = rank;
+            loads.emplace(load + costs[test], rank);
+        }
+        return owners;
+    }
+} // namespace Fortest
+
+#endif // FORTEST_SESSION_DISTRIBUTION_HPP
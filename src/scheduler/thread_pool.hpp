@@ -0,0 +1,226 @@
+#ifndef FORTEST_THREAD_POOL_HPP
+#define FORTEST_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fork_guard.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Fixed-size work-stealing thread pool.
+     *
+     * @details
+     * Every worker owns a task deque. Tasks submitted from outside the
+     * pool are distributed round-robin; tasks submitted from a worker go
+     * to that worker's own deque. A worker pops from the back of its own
+     * deque and, when it runs dry, steals from the front of the others.
+     *
+     * The first exception thrown by a task is captured and rethrown by
+     * wait(); the remaining tasks still run.
+     */
+    class ThreadPool {
+    public:
+        /// Unit of work executed by the pool.
+        using Task = std::function<void()>;
+
+        /// Returned by worker_index() on threads not owned by a pool.
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Start a pool with the given number of workers.
+         * @param num_workers Number of worker threads (at least one is started).
+         */
+        explicit ThreadPool(std::size_t num_workers) {
+            num_workers = num_workers == 0 ? 1 : num_workers;
+            m_queues.reserve(num_workers);
+            for (std::size_t i = 0; i < num_workers; ++i) {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            m_threads.reserve(num_workers);
+            for (std::size_t i = 0; i < num_workers; ++i) {
+                m_threads.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        /// @brief Finish all submitted tasks and join the workers.
+        ~ThreadPool() {
+            {
+                std::unique_lock lock(m_mutex);
+                m_done_cv.wait(lock, [this] { return m_pending == 0; });
+                m_stop = true;
+            }
+            m_work_cv.notify_all();
+            for (auto &thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /// @brief Number of worker threads.
+        [[nodiscard]] std::size_t size() const noexcept { return m_threads.size(); }
+
+        /// @brief Index of the calling worker, or npos outside the pool.
+        [[nodiscard]] static std::size_t worker_index() noexcept { return s_worker_index; }
+
+        /**
+         * @brief Queue a task for execution.
+         * @param task Callable to run on one of the workers.
+         */
+        void submit(Task task) {
+            std::size_t target = s_owner == this
+                                     ? s_worker_index
+                                     : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+            {
+                std::lock_guard lock(m_mutex);
+                ++m_pending;
+                ++m_queued;
+            }
+            {
+                std::lock_guard lock(m_queues[target]->mutex);
+                m_queues[target]->tasks.push_back(std::move(task));
+            }
+            m_work_cv.notify_one();
+        }
+
+        /**
+         * @brief Queue tasks to be started roughly in the given order.
+         *
+         * The tasks are dealt round-robin over the workers, and each
+         * worker takes its share in order: its first task is the first
+         * it runs. Workers that run dry steal the last tasks of the
+         * others. With tasks sorted by decreasing duration this is
+         * longest-processing-time-first list scheduling.
+         *
+         * @param tasks Callables to run, most urgent first.
+         */
+        void submit_ordered(std::vector<Task> tasks) {
+            if (tasks.empty()) return;
+            {
+                std::lock_guard lock(m_mutex);
+                m_pending += tasks.size();
+                m_queued += tasks.size();
+            }
+            const std::size_t first = m_next.fetch_add(tasks.size(), std::memory_order_relaxed);
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                // Owners pop from the back, so the front holds the task to run last.
+                auto &queue = *m_queues[(first + i) % m_queues.size()];
+                std::lock_guard lock(queue.mutex);
+                queue.tasks.push_front(std::move(tasks[i]));
+            }
+            m_work_cv.notify_all();
+        }
+
+        /**
+         * @brief Block until every submitted task has finished.
+         * @throws The first exception thrown by a task, if any.
+         */
+        void wait() {
+            std::unique_lock lock(m_mutex);
+            m_done_cv.wait(lock, [this] { return m_pending == 0; });
+            if (m_error) {
+                std::exception_ptr error = std::exchange(m_error, nullptr);
+                lock.unlock();
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            ForkGuard fork_guard{mutex};
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues; //!< One deque per worker
+        std::vector<std::thread> m_threads;           //!< Worker threads
+        std::atomic<std::size_t> m_next{0};           //!< Round-robin cursor
+
+        std::mutex m_mutex;                  //!< Guards the counters below
+        ForkGuard m_fork_guard{m_mutex};     //!< Keeps m_mutex usable in forked children
+        std::condition_variable m_work_cv;   //!< Signals queued work or stop
+        std::condition_variable m_done_cv;   //!< Signals m_pending reaching zero
+        std::size_t m_pending = 0;           //!< Submitted but not finished
+        std::size_t m_queued = 0;            //!< Submitted but not started
+        bool m_stop = false;                 //!< Set once by the destructor
+        std::exception_ptr m_error;          //!< First task exception
+
+        static inline thread_local const ThreadPool *s_owner = nullptr;
+        static inline thread_local std::size_t s_worker_index = npos;
+
+        bool try_pop(std::size_t id, Task &task) {
+            {
+                auto &own = *m_queues[id];
+                std::lock_guard lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+                auto &victim = *m_queues[(id + offset) % m_queues.size()];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void worker_loop(std::size_t id) {
+            s_owner = this;
+            s_worker_index = id;
+            for (;;) {
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_work_cv.wait(lock, [this] { return m_queued > 0 || m_stop; });
+                    if (m_queued == 0 && m_stop) {
+                        return;
+                    }
+                }
+                Task task;
+                if (!try_pop(id, task)) {
+                    // Another worker took it between the wake-up and the pop.
+                    std::this_thread::yield();
+                    continue;
+                }
+                {
+                    std::lock_guard lock(m_mutex);
+                    --m_queued;
+                }
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard lock(m_mutex);
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                }
+                bool done;
+                {
+                    std::lock_guard lock(m_mutex);
+                    done = --m_pending == 0;
+                }
+                if (done) {
+                    m_done_cv.notify_all();
+                }
+            }
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_THREAD_POOL_HPP
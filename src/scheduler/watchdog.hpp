@@ -0,0 +1,208 @@
+#ifndef FORTEST_WATCHDOG_HPP
+#define FORTEST_WATCHDOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace Fortest {
+    /**
+     * @brief Cancellation flag of the test running on the calling thread.
+     *
+     * @details
+     * A TimeoutGuard binds one to the thread for the duration of a test
+     * and the watchdog raises it when the test overruns its timeout.
+     * Long-running test bodies (e.g. solver loops) poll requested() and
+     * return early; the test is then recorded as TIMEOUT.
+     */
+    class TestCancellation {
+        static inline thread_local const std::atomic<bool> *s_current = nullptr;
+
+    public:
+        /// @brief Whether the test running on this thread has been asked to stop.
+        [[nodiscard]] static bool requested() noexcept {
+            return s_current && s_current->load(std::memory_order_relaxed);
+        }
+
+        /// @brief RAII guard binding a flag to the calling thread; restores the previous one.
+        class Binding {
+            const std::atomic<bool> *m_previous;
+
+        public:
+            explicit Binding(const std::atomic<bool> &flag) noexcept : m_previous(s_current) {
+                s_current = &flag;
+            }
+
+            ~Binding() { s_current = m_previous; }
+
+            Binding(const Binding &) = delete;
+            Binding &operator=(const Binding &) = delete;
+        };
+    };
+
+    /**
+     * @brief Background thread calling functions at their deadlines.
+     *
+     * @details
+     * The thread starts with the first arm() and sleeps until the
+     * earliest deadline. Alarms run on it one at a time, outside the
+     * lock. disarm() waits for an alarm that is already running, so its
+     * captures stay valid until disarm() returns.
+     */
+    class Watchdog {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Alarm = std::function<void()>;
+
+        Watchdog() = default;
+        Watchdog(const Watchdog &) = delete;
+        Watchdog &operator=(const Watchdog &) = delete;
+
+        ~Watchdog() {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            if (m_thread.joinable()) m_thread.join();
+        }
+
+        /// @brief The process-wide watchdog used by test suites.
+        static Watchdog &instance() {
+            static Watchdog watchdog;
+            return watchdog;
+        }
+
+        /**
+         * @brief Call `alarm` on the watchdog thread at `deadline`.
+         * @return Id for disarm().
+         */
+        std::uint64_t arm(Clock::time_point deadline, Alarm alarm) {
+            std::lock_guard lock(m_mutex);
+            if (!m_thread.joinable()) m_thread = std::thread([this] { loop(); });
+            const std::uint64_t id = ++m_next_id;
+            m_alarms.emplace(id, Entry{deadline, std::move(alarm)});
+            m_wake.notify_all();
+            return id;
+        }
+
+        /// @brief Cancel an alarm, waiting for it if it is running.
+        void disarm(std::uint64_t id) {
+            std::unique_lock lock(m_mutex);
+            m_alarms.erase(id);
+            m_done.wait(lock, [&] { return m_firing != id; });
+        }
+
+    private:
+        struct Entry {
+            Clock::time_point deadline;
+            Alarm alarm;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;  //!< New alarm or stop
+        std::condition_variable m_done;  //!< An alarm finished
+        std::map<std::uint64_t, Entry> m_alarms; //!< Armed alarms by id; few, one or two per worker
+        std::uint64_t m_next_id = 0;
+        std::uint64_t m_firing = 0;      //!< Id of the running alarm; 0 if none
+        bool m_stop = false;
+        std::thread m_thread;
+
+        void loop() {
+            std::unique_lock lock(m_mutex);
+            while (!m_stop) {
+                auto next = m_alarms.end();
+                for (auto it = m_alarms.begin(); it != m_alarms.end(); ++it) {
+                    if (next == m_alarms.end() || it->second.deadline < next->second.deadline) next = it;
+                }
+                if (next == m_alarms.end()) {
+                    m_wake.wait(lock);
+                    continue;
+                }
+                if (Clock::now() < next->second.deadline) {
+                    m_wake.wait_until(lock, next->second.deadline);
+                    continue;
+                }
+                const std::uint64_t id = next->first;
+                Alarm alarm = std::move(next->second.alarm);
+                m_alarms.erase(next);
+                m_firing = id;
+                lock.unlock();
+                alarm();
+                lock.lock();
+                m_firing = 0;
+                m_done.notify_all();
+            }
+        }
+    };
+
+    /**
+     * @brief Enforces the timeout of one in-process test run.
+     *
+     * @details
+     * When the test overruns `timeout_seconds`, its TestCancellation
+     * flag is raised so a cooperative body can return (the test is then
+     * reported as TIMEOUT). A test that still runs `grace_seconds` later
+     * cannot be stopped inside the process: `on_hang` is called on the
+     * watchdog thread to record what is known and end the process.
+     *
+     * A non-positive timeout arms nothing and starts no thread.
+     */
+    class TimeoutGuard {
+    public:
+        /// Exit status of a process ended because a test hung, as with timeout(1).
+        static constexpr int hang_exit_code = 124;
+
+        /**
+         * @param timeout_seconds Wall-clock limit of the test; 0 disables it.
+         * @param grace_seconds Time a cancelled test has to return.
+         * @param on_hang Called if it does not; should not return.
+         * @param watchdog Watchdog running the alarms.
+         */
+        TimeoutGuard(double timeout_seconds, double grace_seconds, std::function<void()> on_hang,
+                     Watchdog &watchdog = Watchdog::instance()) {
+            if (timeout_seconds <= 0.0) return;
+            m_watchdog = &watchdog;
+            m_binding.emplace(m_cancelled);
+            const auto start = Watchdog::Clock::now();
+            const auto timeout = std::chrono::duration_cast<Watchdog::Clock::duration>(
+                std::chrono::duration<double>(timeout_seconds));
+            const auto grace = std::chrono::duration_cast<Watchdog::Clock::duration>(
+                std::chrono::duration<double>(std::max(grace_seconds, 0.0)));
+            m_cancel_alarm = watchdog.arm(start + timeout, [this] {
+                m_cancelled.store(true, std::memory_order_relaxed);
+            });
+            m_hang_alarm = watchdog.arm(start + timeout + grace, std::move(on_hang));
+        }
+
+        ~TimeoutGuard() {
+            if (!m_watchdog) return;
+            m_watchdog->disarm(m_hang_alarm);
+            m_watchdog->disarm(m_cancel_alarm);
+        }
+
+        TimeoutGuard(const TimeoutGuard &) = delete;
+        TimeoutGuard &operator=(const TimeoutGuard &) = delete;
+
+        /// @brief Whether the test overran its timeout.
+        [[nodiscard]] bool expired() const noexcept { return m_cancelled.load(std::memory_order_relaxed); }
+
+    private:
+        Watchdog *m_watchdog = nullptr;
+        std::atomic<bool> m_cancelled{false};
+        std::optional<TestCancellation::Binding> m_binding;
+        std::uint64_t m_cancel_alarm = 0;
+        std::uint64_t m_hang_alarm = 0;
+    };
+} // namespace Fortest
+
+#endif // FORTEST_WATCHDOG_HPP
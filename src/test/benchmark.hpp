@@ -0,0 +1,254 @@
+#ifndef FORTEST_BENCHMARK_HPP
+#define FORTEST_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Fortest {
+    /// How a benchmark is measured.
+    struct BenchmarkOptions {
+        std::size_t warmup = 1;                //!< Untimed calls before measuring
+        std::size_t repetitions = 10;          //!< Timed samples
+        double min_time_seconds = 0.1;         //!< Measured time of all samples together, at least
+        std::size_t max_iterations = 1u << 30; //!< Upper limit on the calls per sample
+        double items_per_call = 1.0;           //!< Work done by one call, e.g. bytes, for the throughput
+    };
+
+    /// Statistics of one benchmark run; times are per call.
+    struct BenchmarkStats {
+        std::size_t iterations = 0;  //!< Calls per sample
+        std::size_t repetitions = 0; //!< Samples
+        double min_ns = 0.0;         //!< Fastest sample
+        double median_ns = 0.0;      //!< Median sample
+        double mean_ns = 0.0;        //!< Mean of the samples
+        double stddev_ns = 0.0;      //!< Sample standard deviation
+        double throughput = 0.0;     //!< Items per second at the median time
+
+        /// @brief Human-readable summary, appended to log lines.
+        [[nodiscard]] std::string summary() const {
+            char text[160];
+            std::snprintf(text, sizeof(text),
+                          "(median %.1f ns, min %.1f, mean %.1f +- %.1f, %.4g items/s; %zu x %zu calls)",
+                          median_ns, min_ns, mean_ns, stddev_ns, throughput, repetitions, iterations);
+            return text;
+        }
+
+        /**
+         * @brief Statistics of per-call sample times.
+         * @param samples_ns Mean time per call of each sample.
+         * @param iterations Calls per sample.
+         * @param items_per_call Work done by one call.
+         */
+        [[nodiscard]] static BenchmarkStats from_samples(std::vector<double> samples_ns, std::size_t iterations,
+                                                         double items_per_call) {
+            BenchmarkStats stats;
+            stats.iterations = iterations;
+            stats.repetitions = samples_ns.size();
+            if (samples_ns.empty()) return stats;
+            std::ranges::sort(samples_ns);
+            const std::size_t n = samples_ns.size();
+            stats.min_ns = samples_ns.front();
+            stats.median_ns = n % 2 ? samples_ns[n / 2] : 0.5 * (samples_ns[n / 2 - 1] + samples_ns[n / 2]);
+            double sum = 0.0;
+            for (const double ns : samples_ns) sum += ns;
+            stats.mean_ns = sum / static_cast<double>(n);
+            double squares = 0.0;
+            for (const double ns : samples_ns) squares += (ns - stats.mean_ns) * (ns - stats.mean_ns);
+            stats.stddev_ns = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0;
+            stats.throughput = stats.median_ns > 0.0 ? items_per_call * 1e9 / stats.median_ns : 0.0;
+            return stats;
+        }
+    };
+
+    /**
+     * @brief Time repeated calls of a function.
+     *
+     * @details
+     * After `warmup` untimed calls, the number of calls per sample is
+     * found by timing growing batches until one batch takes its share
+     * of `min_time_seconds` (or reaches `max_iterations`). Then
+     * `repetitions` samples of that many calls each are timed, so calls
+     * far shorter than the clock resolution are still measured well.
+     *
+     * @param call Function to benchmark.
+     * @param options How to measure it.
+     */
+    template<typename Call>
+    [[nodiscard]] BenchmarkStats measure_benchmark(Call &&call, const BenchmarkOptions &options) {
+        using Clock = std::chrono::steady_clock;
+        const auto time_batch = [&](std::size_t calls) {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < calls; ++i) call();
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+
+        for (std::size_t i = 0; i < options.warmup; ++i) call();
+
+        const std::size_t repetitions = std::max<std::size_t>(options.repetitions, 1);
+        const std::size_t max_iterations = std::max<std::size_t>(options.max_iterations, 1);
+        const double target_ns = options.min_time_seconds * 1e9 / static_cast<double>(repetitions);
+        std::size_t iterations = 1;
+        for (;;) {
+            const double elapsed_ns = time_batch(iterations);
+            if (elapsed_ns >= target_ns || iterations >= max_iterations) break;
+            // Aim a little past the target, growing at most tenfold per step.
+            const double factor = elapsed_ns > 0.0 ? 1.4 * target_ns / elapsed_ns : 10.0;
+            const auto next = static_cast<std::size_t>(
+                static_cast<double>(iterations) * std::clamp(factor, 2.0, 10.0));
+            iterations = std::min(next, max_iterations);
+        }
+
+        std::vector<double> samples_ns(repetitions);
+        for (auto &sample : samples_ns) {
+            sample = time_batch(iterations) / static_cast<double>(iterations);
+        }
+        return BenchmarkStats::from_samples(std::move(samples_ns), iterations, options.items_per_call);
+    }
+
+    /**
+     * @brief Statistics of a benchmark's past runs, or none if unknown.
+     *
+     * Arguments: the suite name and the benchmark name.
+     */
+    using BenchmarkBaseline = std::function<std::vector<BenchmarkStats>(std::string_view, std::string_view)>;
+
+    /// When a benchmark counts as slower than its baseline.
+    struct RegressionOptions {
+        double max_slowdown_percent = 0.0; //!< Allowed increase of the median; 0 disables the comparison
+        double significance = 0.05;        //!< A slowdown fails only if its p-value is below this
+    };
+
+    /// Outcome of comparing a benchmark with its baseline.
+    struct RegressionVerdict {
+        double median_ns = 0.0;          //!< Median of the current run
+        double baseline_median_ns = 0.0; //!< Median of the baseline runs' medians
+        double slowdown_percent = 0.0;   //!< Increase of the median over the baseline
+        double p_value = 1.0;            //!< Chance of a mean time this much higher without a slowdown
+        bool regressed = false;          //!< Slower than allowed, and significantly so
+
+        /// @brief Human-readable comparison, for failure messages.
+        [[nodiscard]] std::string summary() const {
+            char text[160];
+            std::snprintf(text, sizeof(text), "median %.1f ns vs baseline %.1f ns: %+.1f%% (p = %.3g)",
+                          median_ns, baseline_median_ns, slowdown_percent, p_value);
+            return text;
+        }
+    };
+
+    namespace detail {
+        /// @brief Continued fraction of the incomplete beta function (modified Lentz).
+        [[nodiscard]] inline double beta_fraction(double a, double b, double x) {
+            constexpr double tiny = 1e-300;
+            const auto guard = [](double value) { return std::abs(value) < tiny ? tiny : value; };
+            double c = 1.0;
+            double d = 1.0 / guard(1.0 - (a + b) * x / (a + 1.0));
+            double h = d;
+            for (int m = 1; m <= 300; ++m) {
+                const double m2 = 2.0 * m;
+                double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+                d = 1.0 / guard(1.0 + aa * d);
+                c = guard(1.0 + aa / c);
+                h *= d * c;
+                aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+                d = 1.0 / guard(1.0 + aa * d);
+                c = guard(1.0 + aa / c);
+                const double step = d * c;
+                h *= step;
+                if (std::abs(step - 1.0) < 1e-12) break;
+            }
+            return h;
+        }
+
+        /// @brief Regularized incomplete beta function I_x(a, b).
+        [[nodiscard]] inline double incomplete_beta(double a, double b, double x) {
+            if (x <= 0.0) return 0.0;
+            if (x >= 1.0) return 1.0;
+            const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                          a * std::log(x) + b * std::log1p(-x));
+            if (x < (a + 1.0) / (a + b + 2.0)) return front * beta_fraction(a, b, x) / a;
+            return 1.0 - front * beta_fraction(b, a, 1.0 - x) / b;
+        }
+
+        /// @brief P(T > t) for Student's t distribution with `df` degrees of freedom.
+        [[nodiscard]] inline double student_t_upper_tail(double t, double df) {
+            const double tail = 0.5 * incomplete_beta(0.5 * df, 0.5, df / (df + t * t));
+            return t > 0.0 ? tail : 1.0 - tail;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Compare a benchmark run with the runs before it.
+     *
+     * @details
+     * The slowdown is the increase of the median time over the median of
+     * the baseline runs' medians. Its significance is a one-sided Welch
+     * t-test of the current samples against the samples of all baseline
+     * runs pooled, whose variance includes the spread between runs, so
+     * noisy machines need a larger slowdown to fail. The run regressed if
+     * the slowdown exceeds `options.max_slowdown_percent` and its p-value
+     * is below `options.significance`.
+     *
+     * @param current Statistics of this run.
+     * @param baseline Statistics of earlier runs; empty never regresses.
+     * @param options Allowed slowdown and significance level.
+     */
+    [[nodiscard]] inline RegressionVerdict compare_with_baseline(const BenchmarkStats &current,
+                                                                 std::span<const BenchmarkStats> baseline,
+                                                                 const RegressionOptions &options) {
+        RegressionVerdict verdict;
+        verdict.median_ns = current.median_ns;
+        if (baseline.empty()) return verdict;
+
+        std::vector<double> medians;
+        medians.reserve(baseline.size());
+        double n = 0.0;
+        double sum = 0.0;
+        for (const BenchmarkStats &run : baseline) {
+            medians.push_back(run.median_ns);
+            const double count = static_cast<double>(std::max<std::size_t>(run.repetitions, 1));
+            n += count;
+            sum += count * run.mean_ns;
+        }
+        std::ranges::sort(medians);
+        const std::size_t k = medians.size();
+        verdict.baseline_median_ns = k % 2 ? medians[k / 2] : 0.5 * (medians[k / 2 - 1] + medians[k / 2]);
+        if (verdict.baseline_median_ns > 0.0) {
+            verdict.slowdown_percent = 100.0 * (current.median_ns / verdict.baseline_median_ns - 1.0);
+        }
+
+        // Pool the baseline runs: within-run plus between-run sums of squares.
+        const double mean = sum / n;
+        double squares = 0.0;
+        for (const BenchmarkStats &run : baseline) {
+            const double count = static_cast<double>(std::max<std::size_t>(run.repetitions, 1));
+            squares += (count - 1.0) * run.stddev_ns * run.stddev_ns +
+                       count * (run.mean_ns - mean) * (run.mean_ns - mean);
+        }
+        const double n1 = static_cast<double>(std::max<std::size_t>(current.repetitions, 1));
+        const double v1 = current.stddev_ns * current.stddev_ns / n1;
+        const double v2 = n > 1.0 ? squares / (n - 1.0) / n : 0.0;
+        const double difference = current.mean_ns - mean;
+        if (v1 + v2 <= 0.0) {
+            verdict.p_value = difference > 0.0 ? 0.0 : 1.0;
+        } else {
+            const double t = difference / std::sqrt(v1 + v2);
+            const double df_terms = (n1 > 1.0 ? v1 * v1 / (n1 - 1.0) : 0.0) + (n > 1.0 ? v2 * v2 / (n - 1.0) : 0.0);
+            const double df = (v1 + v2) * (v1 + v2) / df_terms;
+            verdict.p_value = detail::student_t_upper_tail(t, df);
+        }
+        verdict.regressed = options.max_slowdown_percent > 0.0 &&
+                            verdict.slowdown_percent > options.max_slowdown_percent &&
+                            verdict.p_value < options.significance;
+        return verdict;
+    }
+} // namespace Fortest
+
+#endif // FORTEST_BENCHMARK_HPP
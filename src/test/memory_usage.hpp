@@ -0,0 +1,228 @@
+#ifndef FORTEST_MEMORY_USAGE_HPP
+#define FORTEST_MEMORY_USAGE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include <sys/resource.h>
+
+#include "fork_guard.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Resident memory of one test run.
+     *
+     * @details
+     * `rss_delta_bytes` is the change of the process's resident set over
+     * the test body; `peak_rss_bytes` is the process's resident high-water
+     * mark when the body finished, reset before the body where the kernel
+     * allows it. Both describe the whole process, so they are exact for
+     * serial and forked runs. When another test body runs in the same
+     * process at the same time, the delta includes what that test
+     * allocated, and the peak is `peak_not_measured`: resetting the
+     * high-water mark for one test would hide the peak of the other.
+     */
+    struct MemoryUsage {
+        /// Value of `peak_rss_bytes` when the body overlapped another test in the process.
+        static constexpr std::int64_t peak_not_measured = -1;
+
+        std::int64_t rss_delta_bytes = 0; //!< Resident set after the body minus before
+        std::int64_t peak_rss_bytes = 0;  //!< Resident high-water mark during the body
+        bool measured = false;            //!< Whether memory was tracked for the run
+
+        /// @brief Whether `peak_rss_bytes` holds a peak.
+        [[nodiscard]] bool has_peak() const noexcept { return peak_rss_bytes != peak_not_measured; }
+
+        /// @brief Accumulate another run: deltas add up, the peak is the largest, unless one is not measured.
+        MemoryUsage &operator+=(const MemoryUsage &other) noexcept {
+            if (!other.measured) return *this;
+            rss_delta_bytes += other.rss_delta_bytes;
+            peak_rss_bytes = (measured && !has_peak()) || !other.has_peak()
+                                 ? peak_not_measured
+                                 : std::max(peak_rss_bytes, other.peak_rss_bytes);
+            measured = true;
+            return *this;
+        }
+
+        /// @brief Human-readable summary, e.g. `rss +12.0 MiB, peak 80.5 MiB`.
+        [[nodiscard]] std::string summary() const {
+            char text[64];
+            if (!has_peak()) {
+                std::snprintf(text, sizeof(text), "rss %+.1f MiB, peak not measured", to_mib(rss_delta_bytes));
+            } else {
+                std::snprintf(text, sizeof(text), "rss %+.1f MiB, peak %.1f MiB",
+                              to_mib(rss_delta_bytes), to_mib(peak_rss_bytes));
+            }
+            return text;
+        }
+
+        [[nodiscard]] static double to_mib(std::int64_t bytes) noexcept {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+    };
+
+    /**
+     * @brief Tracks the resident memory of test bodies.
+     *
+     * @details
+     * configure() switches tracking on or off for the whole process. A
+     * Region reads `/proc/self/status` before and after the body and, on
+     * Linux 4.0 and later, resets the high-water mark through
+     * `/proc/self/clear_refs` so each test reports its own peak. Without
+     * procfs only the peak is known, from `getrusage`, and it is never
+     * reset.
+     *
+     * The high-water mark belongs to the process. Only a Region that
+     * starts while no other one is open resets it, and a Region that
+     * overlaps another, because concurrent workers run tests on threads,
+     * reports its peak as not measured.
+     */
+    class MemoryTracking {
+        static inline std::atomic<bool> s_enabled{false};
+        static inline std::atomic<int> s_open{0};              //!< Regions open in the process
+        static inline std::atomic<std::uint64_t> s_started{0}; //!< Regions started so far
+        static inline thread_local int s_open_here = 0;        //!< Regions open on this thread
+        static inline thread_local std::int64_t s_region_start = -1; //!< RSS when the thread's body began
+        static inline thread_local std::uint64_t s_region_started = 0; //!< s_started after it began
+        static inline thread_local bool s_region_shared = false; //!< Whether it began beside another
+
+    public:
+        /// @brief Start or stop tracking for the following tests.
+        static void configure(bool enabled) noexcept { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+        /// @brief Whether tracking is configured on.
+        [[nodiscard]] static bool enabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+        /// @brief Resident set of the process in bytes; 0 if unknown.
+        [[nodiscard]] static std::int64_t current_rss_bytes() noexcept { return status_bytes("VmRSS:"); }
+
+        /// @brief Resident high-water mark of the process in bytes.
+        [[nodiscard]] static std::int64_t peak_rss_bytes() noexcept {
+            if (const std::int64_t peak = status_bytes("VmHWM:"); peak > 0) return peak;
+            rusage usage{};
+            if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+            return usage.ru_maxrss;
+#else
+            return static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+        }
+
+        /**
+         * @brief Growth of the peak resident memory during the current test body.
+         *
+         * Measured from the resident set at the start of the body, if
+         * tracking is on; otherwise the whole process's peak.
+         *
+         * @return The growth in bytes, or MemoryUsage::peak_not_measured
+         *         if another test body ran in the process meanwhile.
+         */
+        [[nodiscard]] static std::int64_t peak_growth_bytes() noexcept {
+            if (s_region_start >= 0 && (s_region_shared || s_started.load() != s_region_started)) {
+                return MemoryUsage::peak_not_measured;
+            }
+            const std::int64_t peak = peak_rss_bytes();
+            return s_region_start < 0 ? peak : std::max<std::int64_t>(peak - s_region_start, 0);
+        }
+
+        /**
+         * @brief Memory used between construction and stop().
+         *
+         * Reads nothing unless tracking is enabled.
+         */
+        class Region {
+            std::int64_t m_start = -1;
+            std::uint64_t m_started = 0;
+            bool m_shared = false;
+            mutable bool m_open = false;
+            std::int64_t m_previous = -1;
+            std::uint64_t m_previous_started = 0;
+            bool m_previous_shared = false;
+
+        public:
+            Region() noexcept {
+                if (!enabled()) return;
+                static const bool forks_handled = (ForkGuard::on_fork(nullptr, nullptr, child_after_fork), true);
+                (void) forks_handled;
+                m_shared = s_open.fetch_add(1) > 0;
+                ++s_open_here;
+                m_open = true;
+                if (!m_shared) reset_peak();
+                m_started = s_started.fetch_add(1) + 1;
+                m_start = current_rss_bytes();
+                m_previous = std::exchange(s_region_start, m_start);
+                m_previous_started = std::exchange(s_region_started, m_started);
+                m_previous_shared = std::exchange(s_region_shared, m_shared);
+            }
+
+            Region(const Region &) = delete;
+            Region &operator=(const Region &) = delete;
+
+            ~Region() {
+                if (m_start < 0) return;
+                close();
+                s_region_start = m_previous;
+                s_region_started = m_previous_started;
+                s_region_shared = m_previous_shared;
+            }
+
+            /**
+             * @brief Usage since construction; not measured if tracking is off.
+             *
+             * The peak is MemoryUsage::peak_not_measured if another Region
+             * was open at any time in between.
+             */
+            [[nodiscard]] MemoryUsage stop() const noexcept {
+                if (m_start < 0) return {};
+                const bool shared = m_shared || s_started.load() != m_started;
+                const std::int64_t peak = shared ? MemoryUsage::peak_not_measured : peak_rss_bytes();
+                const std::int64_t delta = current_rss_bytes() - m_start;
+                close();
+                return MemoryUsage{delta, peak, true};
+            }
+
+        private:
+            void close() const noexcept {
+                if (!std::exchange(m_open, false)) return;
+                --s_open_here;
+                s_open.fetch_sub(1);
+            }
+        };
+
+    private:
+        /// @brief Only the regions of the forking thread are open in the child.
+        static void child_after_fork() noexcept { s_open.store(s_open_here); }
+
+        /// @brief Value of a `kB` line of `/proc/self/status`, in bytes; 0 if absent.
+        [[nodiscard]] static std::int64_t status_bytes(const char *key) noexcept {
+            std::FILE *file = std::fopen("/proc/self/status", "r");
+            if (!file) return 0;
+            char line[128];
+            long long kib = 0;
+            const std::size_t length = std::strlen(key);
+            while (std::fgets(line, sizeof(line), file)) {
+                if (std::strncmp(line, key, length) == 0) {
+                    std::sscanf(line + length, "%lld", &kib);
+                    break;
+                }
+            }
+            std::fclose(file);
+            return static_cast<std::int64_t>(kib) * 1024;
+        }
+
+        /// @brief Reset the resident high-water mark to the current resident set, where supported.
+        static void reset_peak() noexcept {
+            if (std::FILE *file = std::fopen("/proc/self/clear_refs", "w")) {
+                std::fputs("5", file);
+                std::fclose(file);
+            }
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_MEMORY_USAGE_HPP
@@ -0,0 +1,189 @@
+#ifndef FORTEST_PARAMETER_SPACE_HPP
+#define FORTEST_PARAMETER_SPACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Fortest {
+    /**
+     * @brief Arithmetic sequence of parameter values, `start, start + stride, ...`.
+     *
+     * Follows the Fortran `do` loop convention: `stop` is included when
+     * the sequence reaches it exactly, and a range whose stride points
+     * away from `stop` is empty.
+     */
+    struct ParameterRange {
+        int start = 0;   //!< First value
+        int stop = 0;    //!< Last value, inclusive
+        int stride = 1;  //!< Step between values; must not be zero
+
+        /// @brief Number of values (the trip count of the equivalent `do` loop).
+        [[nodiscard]] std::size_t size() const noexcept {
+            const std::int64_t count =
+                (static_cast<std::int64_t>(stop) - start + stride) / stride;
+            return count > 0 ? static_cast<std::size_t>(count) : 0;
+        }
+
+        /// @brief Value number `k`, counted from 0.
+        [[nodiscard]] int operator[](std::size_t k) const noexcept {
+            return static_cast<int>(start + static_cast<std::int64_t>(k) * stride);
+        }
+    };
+
+    /**
+     * @brief The cases of a parameterized test, generated on demand.
+     *
+     * @details
+     * A space is either an explicit list of values or the Cartesian
+     * product of one or more ParameterRange. Ranges are never expanded:
+     * size() and operator[] are computed from the descriptors, so a sweep
+     * over millions of cases costs a few integers until it runs.
+     *
+     * Each case has a number `k` in `[0, size())`. The value handed to
+     * the test body for case `k` is `operator[](k)`:
+     * - for a list, its `k`-th element;
+     * - for a single range, its `k`-th value;
+     * - for a product of several ranges, `k` itself. The body recovers
+     *   the value along each range with coordinate(); the first range
+     *   varies fastest, like the subscripts of a Fortran array.
+     */
+    class ParameterSpace {
+        std::vector<int> m_values;              //!< Explicit values; empty for ranges
+        std::vector<ParameterRange> m_ranges;   //!< Ranges of a product, first fastest
+        std::size_t m_size = 0;                 //!< Number of cases
+
+    public:
+        /// Input iterator over the values passed to the test body.
+        class const_iterator {
+            const ParameterSpace *m_space = nullptr;
+            std::size_t m_case = 0;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = int;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = int;
+
+            const_iterator() = default;
+            const_iterator(const ParameterSpace *space, std::size_t k) noexcept : m_space(space), m_case(k) {}
+
+            int operator*() const { return (*m_space)[m_case]; }
+            const_iterator &operator++() noexcept { ++m_case; return *this; }
+            const_iterator operator++(int) noexcept { auto copy = *this; ++m_case; return copy; }
+            bool operator==(const const_iterator &other) const noexcept { return m_case == other.m_case; }
+        };
+
+        using value_type = int;
+        using size_type = std::size_t;
+        using iterator = const_iterator;
+
+        ParameterSpace() = default;
+
+        /// @brief Explicit list of values, one case each.
+        ParameterSpace(std::vector<int> values) : m_values(std::move(values)), m_size(m_values.size()) {}
+
+        /// @brief Explicit list of values, one case each.
+        ParameterSpace(std::initializer_list<int> values) : ParameterSpace(std::vector<int>(values)) {}
+
+        /// @brief Values `start, start + stride, ...` up to and including `stop`.
+        [[nodiscard]] static ParameterSpace range(int start, int stop, int stride = 1) {
+            return product({ParameterRange{start, stop, stride}});
+        }
+
+        /**
+         * @brief Every combination of one value from each range.
+         * @throws std::invalid_argument if a stride is zero or the case
+         *         numbers of a product do not fit an `int`.
+         */
+        [[nodiscard]] static ParameterSpace product(std::vector<ParameterRange> ranges) {
+            ParameterSpace space;
+            space.m_size = ranges.empty() ? 0 : 1;
+            for (const auto &range : ranges) {
+                if (range.stride == 0) {
+                    throw std::invalid_argument("ParameterSpace: range stride must not be zero");
+                }
+                space.m_size *= range.size();
+                if (ranges.size() > 1 && space.m_size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+                    throw std::invalid_argument("ParameterSpace: product has more cases than fit an int");
+                }
+            }
+            space.m_ranges = std::move(ranges);
+            return space;
+        }
+
+        /// @brief Number of cases.
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        /// @brief Number of ranges in the product; 0 for an explicit list.
+        [[nodiscard]] std::size_t rank() const noexcept { return m_ranges.size(); }
+
+        /// @brief Whether the test body receives case numbers rather than values.
+        [[nodiscard]] bool is_product() const noexcept { return m_ranges.size() > 1; }
+
+        [[nodiscard]] const std::vector<ParameterRange> &ranges() const noexcept { return m_ranges; }
+
+        /// @brief Value passed to the test body for case `k`.
+        [[nodiscard]] int operator[](std::size_t k) const {
+            if (m_ranges.empty()) return m_values[k];
+            if (m_ranges.size() == 1) return m_ranges.front()[k];
+            return static_cast<int>(k);
+        }
+
+        /// @brief Value of range `dim` in case `k` of a product.
+        [[nodiscard]] int coordinate(std::size_t k, std::size_t dim) const {
+            for (std::size_t d = 0; d < dim; ++d) k /= m_ranges[d].size();
+            return m_ranges[dim][k % m_ranges[dim].size()];
+        }
+
+        /**
+         * @brief Number of the case whose body receives `value`.
+         *
+         * O(1) for ranges, linear for an explicit list; the first match
+         * wins if a list repeats a value.
+         */
+        [[nodiscard]] std::optional<std::size_t> find(int value) const {
+            if (m_ranges.empty()) {
+                const auto it = std::ranges::find(m_values, value);
+                if (it == m_values.end()) return std::nullopt;
+                return static_cast<std::size_t>(it - m_values.begin());
+            }
+            if (m_ranges.size() > 1) {
+                if (value < 0 || static_cast<std::size_t>(value) >= m_size) return std::nullopt;
+                return static_cast<std::size_t>(value);
+            }
+            const auto &range = m_ranges.front();
+            const std::int64_t offset = static_cast<std::int64_t>(value) - range.start;
+            if (offset % range.stride != 0) return std::nullopt;
+            const std::int64_t k = offset / range.stride;
+            if (k < 0 || static_cast<std::size_t>(k) >= m_size) return std::nullopt;
+            return static_cast<std::size_t>(k);
+        }
+
+        /// @brief Case `k` as shown in logs: the value, or the coordinates of a product, e.g. `(2,7)`.
+        [[nodiscard]] std::string label(std::size_t k) const {
+            if (!is_product()) return std::to_string((*this)[k]);
+            std::string text = "(";
+            for (std::size_t dim = 0; dim < m_ranges.size(); ++dim) {
+                if (dim > 0) text += ',';
+                text += std::to_string(coordinate(k, dim));
+            }
+            return text + ")";
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+        [[nodiscard]] const_iterator end() const noexcept { return {this, m_size}; }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_PARAMETER_SPACE_HPP
@@ -1,10 +1,13 @@
 #ifndef FORTEST_PARAMETERIZED_TEST_HPP
 #define FORTEST_PARAMETERIZED_TEST_HPP
 
+#include <cstdint>
 #include <functional>
-#include "db.hpp"
-#include <map>
+#include "timing.hpp"
+#include "status_counts.hpp"
+#include "parameter_space.hpp"
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -12,6 +15,7 @@
 #include "fixture.hpp"
 #include "assert.hpp"
 #include "logging.hpp"
+#include "watchdog.hpp"
 
 namespace Fortest {
 
@@ -22,13 +26,43 @@ namespace Fortest {
     /**
      * @brief Represents a parameterized test case.
      *
-     * A ParameterizedTest holds a test function, parameter values,
-     * optional fixtures (test, suite, session), a name, and the result status.
+     * A ParameterizedTest holds a test function, its ParameterSpace,
+     * optional fixtures (test, suite, session), a name, and the result
+     * status of each case.
+     *
+     * Cases are addressed by their number in the space. Statuses are kept
+     * in a dense array of one byte per case, allocated when the first
+     * case finishes; durations are only accumulated, so the memory of a
+     * sweep does not grow with its per-case timings.
      */
     class ParameterizedTest {
     public:
-        /// Test execution status.
-        enum class Status { PASS, FAIL, NONE };
+        /// Test execution status (see Test::Status).
+        enum class Status : std::uint8_t { PASS, FAIL, NONE, CRASH, TIMEOUT, CACHED };
+
+        /**
+         * @brief Results of some cases, gathered apart from the test.
+         *
+         * Workers running different cases of the same test concurrently
+         * each collect their changes to the counts and durations here and
+         * hand them to merge_tally() once they are done.
+         */
+        struct CaseTally {
+            StatusCounts counts;  //!< Change of the count per status (entries may be negative)
+            TestTiming timing;    //!< Durations of the cases run
+        };
+
+        /// @brief Name of a status as logged and stored in the results database.
+        [[nodiscard]] static constexpr const char *status_name(Status status) noexcept {
+            switch (status) {
+                case Status::PASS: return "PASS";
+                case Status::FAIL: return "FAIL";
+                case Status::CRASH: return "CRASH";
+                case Status::TIMEOUT: return "TIMEOUT";
+                case Status::CACHED: return "CACHED";
+                default: return "NONE";
+            }
+        }
 
     private:
         ParameterizedTestFunction m_test;                   //!< Test body
@@ -36,23 +70,38 @@ namespace Fortest {
         std::shared_ptr<Fixture<void>> m_suite_fixture;     //!< Suite-level fixture
         std::shared_ptr<Fixture<void>> m_session_fixture;   //!< Session-level fixture
         std::string m_name;                                 //!< Test name
-        std::vector<int> m_parameters;                      //!< Parameter indices
-        std::map<int, Status> m_status_map;                 //!< Status per parameter
+        ParameterSpace m_parameters;                        //!< Cases to run
+        std::vector<Status> m_statuses;                     //!< Status per case; empty until one finishes
+        TestTiming m_total_timing;                          //!< Durations of the cases run so far
+        StatusCounts m_counts;                              //!< Cases per status
+
+        /// @brief Case number of a parameter value.
+        [[nodiscard]] std::size_t case_of(int idx) const {
+            const auto k = m_parameters.find(idx);
+            if (!k) {
+                throw std::out_of_range("Parameterized test " + m_name + " has no parameter "
+                                        + std::to_string(idx));
+            }
+            return *k;
+        }
 
     public:
         /**
          * @brief Construct a parameterized test with a name, function, and parameter set.
          * @param name Test name.
          * @param test Test function (takes test, suite, session args, and index).
-         * @param parameters List of parameter indices to run.
+         * @param parameters Cases to run: a list of values or a ParameterSpace of ranges.
          */
         explicit ParameterizedTest(
             std::string name,
             ParameterizedTestFunction test,
-            std::vector<int> parameters)
+            ParameterSpace parameters)
             : m_test(std::move(test)),
               m_name(std::move(name)),
-              m_parameters(std::move(parameters)) {}
+              m_parameters(std::move(parameters)) {
+            m_counts.by_status[StatusCounts::index(Status::NONE)] =
+                static_cast<std::int64_t>(m_parameters.size());
+        }
 
         /// @brief Get the name of the test.
         [[nodiscard]] const std::string &get_name() const { return m_name; }
@@ -83,84 +132,239 @@ namespace Fortest {
          * @param assert Assertion manager used to track results.
          */
         template <LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType = TestLoggerType>
-        void run(const std::shared_ptr<TestLoggerType> &logger, Assert<AssertLoggerType> &assert,
-            const std::optional<SqliteDb> &db = std::nullopt) {
+        void run(const std::shared_ptr<TestLoggerType> &logger, Assert<AssertLoggerType> &assert) {
+            reset_total_timing();
+            for (std::size_t k = 0; k < m_parameters.size(); ++k) {
+                run_case(k, logger, assert, attached_fixtures());
+            }
+        }
+
+        /**
+         * @brief Run the test for a single parameter value.
+         *
+         * @param idx Parameter value to run; must belong to the test's cases.
+         * @param logger Shared pointer to a logger.
+         * @param assert Assertion manager used to track results.
+         * @throws std::out_of_range if no case has the value `idx`.
+         */
+        template <LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType = TestLoggerType>
+        void run_parameter(int idx, const std::shared_ptr<TestLoggerType> &logger,
+                           Assert<AssertLoggerType> &assert) {
+            run_case(case_of(idx), logger, assert, attached_fixtures());
+        }
+
+        /**
+         * @brief Run case number `k` with the given fixtures.
+         *
+         * Used by test suites, which own the fixtures of all their tests.
+         * The status is recorded and the durations are added to the total.
+         *
+         * @param k Case number, in `[0, get_num_cases())`.
+         * @param logger Shared pointer to a logger.
+         * @param assert Assertion manager used to track results.
+         * @param fixtures Fixtures used instead of those attached with add_fixture().
+         * @return Durations of the case.
+         */
+        template <LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType = TestLoggerType>
+        TestTiming run_case(std::size_t k, const std::shared_ptr<TestLoggerType> &logger,
+                            Assert<AssertLoggerType> &assert, const FixtureSet &fixtures) {
+            prepare_results();
+            CaseTally tally;
+            try {
+                const TestTiming timing = run_case(k, logger, assert, fixtures, tally);
+                merge_tally(tally);
+                return timing;
+            } catch (...) {
+                merge_tally(tally);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Run case number `k`, collecting the outcome in `tally`.
+         *
+         * Writes only the status slot of case `k`, so different cases may
+         * run concurrently once prepare_results() has been called.
+         *
+         * @param k Case number, in `[0, get_num_cases())`.
+         * @param logger Shared pointer to a logger.
+         * @param assert Assertion manager used to track results.
+         * @param fixtures Fixtures the case runs with.
+         * @param tally Receives the change of counts and the durations.
+         * @return Durations of the case.
+         */
+        template <LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType = TestLoggerType>
+        TestTiming run_case(std::size_t k, const std::shared_ptr<TestLoggerType> &logger,
+                            Assert<AssertLoggerType> &assert, const FixtureSet &fixtures,
+                            CaseTally &tally) {
             void *test_args = nullptr;
             void *suite_args = nullptr;
             void *session_args = nullptr;
+            Stopwatch stopwatch;
+            TestTiming timing;
 
-            if (m_suite_fixture) {
-                suite_args = m_suite_fixture->get_args();
+            if (fixtures.suite) {
+                suite_args = fixtures.suite->get_args();
+            }
+            if (fixtures.session) {
+                session_args = fixtures.session->get_args();
             }
-            if (m_session_fixture) {
-                session_args = m_session_fixture->get_args();
+            if (fixtures.test) {
+                test_args = fixtures.test->get_args();
+                fixtures.test->setup();
             }
 
-            for (int idx : m_parameters) {
-                if (m_test_fixture) {
-                    test_args = m_test_fixture->get_args();
-                    m_test_fixture->setup();
-                }
+            assert.reset();
+
+            const int idx = m_parameters[k];
+            std::string variation_name = this->variation_name(k);
+            logger->log("Running parameterized test: " + variation_name, "INFO", test_border());
 
-                assert.reset();
-
-                std::string variation_name = m_name + " [param=" + std::to_string(idx) + "]";
-                std::string border = "\n" + std::string(40, '=');
-
-                logger->log("Running parameterized test: " + variation_name, "INFO", border);
-
-                try {
-                    m_test(test_args, suite_args, session_args, idx);
-
-                    m_status_map[idx] =
-                        (assert.get_num_failed() == 0)
-                        ? Status::PASS
-                        : Status::FAIL;
-                    if (db.has_value()) {
-                        SqliteStmt stmt(db.value().get(),
-                                        "INSERT INTO test_results (test_name, status, duration_ms) "
-                                        "VALUES (?, ?, ?);");
-                        std::string status_str = (m_status_map[idx] == Status::PASS)
-                                                     ? "PASS"
-                                                     : "FAIL";
-                        sqlite3_bind_text(stmt.get(), 1, variation_name.c_str(), -1,
-                                          SQLITE_TRANSIENT);
-                        sqlite3_bind_text(stmt.get(), 2, status_str.c_str(), -1,
-                                          SQLITE_TRANSIENT);
-                        sqlite3_bind_int(stmt.get(), 3, 0);
-                        stmt.step();
-                    }
-
-                    if (m_status_map[idx] == Status::PASS) {
-                        logger->log("Test passed: " + variation_name, "PASS");
-                    } else {
-                        logger->log("Test failed: " + variation_name, "FAIL");
-                    }
-
-                    if (m_test_fixture) {
-                        m_test_fixture->teardown();
-                    }
-                } catch (...) {
-                    if (m_test_fixture) {
-                        m_test_fixture->teardown();
-                    }
-                    m_status_map[idx] = Status::FAIL;
-                    logger->log("Test threw exception: " + variation_name, "FAIL");
-                    throw;
+            const MemoryTracking::Region memory;
+            timing.setup_ns = stopwatch.lap();
+            const std::int64_t cpu_start = Stopwatch::thread_cpu_ns();
+            const PerfCounters::Region perf;
+            try {
+                m_test(test_args, suite_args, session_args, idx);
+            } catch (...) {
+                timing.body_ns = stopwatch.lap();
+                timing.cpu_ns = Stopwatch::thread_cpu_ns() - cpu_start;
+                timing.counters = perf.stop();
+                timing.memory = memory.stop();
+                if (fixtures.test) {
+                    fixtures.test->teardown();
                 }
+                timing.teardown_ns = stopwatch.lap();
+                record(k, Status::FAIL, timing, tally);
+                logger->log("Test threw exception: " + variation_name, "FAIL");
+                throw;
+            }
+            timing.body_ns = stopwatch.lap();
+            timing.cpu_ns = Stopwatch::thread_cpu_ns() - cpu_start;
+            timing.counters = perf.stop();
+            timing.memory = memory.stop();
+
+            const Status status = TestCancellation::requested() ? Status::TIMEOUT
+                                  : assert.get_num_failed() == 0 ? Status::PASS
+                                                                 : Status::FAIL;
+            if (fixtures.test) {
+                fixtures.test->teardown();
+            }
+            timing.teardown_ns = stopwatch.lap();
+            record(k, status, timing, tally);
+
+            if (status == Status::PASS) {
+                logger->log("Test passed: " + variation_name + " " + timing.summary(), "PASS");
+            } else if (status == Status::TIMEOUT) {
+                logger->log("Test timed out: " + variation_name + " " + timing.summary(), "TIMEOUT");
+            } else {
+                logger->log("Test failed: " + variation_name + " " + timing.summary() +
+                            assert.thread_failure_report(), "FAIL");
             }
+            return timing;
+        }
+
+        /// @brief Display name of case number `k`, e.g. `name [param=3]` or `name [param=(1,4)]`.
+        [[nodiscard]] std::string variation_name(std::size_t k) const {
+            return m_name + " [param=" + m_parameters.label(k) + "]";
         }
 
-        /// @brief Get the status for a specific parameter index.
+        /// @brief Status of the case with parameter value `idx` (NONE if there is none).
         [[nodiscard]] Status get_status(int idx) const {
-            auto it = m_status_map.find(idx);
-            return (it != m_status_map.end()) ? it->second : Status::NONE;
+            const auto k = m_parameters.find(idx);
+            return k ? get_case_status(*k) : Status::NONE;
+        }
+
+        /// @brief Status of case number `k`.
+        [[nodiscard]] Status get_case_status(std::size_t k) const {
+            return m_statuses.empty() ? Status::NONE : m_statuses[k];
+        }
+
+        /**
+         * @brief Record the outcome of case number `k`, e.g. one observed
+         * by a forked runner.
+         *
+         * Replaces the status of the case and adds `timing` to the total.
+         */
+        void record_result(std::size_t k, Status status, const TestTiming &timing) {
+            prepare_results();
+            CaseTally tally;
+            record(k, status, timing, tally);
+            merge_tally(tally);
+        }
+
+        /// @brief Allocate the status of every case, before cases run concurrently.
+        void prepare_results() {
+            if (m_statuses.empty()) m_statuses.assign(m_parameters.size(), Status::NONE);
+        }
+
+        /// @brief Apply the results collected by a concurrent worker. Not thread-safe.
+        void merge_tally(const CaseTally &tally) noexcept {
+            for (std::size_t i = 0; i < tally.counts.by_status.size(); ++i) {
+                m_counts.by_status[i] += tally.counts.by_status[i];
+            }
+            m_total_timing += tally.timing;
         }
 
-        /// @brief Get all parameter indices.
-        [[nodiscard]] const std::vector<int>& get_parameters() const {
+        /// @brief Status of every case (empty until prepare_results() or the first result).
+        [[nodiscard]] const std::vector<Status> &get_case_statuses() const noexcept { return m_statuses; }
+
+        /**
+         * @brief Replace the results of all cases, e.g. with those merged
+         * from other processes that ran part of them.
+         *
+         * @param statuses Status of every case.
+         * @param total_timing Durations of all cases added together.
+         * @throws std::invalid_argument if `statuses` does not have one entry per case.
+         */
+        void assign_results(std::vector<Status> statuses, const TestTiming &total_timing) {
+            if (statuses.size() != m_parameters.size()) {
+                throw std::invalid_argument("Parameterized test " + m_name + ": expected "
+                                            + std::to_string(m_parameters.size()) + " statuses");
+            }
+            m_statuses = std::move(statuses);
+            m_counts = StatusCounts{};
+            for (const Status status : m_statuses) m_counts.add(status);
+            m_total_timing = total_timing;
+        }
+
+        /// @brief Number of cases in each status, maintained as they run.
+        [[nodiscard]] const StatusCounts &get_status_counts() const { return m_counts; }
+
+        /**
+         * @brief Status of the test as a whole, in O(1).
+         *
+         * The most severe failure wins (CRASH, then TIMEOUT, then FAIL);
+         * otherwise the result is PASS if any case passed and NONE if none
+         * has run.
+         */
+        [[nodiscard]] Status get_summary_status() const { return m_counts.summary<Status>(); }
+
+        /// @brief Durations of the cases run since the last reset_total_timing(), added together.
+        [[nodiscard]] const TestTiming &get_total_timing() const { return m_total_timing; }
+
+        /// @brief Start a new run: forget the durations accumulated so far.
+        void reset_total_timing() noexcept { m_total_timing = TestTiming{}; }
+
+        /// @brief Number of cases.
+        [[nodiscard]] std::size_t get_num_cases() const noexcept { return m_parameters.size(); }
+
+        /// @brief The cases of the test; iterating yields the values passed to the body.
+        [[nodiscard]] const ParameterSpace &get_parameters() const {
             return m_parameters;
         }
+
+    private:
+        /// @brief Set the status of case `k`, noting the change in `tally`.
+        void record(std::size_t k, Status status, const TestTiming &timing, CaseTally &tally) noexcept {
+            tally.counts.move(m_statuses[k], status);
+            m_statuses[k] = status;
+            tally.timing += timing;
+        }
+
+        [[nodiscard]] FixtureSet attached_fixtures() const noexcept {
+            return FixtureSet{m_test_fixture.get(), m_suite_fixture.get(), m_session_fixture.get()};
+        }
     };
 
 } // namespace Fortest
@@ -0,0 +1,286 @@
+#ifndef FORTEST_PERF_COUNTERS_HPP
+#define FORTEST_PERF_COUNTERS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Fortest {
+    /**
+     * @brief Hardware event counts of one test run.
+     *
+     * @details
+     * Counts are taken around the test body only, in user space, for the
+     * thread running it. An event is present if its bit is set in
+     * `counted`; a counter the CPU or kernel does not offer stays absent.
+     * Counts of a multiplexed counter are scaled to the whole body.
+     */
+    struct PerfCounts {
+        /// Counted events, in the order of `values`.
+        enum Event : std::size_t {
+            Cycles,          ///< CPU cycles
+            Instructions,    ///< Retired instructions
+            CacheReferences, ///< Last-level cache accesses
+            CacheMisses,     ///< Last-level cache misses
+            BranchMisses,    ///< Mispredicted branches
+            Flops,           ///< Floating-point operations (raw event, see PerfEventOptions)
+            NumEvents
+        };
+
+        /// Bytes moved by one last-level cache miss, for the bandwidth estimate.
+        static constexpr std::int64_t cache_line_bytes = 64;
+
+        std::array<std::int64_t, NumEvents> values{}; //!< Count per event
+        std::uint32_t counted = 0;                    //!< Bit `1 << e` set if event `e` was counted
+
+        [[nodiscard]] bool has(Event event) const noexcept { return (counted >> event) & 1U; }
+
+        /// @brief Whether any event was counted.
+        [[nodiscard]] bool measured() const noexcept { return counted != 0; }
+
+        [[nodiscard]] std::int64_t operator[](Event event) const noexcept { return values[event]; }
+
+        /// @brief Name of an event as logged and stored in the results database.
+        [[nodiscard]] static constexpr const char *event_name(Event event) noexcept {
+            switch (event) {
+                case Cycles: return "cycles";
+                case Instructions: return "instructions";
+                case CacheReferences: return "cache_references";
+                case CacheMisses: return "cache_misses";
+                case BranchMisses: return "branch_misses";
+                case Flops: return "flops";
+                default: return "";
+            }
+        }
+
+        /// @brief Accumulate another run, e.g. the cases of a parameterized test.
+        PerfCounts &operator+=(const PerfCounts &other) noexcept {
+            for (std::size_t e = 0; e < NumEvents; ++e) values[e] += other.values[e];
+            counted |= other.counted;
+            return *this;
+        }
+
+        /**
+         * @brief Human-readable summary, appended to log lines.
+         * @param body_ns Duration of the counted body, for the rates.
+         * @return E.g. `cycles 2.1e+06, instructions 4.3e+06, IPC 2.05, LLC misses 1.2e+03, ~0.15 GB/s`;
+         *         empty if nothing was counted.
+         */
+        [[nodiscard]] std::string summary(std::int64_t body_ns) const {
+            std::string text;
+            char part[64];
+            auto append = [&](const char *format, double value) {
+                std::snprintf(part, sizeof(part), format, value);
+                if (!text.empty()) text += ", ";
+                text += part;
+            };
+            if (has(Cycles)) append("cycles %.3g", static_cast<double>(values[Cycles]));
+            if (has(Instructions)) append("instructions %.3g", static_cast<double>(values[Instructions]));
+            if (has(Cycles) && has(Instructions) && values[Cycles] > 0) {
+                append("IPC %.2f", static_cast<double>(values[Instructions]) / static_cast<double>(values[Cycles]));
+            }
+            if (has(CacheMisses)) append("LLC misses %.3g", static_cast<double>(values[CacheMisses]));
+            if (has(BranchMisses)) append("branch misses %.3g", static_cast<double>(values[BranchMisses]));
+            if (has(Flops)) append("flops %.3g", static_cast<double>(values[Flops]));
+            if (body_ns > 0) {
+                // Bytes per nanosecond are GB/s.
+                if (has(Flops)) append("%.3g GFLOP/s", static_cast<double>(values[Flops]) / static_cast<double>(body_ns));
+                if (has(CacheMisses)) {
+                    append("~%.3g GB/s", static_cast<double>(values[CacheMisses] * cache_line_bytes) /
+                                         static_cast<double>(body_ns));
+                }
+            }
+            return text;
+        }
+    };
+
+    /// Which hardware events are counted around test bodies.
+    struct PerfEventOptions {
+        bool enabled = false;          //!< Count events at all; off costs one relaxed load per test
+        std::uint64_t flops_event = 0; //!< Raw PMU event code counting floating-point operations; 0 skips FLOPs
+    };
+
+    /**
+     * @brief Per-thread hardware event counters, through Linux `perf_event_open`.
+     *
+     * @details
+     * configure() switches counting on or off for the whole process.
+     * Each thread that runs a test opens its own counter group on first
+     * use (and again after a fork or a new configuration), so tests on
+     * concurrent workers count only their own events. Where counters
+     * cannot be opened, e.g. with `perf_event_paranoid` above 2, in
+     * containers without PMU access, or on other systems, a Region
+     * simply yields no counts.
+     */
+    class PerfCounters {
+        struct Group;
+
+    public:
+        /// @brief Start or stop counting for the following tests, on every thread.
+        static void configure(const PerfEventOptions &options) noexcept {
+            s_flops_event.store(options.flops_event, std::memory_order_relaxed);
+            s_generation.fetch_add(1, std::memory_order_relaxed);
+            s_enabled.store(options.enabled, std::memory_order_release);
+        }
+
+        /// @brief Whether counting is configured on.
+        [[nodiscard]] static bool enabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+        /// @brief Whether the calling thread can count at least one event.
+        [[nodiscard]] static bool available() noexcept { return thread_group() != nullptr; }
+
+        /**
+         * @brief Counts of the events between construction and stop().
+         *
+         * Reads nothing and counts nothing unless counting is enabled.
+         */
+        class Region {
+        public:
+            Region() noexcept {
+                if (enabled()) {
+                    m_group = thread_group();
+                    if (m_group) m_start = m_group->read();
+                }
+            }
+
+            /// @brief Counts since construction; empty if counting is off or unavailable.
+            [[nodiscard]] PerfCounts stop() const noexcept {
+                if (!m_group) return {};
+                PerfCounts counts = m_group->read();
+                for (std::size_t e = 0; e < PerfCounts::NumEvents; ++e) counts.values[e] -= m_start.values[e];
+                return counts;
+            }
+
+        private:
+            Group *m_group = nullptr;
+            PerfCounts m_start;
+        };
+
+    private:
+        inline static std::atomic<bool> s_enabled{false};
+        inline static std::atomic<std::uint64_t> s_flops_event{0};
+        inline static std::atomic<unsigned> s_generation{0};
+
+#if defined(__linux__)
+        /// Counter group of one thread; the first open event leads it.
+        struct Group {
+            int leader = -1;
+            std::array<PerfCounts::Event, PerfCounts::NumEvents> events{}; //!< Event of each group member
+            std::size_t size = 0;
+            std::uint32_t counted = 0;
+            pid_t pid = 0;            //!< Process that opened the group
+            unsigned generation = ~0U;
+
+            Group() = default;
+            Group(const Group &) = delete;
+            Group &operator=(const Group &) = delete;
+            ~Group() { close(); }
+
+            void close() noexcept {
+                for (int fd : fds) {
+                    if (fd >= 0) ::close(fd);
+                }
+                fds.fill(-1);
+                leader = -1;
+                size = 0;
+                counted = 0;
+            }
+
+            void open(std::uint64_t flops_event) noexcept {
+                close();
+                pid = getpid();
+                add(PerfCounts::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+                add(PerfCounts::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+                add(PerfCounts::CacheReferences, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+                add(PerfCounts::CacheMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+                add(PerfCounts::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+                if (flops_event != 0) add(PerfCounts::Flops, PERF_TYPE_RAW, flops_event);
+                if (leader >= 0) {
+                    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                }
+            }
+
+            /// @brief Current totals of the group, scaled for multiplexing.
+            [[nodiscard]] PerfCounts read() const noexcept {
+                PerfCounts counts;
+                struct {
+                    std::uint64_t nr;
+                    std::uint64_t time_enabled;
+                    std::uint64_t time_running;
+                    std::uint64_t values[PerfCounts::NumEvents];
+                } data{};
+                if (::read(leader, &data, sizeof(data)) <= 0 || data.nr != size) return counts;
+                const double scale = data.time_running > 0 && data.time_running < data.time_enabled
+                                         ? static_cast<double>(data.time_enabled) /
+                                           static_cast<double>(data.time_running)
+                                         : 1.0;
+                for (std::size_t i = 0; i < size; ++i) {
+                    counts.values[events[i]] = static_cast<std::int64_t>(static_cast<double>(data.values[i]) * scale);
+                }
+                counts.counted = counted;
+                return counts;
+            }
+
+        private:
+            std::array<int, PerfCounts::NumEvents> fds = filled(-1);
+
+            static std::array<int, PerfCounts::NumEvents> filled(int value) {
+                std::array<int, PerfCounts::NumEvents> a{};
+                a.fill(value);
+                return a;
+            }
+
+            void add(PerfCounts::Event event, std::uint32_t type, std::uint64_t config) noexcept {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = type;
+                attr.config = config;
+                attr.disabled = leader < 0 ? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+                const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                if (fd < 0) return;
+                if (leader < 0) leader = fd;
+                fds[size] = fd;
+                events[size++] = event;
+                counted |= 1U << event;
+            }
+        };
+
+        /// @brief The calling thread's counter group, opened if needed; nullptr if none can be opened.
+        [[nodiscard]] static Group *thread_group() noexcept {
+            thread_local Group group;
+            const unsigned generation = s_generation.load(std::memory_order_relaxed);
+            // A forked child inherits the group of its parent's thread.
+            if (group.generation != generation || group.pid != getpid()) {
+                group.open(s_flops_event.load(std::memory_order_relaxed));
+                group.generation = generation;
+            }
+            return group.leader >= 0 ? &group : nullptr;
+        }
+#else
+        struct Group {
+            [[nodiscard]] PerfCounts read() const noexcept { return {}; }
+        };
+
+        [[nodiscard]] static Group *thread_group() noexcept { return nullptr; }
+#endif
+    };
+} // namespace Fortest
+
+#endif // FORTEST_PERF_COUNTERS_HPP
@@ -0,0 +1,221 @@
+#ifndef FORTEST_STATUS_COUNTS_HPP
+#define FORTEST_STATUS_COUNTS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Fortest {
+    /**
+     * @brief Number of tests (or parameter cases) in each status.
+     *
+     * @details
+     * Indexed by the value of a `Test::Status` or
+     * `ParameterizedTest::Status`, which share their enumerators
+     * (PASS, FAIL, NONE, CRASH, TIMEOUT, CACHED). Owners keep the counts up to
+     * date with move() whenever a status changes, so summaries are read
+     * in O(1) instead of by rescanning every result.
+     */
+    struct StatusCounts {
+        static constexpr std::size_t num_statuses = 6; //!< Enumerators of a status enum
+
+        std::array<std::int64_t, num_statuses> by_status{}; //!< Count per status value
+
+        /// @brief Number of entries in `status`.
+        template<typename Status>
+        [[nodiscard]] std::int64_t operator[](Status status) const noexcept {
+            return by_status[index(status)];
+        }
+
+        /// @brief Count one more entry, in `status`.
+        template<typename Status>
+        void add(Status status) noexcept { ++by_status[index(status)]; }
+
+        /// @brief Move one entry from status `from` to status `to`.
+        template<typename Status>
+        void move(Status from, Status to) noexcept {
+            --by_status[index(from)];
+            ++by_status[index(to)];
+        }
+
+        [[nodiscard]] std::int64_t passed() const noexcept { return by_status[0]; }
+        [[nodiscard]] std::int64_t not_run() const noexcept { return by_status[2]; }
+        [[nodiscard]] std::int64_t cached() const noexcept { return by_status[5]; }
+
+        /// @brief Entries that failed, crashed or timed out.
+        [[nodiscard]] std::int64_t failed() const noexcept {
+            return by_status[1] + by_status[3] + by_status[4];
+        }
+
+        /// @brief All entries.
+        [[nodiscard]] std::int64_t total() const noexcept {
+            std::int64_t sum = 0;
+            for (const auto count : by_status) sum += count;
+            return sum;
+        }
+
+        /**
+         * @brief Status summarizing all entries.
+         *
+         * The most severe failure wins (CRASH, then TIMEOUT, then FAIL);
+         * otherwise the result is PASS if any entry passed, CACHED if
+         * all others were cached, and NONE if none has run.
+         */
+        template<typename Status>
+        [[nodiscard]] Status summary() const noexcept {
+            if (by_status[index(Status::CRASH)] > 0) return Status::CRASH;
+            if (by_status[index(Status::TIMEOUT)] > 0) return Status::TIMEOUT;
+            if (by_status[index(Status::FAIL)] > 0) return Status::FAIL;
+            if (by_status[index(Status::PASS)] > 0) return Status::PASS;
+            if (by_status[index(Status::CACHED)] > 0) return Status::CACHED;
+            return Status::NONE;
+        }
+
+        template<typename Status>
+        [[nodiscard]] static constexpr std::size_t index(Status status) noexcept {
+            return static_cast<std::size_t>(status);
+        }
+    };
+
+    /**
+     * @brief Rank of a status by severity: NONE < CACHED < PASS < FAIL < TIMEOUT < CRASH.
+     *
+     * Results of processes that each ran part of the tests are combined
+     * by keeping the largest rank: a test is NONE wherever it did not
+     * run, so the process that ran it wins.
+     */
+    template<typename Status>
+    [[nodiscard]] constexpr std::uint8_t status_severity(Status status) noexcept {
+        constexpr std::array<std::uint8_t, StatusCounts::num_statuses> by_value{2, 3, 0, 5, 4, 1};
+        return by_value[StatusCounts::index(status)];
+    }
+
+    /// @brief Inverse of status_severity().
+    template<typename Status>
+    [[nodiscard]] constexpr Status status_from_severity(std::uint8_t severity) noexcept {
+        constexpr std::array<Status, StatusCounts::num_statuses> by_severity{
+            Status::NONE, Status::CACHED, Status::PASS, Status::FAIL, Status::TIMEOUT, Status::CRASH};
+        return severity < by_severity.size() ? by_severity[severity] : Status::CRASH;
+    }
+
+    /**
+     * @brief Thread-safe StatusCounts, optionally rolled up into a parent.
+     *
+     * @details
+     * A suite counts its tests here and a session counts all tests of
+     * all its suites: every change is applied to the counter and to its
+     * parent. The parent also tracks how many of its children have at
+     * least one failure, so a session's failing-suite count is O(1) too.
+     */
+    class StatusCounter {
+        std::array<std::atomic<std::int64_t>, StatusCounts::num_statuses> m_counts{};
+        std::atomic<std::int64_t> m_failed{0};             //!< FAIL + CRASH + TIMEOUT
+        std::atomic<std::int64_t> m_failing_children{0};   //!< Children with m_failed > 0
+        StatusCounter *m_parent;
+
+        template<typename Status>
+        static constexpr bool is_failure(Status status) noexcept {
+            return status == Status::FAIL || status == Status::CRASH || status == Status::TIMEOUT;
+        }
+
+    public:
+        /// @param parent Counter that also receives every change; must outlive this one.
+        explicit StatusCounter(StatusCounter *parent = nullptr) noexcept : m_parent(parent) {}
+
+        StatusCounter(const StatusCounter &) = delete;
+        StatusCounter &operator=(const StatusCounter &) = delete;
+
+        /// @brief Count one more entry, in `status`.
+        template<typename Status>
+        void add(Status status) noexcept {
+            m_counts[StatusCounts::index(status)].fetch_add(1, std::memory_order_relaxed);
+            if (is_failure(status)) note_failed(1);
+            if (m_parent) m_parent->add(status);
+        }
+
+        /// @brief Move one entry from status `from` to status `to`.
+        template<typename Status>
+        void move(Status from, Status to) noexcept {
+            if (from == to) return;
+            m_counts[StatusCounts::index(to)].fetch_add(1, std::memory_order_relaxed);
+            m_counts[StatusCounts::index(from)].fetch_sub(1, std::memory_order_relaxed);
+            if (is_failure(to) && !is_failure(from)) note_failed(1);
+            if (is_failure(from) && !is_failure(to)) note_failed(-1);
+            if (m_parent) m_parent->move(from, to);
+        }
+
+        /// @brief Snapshot of the counts.
+        [[nodiscard]] StatusCounts counts() const noexcept {
+            StatusCounts snapshot;
+            for (std::size_t i = 0; i < snapshot.by_status.size(); ++i) {
+                snapshot.by_status[i] = m_counts[i].load(std::memory_order_relaxed);
+            }
+            return snapshot;
+        }
+
+        /// @brief Entries that failed, crashed or timed out.
+        [[nodiscard]] std::int64_t failed() const noexcept {
+            return m_failed.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Children counting into this one that have at least one failure.
+        [[nodiscard]] std::int64_t failing_children() const noexcept {
+            return m_failing_children.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void note_failed(std::int64_t delta) noexcept {
+            const std::int64_t before = m_failed.fetch_add(delta, std::memory_order_relaxed);
+            if (!m_parent) return;
+            if (before == 0 && delta > 0) {
+                m_parent->m_failing_children.fetch_add(1, std::memory_order_relaxed);
+            } else if (before + delta == 0 && delta < 0) {
+                m_parent->m_failing_children.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @brief Number of failures after which a run stops starting tests.
+     *
+     * @details
+     * Shared by a session and its suites. Every regular test and every
+     * parameter case that fails, crashes or times out is recorded; once
+     * the limit is reached, tests that have not started are skipped and
+     * keep their status. Tests already running finish normally.
+     */
+    class FailureBudget {
+        std::atomic<std::int64_t> m_limit{0};    //!< Failures allowed; 0 allows any number
+        std::atomic<std::int64_t> m_failures{0}; //!< Failures recorded since reset()
+
+    public:
+        /// @brief Start a run that stops after `max_failures` failures; 0 never stops.
+        void reset(std::size_t max_failures) noexcept {
+            m_failures.store(0, std::memory_order_relaxed);
+            m_limit.store(static_cast<std::int64_t>(max_failures), std::memory_order_relaxed);
+        }
+
+        /// @brief Record the outcome of a test or parameter case.
+        template<typename Status>
+        void record(Status status) noexcept {
+            if (status == Status::FAIL || status == Status::CRASH || status == Status::TIMEOUT) {
+                m_failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Whether the run has reached its limit and should start no more tests.
+        [[nodiscard]] bool exhausted() const noexcept {
+            const std::int64_t limit = m_limit.load(std::memory_order_relaxed);
+            return limit > 0 && m_failures.load(std::memory_order_relaxed) >= limit;
+        }
+
+        /// @brief Failures recorded since reset().
+        [[nodiscard]] std::int64_t failures() const noexcept { return m_failures.load(std::memory_order_relaxed); }
+
+        /// @brief Failures allowed; 0 if the run never stops early.
+        [[nodiscard]] std::int64_t limit() const noexcept { return m_limit.load(std::memory_order_relaxed); }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_STATUS_COUNTS_HPP
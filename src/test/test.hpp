@@ -5,12 +5,12 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <tuple>
 #include <utility>
 #include "fixture.hpp"
 #include "assert.hpp"
-#include "db.hpp"
+#include "timing.hpp"
 #include "logging.hpp"
+#include "watchdog.hpp"
 
 namespace Fortest {
     /// Function signature for test procedures (test, suite, session args).
@@ -25,7 +25,31 @@ namespace Fortest {
     class Test {
     public:
         /// Test execution status.
-        enum class Status { PASS, FAIL, NONE };
+        ///
+        /// CRASH is only produced by the process-isolated runner, which
+        /// observes the test from outside; TIMEOUT by it or by a
+        /// TimeoutGuard around an in-process run. CACHED marks a cacheable
+        /// test that did not run because the same code and inputs passed
+        /// before (see TestSuite::set_cacheable()).
+        enum class Status { PASS, FAIL, NONE, CRASH, TIMEOUT, CACHED };
+
+        /// @brief Name of a status as logged and stored in the results database.
+        [[nodiscard]] static constexpr const char *status_name(Status status) noexcept {
+            switch (status) {
+                case Status::PASS: return "PASS";
+                case Status::FAIL: return "FAIL";
+                case Status::CRASH: return "CRASH";
+                case Status::TIMEOUT: return "TIMEOUT";
+                case Status::CACHED: return "CACHED";
+                default: return "NONE";
+            }
+        }
+
+        /// @brief Whether a status counts as a failed test.
+        [[nodiscard]] static constexpr bool is_failure(Status status) noexcept {
+            return status == Status::FAIL || status == Status::CRASH ||
+                   status == Status::TIMEOUT;
+        }
 
     private:
         TestFunction m_test; //!< Test body
@@ -36,6 +60,7 @@ namespace Fortest {
         //!< Session-level fixture
         std::string m_name; //!< Test name
         Status m_status = Status::NONE; //!< Test result status
+        TestTiming m_timing; //!< Durations of the last run
 
     public:
         /**
@@ -78,60 +103,96 @@ namespace Fortest {
         template<LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType
             = TestLoggerType>
         void run(const std::shared_ptr<TestLoggerType> &logger,
-                 Assert<AssertLoggerType> &assert,
-                 const std::optional<SqliteDb> &db = std::nullopt) {
+                 Assert<AssertLoggerType> &assert) {
+            const FixtureSet fixtures{m_test_fixture.get(), m_suite_fixture.get(),
+                                      m_session_fixture.get()};
+            try {
+                m_status = execute(m_test, fixtures, assert, m_timing);
+            } catch (...) {
+                m_status = Status::FAIL;
+                throw;
+            }
+        }
+
+        /**
+         * @brief Run a test body between its test fixture's setup and teardown.
+         *
+         * This is the whole of run() without a Test object, for callers
+         * that keep test bodies and fixtures in their own storage.
+         *
+         * @param body Test body.
+         * @param fixtures Fixtures providing the arguments; the test fixture is set up and torn down.
+         * @param assert Assertion manager used to track results.
+         * @param timing Receives the durations, also when the body throws.
+         * @return TIMEOUT if the body returned after the TimeoutGuard of the
+         *         calling thread expired, else PASS if no assertion failed,
+         *         FAIL otherwise.
+         */
+        template<LoggerLike AssertLoggerType>
+        static Status execute(const TestFunction &body, const FixtureSet &fixtures,
+                              Assert<AssertLoggerType> &assert, TestTiming &timing) {
             void *test_args = nullptr;
             void *suite_args = nullptr;
             void *session_args = nullptr;
-            if (m_test_fixture) {
-                test_args = m_test_fixture->get_args();
-                m_test_fixture->setup();
+            Stopwatch stopwatch;
+            timing = {};
+            if (fixtures.test) {
+                test_args = fixtures.test->get_args();
+                fixtures.test->setup();
             }
-            if (m_suite_fixture) {
-                suite_args = m_suite_fixture->get_args();
+            if (fixtures.suite) {
+                suite_args = fixtures.suite->get_args();
             }
-            if (m_session_fixture) {
-                session_args = m_session_fixture->get_args();
+            if (fixtures.session) {
+                session_args = fixtures.session->get_args();
             }
 
             assert.reset();
 
-            auto args = std::make_tuple(test_args, suite_args, session_args);
+            const MemoryTracking::Region memory;
+            timing.setup_ns = stopwatch.lap();
+            const std::int64_t cpu_start = Stopwatch::thread_cpu_ns();
+            const PerfCounters::Region perf;
 
             try {
-                std::apply(m_test, args);
-
-                m_status = (assert.get_num_failed() == 0)
-                               ? Status::PASS
-                               : Status::FAIL;
-                if (db.has_value()) {
-                    SqliteStmt stmt(db.value().get(),
-                                    "INSERT INTO test_results (test_name, status, duration_ms) "
-                                    "VALUES (?, ?, ?);");
-                    std::string status_str = (m_status == Status::PASS)
-                                                 ? "PASS"
-                                                 : "FAIL";
-                    sqlite3_bind_text(stmt.get(), 1, m_name.c_str(), -1,
-                                      SQLITE_TRANSIENT);
-                    sqlite3_bind_text(stmt.get(), 2, status_str.c_str(), -1,
-                                      SQLITE_TRANSIENT);
-                    sqlite3_bind_int(stmt.get(), 3, 0);
-                    stmt.step();
-                }
-                if (m_test_fixture) {
-                    m_test_fixture->teardown();
-                }
+                body(test_args, suite_args, session_args);
             } catch (...) {
-                if (m_test_fixture) {
-                    m_test_fixture->teardown();
+                timing.body_ns = stopwatch.lap();
+                timing.cpu_ns = Stopwatch::thread_cpu_ns() - cpu_start;
+                timing.counters = perf.stop();
+                timing.memory = memory.stop();
+                if (fixtures.test) {
+                    fixtures.test->teardown();
                 }
-                m_status = Status::FAIL;
+                timing.teardown_ns = stopwatch.lap();
                 throw;
             }
+            timing.body_ns = stopwatch.lap();
+            timing.cpu_ns = Stopwatch::thread_cpu_ns() - cpu_start;
+            timing.counters = perf.stop();
+            timing.memory = memory.stop();
+
+            const Status status = TestCancellation::requested() ? Status::TIMEOUT
+                                  : assert.get_num_failed() == 0 ? Status::PASS
+                                                                 : Status::FAIL;
+            if (fixtures.test) {
+                fixtures.test->teardown();
+            }
+            timing.teardown_ns = stopwatch.lap();
+            return status;
         }
 
         /// @brief Get the current status of the test.
         [[nodiscard]] Status get_status() const { return m_status; }
+
+        /// @brief Override the status, e.g. with the outcome observed by a forked runner.
+        void set_status(Status status) { m_status = status; }
+
+        /// @brief Durations of the last run.
+        [[nodiscard]] const TestTiming &get_timing() const { return m_timing; }
+
+        /// @brief Override the durations, e.g. with those measured in a forked child.
+        void set_timing(const TestTiming &timing) { m_timing = timing; }
     };
 } // namespace Fortest
 
@@ -0,0 +1,99 @@
+#ifndef FORTEST_TIMING_HPP
+#define FORTEST_TIMING_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <time.h>
+
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Wall-clock and CPU time spent in one test run.
+     *
+     * @details
+     * All values are nanoseconds. Wall times come from
+     * `std::chrono::steady_clock`. `cpu_ns` is the CPU time consumed by the
+     * calling thread while the test body ran, so it stays meaningful when
+     * other tests run concurrently on other workers. `counters` holds the
+     * hardware events of the body when PerfCounters are enabled, and
+     * `memory` its resident memory when MemoryTracking is.
+     */
+    struct TestTiming {
+        std::int64_t setup_ns = 0;    //!< Test fixture setup
+        std::int64_t body_ns = 0;     //!< Test body
+        std::int64_t teardown_ns = 0; //!< Test fixture teardown
+        std::int64_t cpu_ns = 0;      //!< Thread CPU time of the test body
+        PerfCounts counters;          //!< Hardware events of the test body, if counted
+        MemoryUsage memory;           //!< Resident memory of the test body, if tracked
+
+        /// @brief Wall time of setup, body and teardown together.
+        [[nodiscard]] std::int64_t total_ns() const noexcept {
+            return setup_ns + body_ns + teardown_ns;
+        }
+
+        /// @brief Accumulate another run, e.g. the cases of a parameterized test.
+        TestTiming &operator+=(const TestTiming &other) noexcept {
+            setup_ns += other.setup_ns;
+            body_ns += other.body_ns;
+            teardown_ns += other.teardown_ns;
+            cpu_ns += other.cpu_ns;
+            counters += other.counters;
+            memory += other.memory;
+            return *this;
+        }
+
+        /// @brief Human-readable summary in milliseconds, appended to log lines.
+        [[nodiscard]] std::string summary() const {
+            char text[128];
+            std::snprintf(text, sizeof(text),
+                          "(%.3f ms: setup %.3f, body %.3f, teardown %.3f, cpu %.3f",
+                          to_ms(total_ns()), to_ms(setup_ns), to_ms(body_ns),
+                          to_ms(teardown_ns), to_ms(cpu_ns));
+            std::string result(text);
+            if (memory.measured) result += "; " + memory.summary();
+            if (counters.measured()) result += "; " + counters.summary(body_ns);
+            return result + ")";
+        }
+
+        /// @brief Convert nanoseconds to milliseconds.
+        [[nodiscard]] static double to_ms(std::int64_t ns) noexcept { return static_cast<double>(ns) * 1e-6; }
+
+        /// @brief Convert nanoseconds to seconds.
+        [[nodiscard]] static double to_seconds(std::int64_t ns) noexcept { return static_cast<double>(ns) * 1e-9; }
+    };
+
+    /**
+     * @brief Monotonic stopwatch measuring consecutive phases.
+     *
+     * Each call to lap() returns the time since the previous lap (or since
+     * construction) and starts the next phase.
+     */
+    class Stopwatch {
+        std::chrono::steady_clock::time_point m_last = std::chrono::steady_clock::now();
+
+    public:
+        /// @brief Nanoseconds since the previous lap; starts a new one.
+        std::int64_t lap() noexcept {
+            const auto now = std::chrono::steady_clock::now();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+            m_last = now;
+            return elapsed.count();
+        }
+
+        /// @brief CPU time consumed so far by the calling thread, in nanoseconds.
+        [[nodiscard]] static std::int64_t thread_cpu_ns() noexcept {
+            timespec ts{};
+            if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+                return 0;
+            }
+            return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_TIMING_HPP
@@ -1,7 +1,9 @@
 #ifndef FORTEST_C_TEST_SESSION_H
 #define FORTEST_C_TEST_SESSION_H
 
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <cstdlib>
 #include <vector>
@@ -9,13 +11,24 @@
 #include "g_logging.hpp"
 #include "g_test_session.hpp"
 #include "fixture.hpp"
+#include "mapped_file.hpp"
 
 extern "C" {
 
+/// @brief Range of parameter values, inclusive of `stop` as in a Fortran `do` loop.
+///
+/// Mirrors `parameter_range_t` in the Fortran `fortest_test_session` module.
+///
+typedef struct fortest_parameter_range {
+    int start;   ///< First value
+    int stop;    ///< Last value, inclusive
+    int stride;  ///< Step between values; must not be zero
+} fortest_parameter_range;
+
 /**
  * @brief Helper: Print exception message and terminate.
  */
-inline void fortest_fatal_terminate(const char *func) noexcept {
+[[noreturn]] inline void fortest_fatal_terminate(const char *func) noexcept {
     try {
         throw; // rethrow current exception
     } catch (const std::exception &e) {
@@ -28,14 +41,73 @@ inline void fortest_fatal_terminate(const char *func) noexcept {
     std::terminate();
 }
 
+/**
+ * @brief Helper: Scope named "test", "suite" or "session"; anything else is "test".
+ */
+inline Fortest::Scope fortest_parse_scope(std::string_view scope_name) noexcept {
+    if (scope_name == "suite") return Fortest::Scope::Suite;
+    if (scope_name == "session") return Fortest::Scope::Session;
+    return Fortest::Scope::Test;
+}
+
+/**
+ * @brief Helper: Add a fixture to a suite, or to the session if `suite` is empty and the scope is "session".
+ */
+inline void fortest_add_fixture(std::string_view suite, const Fortest::Fixture<void> &fixture) {
+    if (suite.empty() && fixture.get_scope() == Fortest::Scope::Session) {
+        Fortest::GlobalTestSession::instance().add_fixture(fixture);
+    } else {
+        Fortest::GlobalTestSession::instance().add_fixture(suite, fixture);
+    }
+}
+
+/**
+ * @brief Register a new test suite with the global session.
+ *
+ * @param name      Suite name; need not be null terminated
+ * @param name_len  Length of `name` in bytes
+ */
+void c_register_test_suite_n(const char *name, const std::size_t name_len) {
+    try {
+        Fortest::GlobalTestSession::instance().add_test_suite(std::string_view(name, name_len));
+    } catch (...) {
+        fortest_fatal_terminate("c_register_test_suite_n");
+    }
+}
+
 /**
  * @brief Register a new test suite with the global session.
  */
 void c_register_test_suite(const char *name) {
+    c_register_test_suite_n(name, std::strlen(name));
+}
+
+/**
+ * @brief Register a fixture for a given test suite.
+ *
+ * @param suite_name      Suite name; empty for a session fixture
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param setup_ptr       Setup function: void(*)(void*)
+ * @param teardown_ptr    Teardown function: void(*)(void*)
+ * @param args_ptr        Argument passed to setup and teardown
+ * @param scope           "test", "suite" or "session"
+ * @param scope_len       Length of `scope` in bytes
+ */
+void c_register_fixture_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    void *setup_ptr, void *teardown_ptr, void *args_ptr,
+    const char *scope, const std::size_t scope_len
+) {
     try {
-        Fortest::GlobalTestSession::instance().add_test_suite(name);
+        auto setup = reinterpret_cast<void(*)(void *)>(setup_ptr);
+        auto teardown = reinterpret_cast<void(*)(void *)>(teardown_ptr);
+        fortest_add_fixture(
+            std::string_view(suite_name, suite_name_len),
+            Fortest::Fixture<void>(setup, teardown, args_ptr,
+                                   fortest_parse_scope(std::string_view(scope, scope_len)))
+        );
     } catch (...) {
-        fortest_fatal_terminate("c_register_test_suite");
+        fortest_fatal_terminate("c_register_fixture_n");
     }
 }
 
@@ -46,32 +118,62 @@ void c_register_fixture(
     const char *suite_name, void *setup_ptr, void *teardown_ptr,
     void *args_ptr, const char *scope
 ) {
-    try {
-        auto setup = reinterpret_cast<void(*)(void *)>(setup_ptr);
-        auto teardown = reinterpret_cast<void(*)(void *)>(teardown_ptr);
+    c_register_fixture_n(suite_name, std::strlen(suite_name), setup_ptr, teardown_ptr,
+                         args_ptr, scope, std::strlen(scope));
+}
 
-        Fortest::Scope scope_enum = Fortest::Scope::Test;
-        if (std::string(scope) == "test") {
-            scope_enum = Fortest::Scope::Test;
-        } else if (std::string(scope) == "suite") {
-            scope_enum = Fortest::Scope::Suite;
-        } else if (std::string(scope) == "session") {
-            scope_enum = Fortest::Scope::Session;
-        }
+/**
+ * @brief Register a fixture mapping a golden data file read-only.
+ *
+ * While the fixture is set up, `view` holds the address and size of the
+ * mapped file; it is also the fixture's argument passed to the tests.
+ * See Fortest::mapped_file_fixture().
+ *
+ * @param suite_name      Suite name; empty for a session fixture
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param path            File to map
+ * @param path_len        Length of `path` in bytes
+ * @param view            Receives the mapping; must outlive the session
+ * @param scope           "test", "suite" or "session"
+ * @param scope_len       Length of `scope` in bytes
+ */
+void c_register_mapped_fixture_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *path, const std::size_t path_len, Fortest::MappedView *view,
+    const char *scope, const std::size_t scope_len
+) {
+    try {
+        fortest_add_fixture(
+            std::string_view(suite_name, suite_name_len),
+            Fortest::mapped_file_fixture(std::string(path, path_len), view,
+                                         fortest_parse_scope(std::string_view(scope, scope_len)))
+        );
+    } catch (...) {
+        fortest_fatal_terminate("c_register_mapped_fixture_n");
+    }
+}
 
-        if (std::string(suite_name).empty() &&
-            scope_enum == Fortest::Scope::Session) {
-            Fortest::GlobalTestSession::instance().add_fixture(
-                Fortest::Fixture<void>(setup, teardown, args_ptr, scope_enum)
-            );
-        } else {
-            Fortest::GlobalTestSession::instance().add_fixture(
-                suite_name,
-                Fortest::Fixture<void>(setup, teardown, args_ptr, scope_enum)
-            );
-        }
+/**
+ * @brief Register a test case with the given suite.
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param test_name       Test name; need not be null terminated
+ * @param test_name_len   Length of `test_name` in bytes
+ * @param test_ptr        Function pointer: void(*)(void*, void*, void*)
+ */
+void c_register_test_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *test_name, const std::size_t test_name_len, void *test_ptr
+) {
+    try {
+        auto test = reinterpret_cast<void(*)(void *, void *, void *)>(test_ptr);
+        Fortest::GlobalTestSession::instance().add_test(
+            std::string_view(suite_name, suite_name_len),
+            std::string_view(test_name, test_name_len), test
+        );
     } catch (...) {
-        fortest_fatal_terminate("c_register_fixture");
+        fortest_fatal_terminate("c_register_test_n");
     }
 }
 
@@ -80,14 +182,130 @@ void c_register_fixture(
  */
 void c_register_test(
     const char *suite_name, const char *test_name, void *test_ptr
+) {
+    c_register_test_n(suite_name, std::strlen(suite_name),
+                      test_name, std::strlen(test_name), test_ptr);
+}
+
+/**
+ * @brief Register a table of tests in one call.
+ *
+ * The names are fixed-width fields, as in a Fortran `character(len=*)`
+ * array, with trailing blanks ignored: name `i` starts at byte
+ * `i * width` of its array. See Fortest::TestSession::add_tests().
+ *
+ * @param suite_names       `count` suite names; the suites must be registered
+ * @param suite_name_width  Width of one suite name in bytes
+ * @param test_names        `count` test names
+ * @param test_name_width   Width of one test name in bytes
+ * @param test_ptrs         `count` function pointers: void(*)(void*, void*, void*)
+ * @param count             Number of tests
+ */
+void c_register_tests_n(
+    const char *suite_names, const std::size_t suite_name_width,
+    const char *test_names, const std::size_t test_name_width,
+    void *const *test_ptrs, const std::size_t count
+) {
+    try {
+        const auto field = [](const char *start, std::size_t width) {
+            std::string_view name(start, width);
+            const auto last = name.find_last_not_of(' ');
+            return last == std::string_view::npos ? std::string_view() : name.substr(0, last + 1);
+        };
+        std::vector<Fortest::TestRecord> records(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            records[i] = {field(suite_names + i * suite_name_width, suite_name_width),
+                          field(test_names + i * test_name_width, test_name_width),
+                          reinterpret_cast<void(*)(void *, void *, void *)>(test_ptrs[i])};
+        }
+        Fortest::GlobalTestSession::instance().add_tests(records);
+    } catch (...) {
+        fortest_fatal_terminate("c_register_tests_n");
+    }
+}
+
+/**
+ * @brief Register a test that every process of a distributed session runs.
+ *
+ * Same arguments as c_register_test_n(). Without a distribution it runs
+ * like any other test.
+ */
+void c_register_collective_test_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *test_name, const std::size_t test_name_len, void *test_ptr
 ) {
     try {
         auto test = reinterpret_cast<void(*)(void *, void *, void *)>(test_ptr);
         Fortest::GlobalTestSession::instance().add_test(
-            suite_name, test_name, test
+            std::string_view(suite_name, suite_name_len),
+            std::string_view(test_name, test_name_len), test, true
+        );
+    } catch (...) {
+        fortest_fatal_terminate("c_register_collective_test_n");
+    }
+}
+
+/**
+ * @brief Register a benchmark with the given suite.
+ *
+ * Same first arguments as c_register_test_n(); see
+ * Fortest::TestSuite::add_benchmark(). A negative `warmup` and
+ * non-positive other measurement arguments keep the defaults of
+ * Fortest::BenchmarkOptions.
+ *
+ * @param warmup          Untimed calls before measuring
+ * @param repetitions     Timed samples
+ * @param min_time        Seconds all samples take together, at least
+ * @param items_per_call  Work done by one call, for the throughput
+ */
+void c_register_benchmark_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *test_name, const std::size_t test_name_len, void *test_ptr,
+    const int warmup, const int repetitions, const double min_time, const double items_per_call
+) {
+    try {
+        auto test = reinterpret_cast<void(*)(void *, void *, void *)>(test_ptr);
+        Fortest::BenchmarkOptions options;
+        if (warmup >= 0) options.warmup = static_cast<std::size_t>(warmup);
+        if (repetitions > 0) options.repetitions = static_cast<std::size_t>(repetitions);
+        if (min_time > 0.0) options.min_time_seconds = min_time;
+        if (items_per_call > 0.0) options.items_per_call = items_per_call;
+        Fortest::GlobalTestSession::instance().add_benchmark(
+            std::string_view(suite_name, suite_name_len),
+            std::string_view(test_name, test_name_len), test, options
+        );
+    } catch (...) {
+        fortest_fatal_terminate("c_register_benchmark_n");
+    }
+}
+
+/**
+ * @brief Register a parameterized test with the given suite.
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param test_name       Test name; need not be null terminated
+ * @param test_name_len   Length of `test_name` in bytes
+ * @param test_ptr        Function pointer: void(*)(void*, void*, void*, int)
+ * @param params          Pointer to array of parameter indices
+ * @param nparams         Number of parameter indices
+ */
+void c_register_parameterized_test_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *test_name, const std::size_t test_name_len,
+    void *test_ptr, const int *params, int nparams
+) {
+    try {
+        auto test = reinterpret_cast<void(*)(void *, void *, void *, int)>(test_ptr);
+        std::vector<int> param_vec(params, params + nparams);
+
+        Fortest::GlobalTestSession::instance().add_parameterized_test(
+            std::string_view(suite_name, suite_name_len),
+            std::string_view(test_name, test_name_len),
+            test, std::move(param_vec)
         );
     } catch (...) {
-        fortest_fatal_terminate("c_register_test");
+        fortest_fatal_terminate("c_register_parameterized_test_n");
     }
 }
 
@@ -103,26 +321,424 @@ void c_register_test(
 void c_register_parameterized_test(
     const char *suite_name, const char *test_name,
     void *test_ptr, const int *params, int nparams
+) {
+    c_register_parameterized_test_n(suite_name, std::strlen(suite_name),
+                                    test_name, std::strlen(test_name),
+                                    test_ptr, params, nparams);
+}
+
+/**
+ * @brief Register a parameterized test over a product of ranges.
+ *
+ * The ranges are stored as descriptors and expanded one case at a time
+ * while the test runs. With a single range the body receives its values;
+ * with several it receives the 0-based case number, in which the first
+ * range varies fastest (see Fortest::ParameterSpace).
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param test_name       Test name; need not be null terminated
+ * @param test_name_len   Length of `test_name` in bytes
+ * @param test_ptr        Function pointer: void(*)(void*, void*, void*, int)
+ * @param ranges          Pointer to array of ranges
+ * @param nranges         Number of ranges
+ */
+void c_register_parameterized_ranges_n(
+    const char *suite_name, const std::size_t suite_name_len,
+    const char *test_name, const std::size_t test_name_len,
+    void *test_ptr, const fortest_parameter_range *ranges, int nranges
 ) {
     try {
         auto test = reinterpret_cast<void(*)(void *, void *, void *, int)>(test_ptr);
-        std::vector<int> param_vec(params, params + nparams);
+        std::vector<Fortest::ParameterRange> range_vec;
+        range_vec.reserve(nranges);
+        for (int i = 0; i < nranges; ++i) {
+            range_vec.push_back({ranges[i].start, ranges[i].stop, ranges[i].stride});
+        }
 
         Fortest::GlobalTestSession::instance().add_parameterized_test(
-            suite_name, test_name, test, std::move(param_vec)
+            std::string_view(suite_name, suite_name_len),
+            std::string_view(test_name, test_name_len),
+            test, Fortest::ParameterSpace::product(std::move(range_vec))
         );
     } catch (...) {
-        fortest_fatal_terminate("c_register_parameterized_test");
+        fortest_fatal_terminate("c_register_parameterized_ranges_n");
     }
 }
 
+/**
+ * @brief Set the number of worker threads used by the global session.
+ *
+ * Overrides `FORTEST_NUM_WORKERS`. A value of 1 runs the tests serially;
+ * 0 uses every hardware thread.
+ *
+ * @param num_workers Number of worker threads.
+ */
+void c_set_num_workers(int num_workers) {
+    try {
+        auto &options = Fortest::GlobalTestSession::instance().get_options();
+        options.num_workers = num_workers > 0
+                                  ? static_cast<std::size_t>(num_workers)
+                                  : Fortest::RunOptions::hardware_workers();
+    } catch (...) {
+        fortest_fatal_terminate("c_set_num_workers");
+    }
+}
+
+/**
+ * @brief Set how many cases of a parameterized test a worker takes at a time.
+ *
+ * Overrides `FORTEST_CHUNK_SIZE`.
+ *
+ * @param chunk_size Cases per chunk; 0 sizes chunks by the remaining work.
+ */
+void c_set_chunk_size(int chunk_size) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().chunk_size =
+            chunk_size > 0 ? static_cast<std::size_t>(chunk_size) : 0;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_chunk_size");
+    }
+}
+
+/**
+ * @brief Select process isolation for the global session.
+ *
+ * Overrides `FORTEST_ISOLATION`. With isolation enabled every test runs
+ * in a forked child, so crashes are reported as CRASH and tests running
+ * longer than `timeout_seconds` as TIMEOUT.
+ *
+ * @param enabled Non-zero to fork a child per test.
+ * @param timeout_seconds Per-test wall-clock limit; 0 disables it, a
+ *        negative value keeps the current limit (`FORTEST_TIMEOUT`).
+ */
+void c_set_process_isolation(int enabled, double timeout_seconds) {
+    try {
+        auto &options = Fortest::GlobalTestSession::instance().get_options();
+        options.isolation = enabled != 0
+                                ? Fortest::RunOptions::Isolation::Process
+                                : Fortest::RunOptions::Isolation::Thread;
+        if (timeout_seconds >= 0.0) {
+            options.timeout_seconds = timeout_seconds;
+        }
+    } catch (...) {
+        fortest_fatal_terminate("c_set_process_isolation");
+    }
+}
+
+/**
+ * @brief Set the results database of the global session.
+ *
+ * Overrides `FORTEST_DB`. Every subsequent run is recorded there.
+ *
+ * @param path Path of the SQLite file; an empty string disables recording.
+ */
+void c_set_results_db(const char *path) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().results_db = path;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_results_db");
+    }
+}
+
+/**
+ * @brief Write machine-readable reports of the global session's runs.
+ *
+ * Overrides `FORTEST_REPORT`. The files are written while the tests run.
+ *
+ * @param reports     Comma-separated `format:path` items, with the formats
+ *                    `junit`, `jsonl` and `tap`; empty writes none
+ * @param reports_len Length of `reports` in bytes
+ */
+void c_set_reports_n(const char *reports, const std::size_t reports_len) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().reports = std::string(reports, reports_len);
+    } catch (...) {
+        fortest_fatal_terminate("c_set_reports_n");
+    }
+}
+
+/**
+ * @brief Write the global loggers' output on a background thread.
+ *
+ * Overrides `FORTEST_ASYNC_LOG`. Failures are still printed before the
+ * failing assertion returns.
+ *
+ * @param enabled Non-zero enables asynchronous output; zero flushes and disables it.
+ */
+void c_set_async_logging(int enabled) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().async_log = enabled != 0;
+        Fortest::set_async_logging(enabled != 0);
+    } catch (...) {
+        fortest_fatal_terminate("c_set_async_logging");
+    }
+}
+
+/**
+ * @brief Follow the progress of the global session's runs in a file.
+ *
+ * Overrides `FORTEST_PROGRESS` and `FORTEST_PROGRESS_INTERVAL`. The file
+ * is rewritten with a Prometheus snapshot while the tests run.
+ *
+ * @param path     Path of the file; empty writes none
+ * @param path_len Length of `path` in bytes
+ * @param interval Seconds between two snapshots; not positive keeps the current interval
+ */
+void c_set_progress_file_n(const char *path, const std::size_t path_len, double interval) {
+    try {
+        auto &options = Fortest::GlobalTestSession::instance().get_options();
+        options.progress_file = std::string(path, path_len);
+        if (interval > 0.0) options.progress_interval_seconds = interval;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_progress_file_n");
+    }
+}
+
+/**
+ * @brief Repeat only some tests in the next runs of the global session.
+ *
+ * Overrides `FORTEST_RERUN` and `FORTEST_SKIP_UNCHANGED`. The tests are
+ * chosen from their latest results in the results database.
+ *
+ * @param mode     "all", "failed_first" or "failed"; anything else keeps the current mode
+ * @param mode_len Length of `mode` in bytes
+ * @param skip_unchanged Non-zero also skips the passing tests of suites
+ *        whose fingerprint is unchanged; a negative value keeps the
+ *        current setting.
+ */
+void c_set_rerun_n(const char *mode, const std::size_t mode_len, int skip_unchanged) {
+    try {
+        auto &options = Fortest::GlobalTestSession::instance().get_options();
+        const std::string_view mode_name(mode, mode_len);
+        if (mode_name == "all") {
+            options.rerun = Fortest::RunOptions::Rerun::All;
+        } else if (mode_name == "failed_first") {
+            options.rerun = Fortest::RunOptions::Rerun::FailedFirst;
+        } else if (mode_name == "failed") {
+            options.rerun = Fortest::RunOptions::Rerun::FailedOnly;
+        }
+        if (skip_unchanged >= 0) {
+            options.skip_unchanged = skip_unchanged != 0;
+        }
+    } catch (...) {
+        fortest_fatal_terminate("c_set_rerun_n");
+    }
+}
+
+/**
+ * @brief Fail benchmarks of the global session that became slower than their baseline.
+ *
+ * Overrides `FORTEST_MAX_SLOWDOWN` and `FORTEST_SIGNIFICANCE`. The
+ * baseline is the benchmark's last passing runs in the results database.
+ *
+ * @param max_slowdown_percent Allowed increase of the median; 0 disables
+ *        the comparison, a negative value keeps the current setting.
+ * @param significance Largest p-value of a failing slowdown; values
+ *        outside (0, 1] keep the current setting.
+ */
+void c_set_benchmark_baseline(const double max_slowdown_percent, const double significance) {
+    try {
+        auto &regression = Fortest::GlobalTestSession::instance().get_options().regression;
+        if (max_slowdown_percent >= 0.0) {
+            regression.max_slowdown_percent = max_slowdown_percent;
+        }
+        if (significance > 0.0 && significance <= 1.0) {
+            regression.significance = significance;
+        }
+    } catch (...) {
+        fortest_fatal_terminate("c_set_benchmark_baseline");
+    }
+}
+
+/**
+ * @brief Run only the tests of the global session whose names match a filter.
+ *
+ * Overrides `FORTEST_FILTER`. Suites without a matching test are skipped,
+ * and their fixtures are never set up.
+ *
+ * @param filter     Patterns on `suite.test` names, e.g. `mesh_*.*-*.slow_*`;
+ *                   empty runs every test
+ * @param filter_len Length of `filter` in bytes
+ */
+void c_set_filter_n(const char *filter, const std::size_t filter_len) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().filter = std::string(filter, filter_len);
+    } catch (...) {
+        fortest_fatal_terminate("c_set_filter_n");
+    }
+}
+
+/**
+ * @brief Set the fingerprint of a suite's code, e.g. a hash of its object file.
+ *
+ * Runs that skip unchanged suites compare it with the fingerprint of the
+ * suite's last run; without one, the test binary's is used.
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param fingerprint     Any text identifying the code
+ * @param fingerprint_len Length of `fingerprint` in bytes
+ */
+void c_set_suite_fingerprint_n(const char *suite_name, const std::size_t suite_name_len,
+                               const char *fingerprint, const std::size_t fingerprint_len) {
+    try {
+        Fortest::GlobalTestSession::instance()
+            .find_suite(std::string_view(suite_name, suite_name_len))
+            .set_fingerprint(std::string(fingerprint, fingerprint_len));
+    } catch (...) {
+        fortest_fatal_terminate("c_set_suite_fingerprint_n");
+    }
+}
+
+/**
+ * @brief Stop the global session's runs after a number of failures.
+ *
+ * Overrides `FORTEST_MAX_FAILURES` and `FORTEST_FAIL_FAST`.
+ *
+ * @param max_failures Failed tests or parameter cases after which no test
+ *        starts; 1 stops at the first failure, 0 runs every test.
+ */
+void c_set_max_failures(int max_failures) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().max_failures =
+            max_failures > 0 ? static_cast<std::size_t>(max_failures) : 0;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_max_failures");
+    }
+}
+
+/**
+ * @brief Use or ignore the cached results of the global session's cacheable tests.
+ *
+ * Overrides `FORTEST_CACHE`.
+ *
+ * @param enabled Non-zero reports unchanged cacheable tests as CACHED; zero runs them all.
+ */
+void c_set_use_cache(int enabled) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().use_cache = enabled != 0;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_use_cache");
+    }
+}
+
+/**
+ * @brief Set the default wall-clock limit of every test of the global session.
+ *
+ * Overrides `FORTEST_TIMEOUT`. Suites and tests may set their own limit.
+ *
+ * @param timeout_seconds Limit per test or parameter case; 0 disables it.
+ */
+void c_set_timeout(double timeout_seconds) {
+    try {
+        Fortest::GlobalTestSession::instance().get_options().timeout_seconds =
+            timeout_seconds > 0.0 ? timeout_seconds : 0.0;
+    } catch (...) {
+        fortest_fatal_terminate("c_set_timeout");
+    }
+}
+
+/**
+ * @brief Set the wall-clock limit of every test of a suite; see Fortest::TestSuite::set_timeout().
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param timeout_seconds Limit per test or parameter case; 0 disables the session default
+ */
+void c_set_suite_timeout_n(const char *suite_name, const std::size_t suite_name_len,
+                           double timeout_seconds) {
+    try {
+        Fortest::GlobalTestSession::instance()
+            .find_suite(std::string_view(suite_name, suite_name_len))
+            .set_timeout(timeout_seconds > 0.0 ? timeout_seconds : 0.0);
+    } catch (...) {
+        fortest_fatal_terminate("c_set_suite_timeout_n");
+    }
+}
+
+/**
+ * @brief Set the wall-clock limit of one test; see Fortest::TestSuite::set_test_timeout().
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param test_name       Name of a registered test; need not be null terminated
+ * @param test_name_len   Length of `test_name` in bytes
+ * @param timeout_seconds Limit of the test, or of each case of a parameterized test; 0 disables it
+ */
+void c_set_test_timeout_n(const char *suite_name, const std::size_t suite_name_len,
+                          const char *test_name, const std::size_t test_name_len,
+                          double timeout_seconds) {
+    try {
+        Fortest::GlobalTestSession::instance()
+            .find_suite(std::string_view(suite_name, suite_name_len))
+            .set_test_timeout(std::string_view(test_name, test_name_len),
+                              timeout_seconds > 0.0 ? timeout_seconds : 0.0);
+    } catch (...) {
+        fortest_fatal_terminate("c_set_test_timeout_n");
+    }
+}
+
+/**
+ * @brief Let a test be reported as CACHED while its code and inputs are unchanged.
+ *
+ * See Fortest::TestSuite::set_cacheable(). The input file names are
+ * fixed-width fields, as in a Fortran `character(len=*)` array, with
+ * trailing blanks ignored.
+ *
+ * @param suite_name      Suite name; need not be null terminated
+ * @param suite_name_len  Length of `suite_name` in bytes
+ * @param test_name       Name of a registered regular test; need not be null terminated
+ * @param test_name_len   Length of `test_name` in bytes
+ * @param input_files     `num_inputs` paths of files the result depends on
+ * @param input_width     Width of one path in bytes
+ * @param num_inputs      Number of input files
+ * @param flags           Compiler flags or other settings the result depends on
+ * @param flags_len       Length of `flags` in bytes
+ */
+void c_set_test_cacheable_n(const char *suite_name, const std::size_t suite_name_len,
+                            const char *test_name, const std::size_t test_name_len,
+                            const char *input_files, const std::size_t input_width, const std::size_t num_inputs,
+                            const char *flags, const std::size_t flags_len) {
+    try {
+        std::vector<std::string> files;
+        files.reserve(num_inputs);
+        for (std::size_t i = 0; i < num_inputs; ++i) {
+            std::string_view file(input_files + i * input_width, input_width);
+            const auto last = file.find_last_not_of(' ');
+            if (last != std::string_view::npos) files.emplace_back(file.substr(0, last + 1));
+        }
+        Fortest::GlobalTestSession::instance()
+            .find_suite(std::string_view(suite_name, suite_name_len))
+            .set_cacheable(std::string_view(test_name, test_name_len), std::move(files),
+                           std::string(flags, flags_len));
+    } catch (...) {
+        fortest_fatal_terminate("c_set_test_cacheable_n");
+    }
+}
+
+/**
+ * @brief Whether the test running on the calling thread overran its timeout.
+ *
+ * Long-running test bodies poll it and return early; the test is then
+ * recorded as TIMEOUT.
+ *
+ * @return 1 if the test should stop, 0 otherwise.
+ */
+int c_cancellation_requested() {
+    return Fortest::TestCancellation::requested() ? 1 : 0;
+}
+
 /**
  * @brief Run all registered tests in the global session.
+ *
+ * All output of the run has reached stdout when this returns.
  */
 void c_run_test_session() {
     try {
         const auto logger = Fortest::GlobalLogger::instance();
         Fortest::GlobalTestSession::instance().run(logger);
+        Fortest::flush_global_loggers();
     } catch (...) {
         fortest_fatal_terminate("c_run_test_session");
     }
@@ -130,23 +746,76 @@ void c_run_test_session() {
 
 /**
  * @brief Get the overall status of a test suite.
- * @return 0 if all pass, 1 if any fail
+ * @return 0 if all pass, 1 if any fail, crash, or time out
  */
 int c_get_test_suite_status(const char *name) {
     try {
-        int status = 0;
-        auto statuses =
-            Fortest::GlobalTestSession::instance().get_test_suite_status(name);
+        return Fortest::GlobalTestSession::instance().find_suite(name).has_failures() ? 1 : 0;
+    } catch (...) {
+        fortest_fatal_terminate("c_get_test_suite_status");
+    }
+}
 
-        for (const auto &test_status : statuses | std::views::values) {
-            if (test_status == Fortest::Test::Status::FAIL) {
-                status = 1;
-                break;
-            }
+/**
+ * @brief Get the overall status of the session.
+ * @return Number of suites with a failed, crashed, or timed-out test
+ */
+int c_get_session_status() {
+    try {
+        return static_cast<int>(Fortest::GlobalTestSession::instance().get_num_failing_suites());
+    } catch (...) {
+        fortest_fatal_terminate("c_get_session_status");
+    }
+}
+
+/**
+ * @brief Whether the last run of the global session stopped at its failure limit.
+ * @return 1 if tests were left unstarted because of `max_failures`, 0 otherwise.
+ */
+int c_get_session_stopped() {
+    return Fortest::GlobalTestSession::instance().stopped_early() ? 1 : 0;
+}
+
+/**
+ * @brief Exit status of a test program whose run stopped at its failure limit.
+ */
+int c_get_stopped_exit_code() {
+    return Fortest::TestSession<Fortest::Logger, Fortest::AssertLogger>::stopped_exit_code;
+}
+
+/**
+ * @brief Get the durations of a test's last run, in seconds.
+ *
+ * Parameterized tests report the sum over their parameter cases. Any
+ * output pointer may be null.
+ *
+ * @param suite_name Suite name
+ * @param test_name  Test name
+ * @param setup      Receives the test fixture setup time
+ * @param body       Receives the test body wall time
+ * @param teardown   Receives the test fixture teardown time
+ * @param cpu        Receives the CPU time of the test body
+ * @return 0 if the test exists, 1 otherwise
+ */
+int c_get_test_timing(
+    const char *suite_name, const char *test_name,
+    double *setup, double *body, double *teardown, double *cpu
+) {
+    try {
+        const auto timings =
+            Fortest::GlobalTestSession::instance().get_test_suite_timings(suite_name);
+        const auto it = timings.find(test_name);
+        if (it == timings.end()) {
+            return 1;
         }
-        return status;
+        const auto &timing = it->second;
+        if (setup) *setup = Fortest::TestTiming::to_seconds(timing.setup_ns);
+        if (body) *body = Fortest::TestTiming::to_seconds(timing.body_ns);
+        if (teardown) *teardown = Fortest::TestTiming::to_seconds(timing.teardown_ns);
+        if (cpu) *cpu = Fortest::TestTiming::to_seconds(timing.cpu_ns);
+        return 0;
     } catch (...) {
-        fortest_fatal_terminate("c_get_test_suite_status");
+        fortest_fatal_terminate("c_get_test_timing");
     }
 }
 } // extern "C"
@@ -20,11 +20,22 @@ namespace Fortest {
         /// @brief Access the global test session instance.
         ///
         /// The session is lazily constructed on first call and
-        /// returned by reference on subsequent calls.
+        /// returned by reference on subsequent calls. Its run options
+        /// are initialized from the `FORTEST_*` environment variables,
+        /// and `FORTEST_ASYNC_LOG` switches the global loggers to
+        /// asynchronous output.
         ///
         /// @return Reference to the global `TestSession<Logger>`.
         static TestSession<Logger, AssertLogger> &instance() {
-            static TestSession session(*GlobalAssert::instance());
+            static TestSession<Logger, AssertLogger> session(*GlobalAssert::instance());
+            static const bool configured = [] {
+                session.set_options(RunOptions::from_env());
+                if (session.get_options().async_log) {
+                    set_async_logging(true);
+                }
+                return true;
+            }();
+            (void) configured;
             return session;
         }
 
@@ -0,0 +1,338 @@
+#ifndef FORTEST_RUN_OPTIONS_HPP
+#define FORTEST_RUN_OPTIONS_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "perf_counters.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Options controlling how a TestSession executes its tests.
+     *
+     * @details
+     * Defaults reproduce the classic serial run. from_env() reads the
+     * `FORTEST_*` environment variables so that a test binary can be
+     * reconfigured without recompiling:
+     *
+     * - `FORTEST_NUM_WORKERS`: number of worker threads; `0` or `auto`
+     *   uses every hardware thread.
+     * - `FORTEST_ISOLATION`: `process` runs every test in a forked child
+     *   (at most `num_workers` at a time); `thread` keeps them in-process.
+     * - `FORTEST_TIMEOUT`: default wall-clock limit in seconds for one
+     *   test or parameter case; suites and tests may set their own.
+     * - `FORTEST_TIMEOUT_GRACE`: seconds an in-process test that timed out
+     *   has to return before the session records it and exits; `5` by
+     *   default.
+     * - `FORTEST_CHUNK_SIZE`: cases of a parameterized test a worker takes
+     *   at a time; `0` or `guided` sizes chunks by the remaining work.
+     * - `FORTEST_SCHEDULE`: `lpt` (the default) starts the tests of a
+     *   parallel run with the longest expected duration first, using the
+     *   history in the results database; `name` starts them in name order.
+     * - `FORTEST_DEFAULT_DURATION_MS`: expected duration of tests without
+     *   history; `0` uses the mean of the tests that have one.
+     * - `FORTEST_DISTRIBUTION`: how a distributed session assigns tests to
+     *   processes; `round_robin` deals them out in order, `cost` balances
+     *   their expected durations.
+     * - `FORTEST_RERUN`: `failed` runs only the tests whose latest result
+     *   in the results database failed, plus new tests; `failed_first`
+     *   runs those first and then the rest; `all` runs everything.
+     * - `FORTEST_SKIP_UNCHANGED`: `1` also skips the passing tests of
+     *   suites whose code fingerprint matches their last run.
+     * - `FORTEST_CACHE`: `0` runs the cacheable tests even if they passed
+     *   before with the same code and inputs (see
+     *   TestSuite::set_cacheable()); `1` (the default) reports them as
+     *   CACHED.
+     * - `FORTEST_FILTER`: tests to run, by `suite.test` name, in the
+     *   `--gtest_filter` syntax (see NameFilter); unset runs every test.
+     * - `FORTEST_MAX_SLOWDOWN`: percentage by which a benchmark's median
+     *   may exceed its baseline from the results database before it
+     *   fails; `0` (the default) disables the comparison.
+     * - `FORTEST_SIGNIFICANCE`: p-value below which a slowdown counts,
+     *   `0.05` by default (see compare_with_baseline()).
+     * - `FORTEST_PERF_COUNTERS`: `1` counts hardware events (cycles,
+     *   instructions, cache and branch misses) around every test body;
+     *   `0` (the default) leaves the counters alone.
+     * - `FORTEST_PERF_FLOPS_EVENT`: raw PMU event code, e.g. `0x1c7` for
+     *   `FP_ARITH_INST_RETIRED` on recent Intel CPUs, counted as FLOPs.
+     * - `FORTEST_TRACK_MEMORY`: `1` records the resident memory growth
+     *   and peak of every test body; `0` (the default) does not.
+     * - `FORTEST_FAIL_FAST`: `1` stops the run at the first failed test
+     *   or parameter case, like `FORTEST_MAX_FAILURES=1`.
+     * - `FORTEST_MAX_FAILURES`: number of failed tests or parameter cases
+     *   after which no further test starts; `0` (the default) runs all.
+     * - `FORTEST_DB`: path of the session's results database; an empty
+     *   value disables it.
+     * - `FORTEST_REPORT`: machine-readable reports written while the
+     *   tests run, as comma-separated `format:path` items; the formats
+     *   are `junit`, `jsonl` and `tap` (see make_reporter()).
+     * - `FORTEST_SNAPSHOT_DIR`: directory of the snapshots compared by
+     *   `assert_matches_snapshot`; by default `fortest_snapshots` next to
+     *   the results database.
+     * - `FORTEST_UPDATE_SNAPSHOTS`: `1` records every checked array as
+     *   its new snapshot instead of comparing it.
+     * - `FORTEST_ASYNC_LOG`: `1` writes the global loggers' output on a
+     *   background thread; `0` keeps it synchronous.
+     * - `FORTEST_PROGRESS`: file rewritten with a Prometheus snapshot of
+     *   the run's progress while it runs (see ProgressMonitor).
+     * - `FORTEST_PROGRESS_INTERVAL`: seconds between two snapshots;
+     *   defaults to 1.
+     */
+    struct RunOptions {
+        /// Where tests execute.
+        enum class Isolation {
+            Thread, ///< In the test binary's own process
+            Process ///< In a forked child per test; crashes are contained
+        };
+
+        /// How a distributed session assigns regular tests to processes.
+        enum class Distribution {
+            RoundRobin, ///< In name order, one process after the other
+            Cost        ///< Longest expected duration first, to the least loaded process
+        };
+
+        /// Which tests a run repeats, based on the results database.
+        enum class Rerun {
+            All,         ///< Every test
+            FailedFirst, ///< Failed and new tests, then the others
+            FailedOnly   ///< Failed and new tests only
+        };
+
+        std::size_t num_workers = 1;             //!< Worker threads or children; 1 runs serially
+        Isolation isolation = Isolation::Thread; //!< Where tests execute
+        double timeout_seconds = 0.0;            //!< Default per-test limit; 0 disables it
+        double timeout_grace_seconds = 5.0;      //!< Time a timed-out in-process test has to return
+        std::size_t chunk_size = 0;              //!< Parameter cases per chunk; 0 is guided
+        bool longest_first = true;               //!< Start parallel tests by decreasing expected duration
+        double default_duration_ms = 0.0;        //!< Expected duration without history; 0 is the known mean
+        Distribution distribution = Distribution::RoundRobin; //!< Test assignment of distributed sessions
+        Rerun rerun = Rerun::All;                //!< Tests repeated from the last results
+        bool skip_unchanged = false;             //!< Skip passing tests of suites whose fingerprint is unchanged
+        bool use_cache = true;                   //!< Report unchanged cacheable tests as CACHED instead of running them
+        std::string filter;                      //!< Name patterns of the tests to run; empty runs all
+        RegressionOptions regression;            //!< Benchmark slowdown over the baseline that fails
+        PerfEventOptions perf;                   //!< Hardware events counted around test bodies
+        bool track_memory = false;               //!< Record the resident memory of test bodies
+        std::size_t max_failures = 0;            //!< Failures after which no test starts; 0 runs all
+        std::string results_db = "fortest_results.sqlite"; //!< Results database; empty disables it
+        std::string reports;                     //!< Reports to write, `format:path` separated by commas
+        std::string snapshot_dir;                //!< Snapshot directory; empty is next to the results database
+        bool update_snapshots = false;           //!< Record checked arrays instead of comparing them
+        bool async_log = false;                  //!< Write global log output on a background thread
+        std::string progress_file;               //!< Progress snapshot file; empty writes none
+        double progress_interval_seconds = 1.0;  //!< Time between two progress snapshots
+
+        /// @brief Number of hardware threads, never less than one.
+        [[nodiscard]] static std::size_t hardware_workers() noexcept {
+            const auto n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+
+        /**
+         * @brief Build options from the `FORTEST_*` environment variables.
+         *
+         * Unset or malformed variables keep their default value.
+         */
+        [[nodiscard]] static RunOptions from_env() {
+            RunOptions options;
+            if (const char *value = std::getenv("FORTEST_NUM_WORKERS")) {
+                const std::string text(value);
+                if (text == "auto" || text == "0") {
+                    options.num_workers = hardware_workers();
+                } else {
+                    char *end = nullptr;
+                    const long n = std::strtol(value, &end, 10);
+                    if (end != value && *end == '\0' && n > 0) {
+                        options.num_workers = static_cast<std::size_t>(n);
+                    }
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_ISOLATION")) {
+                const std::string text(value);
+                if (text == "process") {
+                    options.isolation = Isolation::Process;
+                } else if (text == "thread") {
+                    options.isolation = Isolation::Thread;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_TIMEOUT")) {
+                char *end = nullptr;
+                const double seconds = std::strtod(value, &end);
+                if (end != value && *end == '\0' && seconds >= 0.0) {
+                    options.timeout_seconds = seconds;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_TIMEOUT_GRACE")) {
+                char *end = nullptr;
+                const double seconds = std::strtod(value, &end);
+                if (end != value && *end == '\0' && seconds >= 0.0) {
+                    options.timeout_grace_seconds = seconds;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_CHUNK_SIZE")) {
+                const std::string text(value);
+                if (text == "guided") {
+                    options.chunk_size = 0;
+                } else {
+                    char *end = nullptr;
+                    const long n = std::strtol(value, &end, 10);
+                    if (end != value && *end == '\0' && n >= 0) {
+                        options.chunk_size = static_cast<std::size_t>(n);
+                    }
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_SCHEDULE")) {
+                const std::string text(value);
+                if (text == "lpt") {
+                    options.longest_first = true;
+                } else if (text == "name") {
+                    options.longest_first = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_DEFAULT_DURATION_MS")) {
+                char *end = nullptr;
+                const double ms = std::strtod(value, &end);
+                if (end != value && *end == '\0' && ms >= 0.0) {
+                    options.default_duration_ms = ms;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_DISTRIBUTION")) {
+                const std::string text(value);
+                if (text == "round_robin") {
+                    options.distribution = Distribution::RoundRobin;
+                } else if (text == "cost") {
+                    options.distribution = Distribution::Cost;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_RERUN")) {
+                const std::string text(value);
+                if (text == "all") {
+                    options.rerun = Rerun::All;
+                } else if (text == "failed_first") {
+                    options.rerun = Rerun::FailedFirst;
+                } else if (text == "failed") {
+                    options.rerun = Rerun::FailedOnly;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_SKIP_UNCHANGED")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.skip_unchanged = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.skip_unchanged = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_CACHE")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.use_cache = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.use_cache = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_FILTER")) {
+                options.filter = value;
+            }
+            if (const char *value = std::getenv("FORTEST_MAX_SLOWDOWN")) {
+                char *end = nullptr;
+                const double percent = std::strtod(value, &end);
+                if (end != value && *end == '\0' && percent >= 0.0) {
+                    options.regression.max_slowdown_percent = percent;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_SIGNIFICANCE")) {
+                char *end = nullptr;
+                const double p = std::strtod(value, &end);
+                if (end != value && *end == '\0' && p > 0.0 && p <= 1.0) {
+                    options.regression.significance = p;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_PERF_COUNTERS")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.perf.enabled = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.perf.enabled = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_PERF_FLOPS_EVENT")) {
+                char *end = nullptr;
+                const unsigned long long code = std::strtoull(value, &end, 0);
+                if (end != value && *end == '\0') {
+                    options.perf.flops_event = code;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_TRACK_MEMORY")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.track_memory = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.track_memory = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_FAIL_FAST")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.max_failures = 1;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.max_failures = 0;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_MAX_FAILURES")) {
+                char *end = nullptr;
+                const long n = std::strtol(value, &end, 10);
+                if (end != value && *end == '\0' && n >= 0) {
+                    options.max_failures = static_cast<std::size_t>(n);
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_DB")) {
+                options.results_db = value;
+            }
+            if (const char *value = std::getenv("FORTEST_REPORT")) {
+                options.reports = value;
+            }
+            if (const char *value = std::getenv("FORTEST_SNAPSHOT_DIR")) {
+                options.snapshot_dir = value;
+            }
+            if (const char *value = std::getenv("FORTEST_UPDATE_SNAPSHOTS")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.update_snapshots = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.update_snapshots = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_ASYNC_LOG")) {
+                const std::string text(value);
+                if (text == "1" || text == "on" || text == "true") {
+                    options.async_log = true;
+                } else if (text == "0" || text == "off" || text == "false") {
+                    options.async_log = false;
+                }
+            }
+            if (const char *value = std::getenv("FORTEST_PROGRESS")) {
+                options.progress_file = value;
+            }
+            if (const char *value = std::getenv("FORTEST_PROGRESS_INTERVAL")) {
+                char *end = nullptr;
+                const double seconds = std::strtod(value, &end);
+                if (end != value && *end == '\0' && seconds > 0.0) {
+                    options.progress_interval_seconds = seconds;
+                }
+            }
+            return options;
+        }
+
+        /// @brief Directory of the snapshots: `snapshot_dir`, or `fortest_snapshots` beside the results database.
+        [[nodiscard]] std::filesystem::path snapshot_directory() const {
+            if (!snapshot_dir.empty()) return snapshot_dir;
+            return std::filesystem::path(results_db).parent_path() / "fortest_snapshots";
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_RUN_OPTIONS_HPP
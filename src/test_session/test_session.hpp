@@ -1,14 +1,40 @@
 #ifndef FORTEST_TEST_SESSION_HPP
 #define FORTEST_TEST_SESSION_HPP
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <memory>
+#include "name_table.hpp"
 #include "test_suite.hpp"
 #include "fixture.hpp"
+#include "run_options.hpp"
+#include "thread_pool.hpp"
+#include "fork_runner.hpp"
+#include "session_distribution.hpp"
+#include "test_history.hpp"
+#include "fingerprint.hpp"
+#include "name_filter.hpp"
+#include "snapshot_store.hpp"
+#include "reporters.hpp"
+#include "progress.hpp"
 
 namespace Fortest {
+    /// One test of a table registered with TestSession::add_tests().
+    struct TestRecord {
+        std::string_view suite_name;          //!< Suite of the test; must be registered
+        std::string_view test_name;           //!< Name of the test
+        void (*body)(void *, void *, void *); //!< Test procedure (test, suite, session args)
+    };
+
     /**
      * @brief Represents a session of test suites.
      *
@@ -21,33 +47,122 @@ namespace Fortest {
      */
     template<LoggerLike TestLoggerType = Logger, LoggerLike AssertLoggerType = TestLoggerType>
     class TestSession {
+        using Suite = TestSuite<TestLoggerType, AssertLoggerType>;
+
         Assert<AssertLoggerType> &m_assert; //!< Assertion engine for all tests
-        std::map<std::string,
-            std::unique_ptr<TestSuite<TestLoggerType, AssertLoggerType>>> m_suites; //!< Registered test suites
+        NameTable m_suite_names; //!< Suite names; the id of a name indexes m_suites
+        std::vector<std::unique_ptr<Suite>> m_suites; //!< Registered test suites by id
         std::shared_ptr<Fixture<void>> m_session_fixture; //!< Optional session-level fixture
+        SharedFixture m_shared_session_fixture; //!< Sets the session fixture up for the first test that runs
+        RunOptions m_options; //!< How run() executes the tests
+        StatusCounter m_counts; //!< Tests of all suites per status, fed by the suites
+        CaseDistributorFactory m_case_distribution; //!< Shares parameter cases with other processes, if set
+        std::shared_ptr<SessionDistribution> m_distribution; //!< Shares all tests with other processes, if set
+        TestCostModel m_cost_model; //!< Expected test durations set by the user, if any
+        TestHistory m_history; //!< Past durations from the results database, read by run()
+        FailureBudget m_failure_budget; //!< Failures of the current run against `max_failures`
+        std::vector<std::shared_ptr<EventSink>> m_event_sinks; //!< Subscribed to the event bus during every run
+        bool m_publishing = false; //!< Whether this process publishes the events of the current run
 
     public:
+        /// Exit status of a test program whose run stopped at its failure limit.
+        static constexpr int stopped_exit_code = 100;
+
         /// @brief Construct a TestSession with a reference to the assertion engine.
         explicit TestSession(Assert<AssertLoggerType> &assert) : m_assert(assert) {}
 
+        /// @brief Replace the options used by subsequent runs.
+        void set_options(const RunOptions &options) { m_options = options; }
+
+        /// @brief Options used by run().
+        [[nodiscard]] const RunOptions &get_options() const { return m_options; }
+
+        /// @brief Mutable access to the options used by run().
+        [[nodiscard]] RunOptions &get_options() { return m_options; }
+
+        /**
+         * @brief Send the result of every test of later runs to `reporter`.
+         *
+         * The reporter receives the same rows as the results database,
+         * from the workers as tests finish (so it must be thread-safe),
+         * and is flushed at the end of every run. In a distributed
+         * session only the aggregating process reports.
+         */
+        void add_reporter(std::shared_ptr<ResultConsumer> reporter) {
+            if (reporter) m_event_sinks.push_back(std::make_shared<ResultEvents>(std::move(reporter)));
+        }
+
+        /**
+         * @brief Subscribe `sink` to the events of later runs.
+         *
+         * The sink is subscribed to EventBus::global() for the duration
+         * of every run and sees its session, suite, test and assertion
+         * events, from the workers as they happen (so it must be
+         * thread-safe). In a distributed session only the aggregating
+         * process publishes session, suite and test events.
+         */
+        void add_event_sink(std::shared_ptr<EventSink> sink) {
+            if (sink) m_event_sinks.push_back(std::move(sink));
+        }
+
+        /**
+         * @brief Share the cases of every parameterized test with other processes.
+         *
+         * See TestSuite::set_case_distribution(). Every process must then
+         * run the same session. Process isolation keeps the cases local.
+         */
+        void set_case_distribution(CaseDistributorFactory factory) {
+            m_case_distribution = std::move(factory);
+        }
+
+        /**
+         * @brief Share the tests of the session with other processes.
+         *
+         * @details
+         * Every process must register the same tests and run the session.
+         * Each regular test then runs on one process only, chosen by the
+         * `distribution` policy of the run options; collective tests run
+         * on all processes, and the cases of parameterized tests are
+         * shared as with set_case_distribution() (with process isolation
+         * a parameterized test is assigned to one process as a whole).
+         * After the run the results are combined so that every process
+         * reports the same statuses. Only the aggregator logs progress and
+         * writes the results database, including the rows of the others.
+         *
+         * @param distribution Processes sharing the session, or nullptr to
+         *        run every test here again.
+         */
+        void set_distribution(std::shared_ptr<SessionDistribution> distribution) {
+            m_distribution = std::move(distribution);
+        }
+
+        /**
+         * @brief Expected test durations, in milliseconds, for scheduling.
+         *
+         * Consulted first by longest-first scheduling and cost-based
+         * distribution. Tests the model knows nothing about fall back to
+         * their history in the results database, then to their last run
+         * in this session, then to the `default_duration_ms` estimate.
+         */
+        void set_cost_model(TestCostModel model) { m_cost_model = std::move(model); }
+
         /**
          * @brief Add a new test suite to the session.
          * @param name Name of the test suite.
          * @throws std::runtime_error if a suite with the same name already exists.
          * @return Reference to the created TestSuite.
          */
-        TestSuite<TestLoggerType, AssertLoggerType> &add_test_suite(const std::string &name) {
-            if (m_suites.find(name) != m_suites.end()) {
+        Suite &add_test_suite(std::string_view name) {
+            if (!m_suite_names.intern(name).second) {
                 throw std::runtime_error(
-                    "Test suite with name '" + name +
+                    "Test suite with name '" + std::string(name) +
                     "' already exists in session."
                 );
             }
-            auto suite = std::make_unique<TestSuite<TestLoggerType, AssertLoggerType>>(name, m_assert);
-            auto &ref = *suite;
-            m_suites[name] = std::move(suite);
+            auto &ref = *m_suites.emplace_back(
+                std::make_unique<Suite>(std::string(name), m_assert, &m_counts));
             if (m_session_fixture) {
-                m_suites[name]->add_fixture(*m_session_fixture);
+                ref.add_fixture(*m_session_fixture);
             }
             return ref;
         }
@@ -64,7 +179,7 @@ namespace Fortest {
                 );
             }
             m_session_fixture = std::make_shared<Fixture<void>>(fixture);
-            for (auto &[name, suite] : m_suites) {
+            for (auto &suite : m_suites) {
                 suite->add_fixture(fixture);
             }
         }
@@ -77,24 +192,17 @@ namespace Fortest {
          *         or suite does not exist.
          */
         void add_fixture(
-            const std::string &suite_name,
+            std::string_view suite_name,
             const Fixture<void> &fixture
         ) {
             if (fixture.get_scope() != Scope::Test &&
                 fixture.get_scope() != Scope::Suite) {
                 throw std::runtime_error(
-                    "Fixture for suite '" + suite_name +
+                    "Fixture for suite '" + std::string(suite_name) +
                     "' must have test or suite scope."
                 );
             }
-            auto it = m_suites.find(suite_name);
-            if (it == m_suites.end()) {
-                throw std::runtime_error(
-                    "Suite '" + suite_name +
-                    "' does not exist in session."
-                );
-            }
-            it->second->add_fixture(fixture);
+            find_suite(suite_name).add_fixture(fixture);
         }
 
         /**
@@ -102,21 +210,64 @@ namespace Fortest {
          * @param suite_name Name of the suite.
          * @param test_name Name of the test.
          * @param func Test function (void(*)(void*, void*, void*)).
+         * @param collective Whether every process of a distributed session runs the test.
          * @throws std::runtime_error if suite does not exist.
          */
         void add_test(
-            const std::string &suite_name,
-            const std::string &test_name,
-            TestFunction func
+            std::string_view suite_name,
+            std::string_view test_name,
+            TestFunction func,
+            bool collective = false
         ) {
-            auto it = m_suites.find(suite_name);
-            if (it == m_suites.end()) {
-                throw std::runtime_error(
-                    "Suite '" + suite_name +
-                    "' does not exist in session."
-                );
+            find_suite(suite_name).add_test(test_name, std::move(func), collective);
+        }
+
+        /**
+         * @brief Add a table of tests, e.g. one generated from the test sources.
+         *
+         * Same as add_test() for every record in order, but a suite is
+         * looked up once per run of consecutive records naming it, and
+         * each suite reserves room for all of its new tests before the
+         * first is added.
+         *
+         * @param records Tests to add; names are copied.
+         * @throws std::runtime_error if a suite does not exist; no test is added then.
+         */
+        void add_tests(std::span<const TestRecord> records) {
+            std::vector<Suite *> suites(records.size());
+            std::unordered_map<Suite *, std::size_t> num_new;
+            Suite *suite = nullptr;
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                if (!suite || records[i].suite_name != records[i - 1].suite_name) {
+                    suite = &find_suite(records[i].suite_name);
+                }
+                suites[i] = suite;
+                ++num_new[suite];
             }
-            it->second->add_test(test_name, std::move(func));
+            for (const auto &[target, count] : num_new) {
+                const TestRegistry &tests = target->get_registry();
+                target->reserve(tests.num_tests() + count, tests.num_parameterized());
+            }
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                suites[i]->add_test(records[i].test_name, records[i].body);
+            }
+        }
+
+        /**
+         * @brief Add a benchmark to a suite; see TestSuite::add_benchmark().
+         * @param suite_name Name of the suite.
+         * @param test_name Name of the benchmark.
+         * @param func Body to time.
+         * @param options How to measure it.
+         * @throws std::runtime_error if suite does not exist.
+         */
+        void add_benchmark(
+            std::string_view suite_name,
+            std::string_view test_name,
+            TestFunction func,
+            BenchmarkOptions options = {}
+        ) {
+            find_suite(suite_name).add_benchmark(test_name, std::move(func), options);
         }
 
         /**
@@ -124,58 +275,247 @@ namespace Fortest {
          * @param suite_name Name of the suite.
          * @param test_name Name of the test.
          * @param func Parameterized test function.
-         * @param params Vector of parameter indices.
+         * @param params Cases to run: a list of values or a ParameterSpace of ranges.
          * @throws std::runtime_error if suite does not exist.
          */
         void add_parameterized_test(
-            const std::string &suite_name,
-            const std::string &test_name,
+            std::string_view suite_name,
+            std::string_view test_name,
             ParameterizedTestFunction func,
-            std::vector<int> params
+            ParameterSpace params
         ) {
-            auto it = m_suites.find(suite_name);
-            if (it == m_suites.end()) {
-                throw std::runtime_error(
-                    "Suite '" + suite_name +
-                    "' does not exist in session."
-                );
-            }
-            it->second->register_parameterized_test(test_name, std::move(func), std::move(params));
+            find_suite(suite_name).register_parameterized_test(test_name, std::move(func), std::move(params));
         }
 
         /**
          * @brief Run all test suites in the session.
+         *
+         * With `num_workers` greater than one in the run options the tests
+         * are executed concurrently on a work-stealing thread pool;
+         * session and suite fixtures still wrap the tests that use them.
+         * Fixtures are set up by the first test that runs with them, and a
+         * suite fixture is torn down as soon as its suite's last test has
+         * finished rather than at the end of the session.
+         * The cases of a parameterized test are then shared by the
+         * workers in chunks of `chunk_size` (guided when 0).
+         * With process isolation every test runs in a forked child, at
+         * most `num_workers` at a time; crashes and timeouts are recorded
+         * as CRASH and TIMEOUT instead of ending the session. In-process
+         * tests that overrun their timeout (see TestSuite::set_timeout())
+         * are asked to stop through TestCancellation::requested() and recorded
+         * as TIMEOUT; one that does not stop within the grace period ends
+         * the process after its TIMEOUT row has been committed.
+         *
+         * Every run is recorded in the results database named by the run
+         * options, together with one result row per test.
+         *
+         * Parallel runs start the tests with the longest expected duration
+         * first (see set_cost_model()) unless `longest_first` is off, so a
+         * slow test does not start last and stretch the wall time.
+         *
+         * The `filter` option restricts the run to the tests whose names
+         * match; suites without a matching test are skipped, fixtures
+         * included. The `rerun` and `skip_unchanged` options restrict it
+         * to the tests that failed, are new, or belong to a changed suite
+         * according to the results database, optionally followed by the
+         * others. Tests that do not run keep their status and write no
+         * result rows.
+         *
+         * A distributed session (see set_distribution()) runs only this
+         * process's share of the tests and then combines the results of
+         * all processes; the logger and the database are used by the
+         * aggregator only.
+         *
+         * With `max_failures` set, no test starts once that many tests or
+         * parameter cases have failed: queued tests are skipped and keep
+         * their status, running tests finish, and every fixture that was
+         * set up is torn down. stopped_early() then reports the early
+         * stop. A distributed session counts failures per process and
+         * still runs its collective tests.
+         *
          * @param logger Shared pointer to logger.
          */
         void run(const std::shared_ptr<TestLoggerType> &logger) {
-            logger->log("Starting test session: ", "INFO");
+            const bool aggregator = !m_distribution || m_distribution->is_aggregator();
+            const std::shared_ptr<Logger> out = aggregator ? std::shared_ptr<Logger>(logger) : quiet_logger();
+            out->log("Starting test session: ", "INFO");
 
-            if (m_session_fixture) {
-                m_session_fixture->setup();
+            // The first test to run sets the session fixture up; fixtures of
+            // distributed sessions may communicate, so every process does.
+            m_shared_session_fixture.open(m_session_fixture.get(), 1);
+            if (m_distribution || m_case_distribution) m_shared_session_fixture.acquire();
+
+            m_failure_budget.reset(m_options.max_failures);
+            MemoryTracking::configure(m_options.track_memory);
+            PerfCounters::configure(m_options.perf);
+            SnapshotStore::global().configure(m_options.snapshot_directory(), m_options.update_snapshots);
+            if (m_options.perf.enabled && !PerfCounters::available()) {
+                out->log("Hardware performance counters are unavailable (see perf_event_paranoid)", "INFO");
             }
 
-            for (auto &[name, suite] : m_suites) {
-                logger->log("Running test suite: " + name, "INFO");
+            const bool ordered = m_options.num_workers > 1 && m_options.longest_first;
+            const bool cost_based = m_distribution && m_options.distribution == RunOptions::Distribution::Cost;
+            const bool rerunning = m_options.rerun != RunOptions::Rerun::All || m_options.skip_unchanged;
+            const bool filtered = rerunning || !m_options.filter.empty();
+            // Benchmarks compare with their baseline wherever they run.
+            const bool comparing = m_options.regression.max_slowdown_percent > 0.0;
+            // Read the past results before this run adds to them.
+            const bool tracking = aggregator && !m_options.progress_file.empty();
+            const bool caching = aggregator && m_options.use_cache && has_cacheable_tests();
+            m_history = (aggregator && (ordered || cost_based || rerunning || tracking || caching)) || comparing
+                            ? TestHistory::load(m_options.results_db)
+                            : TestHistory{};
+            TestCostModel costs;
+            if (ordered) {
+                costs = [this](std::string_view suite_name, std::string_view test_name) {
+                    return expected_duration_ms(suite_name, test_name);
+                };
+            }
 
-                // Inject session fixture into each suite
-                suite->add_fixture(
-                    Fixture<void>(
-                        nullptr, nullptr,
-                        m_session_fixture
-                            ? m_session_fixture->get_args()
-                            : nullptr,
-                        Scope::Session
-                    )
-                );
+            // The database and the reports subscribe to the run's events.
+            EventBus &bus = EventBus::global();
+            std::shared_ptr<ResultSink> sink;
+            std::vector<std::shared_ptr<StreamReporter>> reports;
+            std::shared_ptr<ProgressMonitor> progress;
+            std::vector<EventBus::Subscription> subscriptions;
+            if (aggregator) {
+                if (!m_options.results_db.empty()) {
+                    sink = std::make_shared<ResultSink>(m_options.results_db);
+                    subscriptions.push_back(bus.scoped(std::make_shared<ResultEvents>(sink)));
+                }
+                for (auto &report : make_reporters(m_options.reports)) {
+                    reports.push_back(std::move(report));
+                    subscriptions.push_back(bus.scoped(std::make_shared<ResultEvents>(reports.back())));
+                }
+                if (tracking) {
+                    const auto interval = std::chrono::milliseconds(
+                        std::llround(m_options.progress_interval_seconds * 1000.0));
+                    progress = std::make_shared<ProgressMonitor>(m_options.progress_file, interval);
+                    subscriptions.push_back(bus.scoped(progress));
+                }
+            }
+            for (const auto &event_sink : m_event_sinks) subscriptions.push_back(bus.scoped(event_sink));
+            m_publishing = aggregator;
+            // Other processes' rows reach the database and reports through the aggregator.
+            ResultBuffer buffer;
+            EventPublisher publisher(bus);
+            ResultConsumer *rows = m_distribution ? static_cast<ResultConsumer *>(&buffer)
+                                   : aggregator && bus.has_subscribers() ? &publisher
+                                                                         : nullptr;
+
+            const std::vector<Suite *> suites = suites_by_name();
+            if (m_publishing) {
+                bus.publish(Event{.kind = EventKind::SessionStarted,
+                                  .value = static_cast<std::int64_t>(suites.size()),
+                                  .time = std::chrono::system_clock::now()});
+            }
+            for (Suite *suite : suites) {
+                BenchmarkBaseline baseline;
+                if (comparing) {
+                    baseline = [this](std::string_view suite_name, std::string_view test_name) {
+                        return m_history.benchmark_baseline(suite_name, test_name);
+                    };
+                }
+                suite->set_benchmark_baseline(std::move(baseline), m_options.regression);
+            }
+            const auto phases = plan_phases(suites);
+            std::vector<TestSelection> candidates = phases.front();
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const TestRegistry &tests = suites[s]->get_registry();
+                for (std::size_t p = 1; p < phases.size(); ++p) {
+                    candidates[s] = TestSelection::combine(candidates[s], phases[p][s], false, tests.num_tests(),
+                                                           tests.num_parameterized());
+                }
+            }
+            const std::vector<TestSelection> assigned = assign_tests(suites, candidates);
+            const std::vector<CacheKeys> cache_keys = aggregator && (caching || sink)
+                                                          ? cache_keys_of(suites, candidates)
+                                                          : std::vector<CacheKeys>(suites.size());
+            apply_cache(suites, cache_keys);
+            if (m_publishing && bus.has_subscribers()) {
+                // The aggregator publishes the results of every process, so the plan covers them all.
+                const RunPlan plan = plan_of(suites, candidates);
+                bus.publish(Event{.kind = EventKind::RunPlanned, .plan = &plan,
+                                  .time = std::chrono::system_clock::now()});
+            }
 
-                suite->run(logger);
+            for (std::size_t p = 0; p < phases.size(); ++p) {
+                if (p > 0 && stop_starting_suites()) break;
+                std::vector<Suite *> running;
+                std::size_t num_selected = 0;
+                for (std::size_t s = 0; s < suites.size(); ++s) {
+                    const TestRegistry &tests = suites[s]->get_registry();
+                    suites[s]->select(TestSelection::combine(assigned[s], phases[p][s], true, tests.num_tests(),
+                                                             tests.num_parameterized()));
+                    const std::size_t n = filtered ? phases[p][s].count(tests.num_tests(), tests.num_parameterized())
+                                                   : 0;
+                    num_selected += n;
+                    if (!filtered || n > 0) running.push_back(suites[s]);
+                }
+                if (filtered) {
+                    const char *kind = p > 0 ? " remaining"
+                                       : !rerunning ? " selected"
+                                       : m_options.skip_unchanged ? " failed, new or changed"
+                                                                  : " failed or new";
+                    out->log(std::string(p == 0 ? "Running " : "Then running ") + std::to_string(num_selected) +
+                             kind + " tests", "INFO");
+                }
+                execute(running, out, rows, costs);
             }
+            for (std::size_t s = 0; s < suites.size(); ++s) suites[s]->select(assigned[s]);
 
-            if (m_session_fixture) {
-                m_session_fixture->teardown();
+            if (m_distribution) {
+                for (Suite *suite : suites) {
+                    suite->reduce_results(*m_distribution, out, rows);
+                }
+                for (auto &row : m_distribution->gather(buffer.take())) {
+                    publisher.push(std::move(row));
+                }
+            }
+            if (sink) {
+                for (std::size_t s = 0; s < suites.size(); ++s) {
+                    const TestRegistry &tests = suites[s]->get_registry();
+                    // Failures are recorded too, so a later run only trusts the latest result under a key.
+                    for (const auto &[id, key] : cache_keys[s]) {
+                        const Test::Status status = tests.status(id);
+                        if (status != Test::Status::NONE && status != Test::Status::CACHED) {
+                            sink->record_cache_key(suites[s]->get_name(), tests.test_name(id), key);
+                        }
+                    }
+                }
+            }
+            for (Suite *suite : suites) suite->set_cached({});
+            if (sink && m_options.skip_unchanged) {
+                for (std::size_t s = 0; s < suites.size(); ++s) {
+                    const TestRegistry &tests = suites[s]->get_registry();
+                    const std::string &fingerprint = fingerprint_of(*suites[s]);
+                    if (!fingerprint.empty() && candidates[s].count(tests.num_tests(), tests.num_parameterized()) > 0) {
+                        sink->record_fingerprint(suites[s]->get_name(), fingerprint);
+                    }
+                }
             }
 
-            logger->log("Finished test session: ", "INFO");
+            if (m_failure_budget.exhausted()) {
+                out->log("Stopped after " + std::to_string(m_failure_budget.failures()) +
+                         " failed tests; the remaining tests were not run", "INFO");
+            }
+
+            if (m_publishing) {
+                bus.publish(Event{.kind = EventKind::SessionFinished,
+                                  .value = static_cast<std::int64_t>(m_failure_budget.failures()),
+                                  .time = std::chrono::system_clock::now()});
+            }
+            // Commit the results and stamp the run's finish time; finish the reports.
+            subscriptions.clear();
+            sink.reset();
+            reports.clear();
+            progress.reset();
+            for (const auto &event_sink : m_event_sinks) event_sink->flush();
+            m_publishing = false;
+
+            m_shared_session_fixture.release();
+
+            out->log("Finished test session: ", "INFO");
         }
 
         /**
@@ -185,15 +525,490 @@ namespace Fortest {
          * @throws std::runtime_error if suite does not exist.
          */
         [[nodiscard]] std::map<std::string, Test::Status>
-        get_test_suite_status(const std::string &suite_name) const {
-            auto it = m_suites.find(suite_name);
-            if (it == m_suites.end()) {
+        get_test_suite_status(std::string_view suite_name) const {
+            return find_suite(suite_name).get_statuses();
+        }
+
+        /**
+         * @brief Number of tests of all suites in each status, in O(1).
+         *
+         * A parameterized test counts once (see TestSuite::get_status_counts).
+         */
+        [[nodiscard]] StatusCounts get_status_counts() const { return m_counts.counts(); }
+
+        /// @brief Number of suites with a failed, crashed or timed-out test, in O(1).
+        [[nodiscard]] std::int64_t get_num_failing_suites() const { return m_counts.failing_children(); }
+
+        /// @brief Whether the last run reached `max_failures` and stopped starting tests.
+        [[nodiscard]] bool stopped_early() const { return m_failure_budget.exhausted(); }
+
+        /**
+         * @brief Get the durations of all tests in a suite.
+         * @param suite_name Name of the suite.
+         * @return Map of test names to their last run's durations.
+         * @throws std::runtime_error if suite does not exist.
+         */
+        [[nodiscard]] std::map<std::string, TestTiming>
+        get_test_suite_timings(std::string_view suite_name) const {
+            return find_suite(suite_name).get_timings();
+        }
+
+        /**
+         * @brief Statistics of a benchmark's latest run, if it ran in this process.
+         * @throws std::runtime_error if suite does not exist.
+         */
+        [[nodiscard]] std::optional<BenchmarkStats>
+        get_benchmark_stats(std::string_view suite_name, std::string_view test_name) const {
+            return find_suite(suite_name).get_benchmark_stats(test_name);
+        }
+
+        /**
+         * @brief Find a suite by name in O(1).
+         * @throws std::runtime_error if suite does not exist.
+         */
+        [[nodiscard]] Suite &find_suite(std::string_view suite_name) const {
+            const auto id = m_suite_names.find(suite_name);
+            if (!id) {
                 throw std::runtime_error(
-                    "Suite '" + suite_name +
+                    "Suite '" + std::string(suite_name) +
                     "' does not exist in session."
                 );
             }
-            return it->second->get_statuses();
+            return *m_suites[*id];
+        }
+
+    private:
+        /// @brief Suites in the order they run: by name.
+        [[nodiscard]] std::vector<Suite *> suites_by_name() const {
+            std::vector<Suite *> ordered;
+            ordered.reserve(m_suites.size());
+            for (NameId id : m_suite_names.sorted()) ordered.push_back(m_suites[id].get());
+            return ordered;
+        }
+
+        /// @brief Pass the session fixture, the default timeout and the parameter sharding settings to a suite.
+        void prepare_suite(Suite &suite) {
+            suite.set_session_fixture(&m_shared_session_fixture);
+            suite.set_default_timeout(m_options.timeout_seconds, m_options.timeout_grace_seconds);
+            suite.set_failure_budget(&m_failure_budget);
+            suite.set_chunk_size(m_options.chunk_size);
+            suite.set_case_distribution(m_distribution ? m_distribution->case_distribution()
+                                                       : m_case_distribution);
+        }
+
+        /**
+         * @brief Whether the failure budget is exhausted and no further suite should start.
+         *
+         * Distributed sessions keep going, so every process still joins
+         * the collective steps; their suites skip the tests instead.
+         */
+        [[nodiscard]] bool stop_starting_suites() const {
+            return !m_distribution && m_failure_budget.exhausted();
+        }
+
+        /// @brief Logger of the processes that do not aggregate a distributed session.
+        [[nodiscard]] static std::shared_ptr<Logger> quiet_logger() {
+            static std::ostream discard(nullptr);
+            return std::make_shared<Logger>(discard);
+        }
+
+        /**
+         * @brief Run the selected tests of the given suites.
+         *
+         * Parallel runs queue the tests of all suites before they start,
+         * in the order of their expected duration if `costs` is set.
+         */
+        void execute(const std::vector<Suite *> &suites, const std::shared_ptr<Logger> &out, ResultConsumer *rows,
+                     const TestCostModel &costs) {
+            const bool parallel = m_options.num_workers > 1;
+            if (m_options.isolation == RunOptions::Isolation::Process) {
+                ForkRunner runner(m_options.num_workers, m_options.timeout_seconds);
+                runner.stop_when([this] { return m_failure_budget.exhausted(); });
+                std::vector<ForkedJob> jobs;
+                for (Suite *suite : suites) {
+                    if (stop_starting_suites()) break;
+                    announce(*suite, *out);
+                    suite->set_session_fixture(&m_shared_session_fixture);
+                    suite->set_default_timeout(m_options.timeout_seconds, m_options.timeout_grace_seconds);
+                    suite->set_failure_budget(&m_failure_budget);
+                    suite->set_case_distribution({});
+                    std::ranges::move(suite->forked_jobs(out, rows, costs), std::back_inserter(jobs));
+                    // Serial runs keep suite fixtures strictly nested.
+                    if (!parallel) {
+                        for (auto &job : std::exchange(jobs, {})) {
+                            runner.submit(std::move(job.body), std::move(job.completion), job.timeout_seconds,
+                                          std::move(job.prepare));
+                        }
+                        runner.wait();
+                    }
+                }
+                if (costs) order_longest_first(jobs, m_options.default_duration_ms);
+                for (auto &job : jobs) {
+                    runner.submit(std::move(job.body), std::move(job.completion), job.timeout_seconds,
+                                  std::move(job.prepare));
+                }
+                runner.wait();
+            } else if (parallel) {
+                ThreadPool pool(m_options.num_workers);
+                std::vector<ScheduledJob> jobs;
+                for (Suite *suite : suites) {
+                    if (stop_starting_suites()) break;
+                    announce(*suite, *out);
+                    prepare_suite(*suite);
+                    std::ranges::move(suite->schedule_jobs(pool.size(), out, rows, costs),
+                                      std::back_inserter(jobs));
+                }
+                if (costs) order_longest_first(jobs, m_options.default_duration_ms);
+                std::vector<ThreadPool::Task> tasks;
+                tasks.reserve(jobs.size());
+                for (auto &job : jobs) tasks.push_back(std::move(job.task));
+                pool.submit_ordered(std::move(tasks));
+                pool.wait();
+                for (Suite *suite : suites) {
+                    suite->merge_distributed(out);
+                }
+            } else {
+                for (Suite *suite : suites) {
+                    if (stop_starting_suites()) break;
+                    announce(*suite, *out);
+                    prepare_suite(*suite);
+                    suite->run(out, rows);
+                }
+            }
+        }
+
+        /// @brief Log that a suite starts and publish its SuiteStarted event.
+        void announce(const Suite &suite, Logger &out) const {
+            out.log("Running test suite: " + suite.get_name(), Logger::Tag::Info);
+            if (m_publishing) {
+                EventBus::global().publish(Event{.kind = EventKind::SuiteStarted,
+                                                 .suite = suite.get_name(),
+                                                 .time = std::chrono::system_clock::now()});
+            }
+        }
+
+        /// @brief Fingerprint identifying a suite's code: its own, or the test binary's.
+        [[nodiscard]] static const std::string &fingerprint_of(const Suite &suite) {
+            return suite.get_fingerprint().empty() ? executable_fingerprint() : suite.get_fingerprint();
+        }
+
+        /**
+         * @brief Split the tests into the phases of the run.
+         *
+         * Only tests matching the name filter take part. Without rerun
+         * options there is one phase of every test. Otherwise
+         * the first phase holds the tests whose latest result failed, the
+         * tests without a result and, when skipping unchanged suites, every
+         * test of a suite whose fingerprint changed. With `FailedFirst` a
+         * second phase holds the other tests, unless unchanged suites are
+         * skipped. The aggregator decides for all processes.
+         *
+         * @return Per phase, the selection of each suite in `suites`.
+         */
+        [[nodiscard]] std::vector<std::vector<TestSelection>> plan_phases(const std::vector<Suite *> &suites) {
+            auto phases = plan_reruns(suites);
+            if (m_options.filter.empty()) return phases;
+            const NameFilter filter(m_options.filter);
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const TestRegistry &tests = suites[s]->get_registry();
+                const TestSelection named = select_by_name(filter, *suites[s]);
+                for (auto &phase : phases) {
+                    phase[s] = TestSelection::combine(phase[s], named, true, tests.num_tests(),
+                                                      tests.num_parameterized());
+                }
+            }
+            return phases;
+        }
+
+        /// @brief Tests of a suite whose name matches the filter.
+        [[nodiscard]] static TestSelection select_by_name(const NameFilter &filter, const Suite &suite) {
+            const auto match = filter.for_suite(suite.get_name());
+            if (match.all()) return {};
+            const TestRegistry &tests = suite.get_registry();
+            TestSelection selection;
+            selection.tests.assign(tests.num_tests(), false);
+            selection.parameterized.assign(tests.num_parameterized(), false);
+            if (match.none()) return selection;
+            for (TestRegistry::Id id = 0; id < tests.num_tests(); ++id) {
+                selection.tests[id] = match.matches(tests.test_name(id));
+            }
+            for (TestRegistry::Id id = 0; id < tests.num_parameterized(); ++id) {
+                selection.parameterized[id] = match.matches(tests.parameterized(id).get_name());
+            }
+            return selection;
+        }
+
+        /// @brief Phases of the run from the rerun options and the results database; see plan_phases().
+        [[nodiscard]] std::vector<std::vector<TestSelection>> plan_reruns(const std::vector<Suite *> &suites) {
+            const bool failed_first = m_options.rerun == RunOptions::Rerun::FailedFirst;
+            std::vector<std::vector<TestSelection>> phases(failed_first ? 2 : 1,
+                                                           std::vector<TestSelection>(suites.size()));
+            if (m_options.rerun == RunOptions::Rerun::All && !m_options.skip_unchanged) return phases;
+
+            // Phase of every test plus one; zero skips it.
+            const std::int64_t rest = failed_first && !m_options.skip_unchanged ? 2 : 0;
+            std::vector<std::int64_t> plan;
+            const bool aggregator = !m_distribution || m_distribution->is_aggregator();
+            for (const Suite *suite : suites) {
+                const TestRegistry &tests = suite->get_registry();
+                bool changed = false;
+                if (aggregator && m_options.skip_unchanged) {
+                    const std::string &fingerprint = fingerprint_of(*suite);
+                    changed = fingerprint.empty() || m_history.fingerprint(suite->get_name()) != fingerprint;
+                }
+                const auto phase = [&](const std::string &name) -> std::int64_t {
+                    if (!aggregator) return 0;
+                    const std::optional<bool> failed = m_history.last_failed(suite->get_name(), name);
+                    return changed || failed.value_or(true) ? 1 : rest;
+                };
+                for (TestRegistry::Id id = 0; id < tests.num_tests(); ++id) plan.push_back(phase(tests.test_name(id)));
+                for (TestRegistry::Id id = 0; id < tests.num_parameterized(); ++id) {
+                    plan.push_back(phase(tests.parameterized(id).get_name()));
+                }
+            }
+            if (m_distribution) m_distribution->max_reduce(plan);
+
+            std::size_t next = 0;
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const TestRegistry &tests = suites[s]->get_registry();
+                for (auto &phase : phases) {
+                    phase[s].tests.assign(tests.num_tests(), false);
+                    phase[s].parameterized.assign(tests.num_parameterized(), false);
+                }
+                for (TestRegistry::Id id = 0; id < tests.num_tests(); ++id) {
+                    if (const std::int64_t p = plan[next++]) phases[p - 1][s].tests[id] = true;
+                }
+                for (TestRegistry::Id id = 0; id < tests.num_parameterized(); ++id) {
+                    if (const std::int64_t p = plan[next++]) phases[p - 1][s].parameterized[id] = true;
+                }
+            }
+            return phases;
+        }
+
+        /**
+         * @brief Select the tests this process runs, out of the candidates.
+         *
+         * Without a distribution this process runs all candidates.
+         * Otherwise the regular candidate tests of all suites, in name
+         * order, are dealt out to the processes; with process isolation so
+         * are whole parameterized tests. Collective tests are selected
+         * everywhere.
+         *
+         * @param suites Suites in run order.
+         * @param candidates Tests of each suite that run at all.
+         * @return Selection of each suite.
+         */
+        [[nodiscard]] std::vector<TestSelection> assign_tests(const std::vector<Suite *> &suites,
+                                                              const std::vector<TestSelection> &candidates) {
+            if (!m_distribution) return candidates;
+            const bool whole_parameterized = m_options.isolation == RunOptions::Isolation::Process;
+
+            struct Unit {
+                std::size_t suite;
+                bool parameterized;
+                TestRegistry::Id id;
+            };
+            std::vector<Unit> units;
+            std::vector<std::optional<double>> known;
+            std::vector<TestSelection> selections(suites.size());
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const Suite &suite = *suites[s];
+                const TestRegistry &tests = suite.get_registry();
+                TestSelection &selection = selections[s];
+                selection.tests.assign(tests.num_tests(), false);
+                selection.parameterized = candidates[s].parameterized;
+                selection.distributed = true;
+                for (TestRegistry::Id id : tests.tests_by_name()) {
+                    if (!candidates[s].has_test(id)) continue;
+                    if (tests.is_collective(id)) {
+                        selection.tests[id] = true;
+                        continue;
+                    }
+                    units.push_back({s, false, id});
+                    known.push_back(expected_duration_ms(suite.get_name(), tests.test_name(id)));
+                }
+                if (whole_parameterized) {
+                    selection.parameterized.assign(tests.num_parameterized(), false);
+                    for (TestRegistry::Id id : tests.parameterized_by_name()) {
+                        if (!candidates[s].has_parameterized(id)) continue;
+                        units.push_back({s, true, id});
+                        known.push_back(expected_duration_ms(suite.get_name(), tests.parameterized(id).get_name()));
+                    }
+                }
+            }
+
+            const std::vector<double> costs = resolve_costs(share_costs(known), m_options.default_duration_ms);
+            const auto owners = assign_owners(costs, m_distribution->size(), m_options.distribution);
+            for (std::size_t i = 0; i < units.size(); ++i) {
+                if (owners[i] != m_distribution->rank()) continue;
+                TestSelection &selection = selections[units[i].suite];
+                (units[i].parameterized ? selection.parameterized : selection.tests)[units[i].id] = true;
+            }
+            return selections;
+        }
+
+        /// Cache keys of the cacheable tests of one suite, by test id.
+        using CacheKeys = std::unordered_map<TestRegistry::Id, std::string>;
+
+        [[nodiscard]] bool has_cacheable_tests() const {
+            return std::ranges::any_of(m_suites, [](const auto &suite) { return !suite->get_cacheable().empty(); });
+        }
+
+        /**
+         * @brief Cache key of a cacheable test: its names, the suite's fingerprint, its input files and flags.
+         * @return Empty if the code or an input file cannot be read, so the test is never cached.
+         */
+        [[nodiscard]] static std::string cache_key(const Suite &suite, std::string_view test_name,
+                                                   const CacheInputs &inputs) {
+            const std::string &code = fingerprint_of(suite);
+            if (code.empty()) return {};
+            std::string text = suite.get_name();
+            for (const std::string_view part : {test_name, std::string_view(code), std::string_view(inputs.flags)}) {
+                text.push_back('\0');
+                text.append(part);
+            }
+            for (const std::string &file : inputs.files) {
+                const std::string fingerprint = file_fingerprint(file);
+                if (fingerprint.empty()) return {};
+                text.append(1, '\0').append(file).append(1, '\0').append(fingerprint);
+            }
+            return text_fingerprint(text);
+        }
+
+        /// @brief Cache keys of the cacheable tests among `candidates`, per suite.
+        [[nodiscard]] static std::vector<CacheKeys> cache_keys_of(const std::vector<Suite *> &suites,
+                                                                  const std::vector<TestSelection> &candidates) {
+            std::vector<CacheKeys> keys(suites.size());
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const TestRegistry &tests = suites[s]->get_registry();
+                for (const auto &[id, inputs] : suites[s]->get_cacheable()) {
+                    if (!candidates[s].has_test(id)) continue;
+                    std::string key = cache_key(*suites[s], tests.test_name(id), inputs);
+                    if (!key.empty()) keys[s].emplace(id, std::move(key));
+                }
+            }
+            return keys;
+        }
+
+        /**
+         * @brief Mark the cacheable tests whose key passed before as CACHED for this run.
+         *
+         * Only the aggregator knows the keys and the results database;
+         * the other processes take its decisions.
+         */
+        void apply_cache(const std::vector<Suite *> &suites, const std::vector<CacheKeys> &keys) {
+            std::vector<std::int64_t> hits;
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const auto &cacheable = suites[s]->get_cacheable();
+                const std::size_t num_tests = suites[s]->get_registry().num_tests();
+                for (TestRegistry::Id id = 0; id < num_tests && !cacheable.empty(); ++id) {
+                    if (!cacheable.contains(id)) continue;
+                    const auto key = keys[s].find(id);
+                    hits.push_back(m_options.use_cache && key != keys[s].end() && m_history.passed_with(key->second));
+                }
+            }
+            if (m_distribution) m_distribution->max_reduce(hits);
+            std::size_t next = 0;
+            for (Suite *suite : suites) {
+                const auto &cacheable = suite->get_cacheable();
+                if (cacheable.empty()) continue;
+                std::vector<bool> cached(suite->get_registry().num_tests());
+                for (TestRegistry::Id id = 0; id < cached.size(); ++id) {
+                    if (cacheable.contains(id)) cached[id] = hits[next++] != 0;
+                }
+                suite->set_cached(std::move(cached));
+            }
+        }
+
+        /**
+         * @brief The tests and parameter cases of `selections`, and their expected work.
+         *
+         * Tests without an expected duration count at the run options'
+         * default duration, else at the mean of the others.
+         */
+        [[nodiscard]] RunPlan plan_of(const std::vector<Suite *> &suites,
+                                      const std::vector<TestSelection> &selections) const {
+            RunPlan plan;
+            plan.workers = static_cast<std::int64_t>(std::max<std::size_t>(m_options.num_workers, 1) *
+                                                     (m_distribution ? m_distribution->size() : 1));
+            double known_ms = 0.0;
+            std::int64_t num_known = 0;
+            std::int64_t num_unknown = 0;
+            const auto expect = [&](std::string_view suite_name, std::string_view test_name) {
+                if (const auto ms = expected_duration_ms(suite_name, test_name)) {
+                    known_ms += *ms;
+                    ++num_known;
+                } else {
+                    ++num_unknown;
+                }
+            };
+            for (std::size_t s = 0; s < suites.size(); ++s) {
+                const TestRegistry &tests = suites[s]->get_registry();
+                for (TestRegistry::Id id = 0; id < tests.num_tests(); ++id) {
+                    if (!selections[s].has_test(id)) continue;
+                    ++plan.tests;
+                    if (!suites[s]->is_cached(id)) expect(suites[s]->get_name(), tests.test_name(id));
+                }
+                for (TestRegistry::Id id = 0; id < tests.num_parameterized(); ++id) {
+                    if (!selections[s].has_parameterized(id)) continue;
+                    const ParameterizedTest &ptest = tests.parameterized(id);
+                    plan.tests += static_cast<std::int64_t>(ptest.get_num_cases());
+                    expect(suites[s]->get_name(), ptest.get_name());
+                }
+            }
+            const double fill_ms = m_options.default_duration_ms > 0.0 ? m_options.default_duration_ms
+                                   : num_known > 0                     ? known_ms / static_cast<double>(num_known)
+                                                                       : 0.0;
+            plan.expected_ns = std::llround((known_ms + fill_ms * static_cast<double>(num_unknown)) * 1e6);
+            return plan;
+        }
+
+        /**
+         * @brief Make every process use the costs known to the aggregator.
+         *
+         * Only the aggregator reads the results database, so the others
+         * take its view; all processes then compute the same assignment.
+         */
+        [[nodiscard]] std::vector<std::optional<double>> share_costs(std::vector<std::optional<double>> known) {
+            if (!m_distribution) return known;
+            // Microseconds plus one; zero stands for unknown.
+            std::vector<std::int64_t> encoded(known.size());
+            if (m_distribution->is_aggregator()) {
+                for (std::size_t i = 0; i < known.size(); ++i) {
+                    if (known[i]) encoded[i] = std::llround(std::max(*known[i], 0.0) * 1000.0) + 1;
+                }
+            }
+            m_distribution->max_reduce(encoded);
+            for (std::size_t i = 0; i < known.size(); ++i) {
+                known[i] = encoded[i] > 0 ? std::optional(static_cast<double>(encoded[i] - 1) / 1000.0)
+                                          : std::nullopt;
+            }
+            return known;
+        }
+
+        /**
+         * @brief Expected duration of a test, parameterized test or case, in milliseconds.
+         *
+         * From the cost model, else the results database, else the test's
+         * last run in this session; std::nullopt if none knows it.
+         */
+        [[nodiscard]] std::optional<double> expected_duration_ms(std::string_view suite_name,
+                                                                 std::string_view test_name) const {
+            if (m_cost_model) {
+                if (const auto ms = m_cost_model(suite_name, test_name)) return ms;
+            }
+            if (const auto ms = m_history.duration_ms(suite_name, test_name)) return ms;
+            const auto suite_id = m_suite_names.find(suite_name);
+            if (!suite_id) return std::nullopt;
+            const TestRegistry &tests = m_suites[*suite_id]->get_registry();
+            std::int64_t ns = 0;
+            if (const auto id = tests.find_test(test_name)) {
+                ns = tests.timing(*id).total_ns();
+            } else if (const auto id = tests.find_parameterized(test_name)) {
+                ns = tests.parameterized(*id).get_total_timing().total_ns();
+            }
+            if (ns > 0) return TestTiming::to_ms(ns);
+            return std::nullopt;
         }
     };
 } // namespace Fortest
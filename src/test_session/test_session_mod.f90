@@ -15,10 +15,40 @@ module fortest_test_session
     implicit none
 
     public :: test_session_t
+    public :: parameter_range_t, parameter_coordinate
+    public :: cancellation_requested
+    public :: golden_data_t
+
+    !> @brief Range of parameter values, `start, start + stride, ...`.
+    !>
+    !> Like a `do` loop, `stop` is included when the sequence reaches it
+    !> and a range whose stride points away from `stop` is empty. Ranges
+    !> are expanded one case at a time while the test runs, so a sweep
+    !> costs no memory per case until it has results. Mirrors
+    !> `fortest_parameter_range` in `c_test_session.h`.
+    type, bind(C) :: parameter_range_t
+        integer(c_int) :: start = 1_c_int   !! First value
+        integer(c_int) :: stop = 1_c_int    !! Last value, inclusive
+        integer(c_int) :: stride = 1_c_int  !! Step between values; must not be zero
+    end type parameter_range_t
+
+    !> @brief Read-only view of a golden data file mapped by a fixture.
+    !>
+    !> Registered with `register_golden_data`, which passes `c_loc` of it
+    !> to the tests as the fixture argument. While the fixture is set up,
+    !> `data` points at the mapped file, ready for `c_f_pointer`; the
+    !> pages are shared with every other process mapping the file.
+    !> Mirrors `Fortest::MappedView` in `mapped_file.hpp`.
+    type, bind(C) :: golden_data_t
+        type(c_ptr) :: data = c_null_ptr     !! First byte of the file; null while not set up
+        integer(c_size_t) :: nbytes = 0      !! Size of the file in bytes
+    end type golden_data_t
 
     interface register_parameterized_test
         module procedure register_parameterized_test_with_num_params
         module procedure register_parameterized_test_with_indices
+        module procedure register_parameterized_test_with_range
+        module procedure register_parameterized_test_with_ranges
     end interface register_parameterized_test
 
     !> @brief Linked list node for holding a test suite.
@@ -37,13 +67,29 @@ module fortest_test_session
         procedure :: register_test_suite  !! Add a new test suite
         procedure :: get_test_suite       !! Find a suite by name
         procedure :: register_fixture     !! Register a fixture with a suite
+        procedure :: register_golden_data !! Map a reference data file read-only as a fixture
         procedure :: register_test        !! Register a test in a suite
+        procedure :: register_tests       !! Register a table of tests in one call
+        procedure :: register_benchmark   !! Register a timed benchmark in a suite
         procedure :: register_parameterized_test_with_num_params
         procedure :: register_parameterized_test_with_indices
+        procedure :: register_parameterized_test_with_range
+        procedure :: register_parameterized_test_with_ranges
         generic :: register_parameterized_test => &
                 register_parameterized_test_with_num_params, &
-                register_parameterized_test_with_indices
+                register_parameterized_test_with_indices, &
+                register_parameterized_test_with_range, &
+                register_parameterized_test_with_ranges
         procedure :: run                  !! Run all registered tests
+        procedure :: set_results_db       !! Choose the results database
+        procedure :: set_reports          !! Write JUnit XML, JSON Lines or TAP reports
+        procedure :: set_suite_fingerprint !! Identify the code of a suite for reruns
+        procedure :: set_suite_timeout    !! Limit the run time of a suite's tests
+        procedure :: set_test_timeout     !! Limit the run time of one test
+        procedure :: set_test_cacheable   !! Skip a test while its code and inputs are unchanged
+        procedure :: set_benchmark_baseline !! Fail benchmarks slower than their past runs
+        procedure :: set_async_logging    !! Write log output on a background thread
+        procedure :: set_progress_file    !! Follow the progress of runs in a file
         procedure, public :: finalize     !! Finalize session and exit with status
         procedure, public :: get_status   !! Aggregate test status across suites
     end type test_session_t
@@ -55,27 +101,23 @@ contains
     !> @param test_suite_name Name of the new test suite
     subroutine register_test_suite(this, test_suite_name)
         use fortest_test_suite, only : test_suite_t
-        use f_c_string_t_mod, only : f_c_string_t
 
         class(test_session_t), intent(inout) :: this
         character(len = *), intent(in) :: test_suite_name
         type(test_suite_t) :: test_suite
-        type(f_c_string_t) :: f_c_string_test_suite_name
         type(test_suite_node_t), pointer :: new_node
-        integer :: status
 
         interface
-            subroutine c_register_test_suite(name) bind(C, name = "c_register_test_suite")
-                import :: c_ptr
-                type(c_ptr), value :: name
-            end subroutine c_register_test_suite
+            subroutine c_register_test_suite_n(name, name_len) bind(C, name = "c_register_test_suite_n")
+                import :: c_char, c_size_t
+                character(kind = c_char), intent(in) :: name(*)
+                integer(c_size_t), value :: name_len
+            end subroutine c_register_test_suite_n
         end interface
 
         ! Initialize and register suite
         test_suite%name = test_suite_name
-        f_c_string_test_suite_name = f_c_string_t(test_suite_name)
-        status = f_c_string_test_suite_name%to_c()
-        call c_register_test_suite(f_c_string_test_suite_name%get_c_string())
+        call c_register_test_suite_n(test_suite_name, len_trim(test_suite_name, kind = c_size_t))
 
         ! Add to linked list
         allocate(new_node)
@@ -96,50 +138,258 @@ contains
     !> @param test_suite_name Name of the suite
     !> @param test_name Name of the test
     !> @param test Test procedure to register
-    subroutine register_test(this, test_suite_name, test_name, test)
-        use f_c_string_t_mod, only : f_c_string_t
+    !> @param collective If `.true.`, every rank of a distributed session
+    !>        runs the test (see `fortest_mpi`), e.g. because it communicates
+    !> @param timeout Wall-clock limit of the test in seconds (optional);
+    !>        0 disables it. Defaults to the suite's limit, see set_test_timeout.
+    subroutine register_test(this, test_suite_name, test_name, test, collective, timeout)
         class(test_session_t), intent(in) :: this
         character(len = *), intent(in) :: test_suite_name
         character(len = *), intent(in) :: test_name
         procedure(test_proc) :: test
-        type(f_c_string_t) :: f_c_string_test_suite_name
-        type(f_c_string_t) :: f_c_string_test_name
-        integer :: status
+        logical, intent(in), optional :: collective
+        real(c_double), intent(in), optional :: timeout
+        logical :: is_collective
 
         interface
-            subroutine c_register_test(test_suite_name, test_name, test) bind(C, name = "c_register_test")
-                import :: c_ptr, c_funptr
-                type(c_ptr), value :: test_suite_name
-                type(c_ptr), value :: test_name
+            subroutine c_register_test_n(test_suite_name, test_suite_name_len, &
+                    test_name, test_name_len, test) bind(C, name = "c_register_test_n")
+                import :: c_char, c_size_t, c_funptr
+                character(kind = c_char), intent(in) :: test_suite_name(*)
+                integer(c_size_t), value :: test_suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
+                type(c_funptr), value :: test
+            end subroutine c_register_test_n
+
+            subroutine c_register_collective_test_n(test_suite_name, test_suite_name_len, &
+                    test_name, test_name_len, test) bind(C, name = "c_register_collective_test_n")
+                import :: c_char, c_size_t, c_funptr
+                character(kind = c_char), intent(in) :: test_suite_name(*)
+                integer(c_size_t), value :: test_suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
                 type(c_funptr), value :: test
-            end subroutine c_register_test
+            end subroutine c_register_collective_test_n
         end interface
 
-        f_c_string_test_suite_name = f_c_string_t(test_suite_name)
-        status = f_c_string_test_suite_name%to_c()
-        f_c_string_test_name = f_c_string_t(test_name)
-        status = f_c_string_test_name%to_c()
-        call c_register_test(&
-                f_c_string_test_suite_name%get_c_string(), &
-                f_c_string_test_name%get_c_string(), &
-                c_funloc(test))
+        is_collective = .false.
+        if (present(collective)) is_collective = collective
+
+        if (is_collective) then
+            call c_register_collective_test_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    c_funloc(test))
+        else
+            call c_register_test_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    c_funloc(test))
+        end if
+        if (present(timeout)) call this%set_test_timeout(test_suite_name, test_name, timeout)
     end subroutine register_test
 
+    !> @brief Register a table of tests in one call.
+    !> @details Same as calling register_test for every row, in order, but
+    !>          with a single call into the library, which reserves room
+    !>          for each suite's tests at once. Meant for generated
+    !>          drivers with many tests; see `fortest-register`. The
+    !>          suites must have been registered.
+    !> @param this The test session
+    !> @param test_suite_names Suite of each test
+    !> @param test_names Name of each test
+    !> @param tests `c_funloc` of each test procedure
+    subroutine register_tests(this, test_suite_names, test_names, tests)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_names(:)
+        character(len = *), intent(in) :: test_names(:)
+        type(c_funptr), intent(in) :: tests(:)
+
+        interface
+            subroutine c_register_tests_n(test_suite_names, test_suite_name_width, &
+                    test_names, test_name_width, tests, count) bind(C, name = "c_register_tests_n")
+                import :: c_char, c_size_t, c_funptr
+                character(kind = c_char), intent(in) :: test_suite_names(*)
+                integer(c_size_t), value :: test_suite_name_width
+                character(kind = c_char), intent(in) :: test_names(*)
+                integer(c_size_t), value :: test_name_width
+                type(c_funptr), intent(in) :: tests(*)
+                integer(c_size_t), value :: count
+            end subroutine c_register_tests_n
+        end interface
+
+        if (size(test_suite_names) /= size(tests) .or. size(test_names) /= size(tests)) then
+            error stop "register_tests: test_suite_names, test_names and tests differ in size"
+        end if
+        call c_register_tests_n(&
+                test_suite_names, len(test_suite_names, kind = c_size_t), &
+                test_names, len(test_names, kind = c_size_t), &
+                tests, size(tests, kind = c_size_t))
+    end subroutine register_tests
+
+    !> @brief Register a benchmark: a test whose body is called and timed repeatedly.
+    !> @details The statistics (median, minimum, mean and standard
+    !>          deviation per call, and throughput) are logged and stored
+    !>          in the results database. Omitted arguments keep the defaults.
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of the benchmark
+    !> @param test Procedure to time
+    !> @param warmup Untimed calls before measuring (default 1)
+    !> @param repetitions Timed samples (default 10)
+    !> @param min_time Seconds all samples take together, at least (default 0.1)
+    !> @param items_per_call Work done by one call, for the throughput (default 1)
+    subroutine register_benchmark(this, test_suite_name, test_name, test, &
+            warmup, repetitions, min_time, items_per_call)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: test_name
+        procedure(test_proc) :: test
+        integer, intent(in), optional :: warmup
+        integer, intent(in), optional :: repetitions
+        real(c_double), intent(in), optional :: min_time
+        real(c_double), intent(in), optional :: items_per_call
+        integer(c_int) :: c_warmup, c_repetitions
+        real(c_double) :: c_min_time, c_items_per_call
+
+        interface
+            subroutine c_register_benchmark_n(test_suite_name, test_suite_name_len, &
+                    test_name, test_name_len, test, warmup, repetitions, min_time, items_per_call) &
+                    bind(C, name = "c_register_benchmark_n")
+                import :: c_char, c_size_t, c_funptr, c_int, c_double
+                character(kind = c_char), intent(in) :: test_suite_name(*)
+                integer(c_size_t), value :: test_suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
+                type(c_funptr), value :: test
+                integer(c_int), value :: warmup
+                integer(c_int), value :: repetitions
+                real(c_double), value :: min_time
+                real(c_double), value :: items_per_call
+            end subroutine c_register_benchmark_n
+        end interface
+
+        c_warmup = -1
+        c_repetitions = 0
+        c_min_time = 0.0_c_double
+        c_items_per_call = 0.0_c_double
+        if (present(warmup)) c_warmup = int(warmup, c_int)
+        if (present(repetitions)) c_repetitions = int(repetitions, c_int)
+        if (present(min_time)) c_min_time = min_time
+        if (present(items_per_call)) c_items_per_call = items_per_call
+
+        call c_register_benchmark_n(&
+                test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                test_name, len_trim(test_name, kind = c_size_t), &
+                c_funloc(test), c_warmup, c_repetitions, c_min_time, c_items_per_call)
+    end subroutine register_benchmark
+
+    !> @brief Register a parameterized test run for indices 1 to num_params.
+    !>
+    !> The indices are generated while the test runs, not stored.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of the test
+    !> @param test Test procedure to register
+    !> @param num_params Number of cases
     subroutine register_parameterized_test_with_num_params(this, test_suite_name, test_name, test, num_params)
-        use f_c_string_t_mod, only : f_c_string_t
         class(test_session_t), intent(in) :: this
         character(len = *), intent(in) :: test_suite_name
         character(len = *), intent(in) :: test_name
         procedure(param_test_proc) :: test
         integer(c_int), intent(in) :: num_params
-        integer(c_int), dimension(:), allocatable :: params
-        integer :: i
 
-        allocate(params(num_params))
-        params = [(i, i = 1, num_params)]
-        call this%register_parameterized_test_with_indices(test_suite_name, test_name, test, params)
+        call this%register_parameterized_test_with_ranges(test_suite_name, test_name, test, &
+                [parameter_range_t(1_c_int, num_params, 1_c_int)])
     end subroutine register_parameterized_test_with_num_params
 
+    !> @brief Register a parameterized test run for each value of a range.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of the test
+    !> @param test Test procedure to register; receives the values of the range
+    !> @param range Values to run
+    subroutine register_parameterized_test_with_range(this, test_suite_name, test_name, test, range)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: test_name
+        procedure(param_test_proc) :: test
+        type(parameter_range_t), intent(in) :: range
+
+        call this%register_parameterized_test_with_ranges(test_suite_name, test_name, test, [range])
+    end subroutine register_parameterized_test_with_range
+
+    !> @brief Register a parameterized test over every combination of the ranges.
+    !>
+    !> With a single range the test receives its values. With several it
+    !> receives the 0-based case number, from which parameter_coordinate()
+    !> recovers the value of each range; the first range varies fastest.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of the test
+    !> @param test Test procedure to register
+    !> @param ranges Ranges whose Cartesian product is run
+    subroutine register_parameterized_test_with_ranges(this, test_suite_name, test_name, test, ranges)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: test_name
+        procedure(param_test_proc) :: test
+        type(parameter_range_t), dimension(:), intent(in) :: ranges
+
+        interface
+            subroutine c_register_parameterized_ranges_n(&
+                    suite_name, suite_name_len, test_name, test_name_len, test, ranges, nranges) &
+                    bind(C, name = "c_register_parameterized_ranges_n")
+                import :: c_char, c_size_t, c_funptr, c_int, parameter_range_t
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
+                type(c_funptr), value :: test
+                type(parameter_range_t), intent(in) :: ranges(*)
+                integer(c_int), value :: nranges
+            end subroutine c_register_parameterized_ranges_n
+        end interface
+
+        call c_register_parameterized_ranges_n(&
+                test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                test_name, len_trim(test_name, kind = c_size_t), &
+                c_funloc(test), ranges, size(ranges, kind = c_int))
+    end subroutine register_parameterized_test_with_ranges
+
+    !> @brief Value of range `dim` in case number `idx` of a product of ranges.
+    !>
+    !> @param ranges The ranges the test was registered with
+    !> @param idx Case number received by the test (0-based)
+    !> @param dim Which range (1-based)
+    !> @return The value of `ranges(dim)` in that case
+    pure function parameter_coordinate(ranges, idx, dim) result(value)
+        type(parameter_range_t), dimension(:), intent(in) :: ranges
+        integer(c_int), intent(in) :: idx
+        integer, intent(in) :: dim
+        integer(c_int) :: value
+        integer(c_int) :: k
+        integer :: d
+
+        k = idx
+        do d = 1, dim - 1
+            k = k / range_size(ranges(d))
+        end do
+        value = ranges(dim)%start + mod(k, range_size(ranges(dim))) * ranges(dim)%stride
+    end function parameter_coordinate
+
+    !> @brief Number of values of a range (the trip count of the equivalent `do` loop).
+    pure function range_size(range) result(n)
+        type(parameter_range_t), intent(in) :: range
+        integer(c_int) :: n
+
+        n = max(0_c_int, (range%stop - range%start + range%stride) / range%stride)
+    end function range_size
+
     !> @brief Register a parameterized test with a suite.
     !>
     !> @param this The test session
@@ -148,38 +398,31 @@ contains
     !> @param test Test procedure to register
     !> @param params Array of parameter indices
     subroutine register_parameterized_test_with_indices(this, test_suite_name, test_name, test, params)
-        use f_c_string_t_mod, only : f_c_string_t
         class(test_session_t), intent(in) :: this
         character(len = *), intent(in) :: test_suite_name
         character(len = *), intent(in) :: test_name
         procedure(param_test_proc) :: test
         integer(c_int), dimension(:), target, intent(in) :: params
 
-        type(f_c_string_t) :: f_c_suite, f_c_name
-        integer :: status
-
         interface
-            subroutine c_register_parameterized_test(&
-                    suite_name, test_name, test, params, nparams) bind(C, name = "c_register_parameterized_test")
-                import :: c_ptr, c_funptr, c_int
-                type(c_ptr), value :: suite_name
-                type(c_ptr), value :: test_name
+            subroutine c_register_parameterized_test_n(&
+                    suite_name, suite_name_len, test_name, test_name_len, test, params, nparams) &
+                    bind(C, name = "c_register_parameterized_test_n")
+                import :: c_char, c_size_t, c_ptr, c_funptr, c_int
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
                 type(c_funptr), value :: test
                 type(c_ptr), value :: params
                 integer(c_int), value :: nparams
-            end subroutine c_register_parameterized_test
+            end subroutine c_register_parameterized_test_n
         end interface
 
-        ! Convert strings
-        f_c_suite = f_c_string_t(test_suite_name)
-        status = f_c_suite%to_c()
-        f_c_name = f_c_string_t(test_name)
-        status = f_c_name%to_c()
-
-        ! Call C wrapper
-        call c_register_parameterized_test(&
-                f_c_suite%get_c_string(), &
-                f_c_name%get_c_string(), &
+        ! Call C wrapper with the names in place
+        call c_register_parameterized_test_n(&
+                test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                test_name, len_trim(test_name, kind = c_size_t), &
                 c_funloc(test), &
                 c_loc(params(1)), &
                 size(params, kind = c_int))
@@ -195,79 +438,544 @@ contains
     !! @param[in] test_suite_name Name of the suite to attach the fixture to.
     subroutine register_fixture(this, setup, teardown, args, scope, test_suite_name)
         use iso_c_binding
-        use f_c_string_t_mod, only : f_c_string_t
         class(test_session_t), intent(in) :: this
         procedure(fixture_proc) :: setup
         procedure(fixture_proc) :: teardown
         type(c_ptr), value :: args
         character(len = *), intent(in) :: scope
         character(len = *), intent(in), optional :: test_suite_name
-        type(f_c_string_t) :: f_c_string_test_suite_name
-        type(f_c_string_t) :: f_c_string_scope
-        integer :: status
         interface
-            subroutine c_register_fixture(test_suite_name, &
-                    setup, teardown, args, scope) bind(C, name = "c_register_fixture")
-                import :: c_ptr, c_funptr
-                type(c_ptr), value :: test_suite_name
+            subroutine c_register_fixture_n(test_suite_name, test_suite_name_len, &
+                    setup, teardown, args, scope, scope_len) bind(C, name = "c_register_fixture_n")
+                import :: c_char, c_size_t, c_ptr, c_funptr
+                character(kind = c_char), intent(in) :: test_suite_name(*)
+                integer(c_size_t), value :: test_suite_name_len
                 type(c_funptr), value :: setup
                 type(c_funptr), value :: teardown
                 type(c_ptr), value :: args
-                type(c_ptr), value :: scope
-            end subroutine c_register_fixture
+                character(kind = c_char), intent(in) :: scope(*)
+                integer(c_size_t), value :: scope_len
+            end subroutine c_register_fixture_n
         end interface
 
         if (present(test_suite_name)) then
-            f_c_string_test_suite_name = f_c_string_t(test_suite_name)
+            call c_register_fixture_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    c_funloc(setup), c_funloc(teardown), args, &
+                    scope, len_trim(scope, kind = c_size_t))
         else
-            f_c_string_test_suite_name = f_c_string_t("")
+            call c_register_fixture_n(&
+                    "", 0_c_size_t, &
+                    c_funloc(setup), c_funloc(teardown), args, &
+                    scope, len_trim(scope, kind = c_size_t))
         end if
-        f_c_string_test_suite_name = f_c_string_t(test_suite_name)
-        status = f_c_string_test_suite_name%to_c()
-        f_c_string_scope = f_c_string_t(scope)
-        status = f_c_string_scope%to_c()
-        call c_register_fixture(&
-                f_c_string_test_suite_name%get_c_string(), &
-                c_funloc(setup), &
-                c_funloc(teardown), &
-                args, &
-                f_c_string_scope%get_c_string())
     end subroutine register_fixture
 
+    !> @brief Register a fixture that maps a golden data file read-only.
+    !!
+    !! Nothing is read or copied up front: the file is mapped when the
+    !! fixture is set up, and pages are loaded as the tests touch them.
+    !! Tests receive `c_loc(golden)` as the fixture argument:
+    !!
+    !!     call c_f_pointer(ts_ptr, golden)
+    !!     call c_f_pointer(golden%data, reference, [golden%nbytes / 8])
+    !!
+    !! @param[in] this    The test session.
+    !! @param[in] path    File to map.
+    !! @param[inout] golden Receives the mapping; must outlive the session, e.g. a module variable.
+    !! @param[in] scope   Scope string: "test", "suite" (the default), or "session".
+    !! @param[in] test_suite_name Name of the suite to attach the fixture to.
+    subroutine register_golden_data(this, path, golden, scope, test_suite_name)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: path
+        type(golden_data_t), target, intent(inout) :: golden
+        character(len = *), intent(in), optional :: scope
+        character(len = *), intent(in), optional :: test_suite_name
+        character(len = :), allocatable :: suite_name, fixture_scope
+        interface
+            subroutine c_register_mapped_fixture_n(test_suite_name, test_suite_name_len, &
+                    path, path_len, view, scope, scope_len) bind(C, name = "c_register_mapped_fixture_n")
+                import :: c_char, c_size_t, c_ptr
+                character(kind = c_char), intent(in) :: test_suite_name(*)
+                integer(c_size_t), value :: test_suite_name_len
+                character(kind = c_char), intent(in) :: path(*)
+                integer(c_size_t), value :: path_len
+                type(c_ptr), value :: view
+                character(kind = c_char), intent(in) :: scope(*)
+                integer(c_size_t), value :: scope_len
+            end subroutine c_register_mapped_fixture_n
+        end interface
+
+        suite_name = ""
+        if (present(test_suite_name)) suite_name = test_suite_name
+        fixture_scope = "suite"
+        if (present(scope)) fixture_scope = scope
+        call c_register_mapped_fixture_n(&
+                suite_name, len_trim(suite_name, kind = c_size_t), &
+                path, len_trim(path, kind = c_size_t), c_loc(golden), &
+                fixture_scope, len_trim(fixture_scope, kind = c_size_t))
+    end subroutine register_golden_data
+
     !> @brief Run all registered test suites in this session.
-    subroutine run(this)
+    !> @param this The test session
+    !> @param num_workers Number of worker threads (optional). Tests run
+    !>        concurrently when greater than 1; 0 uses every hardware thread.
+    !>        Defaults to the FORTEST_NUM_WORKERS environment variable, or 1.
+    !> @param isolate Run every test in a forked child process (optional),
+    !>        so that a crash or error stop only fails that test.
+    !>        Defaults to the FORTEST_ISOLATION environment variable.
+    !> @param timeout Default wall-clock limit of every test in seconds
+    !>        (optional); 0 disables it. Defaults to FORTEST_TIMEOUT.
+    !>        Isolated tests that overrun it are killed; others are asked
+    !>        to stop (see cancellation_requested) and end the run if they
+    !>        do not within FORTEST_TIMEOUT_GRACE seconds.
+    !> @param chunk_size Cases of a parameterized test a worker takes at a
+    !>        time (optional); 0 shrinks the chunks as the cases run out.
+    !>        Defaults to FORTEST_CHUNK_SIZE, or 0.
+    !> @param rerun Which tests to run, from their latest results in the
+    !>        results database (optional): "failed" runs the failed and
+    !>        new tests, "failed_first" runs them before the others, "all"
+    !>        runs every test. Defaults to FORTEST_RERUN, or "all".
+    !> @param skip_unchanged Also skip the passing tests of suites whose
+    !>        fingerprint matches their last run (optional). Defaults to
+    !>        FORTEST_SKIP_UNCHANGED.
+    !> @param filter Patterns selecting the tests to run by their
+    !>        `suite.test` names, e.g. "mesh_*.*-*.slow_*" (optional).
+    !>        Defaults to a `--filter=...` command-line argument, then to
+    !>        FORTEST_FILTER. Suites without a matching test are skipped,
+    !>        fixtures included.
+    !> @param fail_fast Stop starting tests after the first failure
+    !>        (optional). Defaults to a `--fail-fast` command-line
+    !>        argument, then to FORTEST_FAIL_FAST. `.false.` keeps any
+    !>        limit set by max_failures, `--max-failures=N` or
+    !>        FORTEST_MAX_FAILURES.
+    !> @param max_failures Stop starting tests after this many failed tests
+    !>        or parameter cases (optional); 0 runs every test. Defaults to
+    !>        a `--max-failures=N` command-line argument, then to
+    !>        FORTEST_MAX_FAILURES. A stopped run still tears down its
+    !>        fixtures, and finalize exits with a distinct status.
+    !> @param use_cache Report cacheable tests whose code and inputs are
+    !>        unchanged as CACHED instead of running them (optional; see
+    !>        set_test_cacheable). `.false.` forces a full run. Defaults to
+    !>        a `--no-cache` command-line argument, then to FORTEST_CACHE.
+    subroutine run(this, num_workers, isolate, timeout, chunk_size, rerun, skip_unchanged, filter, &
+            fail_fast, max_failures, use_cache)
         class(test_session_t), intent(in) :: this
+        integer, intent(in), optional :: num_workers
+        logical, intent(in), optional :: isolate
+        real(c_double), intent(in), optional :: timeout
+        integer, intent(in), optional :: chunk_size
+        character(len = *), intent(in), optional :: rerun
+        logical, intent(in), optional :: skip_unchanged
+        character(len = *), intent(in), optional :: filter
+        logical, intent(in), optional :: fail_fast
+        integer, intent(in), optional :: max_failures
+        logical, intent(in), optional :: use_cache
+        integer(c_int) :: enabled
+        real(c_double) :: limit
+        character(len = :), allocatable :: argument
+        integer :: i, length, io_status, limit_arg
         interface
             subroutine c_run_test_session() bind(C, name = "c_run_test_session")
             end subroutine c_run_test_session
+            subroutine c_set_num_workers(num_workers) bind(C, name = "c_set_num_workers")
+                import :: c_int
+                integer(c_int), value :: num_workers
+            end subroutine c_set_num_workers
+            subroutine c_set_process_isolation(enabled, timeout_seconds) &
+                    bind(C, name = "c_set_process_isolation")
+                import :: c_int, c_double
+                integer(c_int), value :: enabled
+                real(c_double), value :: timeout_seconds
+            end subroutine c_set_process_isolation
+            subroutine c_set_timeout(timeout_seconds) bind(C, name = "c_set_timeout")
+                import :: c_double
+                real(c_double), value :: timeout_seconds
+            end subroutine c_set_timeout
+            subroutine c_set_chunk_size(chunk_size) bind(C, name = "c_set_chunk_size")
+                import :: c_int
+                integer(c_int), value :: chunk_size
+            end subroutine c_set_chunk_size
+            subroutine c_set_rerun_n(mode, mode_len, skip_unchanged) bind(C, name = "c_set_rerun_n")
+                import :: c_char, c_size_t, c_int
+                character(kind = c_char), intent(in) :: mode(*)
+                integer(c_size_t), value :: mode_len
+                integer(c_int), value :: skip_unchanged
+            end subroutine c_set_rerun_n
+            subroutine c_set_filter_n(filter, filter_len) bind(C, name = "c_set_filter_n")
+                import :: c_char, c_size_t
+                character(kind = c_char), intent(in) :: filter(*)
+                integer(c_size_t), value :: filter_len
+            end subroutine c_set_filter_n
+            subroutine c_set_max_failures(max_failures) bind(C, name = "c_set_max_failures")
+                import :: c_int
+                integer(c_int), value :: max_failures
+            end subroutine c_set_max_failures
+            subroutine c_set_use_cache(enabled) bind(C, name = "c_set_use_cache")
+                import :: c_int
+                integer(c_int), value :: enabled
+            end subroutine c_set_use_cache
         end interface
+        if (present(num_workers)) then
+            call c_set_num_workers(int(num_workers, c_int))
+        end if
+        if (present(chunk_size)) then
+            call c_set_chunk_size(int(chunk_size, c_int))
+        end if
+        if (present(isolate)) then
+            enabled = merge(1_c_int, 0_c_int, isolate)
+            limit = -1.0_c_double
+            if (present(timeout)) limit = timeout
+            call c_set_process_isolation(enabled, limit)
+        else if (present(timeout)) then
+            call c_set_timeout(timeout)
+        end if
+        if (present(rerun) .or. present(skip_unchanged)) then
+            enabled = -1_c_int
+            if (present(skip_unchanged)) enabled = merge(1_c_int, 0_c_int, skip_unchanged)
+            if (present(rerun)) then
+                call c_set_rerun_n(rerun, len_trim(rerun, kind = c_size_t), enabled)
+            else
+                call c_set_rerun_n("", 0_c_size_t, enabled)
+            end if
+        end if
+        do i = 1, command_argument_count()
+            call get_command_argument(i, length = length)
+            allocate(character(len = length) :: argument)
+            call get_command_argument(i, argument)
+            if (index(argument, "--filter=") == 1 .and. .not. present(filter)) then
+                call c_set_filter_n(argument(10:), int(length - 9, c_size_t))
+            else if (argument == "--fail-fast" .and. .not. present(fail_fast)) then
+                call c_set_max_failures(1_c_int)
+            else if (index(argument, "--max-failures=") == 1 .and. .not. present(max_failures)) then
+                read(argument(16:), *, iostat = io_status) limit_arg
+                if (io_status == 0) call c_set_max_failures(int(limit_arg, c_int))
+            else if (argument == "--no-cache" .and. .not. present(use_cache)) then
+                call c_set_use_cache(0_c_int)
+            end if
+            deallocate(argument)
+        end do
+        if (present(filter)) then
+            call c_set_filter_n(filter, len_trim(filter, kind = c_size_t))
+        end if
+        if (present(fail_fast)) then
+            if (fail_fast) call c_set_max_failures(1_c_int)
+        end if
+        if (present(max_failures)) then
+            call c_set_max_failures(int(max_failures, c_int))
+        end if
+        if (present(use_cache)) then
+            call c_set_use_cache(merge(1_c_int, 0_c_int, use_cache))
+        end if
         call c_run_test_session()
     end subroutine run
 
+    !> @brief Choose the SQLite database that records every run.
+    !> @param this The test session
+    !> @param path Path of the database file; an empty string disables
+    !>        recording. Defaults to the FORTEST_DB environment variable,
+    !>        or fortest_results.sqlite.
+    subroutine set_results_db(this, path)
+        use f_c_string_t_mod, only : f_c_string_t
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: path
+        type(f_c_string_t) :: f_c_string_path
+        integer :: status
+        interface
+            subroutine c_set_results_db(path) bind(C, name = "c_set_results_db")
+                import :: c_ptr
+                type(c_ptr), value :: path
+            end subroutine c_set_results_db
+        end interface
+        f_c_string_path = f_c_string_t(path)
+        status = f_c_string_path%to_c()
+        call c_set_results_db(f_c_string_path%get_c_string())
+    end subroutine set_results_db
+
+    !> @brief Write machine-readable reports while the tests run.
+    !> @param this The test session
+    !> @param reports Comma-separated `format:path` items, e.g.
+    !>        "junit:report.xml,jsonl:results.jsonl"; the formats are
+    !>        `junit`, `jsonl` and `tap`. Defaults to the FORTEST_REPORT
+    !>        environment variable; an empty string writes no report.
+    subroutine set_reports(this, reports)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: reports
+        interface
+            subroutine c_set_reports_n(reports, reports_len) bind(C, name = "c_set_reports_n")
+                import :: c_char, c_size_t
+                character(kind = c_char), intent(in) :: reports(*)
+                integer(c_size_t), value :: reports_len
+            end subroutine c_set_reports_n
+        end interface
+        call c_set_reports_n(reports, len_trim(reports, kind = c_size_t))
+    end subroutine set_reports
+
+    !> @brief Identify the code of a suite, e.g. with a hash of its module's object file.
+    !>
+    !> Runs with `skip_unchanged` skip the passing tests of a suite whose
+    !> fingerprint matches its last run. Suites without one use the
+    !> fingerprint of the test binary.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param fingerprint Any text that changes when the suite's code does
+    subroutine set_suite_fingerprint(this, test_suite_name, fingerprint)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: fingerprint
+        interface
+            subroutine c_set_suite_fingerprint_n(suite_name, suite_name_len, fingerprint, fingerprint_len) &
+                    bind(C, name = "c_set_suite_fingerprint_n")
+                import :: c_char, c_size_t
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                character(kind = c_char), intent(in) :: fingerprint(*)
+                integer(c_size_t), value :: fingerprint_len
+            end subroutine c_set_suite_fingerprint_n
+        end interface
+        call c_set_suite_fingerprint_n(&
+                test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                fingerprint, len_trim(fingerprint, kind = c_size_t))
+    end subroutine set_suite_fingerprint
+
+    !> @brief Limit the wall-clock time of every test of a suite.
+    !>
+    !> Applies to the tests without a limit of their own and to each case
+    !> of a parameterized test, instead of the session's `timeout`.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param timeout Limit per test in seconds; 0 disables the session's default
+    subroutine set_suite_timeout(this, test_suite_name, timeout)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        real(c_double), intent(in) :: timeout
+        interface
+            subroutine c_set_suite_timeout_n(suite_name, suite_name_len, timeout_seconds) &
+                    bind(C, name = "c_set_suite_timeout_n")
+                import :: c_char, c_size_t, c_double
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                real(c_double), value :: timeout_seconds
+            end subroutine c_set_suite_timeout_n
+        end interface
+        call c_set_suite_timeout_n(test_suite_name, len_trim(test_suite_name, kind = c_size_t), timeout)
+    end subroutine set_suite_timeout
+
+    !> @brief Limit the wall-clock time of one registered test.
+    !>
+    !> For a parameterized test the limit applies to each case. It takes
+    !> precedence over set_suite_timeout and the session's `timeout`.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of the test
+    !> @param timeout Limit in seconds; 0 disables it for this test
+    subroutine set_test_timeout(this, test_suite_name, test_name, timeout)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: test_name
+        real(c_double), intent(in) :: timeout
+        interface
+            subroutine c_set_test_timeout_n(suite_name, suite_name_len, test_name, test_name_len, &
+                    timeout_seconds) bind(C, name = "c_set_test_timeout_n")
+                import :: c_char, c_size_t, c_double
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
+                real(c_double), value :: timeout_seconds
+            end subroutine c_set_test_timeout_n
+        end interface
+        call c_set_test_timeout_n(&
+                test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                test_name, len_trim(test_name, kind = c_size_t), timeout)
+    end subroutine set_test_timeout
+
+    !> @brief Let a deterministic test be skipped while its code and inputs are unchanged.
+    !>
+    !> A run whose latest result of the test under the same key in the
+    !> results database passed reports it as CACHED instead of running
+    !> it. The key combines the names, the suite's fingerprint (by
+    !> default the test binary's), the contents of `input_files` and
+    !> `flags`. Run with `use_cache = .false.`, `--no-cache` or
+    !> FORTEST_CACHE=0 to run every test.
+    !>
+    !> @param this The test session
+    !> @param test_suite_name Name of the suite
+    !> @param test_name Name of a registered regular test
+    !> @param input_files Files the result depends on (optional), e.g.
+    !>        read by the test's fixture
+    !> @param flags Settings the result depends on (optional), e.g.
+    !>        `compiler_options()` of the test's module
+    subroutine set_test_cacheable(this, test_suite_name, test_name, input_files, flags)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: test_suite_name
+        character(len = *), intent(in) :: test_name
+        character(len = *), intent(in), optional :: input_files(:)
+        character(len = *), intent(in), optional :: flags
+        interface
+            subroutine c_set_test_cacheable_n(suite_name, suite_name_len, test_name, test_name_len, &
+                    input_files, input_width, num_inputs, flags, flags_len) bind(C, name = "c_set_test_cacheable_n")
+                import :: c_char, c_size_t
+                character(kind = c_char), intent(in) :: suite_name(*)
+                integer(c_size_t), value :: suite_name_len
+                character(kind = c_char), intent(in) :: test_name(*)
+                integer(c_size_t), value :: test_name_len
+                character(kind = c_char), intent(in) :: input_files(*)
+                integer(c_size_t), value :: input_width
+                integer(c_size_t), value :: num_inputs
+                character(kind = c_char), intent(in) :: flags(*)
+                integer(c_size_t), value :: flags_len
+            end subroutine c_set_test_cacheable_n
+        end interface
+        if (present(input_files) .and. present(flags)) then
+            call c_set_test_cacheable_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    input_files, len(input_files, kind = c_size_t), size(input_files, kind = c_size_t), &
+                    flags, len(flags, kind = c_size_t))
+        else if (present(input_files)) then
+            call c_set_test_cacheable_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    input_files, len(input_files, kind = c_size_t), size(input_files, kind = c_size_t), &
+                    "", 0_c_size_t)
+        else if (present(flags)) then
+            call c_set_test_cacheable_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    "", 0_c_size_t, 0_c_size_t, flags, len(flags, kind = c_size_t))
+        else
+            call c_set_test_cacheable_n(&
+                    test_suite_name, len_trim(test_suite_name, kind = c_size_t), &
+                    test_name, len_trim(test_name, kind = c_size_t), &
+                    "", 0_c_size_t, 0_c_size_t, "", 0_c_size_t)
+        end if
+    end subroutine set_test_cacheable
+
+    !> @brief Whether the running test overran its timeout and should return.
+    !>
+    !> Poll it in long loops, e.g. once per solver iteration; a test that
+    !> returns after the limit is recorded as TIMEOUT.
+    !>
+    !> @return `.true.` once the test's time is up
+    logical function cancellation_requested()
+        interface
+            integer(c_int) function c_cancellation_requested() bind(C, name = "c_cancellation_requested")
+                import :: c_int
+            end function c_cancellation_requested
+        end interface
+        cancellation_requested = c_cancellation_requested() /= 0
+    end function cancellation_requested
+
+    !> @brief Fail benchmarks that became slower than their past runs.
+    !>
+    !> A benchmark fails if its median exceeds the median of its last
+    !> passing runs in the results database by more than
+    !> `max_slowdown_percent`, with a p-value below `significance`.
+    !>
+    !> @param this The test session
+    !> @param max_slowdown_percent Allowed slowdown in percent; 0 disables the comparison
+    !> @param significance Largest p-value of a failing slowdown (default 0.05)
+    subroutine set_benchmark_baseline(this, max_slowdown_percent, significance)
+        class(test_session_t), intent(in) :: this
+        real(c_double), intent(in) :: max_slowdown_percent
+        real(c_double), intent(in), optional :: significance
+        real(c_double) :: c_significance
+        interface
+            subroutine c_set_benchmark_baseline(max_slowdown_percent, significance) &
+                    bind(C, name = "c_set_benchmark_baseline")
+                import :: c_double
+                real(c_double), value :: max_slowdown_percent
+                real(c_double), value :: significance
+            end subroutine c_set_benchmark_baseline
+        end interface
+        c_significance = 0.0_c_double
+        if (present(significance)) c_significance = significance
+        call c_set_benchmark_baseline(max_slowdown_percent, c_significance)
+    end subroutine set_benchmark_baseline
+
+    !> @brief Write log output on a background thread.
+    !> @param this The test session
+    !> @param enabled Buffer console output and write it asynchronously;
+    !>        failures are still printed immediately. Defaults to the
+    !>        FORTEST_ASYNC_LOG environment variable.
+    subroutine set_async_logging(this, enabled)
+        class(test_session_t), intent(in) :: this
+        logical, intent(in) :: enabled
+        interface
+            subroutine c_set_async_logging(enabled) bind(C, name = "c_set_async_logging")
+                import :: c_int
+                integer(c_int), value :: enabled
+            end subroutine c_set_async_logging
+        end interface
+        call c_set_async_logging(merge(1_c_int, 0_c_int, enabled))
+    end subroutine set_async_logging
+
+    !> @brief Rewrite a file with a Prometheus snapshot of the progress while the tests run.
+    !> @param this The test session
+    !> @param path File receiving the snapshots, e.g. "progress.prom";
+    !>        an empty string writes none. Defaults to the FORTEST_PROGRESS
+    !>        environment variable.
+    !> @param interval Seconds between two snapshots (optional, default 1).
+    subroutine set_progress_file(this, path, interval)
+        class(test_session_t), intent(in) :: this
+        character(len = *), intent(in) :: path
+        real(c_double), intent(in), optional :: interval
+        real(c_double) :: c_interval
+        interface
+            subroutine c_set_progress_file_n(path, path_len, interval) bind(C, name = "c_set_progress_file_n")
+                import :: c_char, c_size_t, c_double
+                character(kind = c_char), intent(in) :: path(*)
+                integer(c_size_t), value :: path_len
+                real(c_double), value :: interval
+            end subroutine c_set_progress_file_n
+        end interface
+        c_interval = 0.0_c_double
+        if (present(interval)) c_interval = interval
+        call c_set_progress_file_n(path, len_trim(path, kind = c_size_t), c_interval)
+    end subroutine set_progress_file
+
     !> @brief Get aggregated status from all test suites.
     !> @param this The test session
-    !> @return Sum of suite statuses (0 if all passed)
+    !> @return Number of suites with a failed test, i.e. the sum of suite
+    !>         statuses (0 if all passed)
     function get_status(this) result(status)
         class(test_session_t), intent(inout) :: this
-        type(test_suite_node_t), pointer :: node
         integer :: status
+        interface
+            function c_get_session_status() bind(C, name = "c_get_session_status")
+                import :: c_int
+                integer(c_int) :: c_get_session_status
+            end function c_get_session_status
+        end interface
 
-        status = 0
-        node => this%head
-        do while (associated(node))
-            status = status + node%suite%get_status()
-            node => node%next
-        end do
+        status = c_get_session_status()
     end function get_status
 
     !> @brief Finalize the test session and exit with status.
+    !> @details The status is the number of failing suites, or 100 if the
+    !>          run stopped at its failure limit (see `fail_fast` in run).
     !> @param this The test session
     subroutine finalize(this)
         class(test_session_t), intent(inout) :: this
         type(test_suite_node_t), pointer :: node, temp
         integer :: status
+        interface
+            function c_get_session_stopped() bind(C, name = "c_get_session_stopped")
+                import :: c_int
+                integer(c_int) :: c_get_session_stopped
+            end function c_get_session_stopped
+            function c_get_stopped_exit_code() bind(C, name = "c_get_stopped_exit_code")
+                import :: c_int
+                integer(c_int) :: c_get_stopped_exit_code
+            end function c_get_stopped_exit_code
+        end interface
 
         status = this%get_status()
+        if (c_get_session_stopped() /= 0) status = c_get_stopped_exit_code()
         node => this%head
         do while (associated(node))
             temp => node%next
@@ -0,0 +1,137 @@
+#ifndef FORTEST_TEST_REGISTRY_HPP
+#define FORTEST_TEST_REGISTRY_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "name_table.hpp"
+#include "test.hpp"
+#include "parameterized_test.hpp"
+
+namespace Fortest {
+    /**
+     * @brief Flat storage of the tests of one suite.
+     *
+     * @details
+     * Regular tests are kept as a struct of arrays indexed by a dense
+     * id: the interned name, the body, the status, and the durations of
+     * the last run each live in their own contiguous vector, so scanning
+     * statuses or timings touches nothing else. Names are interned in a
+     * NameTable whose ids double as test ids, which makes registration
+     * and lookup by name O(1). Tests hold no fixtures; the suite passes
+     * its own when it runs them.
+     *
+     * Parameterized tests are stored contiguously in the same way, with
+     * a separate id space.
+     *
+     * Registering a name twice keeps the first registration.
+     */
+    class TestRegistry {
+    public:
+        /// Index of a test; regular and parameterized tests are numbered separately.
+        using Id = NameId;
+
+        /// @brief Prepare for the given numbers of tests in total.
+        void reserve(std::size_t num_tests, std::size_t num_parameterized = 0) {
+            m_test_names.reserve(num_tests);
+            m_bodies.reserve(num_tests);
+            m_statuses.reserve(num_tests);
+            m_timings.reserve(num_tests);
+            m_collective.reserve(num_tests);
+            m_param_names.reserve(num_parameterized);
+            m_param_tests.reserve(num_parameterized);
+        }
+
+        /// @name Regular tests
+        /// @{
+
+        /**
+         * @brief Register a test that has not run yet.
+         * @param name Name of the test.
+         * @param body Test body.
+         * @param collective Whether every process of a distributed session runs the test.
+         * @return Id of the test, or of the test already registered under `name`.
+         */
+        Id add_test(std::string_view name, TestFunction body, bool collective = false) {
+            const auto [id, added] = m_test_names.intern(name);
+            if (added) {
+                m_bodies.push_back(std::move(body));
+                m_statuses.push_back(Test::Status::NONE);
+                m_timings.emplace_back();
+                m_collective.push_back(collective);
+            }
+            return id;
+        }
+
+        /// @brief Id of the test registered under `name`, if any.
+        [[nodiscard]] std::optional<Id> find_test(std::string_view name) const noexcept {
+            return m_test_names.find(name);
+        }
+
+        /// @brief Number of regular tests.
+        [[nodiscard]] std::size_t num_tests() const noexcept { return m_bodies.size(); }
+
+        [[nodiscard]] const std::string &test_name(Id id) const { return m_test_names.name(id); }
+        [[nodiscard]] const TestFunction &body(Id id) const { return m_bodies[id]; }
+        [[nodiscard]] Test::Status status(Id id) const { return m_statuses[id]; }
+        [[nodiscard]] const TestTiming &timing(Id id) const { return m_timings[id]; }
+        [[nodiscard]] bool is_collective(Id id) const { return m_collective[id]; }
+
+        /// @brief Record the outcome of a run. Safe for concurrent calls on different ids.
+        void set_result(Id id, Test::Status status, const TestTiming &timing) {
+            m_statuses[id] = status;
+            m_timings[id] = timing;
+        }
+
+        /// @brief Ids of all regular tests, ordered by name.
+        [[nodiscard]] std::vector<Id> tests_by_name() const { return m_test_names.sorted(); }
+        /// @}
+
+        /// @name Parameterized tests
+        /// @{
+
+        /**
+         * @brief Register a parameterized test.
+         * @return Id of the test, or of the test already registered under `name`.
+         */
+        Id add_parameterized(std::string_view name, ParameterizedTestFunction body,
+                             ParameterSpace params) {
+            const auto [id, added] = m_param_names.intern(name);
+            if (added) {
+                m_param_tests.emplace_back(std::string(name), std::move(body), std::move(params));
+            }
+            return id;
+        }
+
+        /// @brief Id of the parameterized test registered under `name`, if any.
+        [[nodiscard]] std::optional<Id> find_parameterized(std::string_view name) const noexcept {
+            return m_param_names.find(name);
+        }
+
+        /// @brief Number of parameterized tests.
+        [[nodiscard]] std::size_t num_parameterized() const noexcept { return m_param_tests.size(); }
+
+        [[nodiscard]] ParameterizedTest &parameterized(Id id) { return m_param_tests[id]; }
+        [[nodiscard]] const ParameterizedTest &parameterized(Id id) const { return m_param_tests[id]; }
+
+        /// @brief Ids of all parameterized tests, ordered by name.
+        [[nodiscard]] std::vector<Id> parameterized_by_name() const { return m_param_names.sorted(); }
+        /// @}
+
+    private:
+        NameTable m_test_names;                 //!< Test names; the id of a name is the test id
+        std::vector<TestFunction> m_bodies;     //!< Body per test
+        std::vector<Test::Status> m_statuses;   //!< Status per test
+        std::vector<TestTiming> m_timings;      //!< Durations of each test's last run
+        std::vector<bool> m_collective;         //!< Whether each test runs on every process
+
+        NameTable m_param_names;                     //!< Parameterized test names
+        std::vector<ParameterizedTest> m_param_tests; //!< Parameterized tests by id
+    };
+} // namespace Fortest
+
+#endif // FORTEST_TEST_REGISTRY_HPP
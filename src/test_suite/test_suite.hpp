@@ -1,10 +1,117 @@
 #ifndef FORTEST_TEST_SUITE_HPP
 #define FORTEST_TEST_SUITE_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "test.hpp"
 #include "parameterized_test.hpp"
+#include "test_registry.hpp"
+#include "status_counts.hpp"
+#include "thread_pool.hpp"
+#include "fork_runner.hpp"
+#include "watchdog.hpp"
+#include "case_distributor.hpp"
+#include "session_distribution.hpp"
+#include "result_sink.hpp"
+#include "benchmark.hpp"
 
 namespace Fortest {
+    /**
+     * @brief The tests of a suite that this process runs, by test id.
+     *
+     * An empty mask selects every test of its kind.
+     */
+    struct TestSelection {
+        std::vector<bool> tests;         //!< Regular tests
+        std::vector<bool> parameterized; //!< Parameterized tests
+        bool distributed = false;        //!< Other processes run the rest; see TestSuite::reduce_results()
+
+        [[nodiscard]] bool has_test(std::size_t id) const { return tests.empty() || tests[id]; }
+        [[nodiscard]] bool has_parameterized(std::size_t id) const {
+            return parameterized.empty() || parameterized[id];
+        }
+
+        /// @brief Number of selected tests and parameterized tests.
+        [[nodiscard]] std::size_t count(std::size_t num_tests, std::size_t num_parameterized) const {
+            std::size_t n = 0;
+            for (std::size_t id = 0; id < num_tests; ++id) n += has_test(id);
+            for (std::size_t id = 0; id < num_parameterized; ++id) n += has_parameterized(id);
+            return n;
+        }
+
+        /**
+         * @brief Combine two selections test by test.
+         * @param both Keep the tests selected by both, else by either.
+         */
+        [[nodiscard]] static TestSelection combine(const TestSelection &a, const TestSelection &b, bool both,
+                                                   std::size_t num_tests, std::size_t num_parameterized) {
+            const auto mask = [both](const std::vector<bool> &x, const std::vector<bool> &y, std::size_t n) {
+                if (x.empty() && y.empty()) return std::vector<bool>{};
+                if (!both && (x.empty() || y.empty())) return std::vector<bool>{};
+                std::vector<bool> out(n);
+                for (std::size_t id = 0; id < n; ++id) {
+                    const bool in_x = x.empty() || x[id];
+                    const bool in_y = y.empty() || y[id];
+                    out[id] = both ? in_x && in_y : in_x || in_y;
+                }
+                return out;
+            };
+            return {mask(a.tests, b.tests, num_tests), mask(a.parameterized, b.parameterized, num_parameterized),
+                    a.distributed || b.distributed};
+        }
+    };
+
+    /// A task of a parallel run, with its expected duration.
+    struct ScheduledJob {
+        std::optional<double> cost_ms; //!< Expected duration; std::nullopt if unknown
+        ThreadPool::Task task;         //!< Work to run on the pool
+    };
+
+    /// What, besides its code, determines the result of a cacheable test (see TestSuite::set_cacheable()).
+    struct CacheInputs {
+        std::vector<std::string> files; //!< Input files, e.g. read by the test's fixture
+        std::string flags;              //!< Compiler flags or other settings of the build
+    };
+
+    /// A job of an isolated run, with its expected duration.
+    struct ForkedJob {
+        std::optional<double> cost_ms; //!< Expected duration; std::nullopt if unknown
+        ForkRunner::Body body;         //!< Runs in the child
+        ForkRunner::Completion completion; //!< Runs in the parent
+        std::optional<double> timeout_seconds; //!< Wall-clock limit of the child; std::nullopt keeps the runner's
+        ForkRunner::Prepare prepare;   //!< Runs in the parent before the fork
+    };
+
+    /**
+     * @brief Order jobs by decreasing expected duration.
+     * @param jobs ScheduledJob or ForkedJob list; sorted in place, ties keep their order.
+     * @param estimate_ms Cost of jobs without one; see resolve_costs().
+     */
+    template<typename Job>
+    void order_longest_first(std::vector<Job> &jobs, double estimate_ms = 0.0) {
+        std::vector<std::optional<double>> known(jobs.size());
+        for (std::size_t i = 0; i < jobs.size(); ++i) known[i] = jobs[i].cost_ms;
+        const std::vector<double> costs = resolve_costs(known, estimate_ms);
+        std::vector<Job> ordered;
+        ordered.reserve(jobs.size());
+        for (const std::size_t i : longest_first(costs)) ordered.push_back(std::move(jobs[i]));
+        jobs = std::move(ordered);
+    }
+
     /**
      * @brief Represents a collection of tests within a suite.
      *
@@ -13,144 +120,1240 @@ namespace Fortest {
      * test-level fixtures, and tracks test statuses. Fixtures can be
      * attached at the test, suite, or session scope.
      *
+     * Tests live in a flat TestRegistry and run in name order. The suite
+     * keeps one fixture per scope and hands it to every test it runs,
+     * so attaching a fixture never touches the tests.
+     *
      * @tparam TestLoggerType A logger type satisfying LoggerLike.
      */
     template<LoggerLike TestLoggerType, LoggerLike AssertLoggerType = TestLoggerType>
     class TestSuite {
-        std::string m_name; //!< Name of the test suite
-        std::map<std::string, Test> m_tests; //!< Named tests
-        std::map<std::string, ParameterizedTest> m_param_tests; //!< Named parameterized tests
+        using Id = TestRegistry::Id;
 
-        std::shared_ptr<Fixture<void>> m_test_fixture;    //!< Test-level fixture
-        std::shared_ptr<Fixture<void>> m_suite_fixture;   //!< Suite-level fixture
-        std::shared_ptr<Fixture<void>> m_session_fixture; //!< Session-level fixture
+        std::string m_name; //!< Name of the test suite
+        TestRegistry m_tests; //!< Regular and parameterized tests
+        std::array<std::optional<Fixture<void>>, 3> m_fixtures; //!< Fixture per Scope
 
         Assert<AssertLoggerType> &m_assert; //!< Assertion engine
-        std::map<std::string, Test::Status> m_statuses; //!< Status of all tests
+        StatusCounter m_counts; //!< Tests per status; a parameterized test counts once
+
+        struct ParameterizedRun;
+        std::size_t m_chunk_size = 0;                   //!< Fixed case chunk size; 0 is guided
+        CaseDistributorFactory m_case_distribution;      //!< Shares cases with other processes, if set
+        std::vector<std::shared_ptr<ParameterizedRun>> m_pending_merges; //!< Distributed runs to merge
+        TestSelection m_selection;                       //!< Tests run by this process
+        std::string m_fingerprint;                       //!< Fingerprint of the suite's code; empty is the binary's
+        std::unordered_map<Id, CacheInputs> m_cacheable; //!< Regular tests whose results may be cached
+        std::vector<bool> m_cached;                      //!< Tests reported as CACHED instead of run, by id
+
+        /// A test added with add_benchmark() and its latest measurement.
+        struct Benchmark {
+            BenchmarkOptions options;
+            std::optional<BenchmarkStats> stats;
+        };
+        /// How benchmarks are compared with their past runs.
+        struct BaselineCheck {
+            BenchmarkBaseline baseline;
+            RegressionOptions options;
+        };
+        std::unordered_map<Id, std::shared_ptr<Benchmark>> m_benchmarks; //!< Benchmarks among the tests
+        std::shared_ptr<BaselineCheck> m_baseline = std::make_shared<BaselineCheck>(); //!< Shared with the benchmarks
+
+        std::unordered_map<Id, double> m_test_timeouts;          //!< Limits set for single regular tests
+        std::unordered_map<Id, double> m_parameterized_timeouts; //!< Limits set for the cases of single parameterized tests
+        std::optional<double> m_timeout;                         //!< Limit of the suite's other tests
+        std::optional<double> m_default_timeout;                 //!< Limit given by the session
+        double m_timeout_grace = 5.0;                            //!< Time a timed-out test has to return
+        FailureBudget *m_failure_budget = nullptr;               //!< Stops the run after enough failures, if set
+        SharedFixture m_shared_suite_fixture;                    //!< Sets the suite fixture up for the first test that runs
+        SharedFixture *m_shared_session_fixture = nullptr;       //!< Session fixture set up on first use, if set
 
     public:
-        TestSuite(std::string name, Assert<AssertLoggerType> &assert)
-            : m_name(std::move(name)), m_assert(assert) {}
+        /**
+         * @param name Name of the suite.
+         * @param assert Assertion engine shared by the tests.
+         * @param session_counts Counter of the owning session, which also
+         *        receives every status change of this suite (optional).
+         */
+        TestSuite(std::string name, Assert<AssertLoggerType> &assert,
+                  StatusCounter *session_counts = nullptr)
+            : m_name(std::move(name)), m_assert(assert), m_counts(session_counts) {}
 
-        /// @brief Add a fixture to the suite.
+        /**
+         * @brief Add a fixture to the suite.
+         *
+         * Applies to every test of the suite, registered before or after.
+         * A later fixture of the same scope replaces the earlier one.
+         */
         void add_fixture(const Fixture<void> &fixture) {
-            auto shared_fix = std::make_shared<Fixture<void>>(fixture);
-
-            switch (fixture.get_scope()) {
-                case Scope::Session:
-                    if (!m_session_fixture) m_session_fixture = shared_fix;
-                    break;
-                case Scope::Suite:
-                    if (!m_suite_fixture) m_suite_fixture = shared_fix;
-                    break;
-                case Scope::Test:
-                    if (!m_test_fixture) m_test_fixture = shared_fix;
-                    break;
-            }
+            m_fixtures[static_cast<std::size_t>(fixture.get_scope())] = fixture;
+        }
 
-            for (auto &test : m_tests | std::views::values) {
-                test.add_fixture(std::make_shared<Fixture<void>>(fixture));
-            }
-            for (auto &ptest : m_param_tests | std::views::values) {
-                ptest.add_fixture(std::make_shared<Fixture<void>>(fixture));
-            }
+        /**
+         * @brief Add a regular test to the suite.
+         * @param test_name Name of the test.
+         * @param func Test body.
+         * @param collective Whether every process of a distributed session
+         *        runs the test, e.g. because it communicates.
+         */
+        void add_test(std::string_view test_name, TestFunction func, bool collective = false) {
+            const std::size_t before = m_tests.num_tests();
+            m_tests.add_test(test_name, std::move(func), collective);
+            if (m_tests.num_tests() != before) m_counts.add(Test::Status::NONE);
         }
 
-        /// @brief Add a regular test to the suite.
-        void add_test(const std::string &test_name, TestFunction func) {
-            Test test(test_name, std::move(func));
+        /**
+         * @brief Add a benchmark: a test that times repeated calls of its body.
+         *
+         * The body is called `options.warmup` times untimed, then as often
+         * as measure_benchmark() needs for stable samples. Test fixtures
+         * are set up once around all calls. Failed assertions fail the
+         * benchmark like any test. The statistics are logged, stored with
+         * the test's result row, and returned by get_benchmark_stats().
+         * Every completed measurement counts one assertion: a failed one
+         * if, with a baseline (see set_benchmark_baseline()), it shows a
+         * significant slowdown past the allowed percentage, else a passed
+         * one.
+         *
+         * @param test_name Name of the benchmark.
+         * @param func Body to time.
+         * @param options How to measure it.
+         */
+        void add_benchmark(std::string_view test_name, TestFunction func, BenchmarkOptions options = {}) {
+            if (m_tests.find_test(test_name)) return;
+            auto benchmark = std::make_shared<Benchmark>(Benchmark{options, std::nullopt});
+            add_test(test_name, [benchmark, check = m_baseline, assert = &m_assert, suite_name = m_name,
+                                 name = std::string(test_name), func = std::move(func)](
+                                    void *test, void *suite, void *session) {
+                benchmark->stats = measure_benchmark([&] { func(test, suite, session); }, benchmark->options);
+                // One assertion per measurement: it fails only on a regression.
+                std::optional<RegressionVerdict> verdict;
+                if (check->baseline && check->options.max_slowdown_percent > 0.0) {
+                    const auto baseline = check->baseline(suite_name, name);
+                    if (!baseline.empty()) verdict = compare_with_baseline(*benchmark->stats, baseline, check->options);
+                }
+                if (verdict && verdict->regressed) {
+                    assert->fail("benchmark " + name + " is slower than its baseline: " + verdict->summary(),
+                                 Verbosity::FAIL_ONLY);
+                } else {
+                    assert->pass("benchmark " + name + " measured", Verbosity::FAIL_ONLY);
+                }
+            });
+            m_benchmarks.emplace(*m_tests.find_test(test_name), std::move(benchmark));
+        }
 
-            if (m_test_fixture)    test.add_fixture(m_test_fixture);
-            if (m_suite_fixture)   test.add_fixture(m_suite_fixture);
-            if (m_session_fixture) test.add_fixture(m_session_fixture);
+        /**
+         * @brief Compare the benchmarks of the following runs with their past runs.
+         * @param baseline Statistics of a benchmark's earlier runs; empty
+         *        disables the comparison.
+         * @param options Allowed slowdown and significance level; see
+         *        compare_with_baseline().
+         */
+        void set_benchmark_baseline(BenchmarkBaseline baseline, RegressionOptions options) {
+            *m_baseline = BaselineCheck{std::move(baseline), options};
+        }
 
-            m_statuses[test_name] = test.get_status();
-            m_tests.emplace(test_name, std::move(test));
+        /**
+         * @brief Statistics of the latest run of a benchmark.
+         * @return The statistics, or std::nullopt if `test_name` is no
+         *         benchmark or has not completed a measurement in this
+         *         process.
+         */
+        [[nodiscard]] std::optional<BenchmarkStats> get_benchmark_stats(std::string_view test_name) const {
+            const auto id = m_tests.find_test(test_name);
+            if (!id) return std::nullopt;
+            const auto it = m_benchmarks.find(*id);
+            return it == m_benchmarks.end() ? std::nullopt : it->second->stats;
         }
 
         /// @brief Add a parameterized test to the suite.
-        void register_parameterized_test(const std::string &test_name,
+        void register_parameterized_test(std::string_view test_name,
                                          ParameterizedTestFunction func,
-                                         std::vector<int> params) {
-            ParameterizedTest test(test_name, std::move(func), std::move(params));
+                                         ParameterSpace params) {
+            const std::size_t before = m_tests.num_parameterized();
+            m_tests.add_parameterized(test_name, std::move(func), std::move(params));
+            if (m_tests.num_parameterized() != before) m_counts.add(Test::Status::NONE);
+        }
 
-            if (m_test_fixture)    test.add_fixture(m_test_fixture);
-            if (m_suite_fixture)   test.add_fixture(m_suite_fixture);
-            if (m_session_fixture) test.add_fixture(m_session_fixture);
+        /// @brief Prepare for the given numbers of tests in total.
+        void reserve(std::size_t num_tests, std::size_t num_parameterized = 0) {
+            m_tests.reserve(num_tests, num_parameterized);
+        }
+
+        /**
+         * @brief Number of cases a worker takes from a parameterized test at a time.
+         * @param chunk_size Fixed size, or 0 (the default) for guided chunks
+         *        that shrink as the cases run out; see guided_chunk_size().
+         */
+        void set_chunk_size(std::size_t chunk_size) { m_chunk_size = chunk_size; }
+
+        /**
+         * @brief Share the cases of parameterized tests with other processes.
+         *
+         * Every run of a parameterized test then takes its chunks from a
+         * distributor made by `factory`, and the results of all processes
+         * are merged once the local cases are done. An empty factory keeps
+         * the cases in this process.
+         */
+        void set_case_distribution(CaseDistributorFactory factory) {
+            m_case_distribution = std::move(factory);
+        }
+
+        /**
+         * @brief Restrict the following runs to the selected tests.
+         *
+         * Unselected tests keep their status and write no result rows.
+         * The suite fixture still wraps the run.
+         */
+        void select(TestSelection selection) { m_selection = std::move(selection); }
+
+        [[nodiscard]] const TestSelection &get_selection() const { return m_selection; }
+
+        /**
+         * @brief Identify the code under test, e.g. with file_fingerprint() of its object file.
+         *
+         * Runs that skip unchanged suites compare it with the fingerprint
+         * of the suite's last run. Empty (the default) uses the
+         * fingerprint of the test binary.
+         */
+        void set_fingerprint(std::string fingerprint) { m_fingerprint = std::move(fingerprint); }
 
-            m_param_tests.emplace(test_name, std::move(test));
+        [[nodiscard]] const std::string &get_fingerprint() const { return m_fingerprint; }
+
+        /**
+         * @brief Let a deterministic test be skipped while its code and inputs are unchanged.
+         *
+         * A session whose latest result of the test under the same cache
+         * key passed reports it as CACHED instead of running it. The
+         * key combines the suite and test names, the suite's fingerprint
+         * (see set_fingerprint()), the contents of `input_files` and
+         * `flags`.
+         *
+         * @param test_name Name of a registered regular test.
+         * @param input_files Files the result depends on, e.g. read by the test's fixture.
+         * @param flags Compiler flags or other settings the result depends on.
+         * @throws std::runtime_error if the suite has no such regular test.
+         */
+        void set_cacheable(std::string_view test_name, std::vector<std::string> input_files = {},
+                           std::string flags = {}) {
+            const auto id = m_tests.find_test(test_name);
+            if (!id) {
+                throw std::runtime_error("Regular test '" + std::string(test_name) + "' does not exist in suite '" +
+                                         m_name + "'.");
+            }
+            m_cacheable[*id] = CacheInputs{std::move(input_files), std::move(flags)};
+        }
+
+        /// @brief The cacheable regular tests, by id.
+        [[nodiscard]] const std::unordered_map<Id, CacheInputs> &get_cacheable() const { return m_cacheable; }
+
+        /**
+         * @brief Report some tests of the following runs as CACHED instead of running them.
+         * @param cached One flag per regular test id; empty runs every selected test.
+         */
+        void set_cached(std::vector<bool> cached) { m_cached = std::move(cached); }
+
+        /// @brief Whether the following runs report a regular test as CACHED instead of running it.
+        [[nodiscard]] bool is_cached(Id id) const { return id < m_cached.size() && m_cached[id]; }
+
+        /**
+         * @brief Limit the wall-clock time of one test.
+         *
+         * For a parameterized test the limit applies to each case. It
+         * takes precedence over set_timeout() and the session's default.
+         *
+         * @param test_name Name of a registered test.
+         * @param seconds Limit; 0 disables it for this test.
+         * @throws std::runtime_error if the suite has no such test.
+         */
+        void set_test_timeout(std::string_view test_name, double seconds) {
+            if (const auto id = m_tests.find_parameterized(test_name)) {
+                m_parameterized_timeouts[*id] = seconds;
+            } else if (const auto id = m_tests.find_test(test_name)) {
+                m_test_timeouts[*id] = seconds;
+            } else {
+                throw std::runtime_error("Test '" + std::string(test_name) + "' does not exist in suite '" +
+                                         m_name + "'.");
+            }
+        }
+
+        /**
+         * @brief Limit the wall-clock time of every test of the suite without a limit of its own.
+         * @param seconds Limit per test or parameter case; 0 disables the session's default.
+         */
+        void set_timeout(double seconds) { m_timeout = seconds; }
+
+        /**
+         * @brief Limit applied when neither the test nor the suite sets one; set by the session.
+         * @param seconds Limit per test or parameter case; 0 disables it.
+         * @param grace_seconds Time a timed-out in-process test has to return
+         *        before the process records it and exits; see TimeoutGuard.
+         */
+        void set_default_timeout(double seconds, double grace_seconds) {
+            m_default_timeout = seconds;
+            m_timeout_grace = grace_seconds;
+        }
+
+        /**
+         * @brief Skip the tests that have not started once `budget` is exhausted.
+         *
+         * Every failed test and parameter case of the suite is recorded in
+         * it. Skipped tests keep their status and write no result rows;
+         * the suite fixture is still torn down. Collective tests of a
+         * distributed run are never skipped, since every process must
+         * take part. nullptr (the default) runs every test.
+         */
+        void set_failure_budget(FailureBudget *budget) { m_failure_budget = budget; }
+
+        /**
+         * @brief Lifetime of the session fixture, set up by the first test that uses it.
+         *
+         * Acquired before the suite fixture, so the session fixture is
+         * set up first. nullptr (the default) leaves the session fixture
+         * to the caller; its arguments are passed to the tests either way.
+         */
+        void set_session_fixture(SharedFixture *fixture) { m_shared_session_fixture = fixture; }
+
+        /**
+         * @brief Wall-clock limit a test runs with.
+         * @return The limit in seconds, 0 if disabled, or std::nullopt if
+         *         nothing sets one or the suite has no such test.
+         */
+        [[nodiscard]] std::optional<double> get_timeout(std::string_view test_name) const {
+            if (const auto id = m_tests.find_parameterized(test_name)) {
+                return timeout_of(m_parameterized_timeouts, *id);
+            }
+            if (const auto id = m_tests.find_test(test_name)) return timeout_of(m_test_timeouts, *id);
+            return std::nullopt;
         }
 
         [[nodiscard]] const std::string &get_name() const { return m_name; }
 
+        /// @brief The suite's tests.
+        [[nodiscard]] const TestRegistry &get_registry() const { return m_tests; }
+
+        /**
+         * @brief Status of one test, looked up in O(1).
+         *
+         * A parameterized test reports the combination of its cases, as in get_statuses().
+         *
+         * @return The status, or std::nullopt if no test has that name.
+         */
+        [[nodiscard]] std::optional<Test::Status> get_status(std::string_view test_name) const {
+            if (const auto id = m_tests.find_parameterized(test_name)) {
+                return aggregate_status(m_tests.parameterized(*id));
+            }
+            if (const auto id = m_tests.find_test(test_name)) {
+                return m_tests.status(*id);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Number of tests in each status, in O(1).
+         *
+         * Maintained as tests finish. A parameterized test counts once,
+         * with the status get_status() reports for it.
+         */
+        [[nodiscard]] StatusCounts get_status_counts() const { return m_counts.counts(); }
+
+        /// @brief Whether any test failed, crashed or timed out, in O(1).
+        [[nodiscard]] bool has_failures() const { return m_counts.failed() > 0; }
+
         /// @brief Get a map of all test names to their statuses (both regular and parameterized).
         [[nodiscard]] std::map<std::string, Test::Status> get_statuses() const {
-            auto combined = m_statuses;
-            for (auto &[name, ptest] : m_param_tests) {
-                // If all parameter cases passed, mark PASS; if any failed, mark FAIL.
-                bool any_fail = false;
-                bool any_pass = false;
-                for (int idx : ptest.get_parameters()) {
-                    auto st = ptest.get_status(idx);
-                    if (st == ParameterizedTest::Status::FAIL) any_fail = true;
-                    if (st == ParameterizedTest::Status::PASS) any_pass = true;
-                }
-                if (any_fail) {
-                    combined[name] = Test::Status::FAIL;
-                } else if (any_pass) {
-                    combined[name] = Test::Status::PASS;
-                } else {
-                    combined[name] = Test::Status::NONE;
-                }
+            std::map<std::string, Test::Status> combined;
+            for (Id id = 0; id < m_tests.num_tests(); ++id) {
+                combined[m_tests.test_name(id)] = m_tests.status(id);
+            }
+            for (Id id = 0; id < m_tests.num_parameterized(); ++id) {
+                const auto &ptest = m_tests.parameterized(id);
+                combined[ptest.get_name()] = aggregate_status(ptest);
             }
             return combined;
         }
 
-        /// @brief Run all tests and parameterized tests in the suite.
-        void run(const std::shared_ptr<Logger> &logger) {
-            if (m_suite_fixture) m_suite_fixture->setup();
+        /**
+         * @brief Get the durations of every test's last run.
+         *
+         * Parameterized tests report the sum over their parameter cases.
+         */
+        [[nodiscard]] std::map<std::string, TestTiming> get_timings() const {
+            std::map<std::string, TestTiming> timings;
+            for (Id id = 0; id < m_tests.num_tests(); ++id) {
+                timings[m_tests.test_name(id)] = m_tests.timing(id);
+            }
+            for (Id id = 0; id < m_tests.num_parameterized(); ++id) {
+                const auto &ptest = m_tests.parameterized(id);
+                timings[ptest.get_name()] = ptest.get_total_timing();
+            }
+            return timings;
+        }
+
+        /**
+         * @brief Run all tests and parameterized tests in the suite.
+         *
+         * The suite fixture is set up just before the first test that
+         * runs, so a suite whose tests are all filtered out or skipped
+         * never sets it up, and torn down at the end.
+         *
+         * @param logger Logger for progress and outcomes.
+         * @param sink Optional sink receiving one result row per test or parameter case.
+         */
+        void run(const std::shared_ptr<Logger> &logger, ResultConsumer *sink = nullptr) {
+            open_suite_fixture();
 
             // Regular tests
-            const auto db_opt = std::make_optional<SqliteDb>(std::move(m_name + ".sqlite"));
-            db_opt.value().exec(
-                 "CREATE TABLE IF NOT EXISTS test_results ("
-                 "  test_name TEXT,"
-                 "  status TEXT,"
-                 "  duration_ms INTEGER"
-                 ");");
-            for (auto &[test_name, test] : m_tests) {
-                std::string border = "\n" + std::string(40, '=');
-                logger->log("Running test: " + test_name, "INFO", border);
-
-                test.run(logger, m_assert, db_opt);
-                m_statuses[test_name] = test.get_status();
-
-                if (test.get_status() == Test::Status::PASS) {
-                    logger->log("Test passed: " + test_name, "PASS");
-                } else {
-                    logger->log("Test failed: " + test_name, "FAIL");
-                }
+            for (Id id : m_tests.tests_by_name()) {
+                if (is_selected_test(id)) run_test(id, logger, sink);
             }
 
             // Parameterized tests
-            for (auto &[test_name, ptest] : m_param_tests) {
-                std::string border = "\n" + std::string(40, '=');
-                logger->log("Running parameterized test: " + test_name, "INFO", border);
-
-                ptest.run(logger, m_assert, db_opt);
-
-                auto statuses = get_statuses();
-                auto st = statuses[test_name];
-                if (st == Test::Status::PASS) {
-                    logger->log("Parameterized test passed: " + test_name, "PASS");
-                } else if (st == Test::Status::FAIL) {
-                    logger->log("Parameterized test failed: " + test_name, "FAIL");
+            for (Id id : m_tests.parameterized_by_name()) {
+                // Distributed cases are merged collectively, so they always run.
+                if (is_selected_parameterized(id) && !(stopping() && !m_case_distribution)) {
+                    run_parameterized_test(m_tests.parameterized(id), logger, sink);
+                }
+            }
+
+            m_shared_suite_fixture.release();
+        }
+
+        /**
+         * @brief Run the suite's tests concurrently on a thread pool.
+         *
+         * @details
+         * The suite fixture is set up by the first test that starts and
+         * torn down by whichever worker finishes the suite's last test, so
+         * the fixture ordering of run() is preserved while tests of
+         * different suites overlap, and an expensive fixture is only held
+         * while its suite runs. Every test runs with its own AssertContext bound
+         * to the worker thread; threads the test starts count toward it once
+         * they bind that context too. Tests sharing a test-scope fixture would
+         * share its arguments, so they are serialized within the suite.
+         *
+         * The suite must stay alive until the pool has finished.
+         *
+         * @param pool Pool that executes the tests.
+         * @param logger Logger shared by all workers.
+         * @param sink Optional sink receiving the results; must outlive the pool's work.
+         * @param costs Expected durations; if given, the longest tests start first.
+         */
+        void schedule(ThreadPool &pool, const std::shared_ptr<Logger> &logger,
+                      ResultConsumer *sink = nullptr, const TestCostModel &costs = {}) {
+            auto jobs = schedule_jobs(pool.size(), logger, sink, costs);
+            if (costs) order_longest_first(jobs);
+            std::vector<ThreadPool::Task> tasks;
+            tasks.reserve(jobs.size());
+            for (auto &job : jobs) tasks.push_back(std::move(job.task));
+            pool.submit_ordered(std::move(tasks));
+        }
+
+        /**
+         * @brief Prepare the tasks of a parallel run without submitting them.
+         *
+         * Same as schedule(), but the tasks are returned so that a session
+         * can order the tasks of all its suites together. Every task must
+         * be run exactly once, or the suite fixture is never torn down.
+         *
+         * @param workers Number of workers of the pool that will run the tasks.
+         * @param logger Logger shared by all workers.
+         * @param sink Optional sink receiving the results; must outlive the tasks.
+         * @param costs Expected durations of the tests, to annotate the tasks (optional).
+         * @return One task per regular test and per worker share of a parameterized test.
+         */
+        [[nodiscard]] std::vector<ScheduledJob> schedule_jobs(std::size_t workers,
+                                                              const std::shared_ptr<Logger> &logger,
+                                                              ResultConsumer *sink = nullptr,
+                                                              const TestCostModel &costs = {}) {
+            workers = std::max<std::size_t>(workers, 1);
+            std::vector<ScheduledJob> jobs;
+            open_suite_fixture();
+
+            // A parameterized test is spread over up to one job per
+            // worker; cases sharing a test fixture stay in one job.
+            std::vector<std::shared_ptr<ParameterizedRun>> param_runs;
+            const std::vector<Id> test_ids = selected_tests();
+            std::size_t num_tests = test_ids.size();
+            for (Id id : m_tests.parameterized_by_name()) {
+                if (!is_selected_parameterized(id)) continue;
+                ParameterizedTest &ptest = m_tests.parameterized(id);
+                const std::size_t shares = test_fixture()
+                    ? 1
+                    : std::clamp<std::size_t>(ptest.get_num_cases(), 1, workers);
+                param_runs.push_back(start_parameterized(ptest, shares));
+                num_tests += shares;
+            }
+            if (num_tests == 0) {
+                m_shared_suite_fixture.release();
+                return jobs;
+            }
+            jobs.reserve(num_tests);
+
+            auto batch = std::make_shared<ScheduledRun>(num_tests);
+            auto finish = [this, batch] {
+                if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    m_shared_suite_fixture.release();
+                }
+            };
+            auto isolated = [this, batch, finish](auto &&body) {
+                return [this, batch, finish, body] {
+                    AssertContext context;
+                    AssertContext::Binding binding(context);
+                    try {
+                        if (test_fixture()) {
+                            std::lock_guard lock(batch->test_fixture_mutex);
+                            body();
+                        } else {
+                            body();
+                        }
+                    } catch (...) {
+                        finish();
+                        throw;
+                    }
+                    finish();
+                };
+            };
+
+            for (Id id : test_ids) {
+                jobs.push_back({cost_of(costs, m_tests.test_name(id)), isolated([this, id, logger, sink] {
+                    run_test(id, logger, sink);
+                })});
+            }
+            for (const auto &run : param_runs) {
+                if (run->cases->is_distributed()) m_pending_merges.push_back(run);
+                const std::size_t shares = run->active.load();
+                auto cost = cost_of(costs, run->test->get_name());
+                if (cost) *cost /= static_cast<double>(shares);
+                for (std::size_t w = shares; w > 0; --w) {
+                    jobs.push_back({cost, isolated([this, run, logger, sink] {
+                        run_parameterized_chunks(*run, logger, sink);
+                    })});
+                }
+            }
+            return jobs;
+        }
+
+        /**
+         * @brief Merge the results of parameterized tests shared with other processes.
+         *
+         * Completes the runs queued by schedule() once the pool has
+         * finished, in name order. Collective when a case distribution is
+         * set: every process must call it for the same suites in the same
+         * order. Does nothing otherwise.
+         *
+         * @param logger Logger for the outcomes of the merged tests.
+         */
+        void merge_distributed(const std::shared_ptr<Logger> &logger) {
+            for (const auto &run : std::exchange(m_pending_merges, {})) {
+                complete_parameterized(*run, logger);
+            }
+        }
+
+        /**
+         * @brief Run every test of the suite in its own forked child.
+         *
+         * @details
+         * Regular tests and individual parameter cases become separate
+         * jobs of the runner, so a segfault, `error stop`, or hang only
+         * affects the case that caused it: it is reported as CRASH or
+         * TIMEOUT and the remaining cases still run. The suite fixture is
+         * set up in the parent before the first child is forked (children
+         * inherit its state) and torn down once the last job completed.
+         * Results are logged and written to the database by the parent.
+         *
+         * The suite must stay alive until the runner has finished.
+         *
+         * @param runner Runner that forks the children.
+         * @param logger Logger used by the children and the parent.
+         * @param sink Optional sink receiving the results; must outlive the runner's work.
+         * @param costs Expected durations; if given, the longest jobs start first.
+         */
+        void schedule_forked(ForkRunner &runner, const std::shared_ptr<Logger> &logger,
+                             ResultConsumer *sink = nullptr, const TestCostModel &costs = {}) {
+            auto jobs = forked_jobs(logger, sink, costs);
+            if (costs) order_longest_first(jobs);
+            for (auto &job : jobs) {
+                runner.submit(std::move(job.body), std::move(job.completion), job.timeout_seconds,
+                              std::move(job.prepare));
+            }
+        }
+
+        /**
+         * @brief Prepare the jobs of schedule_forked() without submitting them.
+         *
+         * Every job must be submitted to a runner exactly once, with its
+         * `prepare` step, which sets the fixtures up for the first child.
+         *
+         * @param logger Logger used by the children and the parent.
+         * @param sink Optional sink receiving the results; must outlive the jobs.
+         * @param costs Expected durations of the tests and cases, to annotate the jobs (optional).
+         * @return One job per regular test and per parameter case.
+         */
+        [[nodiscard]] std::vector<ForkedJob> forked_jobs(const std::shared_ptr<Logger> &logger,
+                                                         ResultConsumer *sink = nullptr,
+                                                         const TestCostModel &costs = {}) {
+            std::vector<ForkedJob> jobs;
+            open_suite_fixture();
+
+            std::vector<Id> test_ids = selected_tests();
+            // Cached tests need no child; the parent reports them right away.
+            std::erase_if(test_ids, [&](Id id) {
+                if (!is_cached(id)) return false;
+                report_cached(id, logger, sink);
+                return true;
+            });
+            std::size_t num_jobs = test_ids.size();
+            for (Id id = 0; id < m_tests.num_parameterized(); ++id) {
+                if (is_selected_parameterized(id)) num_jobs += m_tests.parameterized(id).get_num_cases();
+            }
+            if (num_jobs == 0) {
+                m_shared_suite_fixture.release();
+                return jobs;
+            }
+            jobs.reserve(num_jobs);
+            // Children inherit the fixtures, so the parent sets them up; it
+            // also announces each test, since only the parent reports.
+            const ForkRunner::Prepare prepare = [this] { acquire_fixtures(); };
+            auto prepare_for = [this, sink, &prepare](const std::string &name) -> ForkRunner::Prepare {
+                if (!sink) return prepare;
+                return [this, sink, name] {
+                    acquire_fixtures();
+                    sink->start(m_name, name);
+                };
+            };
+
+            // Completions run on the thread calling runner.wait(), so a
+            // plain counter is enough here.
+            auto remaining = std::make_shared<std::size_t>(num_jobs);
+            auto finish = [this, remaining] {
+                if (--*remaining == 0) {
+                    m_shared_suite_fixture.release();
+                }
+            };
+
+            for (Id id : test_ids) {
+                jobs.push_back({
+                    cost_of(costs, m_tests.test_name(id)),
+                    [this, id, logger](const ForkRunner::Writer &writer) {
+                        logger->log("Running test: " + m_tests.test_name(id), "INFO", border());
+                        TestTiming timing;
+                        const auto status = Test::execute(m_tests.body(id), fixtures(), m_assert, timing);
+                        // The parent learns only the status; the child reports the other threads' failures.
+                        if (const std::string report = m_assert.thread_failure_report(); !report.empty()) {
+                            logger->log("Failed on other threads: " + m_tests.test_name(id) + report, "FAIL");
+                        }
+                        if (const auto stats = benchmark_stats(id)) write_forked_benchmark(writer, *stats);
+                        write_forked_result(writer, status, timing);
+                    },
+                    [this, id, logger, sink, finish](const ForkRunner::Result &result) {
+                        if (result.outcome == ForkRunner::Outcome::Cancelled) {
+                            finish();
+                            return;
+                        }
+                        TestTiming timing;
+                        const auto status = read_forked_result<Test::Status>(result, timing);
+                        set_result(id, status, timing);
+                        record_failure(status);
+                        const std::string &name = m_tests.test_name(id);
+                        const auto stats = read_forked_benchmark(id, result);
+                        if (stats) logger->log("Benchmark " + name + " " + stats->summary(), "INFO");
+                        log_forked_outcome(logger, name, result,
+                                           status == Test::Status::PASS, timing);
+                        if (sink && !(m_selection.distributed && m_tests.is_collective(id))) {
+                            sink->push(m_name, name, Test::status_name(status), timing, stats);
+                        }
+                        finish();
+                    },
+                    timeout_of(m_test_timeouts, id), prepare_for(m_tests.test_name(id))});
+            }
+            for (Id id : m_tests.parameterized_by_name()) {
+                if (!is_selected_parameterized(id)) continue;
+                ParameterizedTest *ptest = &m_tests.parameterized(id);
+                ptest->reset_total_timing();
+                const std::optional<double> timeout = timeout_of(m_parameterized_timeouts, id);
+                for (std::size_t k = 0; k < ptest->get_num_cases(); ++k) {
+                    jobs.push_back({
+                        costs ? cost_of(costs, ptest->variation_name(k)) : std::nullopt,
+                        [this, ptest, k, logger](const ForkRunner::Writer &writer) {
+                            const TestTiming timing = ptest->run_case(k, logger, m_assert, fixtures());
+                            write_forked_result(writer, ptest->get_case_status(k), timing);
+                        },
+                        [this, ptest, k, logger, sink, finish](const ForkRunner::Result &result) {
+                            if (result.outcome == ForkRunner::Outcome::Cancelled) {
+                                finish();
+                                return;
+                            }
+                            TestTiming timing;
+                            const auto status =
+                                read_forked_result<ParameterizedTest::Status>(result, timing);
+                            record_failure(status);
+                            const Test::Status before = aggregate_status(*ptest);
+                            ptest->record_result(k, status, timing);
+                            m_counts.move(before, aggregate_status(*ptest));
+                            const std::string name = ptest->variation_name(k);
+                            log_forked_outcome(logger, name, result,
+                                               status == ParameterizedTest::Status::PASS, timing);
+                            if (sink) sink->push(m_name, name, ParameterizedTest::status_name(status), timing);
+                            finish();
+                        },
+                        timeout, sink ? prepare_for(ptest->variation_name(k)) : prepare});
+                }
+            }
+            return jobs;
+        }
+
+        /**
+         * @brief Combine the results of the processes sharing the suite.
+         *
+         * @details
+         * Called after a run restricted by select(). Every regular test
+         * takes the result of the process that ran it; a collective test
+         * takes the most severe status of all processes and the longest
+         * durations. Parameterized tests that were selected per process
+         * are combined case by case the same way; the others were merged
+         * by their case distributor. A test run by several processes
+         * takes its memory growth, which may be negative, from the
+         * aggregator alone, and keeps every hardware event counted by any
+         * of them (see ReducedTiming). Afterwards every process holds the
+         * same statuses and counts.
+         *
+         * Collective: every process calls it for the same suites in the
+         * same order.
+         *
+         * @param distribution Processes sharing the session.
+         * @param logger Logger for the outcomes of tests run by other processes.
+         * @param sink Optional sink receiving, on the aggregator, the
+         *        combined result of every collective test.
+         */
+        void reduce_results(SessionDistribution &distribution, const std::shared_ptr<Logger> &logger,
+                            ResultConsumer *sink = nullptr) {
+            const std::vector<Id> ids = m_tests.tests_by_name();
+            std::vector<std::int64_t> values(ids.size() * reduced_fields);
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                const Id id = ids[i];
+                std::int64_t *out = &values[i * reduced_fields];
+                if (!is_selected_test(id)) {
+                    ReducedTiming::pack_absent(out + 1);
+                    continue;
+                }
+                const bool shared = m_tests.is_collective(id);
+                pack_result(out, m_tests.status(id), m_tests.timing(id), !shared || distribution.is_aggregator());
+            }
+            distribution.max_reduce(values);
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                const Id id = ids[i];
+                const Test::Status local = m_tests.status(id);
+                TestTiming timing;
+                const auto status = unpack_result<Test::Status>(&values[i * reduced_fields], timing);
+                set_result(id, status, timing);
+                const std::string &name = m_tests.test_name(id);
+                if (!m_tests.is_collective(id)) {
+                    if (!is_selected_test(id)) log_outcome(logger, "Test", name, status, timing);
+                    continue;
+                }
+                if (status != local) log_outcome(logger, "Collective test", name, status, timing);
+                if (sink && distribution.is_aggregator()) {
+                    sink->push(m_name, name, Test::status_name(status), timing);
+                }
+            }
+
+            if (m_selection.parameterized.empty()) return;
+            for (Id id : m_tests.parameterized_by_name()) {
+                ParameterizedTest &ptest = m_tests.parameterized(id);
+                const bool local = is_selected_parameterized(id);
+                const std::size_t num_cases = ptest.get_num_cases();
+                // One severity per case, then the durations of the process's cases.
+                std::vector<std::int64_t> cases(num_cases + reduced_fields - 1);
+                if (local) {
+                    ptest.prepare_results();
+                    const auto &statuses = ptest.get_case_statuses();
+                    for (std::size_t k = 0; k < num_cases; ++k) cases[k] = status_severity(statuses[k]);
+                    // Shared cases run on every process.
+                    const bool shared = static_cast<bool>(m_case_distribution);
+                    ReducedTiming::pack(&cases[num_cases], ptest.get_total_timing(), !shared || distribution.is_aggregator());
                 } else {
-                    logger->log("Parameterized test not run: " + test_name, "NONE");
+                    ReducedTiming::pack_absent(&cases[num_cases]);
+                }
+                distribution.max_reduce(cases);
+
+                std::vector<ParameterizedTest::Status> statuses(num_cases);
+                for (std::size_t k = 0; k < num_cases; ++k) {
+                    statuses[k] = status_from_severity<ParameterizedTest::Status>(
+                        static_cast<std::uint8_t>(cases[k]));
+                }
+                const Test::Status before = aggregate_status(ptest);
+                ptest.assign_results(std::move(statuses), ReducedTiming::unpack(&cases[num_cases]));
+                m_counts.move(before, aggregate_status(ptest));
+                if (!local) {
+                    log_outcome(logger, "Parameterized test", ptest.get_name(), aggregate_status(ptest),
+                                ptest.get_total_timing());
+                }
+            }
+        }
+
+    private:
+        /// Values per test combined by reduce_results(): the severity, then the timing.
+        static constexpr std::size_t reduced_fields = 1 + ReducedTiming::size;
+
+        template<typename Status>
+        static void pack_result(std::int64_t *out, Status status, const TestTiming &timing,
+                                bool reports_delta) noexcept {
+            out[0] = status_severity(status);
+            ReducedTiming::pack(out + 1, timing, reports_delta);
+        }
+
+        template<typename Status>
+        [[nodiscard]] static Status unpack_result(const std::int64_t *in, TestTiming &timing) noexcept {
+            timing = ReducedTiming::unpack(in + 1);
+            return status_from_severity<Status>(static_cast<std::uint8_t>(in[0]));
+        }
+
+        /// @brief Expected duration of a test of this suite, if `costs` knows it.
+        [[nodiscard]] std::optional<double> cost_of(const TestCostModel &costs, const std::string &test_name) const {
+            if (!costs) return std::nullopt;
+            return costs(m_name, test_name);
+        }
+
+        /// @brief Log the outcome of a test that this process did not run.
+        static void log_outcome(const std::shared_ptr<Logger> &logger, const std::string &kind,
+                                const std::string &name, Test::Status status, const TestTiming &timing) {
+            if (status == Test::Status::PASS) {
+                logger->log(kind + " passed: " + name + " " + timing.summary(), "PASS");
+            } else if (status == Test::Status::CACHED) {
+                logger->log(kind + " cached: " + name, "PASS");
+            } else if (Test::is_failure(status)) {
+                logger->log(kind + " failed: " + name + " " + timing.summary(), "FAIL");
+            } else {
+                logger->log(kind + " not run: " + name, "NONE");
+            }
+        }
+
+        [[nodiscard]] bool is_selected_test(Id id) const { return m_selection.has_test(id); }
+
+        [[nodiscard]] bool is_selected_parameterized(Id id) const { return m_selection.has_parameterized(id); }
+
+        /// @brief Ids of the selected regular tests, ordered by name.
+        [[nodiscard]] std::vector<Id> selected_tests() const {
+            std::vector<Id> ids = m_tests.tests_by_name();
+            std::erase_if(ids, [this](Id id) { return !is_selected_test(id); });
+            return ids;
+        }
+
+        /// @brief Shared state of the workers running one parameterized test.
+        struct ParameterizedRun {
+            ParameterizedTest *test;                   //!< Test being run
+            std::unique_ptr<CaseDistributor> cases;    //!< Source of the workers' chunks
+            Test::Status before;                       //!< Status of the test before the run
+            std::atomic<std::size_t> active;           //!< Workers still running cases
+            std::mutex merge_mutex;                    //!< Serializes merge_tally()
+            std::once_flag started;                    //!< Logs the start of the test by its first worker
+            double timeout;                            //!< Wall-clock limit per case; 0 disables it
+
+            ParameterizedRun(ParameterizedTest &ptest, std::unique_ptr<CaseDistributor> distributor,
+                             std::size_t workers, double timeout_seconds)
+                : test(&ptest), cases(std::move(distributor)), before(aggregate_status(ptest)),
+                  active(workers), timeout(timeout_seconds) {}
+        };
+
+        /// @brief Shared state of one scheduled run of the suite.
+        struct ScheduledRun {
+            std::atomic<std::size_t> remaining;     //!< Tests not yet finished
+            std::mutex test_fixture_mutex;          //!< Serializes test-fixture users
+
+            explicit ScheduledRun(std::size_t num_tests) : remaining(num_tests) {}
+        };
+
+        /// Keys of the records a forked job reports to the parent.
+        enum ForkedKey : std::int32_t {
+            StatusKey, SetupKey, BodyKey, TeardownKey, CpuKey, RssDeltaKey, PeakRssKey,
+            PerfCountedKey, PerfValueKey, // one PerfValueKey + e per event e
+            BenchIterationsKey = PerfValueKey + PerfCounts::NumEvents, BenchRepetitionsKey, BenchMinKey, BenchMedianKey, BenchMeanKey,
+            BenchStddevKey, BenchThroughputKey
+        };
+
+        /// @brief Statistics of the benchmark `id` measured in this process, if it is one.
+        [[nodiscard]] std::optional<BenchmarkStats> benchmark_stats(Id id) const {
+            const auto it = m_benchmarks.find(id);
+            return it == m_benchmarks.end() ? std::nullopt : it->second->stats;
+        }
+
+        /// @brief Child side: report the statistics of a benchmark; doubles travel as their bits.
+        static void write_forked_benchmark(const ForkRunner::Writer &writer, const BenchmarkStats &stats) {
+            writer.write(BenchIterationsKey, static_cast<std::int64_t>(stats.iterations));
+            writer.write(BenchRepetitionsKey, static_cast<std::int64_t>(stats.repetitions));
+            writer.write(BenchMinKey, std::bit_cast<std::int64_t>(stats.min_ns));
+            writer.write(BenchMedianKey, std::bit_cast<std::int64_t>(stats.median_ns));
+            writer.write(BenchMeanKey, std::bit_cast<std::int64_t>(stats.mean_ns));
+            writer.write(BenchStddevKey, std::bit_cast<std::int64_t>(stats.stddev_ns));
+            writer.write(BenchThroughputKey, std::bit_cast<std::int64_t>(stats.throughput));
+        }
+
+        /// @brief Parent side: statistics the forked benchmark `id` reported, kept for get_benchmark_stats().
+        std::optional<BenchmarkStats> read_forked_benchmark(Id id, const ForkRunner::Result &result) {
+            const auto it = m_benchmarks.find(id);
+            if (it == m_benchmarks.end()) return std::nullopt;
+            std::optional<BenchmarkStats> stats;
+            for (const auto &record : result.records) {
+                if (record.key < BenchIterationsKey) continue;
+                if (!stats) stats.emplace();
+                const double real = std::bit_cast<double>(record.value);
+                switch (record.key) {
+                    case BenchIterationsKey: stats->iterations = static_cast<std::size_t>(record.value); break;
+                    case BenchRepetitionsKey: stats->repetitions = static_cast<std::size_t>(record.value); break;
+                    case BenchMinKey: stats->min_ns = real; break;
+                    case BenchMedianKey: stats->median_ns = real; break;
+                    case BenchMeanKey: stats->mean_ns = real; break;
+                    case BenchStddevKey: stats->stddev_ns = real; break;
+                    case BenchThroughputKey: stats->throughput = real; break;
+                    default: break;
+                }
+            }
+            it->second->stats = stats;
+            return stats;
+        }
+
+        /// @brief Child side: report the status and durations of a run.
+        template<typename Status>
+        static void write_forked_result(const ForkRunner::Writer &writer, Status status,
+                                        const TestTiming &timing) {
+            writer.write(SetupKey, timing.setup_ns);
+            writer.write(BodyKey, timing.body_ns);
+            writer.write(TeardownKey, timing.teardown_ns);
+            writer.write(CpuKey, timing.cpu_ns);
+            if (timing.memory.measured) {
+                writer.write(RssDeltaKey, timing.memory.rss_delta_bytes);
+                writer.write(PeakRssKey, timing.memory.peak_rss_bytes);
+            }
+            if (timing.counters.measured()) {
+                writer.write(PerfCountedKey, timing.counters.counted);
+                for (std::size_t e = 0; e < PerfCounts::NumEvents; ++e) {
+                    writer.write(PerfValueKey + static_cast<std::int32_t>(e), timing.counters.values[e]);
+                }
+            }
+            writer.write(StatusKey, static_cast<std::int64_t>(status));
+        }
+
+        /**
+         * @brief Parent side: status of a forked job, the one it reported or
+         * how it died, plus the durations it reported.
+         *
+         * A job that crashed or timed out is charged the wall time the
+         * runner observed as its body time.
+         */
+        template<typename Status>
+        [[nodiscard]] static Status read_forked_result(const ForkRunner::Result &result,
+                                                       TestTiming &timing) {
+            std::optional<Status> reported;
+            for (const auto &record : result.records) {
+                switch (record.key) {
+                    case StatusKey: reported = static_cast<Status>(record.value); break;
+                    case SetupKey: timing.setup_ns = record.value; break;
+                    case BodyKey: timing.body_ns = record.value; break;
+                    case TeardownKey: timing.teardown_ns = record.value; break;
+                    case CpuKey: timing.cpu_ns = record.value; break;
+                    case RssDeltaKey:
+                        timing.memory.rss_delta_bytes = record.value;
+                        timing.memory.measured = true;
+                        break;
+                    case PeakRssKey: timing.memory.peak_rss_bytes = record.value; break;
+                    case PerfCountedKey: timing.counters.counted = static_cast<std::uint32_t>(record.value); break;
+                    default:
+                        if (record.key >= PerfValueKey && record.key < BenchIterationsKey) {
+                            timing.counters.values[record.key - PerfValueKey] = record.value;
+                        }
+                        break;
+                }
+            }
+            switch (result.outcome) {
+                case ForkRunner::Outcome::Exited:
+                    if (reported) return *reported;
+                    break;
+                case ForkRunner::Outcome::TimedOut:
+                    timing = TestTiming{.body_ns = result.wall_ns};
+                    return Status::TIMEOUT;
+                default:
+                    break;
+            }
+            timing = TestTiming{.body_ns = result.wall_ns};
+            return Status::CRASH;
+        }
+
+        /// @brief Log how a forked job ended.
+        static void log_forked_outcome(const std::shared_ptr<Logger> &logger,
+                                       const std::string &name,
+                                       const ForkRunner::Result &result, bool passed,
+                                       const TestTiming &timing) {
+            switch (result.outcome) {
+                case ForkRunner::Outcome::TimedOut:
+                    logger->log("Test timed out: " + name + " " + timing.summary(), "TIMEOUT");
+                    break;
+                case ForkRunner::Outcome::Crashed:
+                    logger->log("Test crashed: " + name +
+                                (result.signal != 0
+                                     ? " (signal " + std::to_string(result.signal) + ")"
+                                     : " (exit code " + std::to_string(result.exit_code) + ")"),
+                                "CRASH");
+                    break;
+                case ForkRunner::Outcome::Cancelled:
+                    break;
+                case ForkRunner::Outcome::Exited:
+                    if (passed) {
+                        logger->log("Test passed: " + name + " " + timing.summary(), "PASS");
+                    } else {
+                        logger->log("Test failed: " + name + " " + timing.summary(), "FAIL");
+                    }
+                    break;
+            }
+        }
+
+        /// @brief Status of a parameterized test as a whole (see ParameterizedTest::get_summary_status).
+        [[nodiscard]] static Test::Status aggregate_status(const ParameterizedTest &ptest) {
+            static_assert(static_cast<int>(Test::Status::CACHED) ==
+                          static_cast<int>(ParameterizedTest::Status::CACHED),
+                          "Test and ParameterizedTest statuses must share their values");
+            return static_cast<Test::Status>(ptest.get_summary_status());
+        }
+
+        /// @brief Record the outcome of a regular test and update the counts.
+        void set_result(Id id, Test::Status status, const TestTiming &timing) {
+            const Test::Status before = m_tests.status(id);
+            m_tests.set_result(id, status, timing);
+            m_counts.move(before, status);
+        }
+
+        /// @brief Test-level fixture, if any.
+        [[nodiscard]] const Fixture<void> *test_fixture() const {
+            return fixture(Scope::Test);
+        }
+
+        /// @brief Suite-level fixture, if any.
+        [[nodiscard]] const Fixture<void> *suite_fixture() const {
+            return fixture(Scope::Suite);
+        }
+
+        [[nodiscard]] const Fixture<void> *fixture(Scope scope) const {
+            const auto &slot = m_fixtures[static_cast<std::size_t>(scope)];
+            return slot ? &*slot : nullptr;
+        }
+
+        /**
+         * @brief Start a batch of the suite's tests, holding one share of the suite fixture.
+         *
+         * The fixture is set up by the first test that runs. Fixtures may
+         * communicate, so in distributed runs every process sets them up
+         * right away, whether or not it gets a test.
+         */
+        void open_suite_fixture() {
+            m_shared_suite_fixture.open(suite_fixture(), 1);
+            if (m_selection.distributed || m_case_distribution) acquire_fixtures();
+        }
+
+        /// @brief Set the session and suite fixtures up if a test is the first to use them.
+        void acquire_fixtures() {
+            if (m_shared_session_fixture) m_shared_session_fixture->acquire();
+            m_shared_suite_fixture.acquire();
+        }
+
+        /// @brief The fixtures every test of the suite runs with.
+        [[nodiscard]] FixtureSet fixtures() const {
+            return {fixture(Scope::Test), fixture(Scope::Suite), fixture(Scope::Session)};
+        }
+
+        /// @brief Record a cached test as CACHED without running it.
+        void report_cached(Id id, const std::shared_ptr<Logger> &logger, ResultConsumer *sink) {
+            const std::string &name = m_tests.test_name(id);
+            set_result(id, Test::Status::CACHED, TestTiming{});
+            log_outcome(logger, "Test", name, Test::Status::CACHED, TestTiming{});
+            if (sink && !(m_selection.distributed && m_tests.is_collective(id))) {
+                sink->push(m_name, name, Test::status_name(Test::Status::CACHED), TestTiming{});
+            }
+        }
+
+        /// @brief Run one regular test, record its status, and log the outcome.
+        void run_test(Id id, const std::shared_ptr<Logger> &logger,
+                      ResultConsumer *sink) {
+            if (stopping() && !(m_selection.distributed && m_tests.is_collective(id))) return;
+            if (is_cached(id)) {
+                report_cached(id, logger, sink);
+                return;
+            }
+            const std::string &test_name = m_tests.test_name(id);
+            logger->log("Running test: " + test_name, "INFO", border());
+            if (sink) sink->start(m_name, test_name);
+
+            TestTiming timing;
+            Test::Status status;
+            try {
+                acquire_fixtures();
+                const auto guard = timeout_guard(timeout_of(m_test_timeouts, id).value_or(0.0), test_name,
+                                                 logger, sink);
+                status = Test::execute(m_tests.body(id), fixtures(), m_assert, timing);
+            } catch (...) {
+                set_result(id, Test::Status::FAIL, timing);
+                throw;
+            }
+            // Each worker writes only its own test's slots.
+            set_result(id, status, timing);
+            record_failure(status);
+            const auto stats = benchmark_stats(id);
+            if (stats) logger->log("Benchmark " + test_name + " " + stats->summary(), "INFO");
+            // A collective test reports its combined result once, after the run.
+            if (sink && !(m_selection.distributed && m_tests.is_collective(id))) {
+                sink->push(m_name, test_name, Test::status_name(status), timing, stats);
+            }
+
+            const std::string summary = timing.summary();
+            if (status == Test::Status::PASS) {
+                logger->log("Test passed: " + test_name + " " + summary, "PASS");
+            } else if (status == Test::Status::TIMEOUT) {
+                logger->log("Test timed out: " + test_name + " " + summary, "TIMEOUT");
+            } else {
+                logger->log("Test failed: " + test_name + " " + summary + m_assert.thread_failure_report(),
+                            "FAIL");
+            }
+        }
+
+        /// @brief Run every case of a parameterized test and log the outcome.
+        void run_parameterized_test(ParameterizedTest &ptest,
+                                    const std::shared_ptr<Logger> &logger,
+                                    ResultConsumer *sink) {
+            const auto run = start_parameterized(ptest, 1);
+            run_parameterized_chunks(*run, logger, sink);
+            if (run->cases->is_distributed()) complete_parameterized(*run, logger);
+        }
+
+        /// @brief Prepare a run of `ptest` by `workers` concurrent workers.
+        std::shared_ptr<ParameterizedRun> start_parameterized(ParameterizedTest &ptest,
+                                                              std::size_t workers) {
+            ptest.reset_total_timing();
+            ptest.prepare_results();
+            const std::size_t num_cases = ptest.get_num_cases();
+            auto cases = m_case_distribution
+                ? m_case_distribution(num_cases, workers, m_chunk_size)
+                : std::make_unique<LocalCaseDistributor>(num_cases, workers, m_chunk_size);
+            const auto id = m_tests.find_parameterized(ptest.get_name());
+            const double timeout = id ? timeout_of(m_parameterized_timeouts, *id).value_or(0.0) : 0.0;
+            return std::make_shared<ParameterizedRun>(ptest, std::move(cases), workers, timeout);
+        }
+
+        /**
+         * @brief Worker loop: run chunks of cases until none are left.
+         *
+         * The last worker to finish completes a local run.
+         */
+        void run_parameterized_chunks(ParameterizedRun &run, const std::shared_ptr<Logger> &logger,
+                                      ResultConsumer *sink) {
+            ParameterizedTest &ptest = *run.test;
+            std::call_once(run.started, [&] {
+                logger->log("Running parameterized test: " + ptest.get_name(), "INFO", border());
+            });
+            ParameterizedTest::CaseTally tally;
+            auto finish = [&] {
+                {
+                    std::lock_guard lock(run.merge_mutex);
+                    ptest.merge_tally(tally);
+                }
+                if (run.active.fetch_sub(1, std::memory_order_acq_rel) == 1 && !run.cases->is_distributed()) {
+                    complete_parameterized(run, logger);
+                }
+            };
+            try {
+                // A distributed run hands out every case, so it cannot stop early.
+                const bool stoppable = !run.cases->is_distributed();
+                while (!(stoppable && stopping())) {
+                    const auto chunk = run.cases->next();
+                    if (!chunk) break;
+                    for (std::size_t k = chunk->begin; k < chunk->end; ++k) {
+                        if (stoppable && stopping()) break;
+                        acquire_fixtures();
+                        if (sink) sink->start(m_name, ptest.variation_name(k));
+                        const auto guard = timeout_guard(run.timeout, ptest.variation_name(k), logger, sink);
+                        const TestTiming timing = ptest.run_case(k, logger, m_assert, fixtures(), tally);
+                        record_failure(ptest.get_case_status(k));
+                        if (sink) {
+                            sink->push(m_name, ptest.variation_name(k),
+                                       ParameterizedTest::status_name(ptest.get_case_status(k)), timing);
+                        }
+                    }
                 }
+            } catch (...) {
+                finish();
+                throw;
             }
+            finish();
+        }
+
+        /// @brief Merge the results of other processes if needed, update the counts, and log the outcome.
+        void complete_parameterized(ParameterizedRun &run, const std::shared_ptr<Logger> &logger) {
+            ParameterizedTest &ptest = *run.test;
+            run.cases->merge(ptest);
+
+            const std::string &test_name = ptest.get_name();
+            auto st = aggregate_status(ptest);
+            m_counts.move(run.before, st);
+            const std::string summary = ptest.get_total_timing().summary();
+            if (st == Test::Status::PASS) {
+                logger->log("Parameterized test passed: " + test_name + " " + summary, "PASS");
+            } else if (Test::is_failure(st)) {
+                logger->log("Parameterized test failed: " + test_name + " " + summary, "FAIL");
+            } else {
+                logger->log("Parameterized test not run: " + test_name, "NONE");
+            }
+        }
+
+        /// @brief Whether the failure budget is exhausted and tests should no longer start.
+        [[nodiscard]] bool stopping() const { return m_failure_budget && m_failure_budget->exhausted(); }
+
+        /// @brief Count a failed test or parameter case against the failure budget.
+        template<typename Status>
+        void record_failure(Status status) const {
+            if (m_failure_budget) m_failure_budget->record(status);
+        }
+
+        /// @brief Wall-clock limit of a test: its own, the suite's, or the session's.
+        [[nodiscard]] std::optional<double> timeout_of(const std::unordered_map<Id, double> &limits, Id id) const {
+            if (const auto it = limits.find(id); it != limits.end()) return it->second;
+            return m_timeout ? m_timeout : m_default_timeout;
+        }
+
+        /**
+         * @brief Enforce a limit on the in-process run of the test `name`.
+         *
+         * A test still running `m_timeout_grace` seconds after its limit
+         * is recorded as TIMEOUT and ends the process: the rows and log
+         * lines so far are flushed first, so the results collected before
+         * the hang survive it.
+         *
+         * @return The guard, or nothing if `seconds` disables the limit.
+         */
+        [[nodiscard]] std::unique_ptr<TimeoutGuard> timeout_guard(double seconds, const std::string &name,
+                                                                  const std::shared_ptr<Logger> &logger,
+                                                                  ResultConsumer *sink) const {
+            if (seconds <= 0.0) return nullptr;
+            const double grace = m_timeout_grace;
+            return std::make_unique<TimeoutGuard>(seconds, grace, [suite = m_name, name, seconds, grace, logger,
+                                                                   sink] {
+                logger->log("Test timed out and did not stop: " + name + ", ending the session", "TIMEOUT");
+                if (sink) {
+                    const TestTiming timing{.body_ns = static_cast<std::int64_t>((seconds + grace) * 1e9)};
+                    sink->push(suite, name, Test::status_name(Test::Status::TIMEOUT), timing);
+                    try {
+                        sink->flush();
+                    } catch (const std::exception &e) {
+                        logger->log(std::string("Failed to write test results: ") + e.what(), "FAIL");
+                    }
+                }
+                logger->flush();
+                AsyncWriter::flush_all();
+                std::fflush(nullptr);
+                std::_Exit(TimeoutGuard::hang_exit_code);
+            });
+        }
 
-            if (m_suite_fixture) m_suite_fixture->teardown();
+        /// @brief Separator logged before every test.
+        [[nodiscard]] static const std::optional<std::string> &border() {
+            return test_border();
         }
     };
 } // namespace Fortest
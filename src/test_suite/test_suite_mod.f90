@@ -17,6 +17,8 @@ module fortest_test_suite
    contains
       !> Retrieve the current status code of the suite.
       procedure :: get_status => get_status
+      !> Retrieve the durations of a test's last run.
+      procedure :: get_test_timing
       !> Finalize the suite and exit with its status code.
       procedure, public :: finalize
    end type test_suite_t
@@ -49,6 +51,50 @@ contains
       status = c_get_test_suite_status(f_c_string_name%get_c_string())
    end function get_status
 
+   !> @brief Get the durations of a test's last run, in seconds.
+   !!
+   !! Parameterized tests report the sum over their parameter cases.
+   !!
+   !! @param[in] this The test suite.
+   !! @param[in] test_name Name of the test.
+   !! @param[out] setup Test fixture setup time (optional).
+   !! @param[out] body Wall time of the test body (optional).
+   !! @param[out] teardown Test fixture teardown time (optional).
+   !! @param[out] cpu CPU time of the test body (optional).
+   !! @return Status code (0 = found, nonzero = no such test).
+   function get_test_timing(this, test_name, setup, body, teardown, cpu) result(status)
+      use iso_c_binding
+      use f_c_string_t_mod, only: f_c_string_t
+      implicit none
+      class(test_suite_t), intent(in) :: this
+      character(len = *), intent(in) :: test_name
+      real(c_double), intent(out), optional :: setup, body, teardown, cpu
+      real(c_double), target :: values(4)
+      integer :: status, ierr
+      type (f_c_string_t) :: f_c_string_name, f_c_string_test_name
+      interface
+         function c_get_test_timing(suite_name, test_name, setup, body, teardown, cpu) &
+               bind(C, name = "c_get_test_timing")
+            import :: c_ptr, c_int, c_double
+            type(c_ptr), value :: suite_name, test_name
+            real(c_double), intent(out) :: setup, body, teardown, cpu
+            integer(c_int) :: c_get_test_timing
+         end function c_get_test_timing
+      end interface
+      f_c_string_name = f_c_string_t(this%name)
+      ierr = f_c_string_name%to_c()
+      f_c_string_test_name = f_c_string_t(test_name)
+      ierr = f_c_string_test_name%to_c()
+      values = 0.0_c_double
+      status = c_get_test_timing(f_c_string_name%get_c_string(), &
+            f_c_string_test_name%get_c_string(), &
+            values(1), values(2), values(3), values(4))
+      if (present(setup)) setup = values(1)
+      if (present(body)) body = values(2)
+      if (present(teardown)) teardown = values(3)
+      if (present(cpu)) cpu = values(4)
+   end function get_test_timing
+
    !> @brief Finalize this test suite and exit with its status code.
    !!
    !! This will terminate the program using the exit code
@@ -0,0 +1,56 @@
+#ifndef FORTEST_FINGERPRINT_HPP
+#define FORTEST_FINGERPRINT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace Fortest {
+    /**
+     * @brief Fingerprint of a file's contents: its 64-bit FNV-1a hash in hex.
+     *
+     * Meant to tell whether compiled code changed between runs, e.g. a
+     * test binary or the object file of a suite's module.
+     *
+     * @param path File to hash.
+     * @return 16 hex digits, or an empty string if the file cannot be read.
+     */
+    [[nodiscard]] inline std::string file_fingerprint(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return {};
+        std::uint64_t hash = 14695981039346656037ull;
+        char buffer[1 << 16];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+            const std::streamsize n = file.gcount();
+            for (std::streamsize i = 0; i < n; ++i) {
+                hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+            }
+        }
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+        return text;
+    }
+
+    /**
+     * @brief Fingerprint of some text, in the format of file_fingerprint().
+     *
+     * Meant to combine several fingerprints and settings into one key.
+     */
+    [[nodiscard]] inline std::string text_fingerprint(std::string_view text) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const char c : text) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+        return hex;
+    }
+
+    /// @brief Fingerprint of the running test binary, computed on first use.
+    [[nodiscard]] inline const std::string &executable_fingerprint() {
+        static const std::string fingerprint = file_fingerprint("/proc/self/exe");
+        return fingerprint;
+    }
+} // namespace Fortest
+
+#endif // FORTEST_FINGERPRINT_HPP
@@ -0,0 +1,135 @@
+#ifndef FORTEST_FORK_GUARD_HPP
+#define FORTEST_FORK_GUARD_HPP
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+
+namespace Fortest {
+    /**
+     * @brief Keeps a mutex usable in children forked by a multithreaded process.
+     *
+     * @details
+     * fork() copies only the calling thread. A mutex that another thread
+     * (a pool worker, a logger's writer, the watchdog) holds at that
+     * moment stays locked in the child forever, and a child that logs
+     * would hang until it is killed as a spurious TIMEOUT. Every guarded
+     * mutex is therefore acquired right before fork(), which waits for
+     * the other threads to leave their critical sections, and released
+     * again in the parent and in the child.
+     *
+     * Guarded mutexes must be leaves among each other: a thread holding
+     * one never waits for another, so they can be acquired in any order.
+     * Locks taken inside them, such as those of an AsyncWriter, are
+     * handled by on_fork() handlers, which run while the guarded mutexes
+     * are held. The thread that forks must hold none of them.
+     */
+    class ForkGuard {
+    public:
+        /**
+         * @brief Guard `mutex` until this object is destroyed.
+         *
+         * Declare the guard after the mutex, so that it is removed first.
+         *
+         * @param mutex The mutex to hold across fork().
+         * @param in_child Runs in the child while the mutex is still held,
+         *        e.g. to drop state that belongs to the parent (optional).
+         */
+        explicit ForkGuard(std::mutex &mutex, std::function<void()> in_child = {})
+            : m_mutex(&mutex), m_in_child(std::move(in_child)) {
+            Registry::get().add(this);
+        }
+
+        ~ForkGuard() { Registry::get().remove(this); }
+
+        ForkGuard(const ForkGuard &) = delete;
+        ForkGuard &operator=(const ForkGuard &) = delete;
+
+        /**
+         * @brief Run handlers around every later fork().
+         *
+         * `prepare` runs once the guarded mutexes are held; `parent` and
+         * `child` run after fork() before they are released. Handlers
+         * added later run their `prepare` first, like pthread_atfork().
+         */
+        static void on_fork(void (*prepare)(), void (*parent)(), void (*child)()) {
+            Registry::get().add_handlers({prepare, parent, child});
+        }
+
+    private:
+        struct Handlers {
+            void (*prepare)();
+            void (*parent)();
+            void (*child)();
+        };
+
+        /// Live guards and handlers; owns the only pthread_atfork() registration.
+        class Registry {
+            std::mutex m_mutex;
+            std::vector<ForkGuard *> m_guards;
+            std::vector<Handlers> m_handlers;
+
+            Registry() { ::pthread_atfork(prepare_fork, parent_after_fork, child_after_fork); }
+
+            static void prepare_fork() {
+                auto &registry = get();
+                registry.m_mutex.lock();
+                for (auto *guard: registry.m_guards) guard->m_mutex->lock();
+                for (auto it = registry.m_handlers.rbegin(); it != registry.m_handlers.rend(); ++it) {
+                    if (it->prepare) it->prepare();
+                }
+            }
+
+            static void parent_after_fork() {
+                auto &registry = get();
+                for (const auto &handlers: registry.m_handlers) {
+                    if (handlers.parent) handlers.parent();
+                }
+                for (auto *guard: registry.m_guards) guard->m_mutex->unlock();
+                registry.m_mutex.unlock();
+            }
+
+            static void child_after_fork() {
+                auto &registry = get();
+                for (const auto &handlers: registry.m_handlers) {
+                    if (handlers.child) handlers.child();
+                }
+                for (auto *guard: registry.m_guards) {
+                    if (guard->m_in_child) guard->m_in_child();
+                    guard->m_mutex->unlock();
+                }
+                registry.m_mutex.unlock();
+            }
+
+        public:
+            static Registry &get() {
+                // Never destroyed: guards may outlive static destruction order.
+                static auto *registry = new Registry();
+                return *registry;
+            }
+
+            void add(ForkGuard *guard) {
+                std::lock_guard lock(m_mutex);
+                m_guards.push_back(guard);
+            }
+
+            void remove(ForkGuard *guard) {
+                std::lock_guard lock(m_mutex);
+                std::erase(m_guards, guard);
+            }
+
+            void add_handlers(const Handlers &handlers) {
+                std::lock_guard lock(m_mutex);
+                m_handlers.push_back(handlers);
+            }
+        };
+
+        std::mutex *m_mutex;
+        std::function<void()> m_in_child;
+    };
+} // namespace Fortest
+
+#endif // FORTEST_FORK_GUARD_HPP
@@ -0,0 +1,257 @@
+#ifndef FORTEST_NAME_FILTER_HPP
+#define FORTEST_NAME_FILTER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Fortest {
+    /**
+     * @brief Glob pattern matched one character at a time.
+     *
+     * `*` matches any run of characters and `?` any single one. The
+     * pattern is simulated as a set of positions, so a name is matched in
+     * O(length of name * length of pattern) without backtracking, and a
+     * match can be continued: TestSession matches a suite name once and
+     * then every test of the suite from there.
+     */
+    class GlobPattern {
+        std::string m_text;
+        std::vector<char> m_star_tail; //!< Whether m_text[i..] is non-empty and all `*`
+
+    public:
+        /// Positions of the pattern reachable after the input so far.
+        using States = std::vector<char>;
+
+        explicit GlobPattern(std::string text) : m_text(std::move(text)), m_star_tail(m_text.size() + 1, 0) {
+            for (std::size_t i = m_text.size(); i-- > 0;) {
+                m_star_tail[i] = m_text[i] == '*' && (i + 1 == m_text.size() || m_star_tail[i + 1]);
+            }
+        }
+
+        /// @brief States before any input.
+        [[nodiscard]] States start() const {
+            States states(m_text.size() + 1, 0);
+            states[0] = 1;
+            close(states);
+            return states;
+        }
+
+        /// @brief States after reading `input` from `states`.
+        [[nodiscard]] States advance(States states, std::string_view input) const {
+            States next(states.size());
+            for (const char c : input) {
+                std::ranges::fill(next, 0);
+                bool alive = false;
+                for (std::size_t i = 0; i < m_text.size(); ++i) {
+                    if (!states[i]) continue;
+                    if (m_text[i] == '*') {
+                        next[i] = 1;
+                    } else if (m_text[i] == '?' || m_text[i] == c) {
+                        next[i + 1] = 1;
+                    } else {
+                        continue;
+                    }
+                    alive = true;
+                }
+                states.swap(next);
+                if (!alive) {
+                    std::ranges::fill(states, 0);
+                    break;
+                }
+                close(states);
+            }
+            return states;
+        }
+
+        /// @brief Whether the input read so far matches.
+        [[nodiscard]] bool accepts(const States &states) const { return states.back() != 0; }
+
+        /// @brief Whether some continuation of the input can still match.
+        [[nodiscard]] static bool alive(const States &states) {
+            return std::ranges::any_of(states, [](char state) { return state != 0; });
+        }
+
+        /// @brief Whether every continuation of the input matches.
+        [[nodiscard]] bool accepts_any(const States &states) const {
+            for (std::size_t i = 0; i < m_text.size(); ++i) {
+                if (states[i] && m_star_tail[i]) return true;
+            }
+            return false;
+        }
+
+        /// @brief Whether the whole of `name` matches.
+        [[nodiscard]] bool matches(std::string_view name) const { return accepts(advance(start(), name)); }
+
+    private:
+        /// @brief Add the positions reached by letting a `*` match nothing.
+        void close(States &states) const {
+            for (std::size_t i = 0; i < m_text.size(); ++i) {
+                if (states[i] && m_text[i] == '*') states[i + 1] = 1;
+            }
+        }
+    };
+
+    /**
+     * @brief Selects tests by their full name, `suite.test`.
+     *
+     * @details
+     * The specification follows the `--gtest_filter` syntax: patterns
+     * separated by `:`, optionally followed by `-` and patterns that
+     * exclude. A pattern is a glob (`*` and `?`), or an ECMAScript regex
+     * between slashes (`/mesh_[0-9]+/`), which matches if it is found
+     * anywhere in the name. A test is selected if it matches a positive
+     * pattern (any test, if there is none) and no negative one. An empty
+     * specification selects everything.
+     *
+     * Matching starts per suite (see for_suite()): globs read the suite
+     * name once, so a suite that no pattern can match is skipped without
+     * looking at its tests, and one that all tests match needs no
+     * per-test work.
+     */
+    class NameFilter {
+        struct Pattern {
+            GlobPattern glob{""};
+            std::regex regex;
+            bool is_regex = false;
+        };
+
+        std::vector<Pattern> m_positive;
+        std::vector<Pattern> m_negative;
+
+    public:
+        /// @brief Filter that selects every test.
+        NameFilter() = default;
+
+        /**
+         * @brief Parse a filter specification.
+         * @throws std::regex_error if a regex pattern is malformed.
+         */
+        explicit NameFilter(std::string_view spec) {
+            std::string token;
+            bool negative = false;
+            bool in_regex = false;
+            const auto flush = [&] {
+                if (token.empty()) return;
+                Pattern pattern;
+                if (token.size() >= 2 && token.front() == '/' && token.back() == '/') {
+                    pattern.regex = std::regex(token.substr(1, token.size() - 2));
+                    pattern.is_regex = true;
+                } else {
+                    pattern.glob = GlobPattern(token);
+                }
+                (negative ? m_negative : m_positive).push_back(std::move(pattern));
+                token.clear();
+            };
+            for (const char c : spec) {
+                if (in_regex) {
+                    token.push_back(c);
+                    in_regex = c != '/';
+                } else if (c == '/' && token.empty()) {
+                    token.push_back(c);
+                    in_regex = true;
+                } else if (c == ':') {
+                    flush();
+                } else if (c == '-' && !negative) {
+                    flush();
+                    negative = true;
+                } else {
+                    token.push_back(c);
+                }
+            }
+            flush();
+        }
+
+        /// @brief Whether the filter selects every test.
+        [[nodiscard]] bool empty() const noexcept { return m_positive.empty() && m_negative.empty(); }
+
+        /// @brief The filter, applied to the tests of one suite.
+        class SuiteMatch {
+            struct Active {
+                const Pattern *pattern;
+                GlobPattern::States states; //!< After `suite.`; unused by regexes
+            };
+
+            std::string m_prefix;          //!< `suite.`
+            std::vector<Active> m_positive;
+            std::vector<Active> m_negative;
+            bool m_any_positive = true;    //!< No positive pattern was given
+            bool m_none = false;
+            bool m_all = false;
+
+            friend class NameFilter;
+
+            [[nodiscard]] bool matched(const std::vector<Active> &patterns, std::string_view test) const {
+                for (const Active &active : patterns) {
+                    if (active.pattern->is_regex) {
+                        const std::string name = m_prefix + std::string(test);
+                        if (std::regex_search(name, active.pattern->regex)) return true;
+                    } else if (active.pattern->glob.accepts(active.pattern->glob.advance(active.states, test))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+        public:
+            /// @brief Whether no test of the suite is selected.
+            [[nodiscard]] bool none() const noexcept { return m_none; }
+
+            /// @brief Whether every test of the suite is selected.
+            [[nodiscard]] bool all() const noexcept { return m_all; }
+
+            /// @brief Whether the test of this suite named `test` is selected.
+            [[nodiscard]] bool matches(std::string_view test) const {
+                if (m_none) return false;
+                if (m_all) return true;
+                if (!m_any_positive && !matched(m_positive, test)) return false;
+                return !matched(m_negative, test);
+            }
+        };
+
+        /// @brief Start matching the tests of the suite named `suite`.
+        [[nodiscard]] SuiteMatch for_suite(std::string_view suite) const {
+            SuiteMatch match;
+            match.m_prefix = std::string(suite) + '.';
+            match.m_any_positive = m_positive.empty();
+            bool positive_all = match.m_any_positive;
+            for (const Pattern &pattern : m_positive) {
+                if (pattern.is_regex) {
+                    match.m_positive.push_back({&pattern, {}});
+                    continue;
+                }
+                auto states = pattern.glob.advance(pattern.glob.start(), match.m_prefix);
+                if (!GlobPattern::alive(states)) continue;
+                positive_all = positive_all || pattern.glob.accepts_any(states);
+                match.m_positive.push_back({&pattern, std::move(states)});
+            }
+            for (const Pattern &pattern : m_negative) {
+                if (pattern.is_regex) {
+                    match.m_negative.push_back({&pattern, {}});
+                    continue;
+                }
+                auto states = pattern.glob.advance(pattern.glob.start(), match.m_prefix);
+                if (!GlobPattern::alive(states)) continue;
+                if (pattern.glob.accepts_any(states)) {
+                    match.m_none = true;
+                    return match;
+                }
+                match.m_negative.push_back({&pattern, std::move(states)});
+            }
+            match.m_none = !match.m_any_positive && match.m_positive.empty();
+            match.m_all = positive_all && match.m_negative.empty();
+            return match;
+        }
+
+        /// @brief Whether the test `suite.test` is selected.
+        [[nodiscard]] bool matches(std::string_view suite, std::string_view test) const {
+            return for_suite(suite).matches(test);
+        }
+    };
+} // namespace Fortest
+
+#endif // FORTEST_NAME_FILTER_HPP
@@ -0,0 +1,118 @@
+#ifndef FORTEST_NAME_TABLE_HPP
+#define FORTEST_NAME_TABLE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Fortest {
+    /// Dense identifier of an interned name, assigned in insertion order.
+    using NameId = std::uint32_t;
+
+    /**
+     * @brief Interned set of names with O(1) lookup in both directions.
+     *
+     * @details
+     * Each distinct name is stored once and given the next free id, so
+     * ids can index parallel vectors directly. Names live in a
+     * `std::deque`, which never moves them. The index is an open
+     * addressing table of ids and hashes, kept at most half full, so
+     * interning a name allocates no hash node and a lookup probes one
+     * contiguous array; lookups take a `std::string_view` and never
+     * allocate.
+     */
+    class NameTable {
+        /// One entry of the index; `id == empty` marks a free slot.
+        struct Slot {
+            NameId id;
+            std::uint32_t hash; //!< Low bits of the name's hash, to skip most string comparisons
+        };
+
+        static constexpr NameId empty = ~NameId{0};
+
+        std::deque<std::string> m_names; //!< Names by id
+        std::vector<Slot> m_slots;       //!< Index; its size is zero or a power of two
+
+        [[nodiscard]] static std::uint32_t hash_of(std::string_view name) noexcept {
+            return static_cast<std::uint32_t>(std::hash<std::string_view>{}(name));
+        }
+
+        /// Slot holding `name`, or the free slot where it belongs; needs a non-empty index.
+        [[nodiscard]] std::size_t slot_of(std::string_view name, std::uint32_t hash) const noexcept {
+            const std::size_t mask = m_slots.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                const Slot &slot = m_slots[i];
+                if (slot.id == empty || (slot.hash == hash && m_names[slot.id] == name)) return i;
+            }
+        }
+
+        /// Grow the index to `capacity` slots, a power of two, and re-insert every name.
+        void rehash(std::size_t capacity) {
+            std::vector<Slot> old(capacity, Slot{empty, 0});
+            old.swap(m_slots);
+            const std::size_t mask = capacity - 1;
+            for (const Slot &slot : old) {
+                if (slot.id == empty) continue;
+                std::size_t i = slot.hash & mask;
+                while (m_slots[i].id != empty) i = (i + 1) & mask;
+                m_slots[i] = slot;
+            }
+        }
+
+    public:
+        /**
+         * @brief Id of `name`, adding it if it is new.
+         * @param name Name to intern.
+         * @return The name's id and whether it was added.
+         */
+        std::pair<NameId, bool> intern(std::string_view name) {
+            if (2 * (m_names.size() + 1) > m_slots.size()) rehash(std::max<std::size_t>(16, 2 * m_slots.size()));
+            const std::uint32_t hash = hash_of(name);
+            Slot &slot = m_slots[slot_of(name, hash)];
+            if (slot.id != empty) return {slot.id, false};
+            const auto id = static_cast<NameId>(m_names.size());
+            m_names.emplace_back(name);
+            slot = Slot{id, hash};
+            return {id, true};
+        }
+
+        /// @brief Id of `name`, if it has been interned.
+        [[nodiscard]] std::optional<NameId> find(std::string_view name) const noexcept {
+            if (m_slots.empty()) return std::nullopt;
+            const Slot &slot = m_slots[slot_of(name, hash_of(name))];
+            if (slot.id == empty) return std::nullopt;
+            return slot.id;
+        }
+
+        /// @brief Name of an id returned by intern().
+        [[nodiscard]] const std::string &name(NameId id) const { return m_names[id]; }
+
+        /// @brief Number of interned names.
+        [[nodiscard]] std::size_t size() const noexcept { return m_names.size(); }
+
+        /// @brief Prepare for `count` names in total.
+        void reserve(std::size_t count) {
+            std::size_t capacity = 16;
+            while (capacity < 2 * count) capacity *= 2;
+            if (capacity > m_slots.size()) rehash(capacity);
+        }
+
+        /// @brief All ids, ordered by name.
+        [[nodiscard]] std::vector<NameId> sorted() const {
+            std::vector<NameId> ids(m_names.size());
+            std::iota(ids.begin(), ids.end(), NameId{0});
+            std::ranges::sort(ids, [this](NameId a, NameId b) { return m_names[a] < m_names[b]; });
+            return ids;
+        }
+    };
+
+} // namespace Fortest
+
+#endif // FORTEST_NAME_TABLE_HPP
@@ -2,7 +2,7 @@ module procedure_interfaces_mod
     use iso_c_binding
     implicit none
     private
-    public :: test_proc, fixture_proc, param_test_proc
+    public :: test_proc, fixture_proc, param_test_proc, timed_proc
 
     !> @brief Abstract interface for a test procedure.
     !!
@@ -54,4 +54,12 @@ module procedure_interfaces_mod
         end subroutine fixture_proc
     end interface
 
+    !> @brief Abstract interface for a procedure whose duration is asserted.
+    !!
+    !! A timed procedure takes no arguments; see `assert_duration_below`.
+    abstract interface
+        subroutine timed_proc()
+        end subroutine timed_proc
+    end interface
+
 end module procedure_interfaces_mod
@@ -0,0 +1,227 @@
+#include "array_compare.hpp"
+#include "assert.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+namespace {
+    /// Logger remembering the last message.
+    class CapturingLogger {
+    public:
+        std::string last_msg;
+        std::string last_tag;
+
+        void log(const std::string &msg, const std::string &tag,
+                 const std::optional<std::string> & = std::nullopt) {
+            last_msg = msg;
+            last_tag = tag;
+        }
+    };
+}
+
+/**
+ * @test Behavior: Identical arrays of a size that is not a multiple of the SIMD width pass.
+ */
+TEST(ArrayCompareBehavior, IdenticalArraysPass) {
+    std::vector<double> values(1037);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = std::sin(static_cast<double>(i));
+
+    const auto result = Fortest::compare_arrays(std::span<const double>(values), std::span<const double>(values));
+
+    EXPECT_TRUE(result.passed());
+    EXPECT_EQ(result.size, 1037u);
+    EXPECT_EQ(result.max_abs_error, 0.0);
+    EXPECT_TRUE(result.first_failures.empty());
+}
+
+/**
+ * @test Behavior: Mismatches in the vector body and in the tail are counted and located.
+ */
+TEST(ArrayCompareBehavior, ReportsMismatchesAndErrors) {
+    std::vector<double> expected(2051, 1.0);
+    std::vector<double> actual = expected;
+    actual[3] = 1.5;
+    actual[1500] = 4.0;
+    actual[2050] = 0.0;
+
+    const auto result = Fortest::compare_arrays(std::span<const double>(expected),
+                                                std::span<const double>(actual), 0.1, 0.0);
+
+    EXPECT_EQ(result.mismatches, 3u);
+    EXPECT_DOUBLE_EQ(result.max_abs_error, 3.0);
+    EXPECT_DOUBLE_EQ(result.max_rel_error, 1.0);
+    EXPECT_THAT(result.first_failures, ElementsAre(3u, 1500u, 2050u));
+}
+
+/**
+ * @test Behavior: Only the first max_reported failing offsets are kept, in order.
+ */
+TEST(ArrayCompareBehavior, KeepsFirstFailingOffsets) {
+    std::vector<float> expected(5000, 2.0f);
+    std::vector<float> actual(5000, 3.0f);
+
+    const auto result = Fortest::compare_arrays(std::span<const float>(expected),
+                                                std::span<const float>(actual), 0.0, 0.0, 4);
+
+    EXPECT_EQ(result.mismatches, 5000u);
+    EXPECT_THAT(result.first_failures, ElementsAre(0u, 1u, 2u, 3u));
+}
+
+/**
+ * @test Behavior: The relative tolerance scales with the larger magnitude.
+ */
+TEST(ArrayCompareBehavior, RelativeToleranceScales) {
+    const std::vector<double> expected{1000.0, 1.0, -500.0};
+    const std::vector<double> actual{1005.0, 1.004, -502.0};
+
+    EXPECT_TRUE(Fortest::compare_arrays(std::span<const double>(expected),
+                                        std::span<const double>(actual), 0.0, 0.005).passed());
+    EXPECT_EQ(Fortest::compare_arrays(std::span<const double>(expected),
+                                      std::span<const double>(actual), 0.0, 0.001).mismatches, 3u);
+}
+
+/**
+ * @test Behavior: NaN never matches, and does not poison the reported maxima.
+ */
+TEST(ArrayCompareBehavior, NaNIsAMismatch) {
+    std::vector<double> expected(64, 1.0);
+    std::vector<double> actual = expected;
+    actual[10] = std::numeric_limits<double>::quiet_NaN();
+    actual[11] = 1.25;
+
+    const auto result = Fortest::compare_arrays(std::span<const double>(expected),
+                                                std::span<const double>(actual), 1.0, 0.0);
+
+    EXPECT_EQ(result.mismatches, 1u);
+    EXPECT_THAT(result.first_failures, ElementsAre(10u));
+    EXPECT_DOUBLE_EQ(result.max_abs_error, 0.25);
+}
+
+/**
+ * @test Behavior: Integer arrays compare exactly, without overflow in the error.
+ */
+TEST(ArrayCompareBehavior, IntegersCompareExactly) {
+    std::vector<int> expected(100, 7);
+    std::vector<int> actual = expected;
+    actual[42] = std::numeric_limits<int>::min();
+
+    const auto result = Fortest::compare_arrays(std::span<const int>(expected),
+                                                std::span<const int>(actual));
+
+    EXPECT_EQ(result.mismatches, 1u);
+    EXPECT_THAT(result.first_failures, ElementsAre(42u));
+    EXPECT_DOUBLE_EQ(result.max_abs_error, 7.0 - static_cast<double>(std::numeric_limits<int>::min()));
+}
+
+/**
+ * @test Behavior: Complex errors are moduli of the difference.
+ */
+TEST(ArrayCompareBehavior, ComplexUsesModulus) {
+    std::vector<std::complex<double>> expected(21, {1.0, 1.0});
+    std::vector<std::complex<double>> actual = expected;
+    actual[5] = {4.0, 5.0};   // |difference| = 5
+    actual[20] = {1.0, 1.5};  // tail element
+
+    const auto result = Fortest::compare_arrays(
+        std::span<const std::complex<double>>(expected),
+        std::span<const std::complex<double>>(actual), 0.1, 0.0);
+
+    EXPECT_EQ(result.mismatches, 2u);
+    EXPECT_DOUBLE_EQ(result.max_abs_error, 5.0);
+    EXPECT_THAT(result.first_failures, ElementsAre(5u, 20u));
+
+    std::vector<std::complex<float>> fexpected(40, {0.0f, 2.0f});
+    std::vector<std::complex<float>> factual = fexpected;
+    factual[33] = {0.0f, 2.5f};
+    const auto fresult = Fortest::compare_arrays(
+        std::span<const std::complex<float>>(fexpected),
+        std::span<const std::complex<float>>(factual), 0.0, 0.1);
+    EXPECT_EQ(fresult.mismatches, 1u);
+    EXPECT_THAT(fresult.first_failures, ElementsAre(33u));
+}
+
+/**
+ * @test Behavior: The SIMD kernel agrees with a scalar reference on random data.
+ */
+TEST(ArrayCompareBehavior, MatchesScalarReference) {
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> value(0.0, 10.0);
+    std::uniform_real_distribution<double> noise(-1e-3, 1e-3);
+
+    std::vector<double> expected(10007);
+    std::vector<double> actual(expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = value(rng);
+        actual[i] = expected[i] + noise(rng);
+    }
+    const double abs_tol = 5e-4;
+    const double rel_tol = 1e-4;
+
+    std::size_t mismatches = 0;
+    std::vector<std::size_t> first;
+    double max_abs = 0.0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        const double diff = std::abs(expected[i] - actual[i]);
+        const double scale = std::max(std::abs(expected[i]), std::abs(actual[i]));
+        max_abs = std::max(max_abs, diff);
+        if (!(diff <= abs_tol || diff <= rel_tol * scale)) {
+            ++mismatches;
+            if (first.size() < Fortest::default_reported_mismatches) first.push_back(i);
+        }
+    }
+
+    const auto result = Fortest::compare_arrays(std::span<const double>(expected),
+                                                std::span<const double>(actual), abs_tol, rel_tol);
+    EXPECT_GT(mismatches, 0u);
+    EXPECT_EQ(result.mismatches, mismatches);
+    EXPECT_EQ(result.first_failures, first);
+    EXPECT_DOUBLE_EQ(result.max_abs_error, max_abs);
+}
+
+/**
+ * @test Behavior: assert_array_equal counts one assertion and names failures by subscript.
+ */
+TEST(ArrayCompareBehavior, AssertNamesFailingSubscripts) {
+    Fortest::Assert<CapturingLogger> asserter;
+    const std::vector<double> expected{1, 2, 3, 4, 5, 6};
+    const std::vector<double> actual{1, 2, 3, 4, 9, 6};
+    const std::vector<std::int64_t> shape{3, 2};
+
+    asserter.assert_array_equal(std::span<const double>(expected), std::span<const double>(actual),
+                                0.0, 0.0, Fortest::Verbosity::FAIL_ONLY, shape);
+
+    EXPECT_EQ(asserter.get_num_failed(), 1);
+    EXPECT_EQ(asserter.get_num_passed(), 0);
+    EXPECT_EQ(asserter.get_logger()->last_tag, "FAIL");
+    EXPECT_THAT(asserter.get_logger()->last_msg, HasSubstr("differ in 1 of 6 elements"));
+    EXPECT_THAT(asserter.get_logger()->last_msg, HasSubstr("(2,2) expected 5"));
+
+    asserter.assert_array_equal(std::span<const double>(expected), std::span<const double>(expected));
+    EXPECT_EQ(asserter.get_num_passed(), 1);
+}
+
+/**
+ * @test Behavior: Arrays of different sizes fail.
+ */
+TEST(ArrayCompareBehavior, SizeMismatchFails) {
+    Fortest::Assert<CapturingLogger> asserter;
+    const std::vector<int> expected{1, 2, 3};
+    const std::vector<int> actual{1, 2};
+
+    asserter.assert_array_equal(std::span<const int>(expected), std::span<const int>(actual),
+                                0.0, 0.0, Fortest::Verbosity::FAIL_ONLY);
+
+    EXPECT_EQ(asserter.get_num_failed(), 1);
+    EXPECT_THAT(asserter.get_logger()->last_msg, HasSubstr("array sizes differ (3 != 2)"));
+}
@@ -1,8 +1,31 @@
 // test_assert.cpp
 #include "assert.hpp"
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <new>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Counts heap allocations made by the calling thread while enabled.
+namespace {
+    thread_local bool g_count_allocations = false;
+    thread_local int g_allocations = 0;
+}
+
+void *operator new(std::size_t size) {
+    if (g_count_allocations) ++g_allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
 
 
 // Null logger that satisfies LoggerLike but discards output
@@ -94,6 +117,29 @@ TEST_F(AssertTest, False_FailsOnTrueCondition) {
     expect_summary(0, 1);
 }
 
+// -------- Durations --------
+
+/// @test AssertDurationBelow passes within the limit and fails past it.
+TEST_F(AssertTest, DurationBelow_ComparesWallTime) {
+    int calls = 0;
+    const double fast = test_assert.assert_duration_below([&] { ++calls; }, 1.0);
+    EXPECT_LT(fast, 1.0);
+    const double slow = test_assert.assert_duration_below(
+        [&] { ++calls; std::this_thread::sleep_for(std::chrono::milliseconds(20)); }, 0.001);
+    EXPECT_GE(slow, 0.02);
+    EXPECT_EQ(calls, 2);
+    expect_summary(1, 1);
+}
+
+/// @test AssertMaxMemory passes under a generous limit and fails under a zero one.
+TEST_F(AssertTest, MaxMemory_ComparesPeakGrowth) {
+    const std::int64_t used = test_assert.assert_max_memory(std::int64_t{1} << 40);
+    EXPECT_GE(used, 0);
+    // Without tracking the limit applies to the whole process, which is resident.
+    test_assert.assert_max_memory(0);
+    expect_summary(1, 1);
+}
+
 // -------- Accumulation & Reset --------
 
 /// @test Multiple assertions accumulate pass and fail counts correctly.
@@ -201,3 +247,172 @@ TEST_F(AssertTest, Equal_FailsOutsideRelativeTolerance) {
     test_assert.assert_equal(a, b, 0.0, rel_tol);
     expect_summary(0, 1);
 }
+
+/// @test While an AssertContext is bound, assertions count into it instead of the Assert.
+TEST_F(AssertTest, BoundContextReceivesCounts) {
+    test_assert.assert_true(true);
+    {
+        Fortest::AssertContext context;
+        Fortest::AssertContext::Binding binding(context);
+        test_assert.assert_true(true);
+        test_assert.assert_equal(1, 2);
+        EXPECT_EQ(context.num_passed, 1);
+        EXPECT_EQ(context.num_failed, 1);
+        expect_summary(1, 1);
+        test_assert.reset();
+        EXPECT_EQ(context.num_passed, 0);
+    }
+    expect_summary(1, 0);
+}
+
+/// @test Contexts are per thread: another thread's binding does not see this thread's counts.
+TEST_F(AssertTest, ContextIsThreadLocal) {
+    Fortest::AssertContext context;
+    Fortest::AssertContext::Binding binding(context);
+
+    std::thread other([&] {
+        Fortest::AssertContext other_context;
+        Fortest::AssertContext::Binding other_binding(other_context);
+        test_assert.assert_true(false);
+        EXPECT_EQ(other_context.num_failed, 1);
+    });
+    other.join();
+
+    EXPECT_EQ(context.num_failed, 0);
+}
+
+/// @test String assertions compare contents, also for C strings and views.
+TEST_F(AssertTest, StringComparisonUsesContents) {
+    const char expected[] = "grid";
+    const std::string actual = "grid";
+    test_assert.assert_equal(std::string_view(expected), std::string_view(actual));
+    test_assert.assert_equal("grid", actual.c_str());
+    test_assert.assert_not_equal("grid", "mesh");
+    expect_summary(3, 0);
+}
+
+/// @test Passing assertions below Verbosity::ALL make no heap allocation.
+TEST_F(AssertTest, PassingAssertionsDoNotAllocate) {
+    const std::string long_text(100, 'x');
+    const char *c_text = long_text.c_str();
+
+    g_allocations = 0;
+    g_count_allocations = true;
+    test_assert.assert_equal(7, 7);
+    test_assert.assert_equal(1.0, 1.0 + 1e-12, 1e-9, 0.0, Fortest::Verbosity::FAIL_ONLY);
+    test_assert.assert_equal(long_text, long_text);
+    test_assert.assert_equal(c_text, c_text, 0.0, 0.0, Fortest::Verbosity::FAIL_ONLY);
+    test_assert.assert_not_equal(1, 2);
+    test_assert.assert_true(true, Fortest::Verbosity::FAIL_ONLY);
+    g_count_allocations = false;
+
+    EXPECT_EQ(g_allocations, 0);
+    expect_summary(6, 0);
+}
+
+// -------- Policies --------
+
+namespace {
+    /// Logger counting the messages it receives.
+    class CountingLogger {
+    public:
+        inline static int messages = 0;
+
+        static void log(const std::string &, const std::string &, const std::optional<std::string> & = std::nullopt) {
+            ++messages;
+        }
+    };
+}
+
+/// @test A fixed verbosity policy overrides the Verbosity arguments.
+TEST(AssertPolicies, FixedVerbosityIgnoresArguments) {
+    Fortest::Assert<CountingLogger, Fortest::FixedVerbosity<Fortest::Verbosity::QUIET>> quiet;
+    CountingLogger::messages = 0;
+    quiet.assert_equal(1, 1, 0, 0, Fortest::Verbosity::ALL);
+    quiet.assert_equal(1, 2, 0, 0, Fortest::Verbosity::ALL);
+    EXPECT_EQ(CountingLogger::messages, 0);
+    EXPECT_EQ(quiet.get_num_passed(), 1);
+    EXPECT_EQ(quiet.get_num_failed(), 1);
+
+    Fortest::Assert<CountingLogger, Fortest::FixedVerbosity<Fortest::Verbosity::ALL>> loud;
+    loud.assert_true(true);
+    EXPECT_EQ(CountingLogger::messages, 1);
+}
+
+/// @test QuietPasses never reports passes but reports failures as asked.
+TEST(AssertPolicies, QuietPassesReportsOnlyFailures) {
+    Fortest::Assert<CountingLogger, Fortest::QuietPasses> asserter;
+    CountingLogger::messages = 0;
+    asserter.assert_true(true, Fortest::Verbosity::ALL);
+    EXPECT_EQ(CountingLogger::messages, 0);
+    asserter.assert_true(false, Fortest::Verbosity::QUIET);
+    EXPECT_EQ(CountingLogger::messages, 0);
+    asserter.assert_true(false, Fortest::Verbosity::FAIL_ONLY);
+    EXPECT_EQ(CountingLogger::messages, 1);
+}
+
+/// @test LocalCounters count into the Assert even while a context is bound.
+TEST(AssertPolicies, LocalCountersIgnoreContexts) {
+    Fortest::Assert<NullLogger, Fortest::RuntimeVerbosity, Fortest::LocalCounters> local;
+    Fortest::AssertContext context;
+    Fortest::AssertContext::Binding binding(context);
+    local.assert_true(true);
+    local.assert_true(false);
+    EXPECT_EQ(local.get_num_passed(), 1);
+    EXPECT_EQ(local.get_num_failed(), 1);
+    EXPECT_EQ(context.num_passed, 0);
+    local.reset();
+    EXPECT_EQ(local.get_num_passed(), 0);
+}
+
+/// @test Threads without a bound context, like those of an OpenMP region, lose no counts.
+TEST_F(AssertTest, UnboundThreadsCountWithoutRaces) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([this, t] {
+            for (int i = 0; i < 10000; ++i) test_assert.assert_true(i % 100 != t);
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    expect_summary(8 * 9900, 8 * 100);
+
+    test_assert.reset();
+    expect_summary(0, 0);
+}
+
+/// @test Threads that bind the test's context count toward it and keep their failure messages.
+TEST_F(AssertTest, BoundContextCountsThreadsThatBindIt) {
+    Fortest::AssertContext context;
+    Fortest::AssertContext::Binding binding(context);
+    test_assert.reset();
+    test_assert.assert_true(true);
+    std::thread([this, parent = Fortest::AssertContext::current()] {
+        Fortest::AssertContext::Binding thread_binding(parent);
+        test_assert.assert_true(true);
+        test_assert.assert_equal(1, 2);
+    }).join();
+    std::thread([this] { test_assert.assert_true(false); }).join();
+
+    EXPECT_EQ(test_assert.get_num_passed(), 2);
+    EXPECT_EQ(test_assert.get_num_failed(), 1);
+    EXPECT_EQ(context.num_failed, 0);
+    EXPECT_THAT(test_assert.thread_failure_report(), ::testing::HasSubstr("\n    thread 1: "));
+
+    test_assert.reset();
+    EXPECT_EQ(test_assert.get_num_failed(), 0);
+    EXPECT_EQ(test_assert.thread_failure_report(), "");
+}
+
+/// @test A thread keeps a bounded number of failure messages and counts the rest.
+TEST_F(AssertTest, ThreadFailureReportIsBounded) {
+    constexpr int failures = 20;
+    std::thread([this] {
+        for (int i = 0; i < failures; ++i) test_assert.assert_equal(i, -1);
+    }).join();
+
+    const std::string report = test_assert.thread_failure_report();
+    EXPECT_EQ(test_assert.get_num_failed(), failures);
+    EXPECT_THAT(report, ::testing::HasSubstr(
+                            std::to_string(failures - Fortest::detail::ThreadShards::max_messages) +
+                            " more failed assertions"));
+}
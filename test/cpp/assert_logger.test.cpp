@@ -98,6 +98,25 @@ TEST_F(AssertLoggerTest, EntriesAccumulateInOrder) {
     EXPECT_EQ(entries[2].msg, "three");
 }
 
+/**
+ * @test Behavior: Only the most recent entries are kept, but the summary counts every result.
+ */
+TEST_F(AssertLoggerTest, KeepsMostRecentEntries) {
+    logger.set_max_entries(2);
+    logger.log("one", "PASS");
+    logger.log("two", "FAIL");
+    logger.log("three", "PASS");
+
+    const auto &entries = logger.entries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].msg, "two");
+    EXPECT_EQ(entries[1].msg, "three");
+
+    clear_output();
+    logger.print_summary();
+    EXPECT_THAT(get_output(), HasSubstr("2 passed, 1 failed"));
+}
+
 // -----------------------------------------------------------------------------
 // Summary behavior
 // -----------------------------------------------------------------------------
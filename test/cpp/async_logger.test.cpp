@@ -0,0 +1,201 @@
+#include "async_logger.hpp"
+#include "fork_runner.hpp"
+#include "g_assert.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::testing::HasSubstr;
+
+/**
+ * @test Behavior: An AsyncLogger produces exactly the output of a Logger.
+ */
+TEST(AsyncLoggerBehavior, OutputMatchesSynchronousLogger) {
+    std::ostringstream sync_buffer;
+    std::ostringstream async_buffer;
+    Fortest::Logger sync_logger(sync_buffer, "====");
+    Fortest::AsyncLogger async_logger(async_buffer, Fortest::AsyncWriter::default_capacity, "====");
+
+    for (auto *tag: {"PASS", "FAIL", "INFO", "CRASH", "OTHER"}) {
+        sync_logger.log(std::string("message ") + tag, tag);
+        async_logger.log(std::string("message ") + tag, tag);
+    }
+    sync_logger.log("override", "INFO", Fortest::test_border());
+    async_logger.log("override", "INFO", Fortest::test_border());
+    async_logger.flush();
+
+    EXPECT_EQ(async_buffer.str(), sync_buffer.str());
+}
+
+/**
+ * @test Behavior: A failure is on the stream as soon as log() returns.
+ */
+TEST(AsyncLoggerBehavior, FailureIsFlushedBeforeLogReturns) {
+    std::ostringstream buffer;
+    Fortest::AsyncLogger logger(buffer);
+
+    logger.log("first", "INFO");
+    logger.log("it broke", "FAIL");
+
+    const std::string out = buffer.str();
+    EXPECT_THAT(out, HasSubstr("[INFO] first"));
+    EXPECT_THAT(out, HasSubstr("[FAIL] it broke"));
+}
+
+/**
+ * @test Behavior: Destroying the logger writes everything still queued.
+ */
+TEST(AsyncLoggerBehavior, DestructorFlushesPendingOutput) {
+    std::ostringstream buffer;
+    {
+        Fortest::AsyncLogger logger(buffer);
+        for (int i = 0; i < 100; ++i) {
+            logger.log("line " + std::to_string(i), "INFO");
+        }
+    }
+    EXPECT_THAT(buffer.str(), HasSubstr("[INFO] line 99"));
+}
+
+/**
+ * @test Behavior: Messages from concurrent threads are never interleaved.
+ */
+TEST(AsyncLoggerBehavior, ConcurrentMessagesAreNotTorn) {
+    std::ostringstream buffer;
+    Fortest::AsyncLogger logger(buffer, 1024);
+    constexpr int threads = 4;
+    constexpr int per_thread = 500;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                logger.log("thread " + std::to_string(t) + " message " + std::to_string(i), "OTHER");
+            }
+        });
+    }
+    for (auto &worker: workers) worker.join();
+    logger.flush();
+
+    std::istringstream lines(buffer.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_THAT(line, ::testing::MatchesRegex("thread [0-9] message [0-9]+"));
+        ++count;
+    }
+    EXPECT_EQ(count, threads * per_thread);
+}
+
+/**
+ * @test Behavior: A small buffer wraps around and keeps messages in order.
+ */
+TEST(AsyncLoggerBehavior, SmallBufferWrapsAroundInOrder) {
+    std::ostringstream buffer;
+    std::ostringstream expected;
+    Fortest::AsyncWriter writer(buffer, 256);
+    EXPECT_EQ(writer.capacity(), 256u);
+
+    for (int i = 0; i < 1000; ++i) {
+        const std::string line = "entry " + std::to_string(i) + "\n";
+        writer.write(line);
+        expected << line;
+    }
+    writer.flush();
+
+    EXPECT_EQ(buffer.str(), expected.str());
+}
+
+/**
+ * @test Behavior: A message larger than the buffer is written intact, after earlier ones.
+ */
+TEST(AsyncLoggerBehavior, OversizedMessageIsWrittenInOrder) {
+    std::ostringstream buffer;
+    Fortest::AsyncWriter writer(buffer, 256);
+    const std::string big(10000, 'x');
+
+    writer.write("before\n");
+    writer.write(big);
+    writer.write("\nafter\n");
+    writer.flush();
+
+    EXPECT_EQ(buffer.str(), "before\n" + big + "\nafter\n");
+}
+
+/**
+ * @test Behavior: An AsyncAssertLogger records entries and prints like an AssertLogger.
+ */
+TEST(AsyncLoggerBehavior, AssertLoggerRecordsAndPrints) {
+    std::ostringstream buffer;
+    Fortest::Assert<Fortest::AsyncAssertLogger, Fortest::RuntimeVerbosity> asserter(buffer, false);
+
+    asserter.assert_true(true, Fortest::Verbosity::ALL);
+    asserter.assert_equal(1, 2, 0, 0, Fortest::Verbosity::FAIL_ONLY);
+
+    EXPECT_EQ(buffer.str(),
+              "[ASSERT][PASS] condition is true\n"
+              "[ASSERT][FAIL] values are not equal (1 != 2)\n");
+    EXPECT_EQ(asserter.get_logger()->entries().size(), 2u);
+}
+
+/**
+ * @test Behavior: In a forked child the logger writes synchronously.
+ */
+TEST(AsyncLoggerBehavior, ForkedChildWritesSynchronously) {
+    std::ostringstream buffer;
+    Fortest::AsyncLogger logger(buffer);
+    logger.log("parent", "INFO");
+
+    Fortest::ForkRunner runner(1);
+    Fortest::ForkRunner::Result result;
+    runner.submit(
+        [&](const Fortest::ForkRunner::Writer &writer) {
+            logger.log("child", "INFO");
+            writer.write(0, buffer.str().find("[INFO] child") != std::string::npos);
+        },
+        [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    runner.wait();
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::Exited);
+    ASSERT_EQ(result.records.size(), 1u);
+    EXPECT_EQ(result.records[0].value, 1);
+    logger.log("parent again", "FAIL");
+    EXPECT_THAT(buffer.str(), HasSubstr("[FAIL] parent again"));
+}
+
+/**
+ * @test Behavior: Queued output is flushed when std::terminate is called.
+ */
+TEST(AsyncLoggerDeathTest, TerminateFlushesPendingOutput) {
+    EXPECT_DEATH(
+        {
+            Fortest::AsyncLogger logger(std::cerr);
+            for (int i = 0; i < 1000; ++i) {
+                logger.log("queued " + std::to_string(i), "INFO");
+            }
+            std::terminate();
+        },
+        "queued 999");
+}
+
+/**
+ * @test Behavior: set_async_logging routes all global loggers through one writer.
+ */
+TEST(AsyncLoggerBehavior, GlobalLoggersShareOneWriter) {
+    Fortest::set_async_logging(true);
+    const auto writer = Fortest::global_async_writer();
+    ASSERT_NE(writer, nullptr);
+    EXPECT_EQ(Fortest::GlobalLogger::instance()->get_async_writer(), writer);
+    EXPECT_EQ(Fortest::GlobalAssertLogger::instance()->get_async_writer(), writer);
+    EXPECT_EQ(Fortest::GlobalAssert::instance()->get_logger()->get_async_writer(), writer);
+
+    Fortest::set_async_logging(false);
+    EXPECT_EQ(Fortest::global_async_writer(), nullptr);
+    EXPECT_EQ(Fortest::GlobalLogger::instance()->get_async_writer(), nullptr);
+    EXPECT_EQ(Fortest::GlobalAssert::instance()->get_logger()->get_async_writer(), nullptr);
+}
@@ -0,0 +1,100 @@
+#include "benchmark.hpp"
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <vector>
+
+namespace {
+    Fortest::BenchmarkStats run_stats(double mean_ns, double stddev_ns, std::size_t repetitions = 10) {
+        Fortest::BenchmarkStats stats;
+        stats.repetitions = repetitions;
+        stats.iterations = 1000;
+        stats.median_ns = stats.mean_ns = mean_ns;
+        stats.min_ns = mean_ns - stddev_ns;
+        stats.stddev_ns = stddev_ns;
+        return stats;
+    }
+}
+
+/**
+ * @brief Behavior: Statistics are taken over the per-call sample times.
+ */
+TEST(BenchmarkStatsBehavior, SummarizesSamples) {
+    const auto stats = Fortest::BenchmarkStats::from_samples({40.0, 10.0, 30.0, 20.0}, 8, 2.0);
+    EXPECT_EQ(stats.iterations, 8u);
+    EXPECT_EQ(stats.repetitions, 4u);
+    EXPECT_DOUBLE_EQ(stats.min_ns, 10.0);
+    EXPECT_DOUBLE_EQ(stats.median_ns, 25.0);
+    EXPECT_DOUBLE_EQ(stats.mean_ns, 25.0);
+    EXPECT_NEAR(stats.stddev_ns, 12.9099, 1e-4);
+    EXPECT_DOUBLE_EQ(stats.throughput, 2.0 * 1e9 / 25.0);
+
+    const auto single = Fortest::BenchmarkStats::from_samples({7.0}, 1, 1.0);
+    EXPECT_DOUBLE_EQ(single.median_ns, 7.0);
+    EXPECT_DOUBLE_EQ(single.stddev_ns, 0.0);
+}
+
+/**
+ * @brief Behavior: Warmup calls are extra, and every sample makes the same number of calls.
+ */
+TEST(BenchmarkBehavior, CallsWarmupThenEqualSamples) {
+    std::size_t calls = 0;
+    const Fortest::BenchmarkOptions options{.warmup = 3, .repetitions = 5, .min_time_seconds = 0.0};
+    const auto stats = Fortest::measure_benchmark([&] { ++calls; }, options);
+    // No minimum time: one calibration call, then one call per sample.
+    EXPECT_EQ(stats.iterations, 1u);
+    EXPECT_EQ(stats.repetitions, 5u);
+    EXPECT_EQ(calls, 3u + 1u + 5u);
+}
+
+/**
+ * @brief Behavior: Short calls are batched until a sample lasts its share of the minimum time.
+ */
+TEST(BenchmarkBehavior, ScalesIterationsToMinimumTime) {
+    volatile std::size_t sink = 0;
+    const Fortest::BenchmarkOptions options{.warmup = 0, .repetitions = 4, .min_time_seconds = 0.02};
+    const auto stats = Fortest::measure_benchmark([&] { sink = sink + 1; }, options);
+    EXPECT_GT(stats.iterations, 1000u);
+    EXPECT_EQ(stats.repetitions, 4u);
+    EXPECT_GT(stats.median_ns, 0.0);
+    EXPECT_GE(stats.median_ns, stats.min_ns);
+
+    const Fortest::BenchmarkOptions capped{.warmup = 0, .repetitions = 2, .min_time_seconds = 10.0,
+                                           .max_iterations = 64};
+    EXPECT_EQ(Fortest::measure_benchmark([&] { sink = sink + 1; }, capped).iterations, 64u);
+}
+
+/**
+ * @brief Behavior: The t-test tail matches tabulated critical values.
+ */
+TEST(BaselineComparisonBehavior, StudentTailMatchesTables) {
+    EXPECT_NEAR(Fortest::detail::student_t_upper_tail(2.015, 5.0), 0.05, 5e-4);
+    EXPECT_NEAR(Fortest::detail::student_t_upper_tail(2.764, 10.0), 0.01, 1e-4);
+    EXPECT_NEAR(Fortest::detail::student_t_upper_tail(0.0, 7.0), 0.5, 1e-12);
+    EXPECT_NEAR(Fortest::detail::student_t_upper_tail(-2.015, 5.0), 0.95, 5e-4);
+}
+
+/**
+ * @brief Behavior: Only a slowdown past the threshold that is also significant regresses.
+ */
+TEST(BaselineComparisonBehavior, FailsOnSignificantSlowdown) {
+    const std::vector<Fortest::BenchmarkStats> baseline{run_stats(100.0, 2.0), run_stats(102.0, 2.0),
+                                                        run_stats(98.0, 2.0)};
+    const Fortest::RegressionOptions options{.max_slowdown_percent = 10.0, .significance = 0.05};
+
+    const auto slower = Fortest::compare_with_baseline(run_stats(130.0, 2.0), baseline, options);
+    EXPECT_DOUBLE_EQ(slower.baseline_median_ns, 100.0);
+    EXPECT_DOUBLE_EQ(slower.slowdown_percent, 30.0);
+    EXPECT_LT(slower.p_value, 1e-6);
+    EXPECT_TRUE(slower.regressed);
+
+    // Within the allowed slowdown, however significant.
+    EXPECT_FALSE(Fortest::compare_with_baseline(run_stats(105.0, 0.1), baseline, options).regressed);
+    // Past the threshold, but lost in the noise.
+    const auto noisy = Fortest::compare_with_baseline(run_stats(120.0, 60.0, 3), baseline, options);
+    EXPECT_GT(noisy.p_value, 0.05);
+    EXPECT_FALSE(noisy.regressed);
+    // Faster, and no history.
+    EXPECT_FALSE(Fortest::compare_with_baseline(run_stats(50.0, 2.0), baseline, options).regressed);
+    EXPECT_FALSE(Fortest::compare_with_baseline(run_stats(500.0, 2.0), {}, options).regressed);
+}
@@ -0,0 +1,60 @@
+#include "case_distributor.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using ::testing::ElementsAre;
+
+/**
+ * @test Behavior: Guided chunks shrink with the remaining work and never drop below one.
+ */
+TEST(CaseDistributorBehavior, GuidedChunksShrink) {
+    EXPECT_EQ(Fortest::guided_chunk_size(1000, 4), 125u);
+    EXPECT_EQ(Fortest::guided_chunk_size(10, 4), 1u);
+    EXPECT_EQ(Fortest::guided_chunk_size(1000, 4, 64), 64u);
+    EXPECT_EQ(Fortest::guided_chunk_size(3, 4, 64), 3u);
+}
+
+/**
+ * @test Behavior: A single worker gets contiguous, shrinking chunks covering every case.
+ */
+TEST(CaseDistributorBehavior, ChunksCoverTheCasesInOrder) {
+    Fortest::LocalCaseDistributor cases(16, 2);
+
+    std::vector<std::size_t> sizes;
+    std::size_t next = 0;
+    while (const auto chunk = cases.next()) {
+        EXPECT_EQ(chunk->begin, next);
+        sizes.push_back(chunk->end - chunk->begin);
+        next = chunk->end;
+    }
+    EXPECT_EQ(next, 16u);
+    EXPECT_THAT(sizes, ElementsAre(4, 3, 2, 1, 1, 1, 1, 1, 1, 1));
+    EXPECT_FALSE(cases.next().has_value());
+}
+
+/**
+ * @test Behavior: Concurrent workers draw every case exactly once.
+ */
+TEST(CaseDistributorBehavior, ConcurrentWorkersDrawEachCaseOnce) {
+    constexpr std::size_t num_cases = 100'003;
+    Fortest::LocalCaseDistributor cases(num_cases, 4);
+    std::vector<std::atomic<int>> drawn(num_cases);
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&] {
+            while (const auto chunk = cases.next()) {
+                for (std::size_t k = chunk->begin; k < chunk->end; ++k) drawn[k].fetch_add(1);
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+
+    for (std::size_t k = 0; k < num_cases; ++k) {
+        ASSERT_EQ(drawn[k].load(), 1) << "case " << k;
+    }
+}
@@ -0,0 +1,145 @@
+#include "events.hpp"
+#include "assert.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::testing::HasSubstr;
+
+namespace {
+    /// Sink recording the kinds and texts of the events it sees.
+    class RecordingSink final : public Fortest::EventSink {
+        std::mutex m_mutex;
+
+    public:
+        std::vector<Fortest::EventKind> kinds;
+        std::vector<std::string> texts;
+
+        void on_event(const Fortest::Event &event) override {
+            std::lock_guard lock(m_mutex);
+            kinds.push_back(event.kind);
+            texts.emplace_back(event.text);
+        }
+    };
+
+    /// Assertion logger that drops its messages.
+    class SilentLogger {
+    public:
+        static void log(const std::string &, const std::string &, const std::optional<std::string> & = std::nullopt) {}
+    };
+}
+
+/**
+ * @brief Behavior: Sinks receive the events published while they are subscribed, in order.
+ */
+TEST(EventBusBehavior, DeliversToSubscribedSinks) {
+    Fortest::EventBus bus;
+    EXPECT_FALSE(bus.has_subscribers());
+    bus.publish(Fortest::Event{.kind = Fortest::EventKind::SessionStarted});
+
+    auto sink = std::make_shared<RecordingSink>();
+    {
+        const auto subscription = bus.scoped(sink);
+        EXPECT_TRUE(bus.has_subscribers());
+        bus.publish(Fortest::Event{.kind = Fortest::EventKind::SuiteStarted, .suite = "Mesh"});
+        bus.publish(Fortest::Event{.kind = Fortest::EventKind::AssertionFailed, .text = "1 != 2"});
+    }
+    EXPECT_FALSE(bus.has_subscribers());
+    bus.publish(Fortest::Event{.kind = Fortest::EventKind::SessionFinished});
+
+    ASSERT_EQ(sink->kinds.size(), 2u);
+    EXPECT_EQ(sink->kinds[0], Fortest::EventKind::SuiteStarted);
+    EXPECT_EQ(sink->kinds[1], Fortest::EventKind::AssertionFailed);
+    EXPECT_EQ(sink->texts[1], "1 != 2");
+}
+
+/**
+ * @brief Behavior: Subscribing while other threads publish is safe, and no event is lost by the counter.
+ */
+TEST(EventBusBehavior, ConcurrentPublishersAndSubscribers) {
+    Fortest::EventBus bus;
+    auto counter = std::make_shared<Fortest::EventCounter>();
+    bus.subscribe(counter);
+    Fortest::TestTiming timing;
+    timing.body_ns = 10;
+
+    std::atomic<bool> done{false};
+    std::thread churn([&] {
+        while (!done.load()) {
+            const auto subscription = bus.scoped(std::make_shared<RecordingSink>());
+        }
+    });
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 4; ++t) {
+        publishers.emplace_back([&] {
+            for (int i = 0; i < 500; ++i) {
+                bus.publish(Fortest::Event{.kind = Fortest::EventKind::TestFinished,
+                                           .status = i % 5 == 0 ? "FAIL" : "PASS",
+                                           .timing = &timing});
+            }
+        });
+    }
+    for (auto &thread: publishers) thread.join();
+    done = true;
+    churn.join();
+
+    EXPECT_EQ(counter->finished(), 2000);
+    EXPECT_EQ(counter->failed(), 400);
+    EXPECT_EQ(counter->passed(), 1600);
+    EXPECT_EQ(counter->body_ns(), 20000);
+}
+
+/**
+ * @brief Behavior: The text sink formats events as tagged log lines.
+ */
+TEST(EventBusBehavior, LoggerSinkFormatsEvents) {
+    std::ostringstream text;
+    Fortest::LoggerEventSink sink(std::make_shared<Fortest::Logger>(text));
+    Fortest::TestTiming timing;
+    sink.on_event(Fortest::Event{.kind = Fortest::EventKind::SuiteStarted, .suite = "Mesh"});
+    sink.on_event(Fortest::Event{.kind = Fortest::EventKind::TestFinished, .suite = "Mesh", .test = "refine",
+                                 .status = "CRASH", .timing = &timing});
+    sink.on_event(Fortest::Event{.kind = Fortest::EventKind::SessionFinished, .value = 1});
+
+    EXPECT_THAT(text.str(), HasSubstr("[INFO] Running test suite: Mesh"));
+    EXPECT_THAT(text.str(), HasSubstr("[CRASH] Mesh.refine"));
+    EXPECT_THAT(text.str(), HasSubstr("[INFO] Finished test session: 1 failed"));
+}
+
+/**
+ * @brief Behavior: Failed assertions are published on the global bus, even when not logged.
+ */
+TEST(EventBusBehavior, FailedAssertionsArePublished) {
+    Fortest::Assert<SilentLogger> check;
+    auto sink = std::make_shared<RecordingSink>();
+    const auto subscription = Fortest::EventBus::global().scoped(sink);
+
+    check.assert_equal(1, 1);
+    check.assert_equal(1, 2);
+
+    ASSERT_EQ(sink->kinds.size(), 1u);
+    EXPECT_EQ(sink->kinds[0], Fortest::EventKind::AssertionFailed);
+    EXPECT_FALSE(sink->texts[0].empty());
+}
+
+/**
+ * @brief Behavior: Tag strings map to the typed tags; both log overloads format alike.
+ */
+TEST(EventBusBehavior, LoggerTagsAreTyped) {
+    EXPECT_EQ(Fortest::Logger::tag_of("TIMEOUT"), Fortest::Logger::Tag::Timeout);
+    EXPECT_EQ(Fortest::Logger::tag_of("unknown"), Fortest::Logger::Tag::Plain);
+    EXPECT_EQ(Fortest::Logger::tag_name(Fortest::Logger::Tag::Fail), "FAIL");
+
+    std::ostringstream by_string;
+    std::ostringstream by_tag;
+    Fortest::Logger(by_string).log("msg", "PASS");
+    Fortest::Logger(by_tag).log("msg", Fortest::Logger::Tag::Pass);
+    EXPECT_EQ(by_string.str(), by_tag.str());
+}
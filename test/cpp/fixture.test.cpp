@@ -105,3 +105,40 @@ TEST_F(FixtureTest, NullSetupAndTeardownDoNothing) {
         f.teardown();
     });
 }
+
+/**
+ * @test Behavior: A shared fixture is set up by the first acquire() and torn down by the last release().
+ */
+TEST_F(FixtureTest, SharedFixtureLivesFromFirstUseToLastRelease) {
+    int setups = 0;
+    int teardowns = 0;
+    Fortest::Fixture<void> f([&](void *) { ++setups; }, [&](void *) { ++teardowns; }, nullptr,
+                             Fortest::Scope::Suite);
+    Fortest::SharedFixture shared;
+
+    shared.open(&f, 2);
+    EXPECT_EQ(setups, 0);
+    shared.acquire();
+    shared.acquire();
+    EXPECT_EQ(setups, 1);
+    shared.release();
+    EXPECT_EQ(teardowns, 0);
+    shared.release();
+    EXPECT_EQ(teardowns, 1);
+    EXPECT_FALSE(shared.active());
+}
+
+/**
+ * @test Behavior: A shared fixture nobody acquired is never set up or torn down.
+ */
+TEST_F(FixtureTest, UnusedSharedFixtureIsNeverSetUp) {
+    int calls = 0;
+    Fortest::Fixture<void> f([&](void *) { ++calls; }, [&](void *) { ++calls; }, nullptr,
+                             Fortest::Scope::Suite);
+    Fortest::SharedFixture shared;
+
+    shared.open(&f, 1);
+    shared.release();
+
+    EXPECT_EQ(calls, 0);
+}
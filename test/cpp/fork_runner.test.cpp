@@ -0,0 +1,210 @@
+#include "fork_runner.hpp"
+#include "logging.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Behavior: A job that finishes normally is Exited with all its records.
+ */
+TEST(ForkRunnerBehavior, ExitedJobDeliversRecords) {
+    Fortest::ForkRunner runner(2);
+    Fortest::ForkRunner::Result result;
+
+    runner.submit(
+        [](const Fortest::ForkRunner::Writer &writer) {
+            for (int i = 0; i < 3; ++i) writer.write(i, i * 10);
+        },
+        [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    runner.wait();
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::Exited);
+    ASSERT_EQ(result.records.size(), 3u);
+    EXPECT_EQ(result.records[2].key, 2);
+    EXPECT_EQ(result.records[2].value, 20);
+}
+
+/**
+ * @brief Behavior: A child killed by a signal is reported as Crashed with that signal.
+ */
+TEST(ForkRunnerBehavior, SignalIsReportedAsCrash) {
+    Fortest::ForkRunner runner(1);
+    Fortest::ForkRunner::Result result;
+
+    runner.submit([](const Fortest::ForkRunner::Writer &) { std::raise(SIGSEGV); },
+                  [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    runner.wait();
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::Crashed);
+    EXPECT_EQ(result.signal, SIGSEGV);
+}
+
+/**
+ * @brief Behavior: Exiting before the job finished (e.g. error stop) is a crash.
+ */
+TEST(ForkRunnerBehavior, EarlyExitIsReportedAsCrash) {
+    Fortest::ForkRunner runner(1);
+    Fortest::ForkRunner::Result result;
+
+    runner.submit(
+        [](const Fortest::ForkRunner::Writer &writer) {
+            writer.write(1, 1);
+            std::exit(0);
+        },
+        [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    runner.wait();
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::Crashed);
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.records.size(), 1u);
+}
+
+/**
+ * @brief Behavior: An exception escaping the body is a crash, not a parent failure.
+ */
+TEST(ForkRunnerBehavior, ExceptionIsReportedAsCrash) {
+    Fortest::ForkRunner runner(1);
+    Fortest::ForkRunner::Result result;
+
+    runner.submit([](const Fortest::ForkRunner::Writer &) { throw std::runtime_error("boom"); },
+                  [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    EXPECT_NO_THROW(runner.wait());
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::Crashed);
+    EXPECT_NE(result.exit_code, 0);
+}
+
+/**
+ * @brief Behavior: A job exceeding the timeout is killed and reported as TimedOut.
+ */
+TEST(ForkRunnerBehavior, HangingJobTimesOut) {
+    Fortest::ForkRunner runner(1, 0.2);
+    Fortest::ForkRunner::Result result;
+
+    runner.submit(
+        [](const Fortest::ForkRunner::Writer &) {
+            std::this_thread::sleep_for(std::chrono::seconds(30));
+        },
+        [&](const Fortest::ForkRunner::Result &r) { result = r; });
+    runner.wait();
+
+    EXPECT_EQ(result.outcome, Fortest::ForkRunner::Outcome::TimedOut);
+}
+
+/**
+ * @brief Behavior: A job's own timeout overrides the runner's.
+ */
+TEST(ForkRunnerBehavior, JobTimeoutOverridesRunnerTimeout) {
+    Fortest::ForkRunner runner(2, 0.0);
+    Fortest::ForkRunner::Result limited;
+    Fortest::ForkRunner::Result unlimited;
+
+    runner.submit(
+        [](const Fortest::ForkRunner::Writer &) {
+            std::this_thread::sleep_for(std::chrono::seconds(30));
+        },
+        [&](const Fortest::ForkRunner::Result &r) { limited = r; }, 0.2);
+    runner.submit(
+        [](const Fortest::ForkRunner::Writer &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        },
+        [&](const Fortest::ForkRunner::Result &r) { unlimited = r; });
+    runner.wait();
+
+    EXPECT_EQ(limited.outcome, Fortest::ForkRunner::Outcome::TimedOut);
+    EXPECT_EQ(unlimited.outcome, Fortest::ForkRunner::Outcome::Exited);
+}
+
+/**
+ * @brief Behavior: Children have private copies of global state.
+ */
+TEST(ForkRunnerBehavior, ChildrenDoNotShareGlobalState) {
+    static int counter = 0;
+    Fortest::ForkRunner runner(4);
+    std::vector<int> seen;
+
+    for (int i = 0; i < 8; ++i) {
+        runner.submit(
+            [](const Fortest::ForkRunner::Writer &writer) { writer.write(0, ++counter); },
+            [&](const Fortest::ForkRunner::Result &r) { seen.push_back(r.records.at(0).value); });
+    }
+    runner.wait();
+
+    EXPECT_EQ(counter, 0);
+    ASSERT_EQ(seen.size(), 8u);
+    for (int value : seen) EXPECT_EQ(value, 1);
+}
+
+/**
+ * @brief Behavior: Completions may queue further jobs, which wait() also runs.
+ */
+TEST(ForkRunnerBehavior, CompletionsCanSubmitJobs) {
+    Fortest::ForkRunner runner(2);
+    int completed = 0;
+
+    runner.submit([](const Fortest::ForkRunner::Writer &) {},
+                  [&](const Fortest::ForkRunner::Result &) {
+                      ++completed;
+                      runner.submit([](const Fortest::ForkRunner::Writer &) {},
+                                    [&](const Fortest::ForkRunner::Result &) { ++completed; });
+                  });
+    runner.wait();
+
+    EXPECT_EQ(completed, 2);
+}
+
+/**
+ * @brief Behavior: Once the stop condition holds, queued jobs are cancelled without forking.
+ */
+TEST(ForkRunnerBehavior, StopConditionCancelsQueuedJobs) {
+    Fortest::ForkRunner runner(1);
+    std::vector<Fortest::ForkRunner::Outcome> outcomes;
+    bool stop = false;
+    runner.stop_when([&] { return stop; });
+
+    for (int i = 0; i < 3; ++i) {
+        runner.submit([](const Fortest::ForkRunner::Writer &) {},
+                      [&](const Fortest::ForkRunner::Result &r) {
+                          outcomes.push_back(r.outcome);
+                          stop = true;
+                      });
+    }
+    runner.wait();
+
+    ASSERT_EQ(outcomes.size(), 3u);
+    EXPECT_EQ(outcomes[0], Fortest::ForkRunner::Outcome::Exited);
+    EXPECT_EQ(outcomes[1], Fortest::ForkRunner::Outcome::Cancelled);
+    EXPECT_EQ(outcomes[2], Fortest::ForkRunner::Outcome::Cancelled);
+}
+
+/**
+ * @brief Behavior: A child can log although another thread of the parent
+ * was logging when it was forked.
+ */
+TEST(ForkRunnerBehavior, ChildLogsWhileParentThreadsLog) {
+    std::ostream discard(nullptr);
+    Fortest::Logger logger(discard);
+    std::atomic<bool> stop{false};
+    std::thread chatter([&] {
+        while (!stop.load()) logger.log("parent", "INFO");
+    });
+
+    Fortest::ForkRunner runner(4, 2.0);
+    std::vector<Fortest::ForkRunner::Outcome> outcomes;
+    for (int i = 0; i < 40; ++i) {
+        runner.submit([&](const Fortest::ForkRunner::Writer &) { logger.log("child", "INFO"); },
+                      [&](const Fortest::ForkRunner::Result &r) { outcomes.push_back(r.outcome); });
+    }
+    runner.wait();
+    stop = true;
+    chatter.join();
+
+    ASSERT_EQ(outcomes.size(), 40u);
+    for (const auto outcome: outcomes) EXPECT_EQ(outcome, Fortest::ForkRunner::Outcome::Exited);
+}
@@ -0,0 +1,102 @@
+#include "mapped_file.hpp"
+#include "fork_runner.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief Write `values` to `path` as raw doubles.
+    void write_doubles(const std::string &path, const std::vector<double> &values) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(values.data()),
+                  static_cast<std::streamsize>(values.size() * sizeof(double)));
+    }
+}
+
+/**
+ * @brief Behavior: A mapped file exposes the file's bytes without copying them.
+ */
+TEST(MappedFileBehavior, MapsFileContents) {
+    const std::string path = "mapped_file_contents.bin";
+    write_doubles(path, {1.0, 2.5, -3.0});
+
+    Fortest::MappedFile file(path);
+    const auto values = file.as<double>();
+
+    ASSERT_EQ(file.size(), 3 * sizeof(double));
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_EQ(values[0], 1.0);
+    EXPECT_EQ(values[1], 2.5);
+    EXPECT_EQ(values[2], -3.0);
+    file.close();
+    EXPECT_EQ(file.data(), nullptr);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Behavior: An empty file maps to no data, and a missing file throws.
+ */
+TEST(MappedFileBehavior, EmptyAndMissingFiles) {
+    const std::string path = "mapped_file_empty.bin";
+    write_doubles(path, {});
+
+    Fortest::MappedFile file(path);
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0u);
+    EXPECT_TRUE(file.as<double>().empty());
+    std::remove(path.c_str());
+
+    EXPECT_THROW(Fortest::MappedFile("mapped_file_missing.bin"), std::runtime_error);
+}
+
+/**
+ * @brief Behavior: The fixture publishes the mapping while set up and clears it on teardown.
+ */
+TEST(MappedFileBehavior, FixturePublishesMapping) {
+    const std::string path = "mapped_file_fixture.bin";
+    write_doubles(path, {4.0, 5.0});
+    Fortest::MappedView view;
+
+    const auto fixture = Fortest::mapped_file_fixture(path, &view);
+    EXPECT_EQ(fixture.get_scope(), Fortest::Scope::Suite);
+    EXPECT_EQ(fixture.get_args(), &view);
+
+    fixture.setup();
+    ASSERT_NE(view.data, nullptr);
+    EXPECT_EQ(view.size, 2 * sizeof(double));
+    EXPECT_EQ(static_cast<const double *>(view.data)[1], 5.0);
+
+    fixture.teardown();
+    EXPECT_EQ(view.data, nullptr);
+    EXPECT_EQ(view.size, 0u);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Behavior: Forked children read the mapping set up by the parent.
+ */
+TEST(MappedFileBehavior, ChildrenInheritMapping) {
+    const std::string path = "mapped_file_children.bin";
+    write_doubles(path, {0.0, 1.0, 2.0, 3.0});
+    Fortest::MappedFile file(path);
+    Fortest::ForkRunner runner(2);
+    std::vector<std::int64_t> seen;
+
+    for (int i = 0; i < 4; ++i) {
+        runner.submit(
+            [&file, i](const Fortest::ForkRunner::Writer &writer) {
+                writer.write(0, static_cast<std::int64_t>(file.as<double>()[i]));
+            },
+            [&](const Fortest::ForkRunner::Result &r) { seen.push_back(r.records.at(0).value); });
+    }
+    runner.wait();
+
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen, (std::vector<std::int64_t>{0, 1, 2, 3}));
+    std::remove(path.c_str());
+}
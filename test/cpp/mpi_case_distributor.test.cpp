@@ -0,0 +1,99 @@
+#include "mpi_case_distributor.hpp"
+#include "test_session.hpp"
+#include "assert.hpp"
+#include "logging.hpp"
+
+#include <mpi.h>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+    /// Runs a session whose parameterized test is shared by all ranks of MPI_COMM_WORLD.
+    class MpiCaseDistributorBehavior : public ::testing::Test {
+    protected:
+        std::ostringstream buffer;
+        std::shared_ptr<Fortest::Logger> logger = std::make_shared<Fortest::Logger>(buffer);
+        Fortest::Assert<Fortest::Logger> assert_obj{static_cast<std::ostream &>(buffer)};
+
+        /// Number of times each case ran on this rank.
+        std::vector<int> run_sweep(std::size_t num_workers, std::size_t chunk_size, int num_cases,
+                                   Fortest::TestSession<Fortest::Logger> &session) {
+            std::vector<int> runs(num_cases);
+            std::mutex mutex;
+            session.set_options(Fortest::RunOptions{
+                .num_workers = num_workers, .chunk_size = chunk_size, .results_db = ""});
+            session.set_case_distribution(Fortest::mpi_case_distribution(MPI_COMM_WORLD));
+            auto &suite = session.add_test_suite("Sweep");
+            suite.register_parameterized_test("cases", [&](void *, void *, void *, int idx) {
+                {
+                    std::lock_guard lock(mutex);
+                    ++runs[idx];
+                }
+                assert_obj.assert_true(idx % 10 != 3);
+            }, Fortest::ParameterSpace::range(0, num_cases - 1));
+            suite.register_parameterized_test("empty", [](void *, void *, void *, int) {},
+                                              Fortest::ParameterSpace::range(1, 0));
+            session.run(logger);
+            return runs;
+        }
+    };
+
+    /// Expect every case to have run exactly once over all ranks.
+    void expect_each_case_once(std::vector<int> runs) {
+        MPI_Allreduce(MPI_IN_PLACE, runs.data(), static_cast<int>(runs.size()), MPI_INT, MPI_SUM,
+                      MPI_COMM_WORLD);
+        for (std::size_t k = 0; k < runs.size(); ++k) {
+            ASSERT_EQ(runs[k], 1) << "case " << k;
+        }
+    }
+}
+
+/**
+ * @test Behavior: Ranks split the cases and all of them end up with every status.
+ */
+TEST_F(MpiCaseDistributorBehavior, SerialRanksShareCases) {
+    Fortest::TestSession<Fortest::Logger> session(assert_obj);
+    const auto runs = run_sweep(1, 0, 1000, session);
+
+    expect_each_case_once(runs);
+    const auto &ptest = session.find_suite("Sweep").get_registry().parameterized(0);
+    EXPECT_EQ(ptest.get_status_counts().failed(), 100);
+    EXPECT_EQ(ptest.get_status_counts().passed(), 900);
+    EXPECT_EQ(ptest.get_status(13), Fortest::ParameterizedTest::Status::FAIL);
+    EXPECT_EQ(ptest.get_status(14), Fortest::ParameterizedTest::Status::PASS);
+    EXPECT_EQ(session.get_status_counts().failed(), 1);
+    EXPECT_EQ(session.get_status_counts().not_run(), 1);
+}
+
+/**
+ * @test Behavior: Worker threads on every rank draw chunks of fixed size from the shared counter.
+ */
+TEST_F(MpiCaseDistributorBehavior, ThreadedRanksShareCases) {
+    Fortest::TestSession<Fortest::Logger> session(assert_obj);
+    const auto runs = run_sweep(3, 7, 5000, session);
+
+    expect_each_case_once(runs);
+    const auto &ptest = session.find_suite("Sweep").get_registry().parameterized(0);
+    EXPECT_EQ(ptest.get_status_counts().passed(), 4500);
+    EXPECT_EQ(session.find_suite("Sweep").get_status("cases"), std::optional(Fortest::Test::Status::FAIL));
+}
+
+int main(int argc, char **argv) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    ::testing::InitGoogleTest(&argc, argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+        auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+    const int result = RUN_ALL_TESTS();
+    int worst = result;
+    MPI_Allreduce(&result, &worst, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return worst;
+}
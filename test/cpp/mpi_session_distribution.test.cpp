@@ -0,0 +1,170 @@
+#include "mpi_session_distribution.hpp"
+#include "test_session.hpp"
+#include "assert.hpp"
+#include "logging.hpp"
+
+#include <mpi.h>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ::testing::HasSubstr;
+
+namespace {
+    /// Runs one session spread over all ranks of MPI_COMM_WORLD.
+    class MpiSessionDistributionBehavior : public ::testing::Test {
+    protected:
+        std::ostringstream buffer;
+        std::shared_ptr<Fortest::Logger> logger = std::make_shared<Fortest::Logger>(buffer);
+        Fortest::Assert<Fortest::Logger> assert_obj{static_cast<std::ostream &>(buffer)};
+        int rank = 0;
+        int size = 1;
+
+        void SetUp() override {
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            MPI_Comm_size(MPI_COMM_WORLD, &size);
+        }
+
+        /// Run counts of every rank, added together.
+        static std::vector<int> total_runs(std::vector<int> runs) {
+            MPI_Allreduce(MPI_IN_PLACE, runs.data(), static_cast<int>(runs.size()), MPI_INT, MPI_SUM,
+                          MPI_COMM_WORLD);
+            return runs;
+        }
+    };
+}
+
+/**
+ * @test Behavior: Every test runs on one rank, a collective test on all,
+ * and every rank reports the combined statuses.
+ */
+TEST_F(MpiSessionDistributionBehavior, RanksShareTestsAndAgree) {
+    const std::string path = "mpi_session_results.sqlite";
+    if (rank == 0) {
+        for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    constexpr int num_tests = 10;
+    std::vector<int> runs(num_tests + 1);
+    Fortest::TestSession<Fortest::Logger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.results_db = path});
+    session.set_distribution(std::make_shared<Fortest::MpiSessionDistribution>(MPI_COMM_WORLD));
+    session.add_test_suite("Spread");
+    for (int i = 0; i < num_tests; ++i) {
+        session.add_test("Spread", "test" + std::to_string(i), [&, i](void *, void *, void *) {
+            ++runs[i];
+            assert_obj.assert_true(i != 7);
+        });
+    }
+    session.add_test("Spread", "allreduce", [&](void *, void *, void *) {
+        ++runs[num_tests];
+        int sum = 0;
+        MPI_Allreduce(&rank, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        assert_obj.assert_true(sum == size * (size - 1) / 2);
+    }, true);
+    session.add_parameterized_test("Spread", "cases", [&](void *, void *, void *, int idx) {
+        assert_obj.assert_true(idx != 3);
+    }, Fortest::ParameterSpace::range(1, 20));
+
+    session.run(logger);
+
+    const auto totals = total_runs(runs);
+    for (int i = 0; i < num_tests; ++i) EXPECT_EQ(totals[i], 1) << "test" << i;
+    EXPECT_EQ(totals[num_tests], size);
+
+    const auto counts = session.get_status_counts();
+    EXPECT_EQ(counts.passed(), num_tests);
+    EXPECT_EQ(counts.failed(), 2);
+    EXPECT_EQ(session.find_suite("Spread").get_status("test7"), std::optional(Fortest::Test::Status::FAIL));
+    EXPECT_EQ(session.find_suite("Spread").get_status("allreduce"), std::optional(Fortest::Test::Status::PASS));
+    EXPECT_EQ(session.get_num_failing_suites(), 1);
+
+    if (rank == 0) {
+        EXPECT_THAT(buffer.str(), HasSubstr("Test failed: test7"));
+        SqliteDb db(path);
+        SqliteStmt rows(db.get(), "SELECT COUNT(*), SUM(status = 'FAIL') FROM results;");
+        ASSERT_TRUE(rows.step());
+        EXPECT_EQ(sqlite3_column_int64(rows.get(), 0), num_tests + 1 + 20);
+        EXPECT_EQ(sqlite3_column_int64(rows.get(), 1), 2);
+        for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+    } else {
+        EXPECT_EQ(buffer.str().find("Running test"), std::string::npos);
+    }
+}
+
+/**
+ * @test Behavior: With process isolation, parameterized tests are owned
+ * whole and their cases are combined after the run.
+ */
+TEST_F(MpiSessionDistributionBehavior, IsolatedRanksShareWholeTests) {
+    Fortest::TestSession<Fortest::Logger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.isolation = Fortest::RunOptions::Isolation::Process,
+                                            .distribution = Fortest::RunOptions::Distribution::Cost,
+                                            .results_db = ""});
+    session.set_distribution(std::make_shared<Fortest::MpiSessionDistribution>(MPI_COMM_WORLD));
+    auto &suite = session.add_test_suite("Forked");
+    for (int i = 0; i < 4; ++i) {
+        suite.register_parameterized_test("p" + std::to_string(i), [&, i](void *, void *, void *, int idx) {
+            assert_obj.assert_true(idx != i);
+        }, {0, 1, 2, 3, 4, 5});
+    }
+    suite.register_parameterized_test("clean", [&](void *, void *, void *, int) {
+        assert_obj.assert_true(true);
+    }, {0, 1});
+
+    session.run(logger);
+
+    for (int i = 0; i < 4; ++i) {
+        const auto &ptest = suite.get_registry().parameterized(*suite.get_registry().find_parameterized(
+            "p" + std::to_string(i)));
+        EXPECT_EQ(ptest.get_status_counts().passed(), 5);
+        EXPECT_EQ(ptest.get_status(i), Fortest::ParameterizedTest::Status::FAIL);
+    }
+    EXPECT_EQ(suite.get_status("clean"), std::optional(Fortest::Test::Status::PASS));
+    EXPECT_EQ(session.get_status_counts().failed(), 4);
+}
+
+/**
+ * @test Behavior: Combining timings keeps the events counted by every
+ * rank, also when the ranks counted different events.
+ */
+TEST_F(MpiSessionDistributionBehavior, RanksUniteCountedEvents) {
+    using Fortest::PerfCounts;
+    Fortest::MpiSessionDistribution distribution(MPI_COMM_WORLD);
+    const auto event = static_cast<std::size_t>(rank) % PerfCounts::NumEvents;
+    Fortest::TestTiming timing;
+    timing.counters.counted = 1U << event;
+    timing.counters.values[event] = rank + 1;
+    std::vector<std::int64_t> values(Fortest::ReducedTiming::size);
+    Fortest::ReducedTiming::pack(values.data(), timing, rank == 0);
+
+    distribution.max_reduce(values);
+    const Fortest::TestTiming combined = Fortest::ReducedTiming::unpack(values.data());
+
+    for (int r = 0; r < size; ++r) {
+        const auto e = static_cast<std::size_t>(r) % PerfCounts::NumEvents;
+        EXPECT_TRUE(combined.counters.has(static_cast<PerfCounts::Event>(e))) << "rank " << r;
+        EXPECT_GE(combined.counters.values[e], r + 1) << "rank " << r;
+    }
+}
+
+int main(int argc, char **argv) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    ::testing::InitGoogleTest(&argc, argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+        auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+    const int result = RUN_ALL_TESTS();
+    int worst = result;
+    MPI_Allreduce(&result, &worst, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return worst;
+}
@@ -0,0 +1,62 @@
+#include "name_filter.hpp"
+
+#include <gtest/gtest.h>
+#include <regex>
+#include <string>
+
+/**
+ * @brief Behavior: Globs match whole names with `*` and `?`, without backtracking blowup.
+ */
+TEST(GlobPatternBehavior, MatchesWholeNames) {
+    EXPECT_TRUE(Fortest::GlobPattern("a*c").matches("abbbc"));
+    EXPECT_TRUE(Fortest::GlobPattern("a?c").matches("abc"));
+    EXPECT_TRUE(Fortest::GlobPattern("*").matches(""));
+    EXPECT_FALSE(Fortest::GlobPattern("a*c").matches("abcd"));
+    EXPECT_FALSE(Fortest::GlobPattern("a?c").matches("ac"));
+
+    const std::string many_a(10000, 'a');
+    EXPECT_FALSE(Fortest::GlobPattern("*a*a*a*a*a*a*a*b").matches(many_a));
+}
+
+/**
+ * @brief Behavior: A filter selects tests matching a positive pattern and no negative one.
+ */
+TEST(NameFilterBehavior, SelectsPositiveMinusNegative) {
+    const Fortest::NameFilter filter("Mesh*.*:Solver.fast_*-*.slow_*");
+    EXPECT_TRUE(filter.matches("MeshIO", "read"));
+    EXPECT_TRUE(filter.matches("Solver", "fast_cg"));
+    EXPECT_FALSE(filter.matches("Solver", "gmres"));
+    EXPECT_FALSE(filter.matches("MeshIO", "slow_write"));
+    EXPECT_FALSE(filter.matches("Other", "read"));
+
+    const Fortest::NameFilter only_negative("-*.slow_*");
+    EXPECT_TRUE(only_negative.matches("Any", "test"));
+    EXPECT_FALSE(only_negative.matches("Any", "slow_test"));
+
+    EXPECT_TRUE(Fortest::NameFilter().empty());
+    EXPECT_TRUE(Fortest::NameFilter("").matches("Any", "test"));
+}
+
+/**
+ * @brief Behavior: Patterns between slashes are regexes searched in the full name.
+ */
+TEST(NameFilterBehavior, MatchesRegexPatterns) {
+    const Fortest::NameFilter filter("/mesh_[0-9]+$/-/\\.skip/");
+    EXPECT_TRUE(filter.matches("Suite", "mesh_42"));
+    EXPECT_FALSE(filter.matches("Suite", "mesh_x"));
+    EXPECT_FALSE(filter.matches("Suite.skip", "mesh_1"));
+    EXPECT_THROW(Fortest::NameFilter("/(/"), std::regex_error);
+}
+
+/**
+ * @brief Behavior: Suites are classified once, so unmatched suites need no per-test work.
+ */
+TEST(NameFilterBehavior, ClassifiesSuitesUpFront) {
+    const Fortest::NameFilter filter("Mesh*.*:Solver.fast_*-Mesh.slow");
+    EXPECT_TRUE(filter.for_suite("Other").none());
+    EXPECT_TRUE(filter.for_suite("MeshIO").all());
+    EXPECT_FALSE(filter.for_suite("Mesh").all());
+    EXPECT_FALSE(filter.for_suite("Solver").all());
+    EXPECT_FALSE(filter.for_suite("Solver").none());
+    EXPECT_TRUE(Fortest::NameFilter("-Legacy.*").for_suite("Legacy").none());
+}
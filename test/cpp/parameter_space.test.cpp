@@ -0,0 +1,70 @@
+#include "parameter_space.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <vector>
+
+using ::testing::ElementsAre;
+
+/**
+ * @test Behavior: Ranges include stop when reached, follow negative strides, and can be empty.
+ */
+TEST(ParameterSpaceBehavior, RangesFollowDoLoopTripCounts) {
+    EXPECT_THAT(Fortest::ParameterSpace::range(1, 10, 3), ElementsAre(1, 4, 7, 10));
+    EXPECT_THAT(Fortest::ParameterSpace::range(1, 9, 3), ElementsAre(1, 4, 7));
+    EXPECT_THAT(Fortest::ParameterSpace::range(5, 1, -2), ElementsAre(5, 3, 1));
+    EXPECT_TRUE(Fortest::ParameterSpace::range(5, 4).empty());
+    EXPECT_TRUE(Fortest::ParameterSpace::range(5, 4, 3).empty());
+    EXPECT_THROW((void) Fortest::ParameterSpace::range(1, 2, 0), std::invalid_argument);
+}
+
+/**
+ * @test Behavior: Huge ranges are sized and indexed without being expanded.
+ */
+TEST(ParameterSpaceBehavior, HugeRangesStayLazy) {
+    const auto space = Fortest::ParameterSpace::range(0, 2'000'000'000);
+
+    EXPECT_EQ(space.size(), 2'000'000'001u);
+    EXPECT_EQ(space[1'999'999'999], 1'999'999'999);
+    EXPECT_EQ(space.find(123'456'789), std::optional<std::size_t>(123'456'789));
+    EXPECT_FALSE(space.find(-1).has_value());
+}
+
+/**
+ * @test Behavior: A product numbers its cases with the first range varying fastest.
+ */
+TEST(ParameterSpaceBehavior, ProductDecodesCoordinates) {
+    const auto space = Fortest::ParameterSpace::product({{1, 3}, {10, 30, 10}});
+
+    ASSERT_EQ(space.size(), 9u);
+    EXPECT_TRUE(space.is_product());
+    EXPECT_EQ(space[4], 4);
+    EXPECT_EQ(space.coordinate(4, 0), 2);
+    EXPECT_EQ(space.coordinate(4, 1), 20);
+    EXPECT_EQ(space.coordinate(8, 0), 3);
+    EXPECT_EQ(space.coordinate(8, 1), 30);
+    EXPECT_EQ(space.label(5), "(3,20)");
+    EXPECT_FALSE(space.find(9).has_value());
+}
+
+/**
+ * @test Behavior: Explicit lists keep their order and find values by position.
+ */
+TEST(ParameterSpaceBehavior, ListsKeepTheirValues) {
+    const Fortest::ParameterSpace space{7, 3, 9, 3};
+
+    EXPECT_THAT(space, ElementsAre(7, 3, 9, 3));
+    EXPECT_EQ(space.rank(), 0u);
+    EXPECT_EQ(space.find(3), std::optional<std::size_t>(1));
+    EXPECT_FALSE(space.find(4).has_value());
+    EXPECT_EQ(space.label(2), "9");
+}
+
+/**
+ * @test Behavior: A product whose case numbers overflow an int is rejected.
+ */
+TEST(ParameterSpaceBehavior, RejectsOversizedProducts) {
+    EXPECT_THROW((void) Fortest::ParameterSpace::product({{1, 100'000}, {1, 100'000}}),
+                 std::invalid_argument);
+}
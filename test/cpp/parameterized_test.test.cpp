@@ -163,3 +163,48 @@ TEST_F(ParameterizedTestFixture, MultipleAddFixtureOverridesPrevious) {
     delete arg1;
     delete arg2;
 }
+
+/**
+ * @brief Behavior: A range is run value by value and its statuses are looked up by value.
+ */
+TEST_F(ParameterizedTestFixture, RunsRangeValues) {
+    std::vector<int> called_indices;
+    Fortest::ParameterizedTest test(
+        "range",
+        [&](void *, void *, void *, int idx) {
+            called_indices.push_back(idx);
+            assert_obj.assert_true(idx != 20);
+        },
+        Fortest::ParameterSpace::range(10, 40, 10)
+    );
+
+    EXPECT_EQ(test.get_status(20), Fortest::ParameterizedTest::Status::NONE);
+    test.run(logger, assert_obj);
+
+    EXPECT_EQ(called_indices, (std::vector<int>{10, 20, 30, 40}));
+    EXPECT_EQ(test.get_status(10), Fortest::ParameterizedTest::Status::PASS);
+    EXPECT_EQ(test.get_status(20), Fortest::ParameterizedTest::Status::FAIL);
+    EXPECT_EQ(test.get_case_status(1), Fortest::ParameterizedTest::Status::FAIL);
+    EXPECT_EQ(test.get_status(15), Fortest::ParameterizedTest::Status::NONE);
+    EXPECT_EQ(test.get_status_counts().passed(), 3);
+    EXPECT_THROW(test.run_parameter(15, logger, assert_obj), std::out_of_range);
+}
+
+/**
+ * @brief Behavior: A product passes case numbers and names cases by their coordinates.
+ */
+TEST_F(ParameterizedTestFixture, RunsProductCases) {
+    std::vector<int> called_indices;
+    Fortest::ParameterizedTest test(
+        "grid",
+        [&](void *, void *, void *, int idx) { called_indices.push_back(idx); },
+        Fortest::ParameterSpace::product({{1, 2}, {5, 7}})
+    );
+
+    test.run(logger, assert_obj);
+
+    EXPECT_EQ(called_indices, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(test.variation_name(3), "grid [param=(2,6)]");
+    EXPECT_THAT(get_output(), HasSubstr("Test passed: grid [param=(1,7)]"));
+    EXPECT_EQ(test.get_summary_status(), Fortest::ParameterizedTest::Status::PASS);
+}
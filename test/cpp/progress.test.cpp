@@ -0,0 +1,153 @@
+#include "progress.hpp"
+#include "test_session.hpp"
+#include "assert.hpp"
+#include "logging.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace {
+    /// Logger writing tagged lines to a stream.
+    class OStreamLogger : public Fortest::Logger {
+    public:
+        explicit OStreamLogger(std::ostream &out) : Logger(out), out_(out) {}
+
+        void log(const std::string &msg, const std::string &tag, const std::optional<std::string> & = std::nullopt) {
+            out_ << "[" << tag << "] " << msg << "\n";
+        }
+
+    private:
+        std::ostream &out_;
+    };
+
+    Fortest::Event started(std::string_view suite, std::string_view test) {
+        return {.kind = Fortest::EventKind::TestStarted, .suite = suite, .test = test};
+    }
+
+    Fortest::Event finished(std::string_view suite, std::string_view test, const char *status,
+                            const Fortest::TestTiming &timing) {
+        return {.kind = Fortest::EventKind::TestFinished, .suite = suite, .test = test, .status = status,
+                .timing = &timing};
+    }
+
+    std::string read_file(const std::filesystem::path &path) {
+        std::ifstream in(path);
+        std::ostringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+}
+
+/**
+ * @brief Behavior: Counts, busy workers and the slowest tests follow the events.
+ */
+TEST(ProgressMonitorBehavior, FollowsTestEvents) {
+    Fortest::ProgressMonitor monitor({}, std::chrono::seconds(1), 2);
+    const Fortest::RunPlan plan{.tests = 4, .expected_ns = 0, .workers = 2};
+    monitor.on_event({.kind = Fortest::EventKind::SessionStarted});
+    monitor.on_event({.kind = Fortest::EventKind::RunPlanned, .plan = &plan});
+
+    monitor.on_event(started("Mesh", "refine"));
+    monitor.on_event(started("Mesh", "coarsen"));
+    auto snapshot = monitor.snapshot();
+    ASSERT_EQ(snapshot.workers.size(), 2u);
+    EXPECT_EQ(snapshot.workers[0].test, "refine");
+    EXPECT_EQ(snapshot.workers[1].worker, 1u);
+    EXPECT_EQ(snapshot.eta_ns, -1);
+
+    monitor.on_event(finished("Mesh", "refine", "PASS", {.body_ns = 3'000'000}));
+    monitor.on_event(started("Mesh", "smooth"));
+    monitor.on_event(finished("Mesh", "coarsen", "FAIL", {.body_ns = 1'000'000}));
+    monitor.on_event(finished("Mesh", "smooth", "PASS", {.body_ns = 2'000'000}));
+    monitor.on_event({.kind = Fortest::EventKind::AssertionFailed, .text = "1 != 2"});
+
+    snapshot = monitor.snapshot();
+    EXPECT_TRUE(snapshot.running);
+    EXPECT_TRUE(snapshot.workers.empty());
+    EXPECT_EQ(snapshot.passed, 2);
+    EXPECT_EQ(snapshot.failed, 1);
+    EXPECT_EQ(snapshot.failed_assertions, 1);
+    EXPECT_EQ(snapshot.remaining(), 1);
+    ASSERT_EQ(snapshot.slowest.size(), 2u);
+    EXPECT_EQ(snapshot.slowest[0].test, "refine");
+    EXPECT_EQ(snapshot.slowest[1].test, "smooth");
+    // Without history: one test left at the mean of 2 ms, on two workers.
+    EXPECT_EQ(snapshot.eta_ns, 1'000'000);
+
+    monitor.on_event({.kind = Fortest::EventKind::SessionFinished});
+    EXPECT_FALSE(monitor.snapshot().running);
+    EXPECT_EQ(monitor.snapshot().eta_ns, 0);
+}
+
+/**
+ * @brief Behavior: The expected work of the plan gives the ETA until the finished tests exceed it.
+ */
+TEST(ProgressMonitorBehavior, EstimatesFromHistory) {
+    Fortest::ProgressMonitor monitor;
+    const Fortest::RunPlan plan{.tests = 3, .expected_ns = 10'000'000, .workers = 1};
+    monitor.on_event({.kind = Fortest::EventKind::SessionStarted});
+    monitor.on_event({.kind = Fortest::EventKind::RunPlanned, .plan = &plan});
+    monitor.on_event(finished("Solver", "cg", "PASS", {.body_ns = 4'000'000}));
+    EXPECT_EQ(monitor.snapshot().eta_ns, 6'000'000);
+
+    monitor.on_event(finished("Solver", "gmres", "PASS", {.body_ns = 8'000'000}));
+    EXPECT_EQ(monitor.snapshot().eta_ns, 6'000'000);
+}
+
+/**
+ * @brief Behavior: Snapshots are written in the Prometheus text format, with escaped labels.
+ */
+TEST(ProgressMonitorBehavior, FormatsPrometheusText) {
+    Fortest::ProgressMonitor monitor;
+    monitor.on_event({.kind = Fortest::EventKind::SessionStarted});
+    monitor.on_event(started("Mesh", "say \"hi\""));
+
+    const std::string text = Fortest::ProgressMonitor::prometheus(monitor.snapshot());
+    EXPECT_THAT(text, HasSubstr("# TYPE fortest_tests_finished gauge\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_tests_finished{status=\"PASS\"} 0\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_eta_seconds NaN\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_running_test_seconds{worker=\"0\",suite=\"Mesh\",test=\"say \\\"hi\\\"\"}"));
+}
+
+/**
+ * @brief Behavior: A session with a progress file shows its running test and leaves a final snapshot.
+ */
+TEST(ProgressMonitorBehavior, SessionWritesProgressFile) {
+    const std::filesystem::path path = "progress_test.prom";
+    std::filesystem::remove(path);
+    std::ostringstream buffer;
+    auto logger = std::make_shared<OStreamLogger>(buffer);
+    Fortest::Assert<OStreamLogger> assert_obj{static_cast<std::ostream &>(buffer)};
+    auto live = std::make_shared<Fortest::ProgressMonitor>();
+
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.results_db = "", .progress_file = path.string()});
+    session.add_event_sink(live);
+    auto &suite = session.add_test_suite("Progress");
+    Fortest::ProgressMonitor::Snapshot during;
+    suite.add_test("observed", [&](void *, void *, void *) { during = live->snapshot(); });
+    suite.register_parameterized_test("cases", [&](void *, void *, void *, int) {}, {1, 2, 3});
+    session.run(logger);
+
+    EXPECT_EQ(during.planned, 4);
+    ASSERT_EQ(during.workers.size(), 1u);
+    EXPECT_EQ(during.workers[0].suite, "Progress");
+    EXPECT_EQ(during.workers[0].test, "observed");
+
+    const std::string text = read_file(path);
+    EXPECT_THAT(text, HasSubstr("fortest_session_running 0\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_tests_planned 4\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_tests_finished{status=\"PASS\"} 4\n"));
+    EXPECT_THAT(text, HasSubstr("fortest_tests_remaining 0\n"));
+    EXPECT_THAT(text, Not(HasSubstr("fortest_running_test_seconds{")));
+    EXPECT_FALSE(std::filesystem::exists("progress_test.prom.tmp"));
+    std::filesystem::remove(path);
+}
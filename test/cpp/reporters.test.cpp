@@ -0,0 +1,200 @@
+#include "reporters.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::testing::EndsWith;
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+namespace {
+    /// Report path, removed again on destruction.
+    struct TempReport {
+        std::string path;
+
+        explicit TempReport(std::string name) : path(std::move(name)) { std::remove(path.c_str()); }
+        ~TempReport() { std::remove(path.c_str()); }
+
+        [[nodiscard]] std::string contents() const {
+            std::ifstream in(path);
+            std::ostringstream text;
+            text << in.rdbuf();
+            return text.str();
+        }
+
+        [[nodiscard]] std::vector<std::string> lines() const {
+            std::istringstream in(contents());
+            std::vector<std::string> result;
+            for (std::string line; std::getline(in, line);) result.push_back(line);
+            return result;
+        }
+    };
+
+    Fortest::TestTiming millis(std::int64_t ms) {
+        Fortest::TestTiming timing;
+        timing.body_ns = ms * 1'000'000;
+        return timing;
+    }
+}
+
+/**
+ * @brief Behavior: The JUnit report is complete, well-formed XML with current totals after every test.
+ */
+TEST(ReporterBehavior, JUnitReportIsCompleteAfterEveryTest) {
+    TempReport file("test_report.xml");
+    Fortest::JUnitReporter report(file.path, Fortest::RunInfo{.git_sha = "abc", .hostname = "node<1>"});
+    EXPECT_THAT(file.contents(), EndsWith("  </testsuite>\n</testsuites>\n"));
+
+    report.push("Mesh", "refine", "PASS", millis(2));
+    report.push("Mesh", "coarsen \"fast\"", "FAIL", millis(1));
+    std::string text = file.contents();
+    EXPECT_THAT(text, HasSubstr("tests=\"0000000002\" failures=\"0000000001\""));
+    EXPECT_THAT(text, HasSubstr("hostname=\"node&lt;1&gt;\""));
+    EXPECT_THAT(text, HasSubstr("<property name=\"git_sha\" value=\"abc\"/>"));
+    EXPECT_THAT(text, HasSubstr("<testcase classname=\"Mesh\" name=\"refine\" time=\"0.002000\"/>"));
+    EXPECT_THAT(text, HasSubstr("name=\"coarsen &quot;fast&quot;\""));
+    EXPECT_THAT(text, HasSubstr("<failure type=\"FAIL\""));
+    EXPECT_THAT(text, EndsWith("  </testsuite>\n</testsuites>\n"));
+
+    report.push("Solver", "hang", "TIMEOUT", millis(500));
+    text = file.contents();
+    EXPECT_THAT(text, HasSubstr("tests=\"0000000003\" failures=\"0000000002\""));
+    EXPECT_THAT(text, HasSubstr("<error type=\"TIMEOUT\""));
+
+    report.push("Solver", "cg", "CACHED", millis(0));
+    text = file.contents();
+    EXPECT_THAT(text, HasSubstr("tests=\"0000000004\" failures=\"0000000002\""));
+    EXPECT_THAT(text, HasSubstr("<skipped message=\"cached\"/>"));
+    EXPECT_EQ(text.find("</testsuites>"), text.rfind("</testsuites>"));
+}
+
+/**
+ * @brief Behavior: The JSON Lines report frames one result object per line with start and end events.
+ */
+TEST(ReporterBehavior, JsonLinesReportStreamsOneObjectPerLine) {
+    TempReport file("test_report.jsonl");
+    {
+        Fortest::JsonLinesReporter report(file.path, Fortest::RunInfo{.git_sha = "abc", .hostname = "host"});
+        report.push("Mesh", "refine", "PASS", millis(3));
+        Fortest::BenchmarkStats stats;
+        stats.iterations = 10;
+        stats.repetitions = 5;
+        stats.median_ns = 42.0;
+        report.push("Bench", "tab\there", "PASS", millis(1), stats);
+
+        const auto lines = file.lines();
+        ASSERT_EQ(lines.size(), 3u);
+        EXPECT_THAT(lines[0], StartsWith("{\"event\":\"session_start\""));
+        EXPECT_THAT(lines[0], HasSubstr("\"git_sha\":\"abc\""));
+        EXPECT_THAT(lines[1], StartsWith("{\"event\":\"result\",\"suite\":\"Mesh\",\"test\":\"refine\","
+                                         "\"status\":\"PASS\""));
+        EXPECT_THAT(lines[1], HasSubstr("\"duration_ms\":3.000000"));
+        EXPECT_THAT(lines[2], HasSubstr("\"test\":\"tab\\there\""));
+        EXPECT_THAT(lines[2], HasSubstr("\"benchmark\":{\"iterations\":10,\"repetitions\":5"));
+    }
+    const auto lines = file.lines();
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_THAT(lines[3], HasSubstr("\"event\":\"session_end\""));
+    EXPECT_THAT(lines[3], HasSubstr("\"tests\":2,\"failures\":0"));
+}
+
+/**
+ * @brief Behavior: The TAP report numbers the tests and ends with the plan.
+ */
+TEST(ReporterBehavior, TapReportEndsWithPlan) {
+    TempReport file("test_report.tap");
+    {
+        Fortest::TapReporter report(file.path);
+        report.push("Mesh", "refine", "PASS", millis(1));
+        report.push("Mesh", "case #2", "CRASH", millis(1));
+        report.push("Mesh", "skipped", "NONE", millis(0));
+        report.push("Mesh", "smooth", "CACHED", millis(0));
+        EXPECT_EQ(file.lines().size(), 5u);
+    }
+    const auto lines = file.lines();
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0], "TAP version 13");
+    EXPECT_THAT(lines[1], StartsWith("ok 1 - Mesh.refine # time="));
+    EXPECT_EQ(lines[2], "not ok 2 - Mesh.case _2 # CRASH");
+    EXPECT_EQ(lines[3], "ok 3 - Mesh.skipped # SKIP not run");
+    EXPECT_EQ(lines[4], "ok 4 - Mesh.smooth # SKIP cached");
+    EXPECT_EQ(lines[5], "1..4");
+}
+
+/**
+ * @brief Behavior: Concurrent pushes each produce exactly one whole line.
+ */
+TEST(ReporterBehavior, ConcurrentPushesKeepLinesWhole) {
+    TempReport file("test_report_concurrent.jsonl");
+    {
+        Fortest::JsonLinesReporter report(file.path, Fortest::RunInfo{});
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&report, t] {
+                for (int i = 0; i < 250; ++i) {
+                    report.push("Suite" + std::to_string(t), "test" + std::to_string(i), "PASS", millis(0));
+                }
+            });
+        }
+        for (auto &thread: threads) thread.join();
+        EXPECT_EQ(report.num_tests(), 1000u);
+    }
+    const auto lines = file.lines();
+    ASSERT_EQ(lines.size(), 1002u);
+    for (const auto &line: lines) {
+        EXPECT_THAT(line, StartsWith("{\"event\":"));
+        EXPECT_THAT(line, EndsWith("}"));
+    }
+}
+
+/**
+ * @brief Behavior: Report specs name a format and a path; anything else is rejected.
+ */
+TEST(ReporterBehavior, ParsesReportSpecs) {
+    TempReport xml("test_report_spec.xml");
+    TempReport tap("test_report_spec.tap");
+    const auto reporters = Fortest::make_reporters("junit:" + xml.path + ",,tap:" + tap.path);
+    ASSERT_EQ(reporters.size(), 2u);
+    EXPECT_NE(dynamic_cast<Fortest::JUnitReporter *>(reporters[0].get()), nullptr);
+    EXPECT_NE(dynamic_cast<Fortest::TapReporter *>(reporters[1].get()), nullptr);
+
+    EXPECT_TRUE(Fortest::make_reporters("").empty());
+    EXPECT_THROW((void) Fortest::make_reporter("xml:out.xml"), std::invalid_argument);
+    EXPECT_THROW((void) Fortest::make_reporter("junit"), std::invalid_argument);
+    EXPECT_THROW((void) Fortest::make_reporter("junit:no_such_dir/report.xml"), std::runtime_error);
+}
+
+/**
+ * @brief Behavior: Result consumers subscribed to a bus receive every published row.
+ */
+TEST(ReporterBehavior, SubscribedConsumersReceivePublishedRows) {
+    Fortest::EventBus bus;
+    auto first = std::make_shared<Fortest::ResultBuffer>();
+    auto second = std::make_shared<Fortest::ResultBuffer>();
+    bus.subscribe(std::make_shared<Fortest::ResultEvents>(first));
+    bus.subscribe(std::make_shared<Fortest::ResultEvents>(second));
+    Fortest::EventPublisher publisher(bus);
+
+    Fortest::BenchmarkStats stats;
+    stats.iterations = 7;
+    publisher.push("Suite", "test", "FAIL", millis(1), stats);
+    bus.publish(Fortest::Event{.kind = Fortest::EventKind::SuiteStarted, .suite = "Suite"});
+
+    const auto a = first->take();
+    const auto b = second->take();
+    ASSERT_EQ(a.size(), 1u);
+    ASSERT_EQ(b.size(), 1u);
+    EXPECT_EQ(a[0].suite_name, "Suite");
+    EXPECT_EQ(b[0].test_name, "test");
+    EXPECT_STREQ(b[0].status, "FAIL");
+    EXPECT_EQ(b[0].timing.body_ns, 1'000'000);
+    ASSERT_TRUE(b[0].benchmark.has_value());
+    EXPECT_EQ(b[0].benchmark->iterations, 7u);
+}
@@ -0,0 +1,202 @@
+#include "result_sink.hpp"
+#include "test_history.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// Fresh database path, removed again (with its WAL files) on destruction.
+    struct TempDb {
+        std::string path;
+
+        explicit TempDb(std::string name) : path(std::move(name)) { remove(); }
+        ~TempDb() { remove(); }
+
+        void remove() const {
+            for (const char *suffix : {"", "-wal", "-shm"}) {
+                std::remove((path + suffix).c_str());
+            }
+        }
+    };
+
+    long long count_rows(const Fortest::ResultSink &sink) {
+        SqliteStmt stmt(sink.db().get(), "SELECT COUNT(*) FROM results;");
+        stmt.step();
+        return sqlite3_column_int64(stmt.get(), 0);
+    }
+}
+
+/**
+ * @brief Behavior: Rows stay pending until a batch fills up or flush() is called.
+ */
+TEST(ResultSinkBehavior, BatchesRowsUntilFlush) {
+    TempDb file("test_sink_batches.sqlite");
+    Fortest::ResultSink sink(file.path, Fortest::RunInfo{},
+                             {.batch_size = 3, .flush_interval = std::chrono::hours(1)});
+
+    sink.push("suite", "a", "PASS", {});
+    sink.push("suite", "b", "FAIL", {});
+    EXPECT_EQ(sink.pending(), 2u);
+    EXPECT_EQ(count_rows(sink), 0);
+
+    sink.push("suite", "c", "PASS", {});
+    EXPECT_EQ(sink.pending(), 0u);
+    EXPECT_EQ(count_rows(sink), 3);
+
+    sink.push("suite", "d", "PASS", {});
+    sink.flush();
+    EXPECT_EQ(count_rows(sink), 4);
+}
+
+/**
+ * @brief Behavior: Rows are committed in the order they were pushed.
+ */
+TEST(ResultSinkBehavior, PreservesPushOrder) {
+    TempDb file("test_sink_order.sqlite");
+    Fortest::ResultSink sink(file.path);
+
+    for (int i = 0; i < 10; ++i) {
+        sink.push("suite", "t" + std::to_string(i), "PASS", Fortest::TestTiming{.body_ns = i});
+    }
+    sink.flush();
+
+    SqliteStmt stmt(sink.db().get(),
+                    "SELECT tests.name, body_ns FROM results "
+                    "JOIN tests ON tests.id = results.test_id ORDER BY results.id;");
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(stmt.step());
+        EXPECT_EQ(std::string(stmt.column_text(0)), "t" + std::to_string(i));
+        EXPECT_EQ(sqlite3_column_int64(stmt.get(), 1), i);
+    }
+}
+
+/**
+ * @brief Behavior: The database is opened in WAL mode.
+ */
+TEST(ResultSinkBehavior, UsesWriteAheadLog) {
+    TempDb file("test_sink_wal.sqlite");
+    Fortest::ResultSink sink(file.path);
+
+    SqliteStmt stmt(sink.db().get(), "PRAGMA journal_mode;");
+    ASSERT_TRUE(stmt.step());
+    EXPECT_EQ(std::string(stmt.column_text(0)), "wal");
+}
+
+/**
+ * @brief Behavior: Concurrent producers lose no rows.
+ */
+TEST(ResultSinkBehavior, ConcurrentPushesAreAllWritten) {
+    TempDb file("test_sink_concurrent.sqlite");
+    {
+        Fortest::ResultSink sink(file.path, Fortest::RunInfo{}, {.batch_size = 64});
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 8; ++t) {
+            producers.emplace_back([&, t] {
+                for (int i = 0; i < 500; ++i) {
+                    sink.push("suite" + std::to_string(t % 2),
+                              "t" + std::to_string(t) + "_" + std::to_string(i), "PASS", {});
+                }
+            });
+        }
+        for (auto &producer : producers) producer.join();
+        sink.flush();
+        EXPECT_EQ(count_rows(sink), 8 * 500);
+    }
+}
+
+/**
+ * @brief Behavior: Destroying the sink commits the rows still pending.
+ */
+TEST(ResultSinkBehavior, DestructorFlushes) {
+    TempDb file("test_sink_destructor.sqlite");
+    {
+        Fortest::ResultSink sink(file.path);
+        sink.push("suite", "a", "PASS", {});
+    }
+    Fortest::ResultSink reopened(file.path);
+    EXPECT_EQ(count_rows(reopened), 1);
+}
+
+/**
+ * @brief Behavior: Counted hardware events get a perf_counters row; uncounted events are NULL.
+ */
+TEST(ResultSinkBehavior, StoresCountedEvents) {
+    TempDb file("test_sink_counters.sqlite");
+    Fortest::ResultSink sink(file.path);
+
+    Fortest::TestTiming timing{.body_ns = 100};
+    timing.counters.values[Fortest::PerfCounts::Cycles] = 5000;
+    timing.counters.counted = 1U << Fortest::PerfCounts::Cycles;
+    sink.push("suite", "counted", "PASS", timing);
+    sink.push("suite", "plain", "PASS", {});
+    sink.flush();
+
+    SqliteStmt stmt(sink.db().get(),
+                    "SELECT tests.name, cycles, instructions FROM perf_counters "
+                    "JOIN results ON results.id = perf_counters.result_id "
+                    "JOIN tests ON tests.id = results.test_id;");
+    ASSERT_TRUE(stmt.step());
+    EXPECT_EQ(std::string(stmt.column_text(0)), "counted");
+    EXPECT_EQ(sqlite3_column_int64(stmt.get(), 1), 5000);
+    EXPECT_EQ(sqlite3_column_type(stmt.get(), 2), SQLITE_NULL);
+    EXPECT_FALSE(stmt.step());
+}
+
+/**
+ * @brief Behavior: Tracked memory gets a memory_usage row next to the durations.
+ */
+TEST(ResultSinkBehavior, StoresMemoryUsage) {
+    TempDb file("test_sink_memory.sqlite");
+    Fortest::ResultSink sink(file.path);
+
+    Fortest::TestTiming timing{.body_ns = 100};
+    timing.memory = Fortest::MemoryUsage{-4096, 1 << 20, true};
+    sink.push("suite", "tracked", "PASS", timing);
+    sink.push("suite", "untracked", "PASS", {});
+    sink.flush();
+
+    SqliteStmt stmt(sink.db().get(),
+                    "SELECT tests.name, body_ns, rss_delta_bytes, peak_rss_bytes FROM memory_usage "
+                    "JOIN results ON results.id = memory_usage.result_id "
+                    "JOIN tests ON tests.id = results.test_id;");
+    ASSERT_TRUE(stmt.step());
+    EXPECT_EQ(std::string(stmt.column_text(0)), "tracked");
+    EXPECT_EQ(sqlite3_column_int64(stmt.get(), 1), 100);
+    EXPECT_EQ(sqlite3_column_int64(stmt.get(), 2), -4096);
+    EXPECT_EQ(sqlite3_column_int64(stmt.get(), 3), 1 << 20);
+    EXPECT_FALSE(stmt.step());
+}
+
+/**
+ * @brief Behavior: The history averages each test's last runs and sums parameter cases.
+ */
+TEST(TestHistoryBehavior, AveragesRecentRunsAndSumsCases) {
+    TempDb file("test_history.sqlite");
+    EXPECT_TRUE(Fortest::TestHistory::load(file.path).empty());
+
+    const auto ms = [](std::int64_t value) { return Fortest::TestTiming{.body_ns = value * 1'000'000}; };
+    for (const std::int64_t run : {100, 10, 20}) {
+        Fortest::ResultSink sink(file.path);
+        sink.push("suite", "slow", "PASS", ms(run));
+        sink.push("suite", "skipped", "NONE", ms(run));
+        sink.push("suite", "param [param=1]", "PASS", ms(2));
+        sink.push("suite", "param [param=2]", "FAIL", ms(3));
+    }
+
+    const auto history = Fortest::TestHistory::load(file.path, 2);
+    EXPECT_EQ(history.duration_ms("suite", "slow"), std::optional(15.0));
+    EXPECT_EQ(history.duration_ms("suite", "param [param=2]"), std::optional(3.0));
+    EXPECT_EQ(history.duration_ms("suite", "param"), std::optional(5.0));
+    EXPECT_EQ(history.duration_ms("suite", "skipped"), std::nullopt);
+    EXPECT_EQ(history.duration_ms("other", "slow"), std::nullopt);
+
+    EXPECT_EQ(history.last_failed("suite", "slow"), std::optional(false));
+    EXPECT_EQ(history.last_failed("suite", "param"), std::optional(true));
+    EXPECT_EQ(history.last_failed("suite", "param [param=1]"), std::optional(false));
+    EXPECT_EQ(history.last_failed("other", "slow"), std::nullopt);
+}
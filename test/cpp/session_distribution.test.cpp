@@ -0,0 +1,243 @@
+#include "session_distribution.hpp"
+#include "test_session.hpp"
+#include "assert.hpp"
+#include "logging.hpp"
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <barrier>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace {
+    /// Processes simulated by threads: every collective call meets at a barrier.
+    struct ThreadRanks {
+        explicit ThreadRanks(std::size_t size)
+            : values(size), rows(size), sync(static_cast<std::ptrdiff_t>(size)) {}
+
+        std::vector<std::vector<std::int64_t>> values;
+        std::vector<std::vector<Fortest::ResultRow>> rows;
+        std::barrier<> sync;
+    };
+
+    class ThreadRank final : public Fortest::SessionDistribution {
+        ThreadRanks &m_ranks;
+        std::size_t m_rank;
+
+    public:
+        ThreadRank(ThreadRanks &ranks, std::size_t rank) : m_ranks(ranks), m_rank(rank) {}
+
+        [[nodiscard]] std::size_t rank() const noexcept override { return m_rank; }
+        [[nodiscard]] std::size_t size() const noexcept override { return m_ranks.values.size(); }
+
+        void max_reduce(std::span<std::int64_t> values) override {
+            m_ranks.values[m_rank].assign(values.begin(), values.end());
+            m_ranks.sync.arrive_and_wait();
+            for (const auto &other : m_ranks.values) {
+                for (std::size_t i = 0; i < values.size(); ++i) values[i] = std::max(values[i], other[i]);
+            }
+            m_ranks.sync.arrive_and_wait();
+        }
+
+        [[nodiscard]] std::vector<Fortest::ResultRow> gather(std::vector<Fortest::ResultRow> rows) override {
+            m_ranks.rows[m_rank] = std::move(rows);
+            m_ranks.sync.arrive_and_wait();
+            std::vector<Fortest::ResultRow> all;
+            if (is_aggregator()) {
+                for (auto &rank_rows : m_ranks.rows) {
+                    std::ranges::move(rank_rows, std::back_inserter(all));
+                }
+            }
+            m_ranks.sync.arrive_and_wait();
+            return all;
+        }
+
+        [[nodiscard]] Fortest::CaseDistributorFactory case_distribution() override { return {}; }
+    };
+}
+
+/**
+ * @test Behavior: Round robin deals tests out in order.
+ */
+TEST(AssignOwners, RoundRobinDealsInOrder) {
+    const std::vector<double> costs{5, 1, 1, 1, 1};
+    EXPECT_EQ(Fortest::assign_owners(costs, 2, Fortest::RunOptions::Distribution::RoundRobin),
+              (std::vector<std::size_t>{0, 1, 0, 1, 0}));
+}
+
+/**
+ * @test Behavior: Cost-based assignment balances the expected work.
+ */
+TEST(AssignOwners, CostBalancesLoad) {
+    const std::vector<double> costs{1, 8, 2, 3, 4, 6};
+    const auto owners = Fortest::assign_owners(costs, 2, Fortest::RunOptions::Distribution::Cost);
+
+    std::vector<double> load(2);
+    for (std::size_t i = 0; i < costs.size(); ++i) load[owners[i]] += costs[i];
+    EXPECT_EQ(load, (std::vector<double>{12, 12}));
+    EXPECT_EQ(owners[1], 0u);
+}
+
+/**
+ * @test Behavior: Combining timings keeps every event any rank counted,
+ * including events counted by one rank only.
+ */
+TEST(ReducedTiming, MaxReduceUnitesCountedEvents) {
+    using Fortest::PerfCounts;
+    constexpr std::size_t num_ranks = 2;
+    ThreadRanks ranks(num_ranks);
+    std::vector<Fortest::TestTiming> combined(num_ranks);
+
+    auto rank_main = [&](std::size_t rank) {
+        Fortest::TestTiming timing;
+        timing.body_ns = 10 + static_cast<std::int64_t>(rank);
+        const auto event = rank == 0 ? PerfCounts::Cycles : PerfCounts::Instructions;
+        timing.counters.counted = 1U << event;
+        timing.counters.values[event] = 100 * static_cast<std::int64_t>(rank + 1);
+        std::vector<std::int64_t> values(Fortest::ReducedTiming::size);
+        Fortest::ReducedTiming::pack(values.data(), timing, rank == 0);
+        ThreadRank(ranks, rank).max_reduce(values);
+        combined[rank] = Fortest::ReducedTiming::unpack(values.data());
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t rank = 0; rank < num_ranks; ++rank) threads.emplace_back(rank_main, rank);
+    for (auto &thread : threads) thread.join();
+
+    for (const auto &timing : combined) {
+        EXPECT_TRUE(timing.counters.has(PerfCounts::Cycles));
+        EXPECT_TRUE(timing.counters.has(PerfCounts::Instructions));
+        EXPECT_FALSE(timing.counters.has(PerfCounts::CacheMisses));
+        EXPECT_EQ(timing.counters.values[PerfCounts::Cycles], 100);
+        EXPECT_EQ(timing.counters.values[PerfCounts::Instructions], 200);
+        EXPECT_EQ(timing.body_ns, 11);
+    }
+}
+
+/**
+ * @test Behavior: Each test runs on one rank, collective tests on all, and
+ * every rank ends up with the combined results; only rank 0 logs and
+ * writes the database.
+ */
+TEST(DistributedSessionBehavior, RanksShareTestsAndAgreeOnResults) {
+    const std::string path = "session_distribution_results.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    constexpr std::size_t num_ranks = 2;
+    ThreadRanks ranks(num_ranks);
+    std::mutex mutex;
+    std::map<std::string, int> runs;
+    std::vector<std::ostringstream> output(num_ranks);
+    std::vector<Fortest::StatusCounts> counts(num_ranks);
+    std::vector<std::optional<Fortest::Test::Status>> worst(num_ranks);
+    std::vector<std::int64_t> failing_suites(num_ranks);
+
+    auto rank_main = [&](std::size_t rank) {
+        auto logger = std::make_shared<Fortest::Logger>(output[rank]);
+        Fortest::Assert<Fortest::Logger> assert_obj{static_cast<std::ostream &>(output[rank])};
+        Fortest::TestSession<Fortest::Logger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.distribution = Fortest::RunOptions::Distribution::Cost,
+                                                .results_db = path});
+        session.set_distribution(std::make_shared<ThreadRank>(ranks, rank));
+        auto count = [&](const std::string &name) {
+            std::lock_guard lock(mutex);
+            ++runs[name];
+        };
+        for (const std::string suite_name : {"A", "B"}) {
+            session.add_test_suite(suite_name);
+            for (const std::string test : {"t1", "t2", "t3"}) {
+                session.add_test(suite_name, test, [&, suite_name, test](void *, void *, void *) {
+                    count(suite_name + "." + test);
+                    assert_obj.assert_true(!(suite_name == "B" && test == "t2"));
+                });
+            }
+        }
+        session.add_test("A", "everywhere", [&, rank](void *, void *, void *) {
+            count("A.everywhere");
+            assert_obj.assert_true(rank == 0);
+        }, true);
+
+        session.run(logger);
+
+        counts[rank] = session.get_status_counts();
+        worst[rank] = session.find_suite("A").get_status("everywhere");
+        failing_suites[rank] = session.get_num_failing_suites();
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t rank = 0; rank < num_ranks; ++rank) threads.emplace_back(rank_main, rank);
+    for (auto &thread : threads) thread.join();
+
+    for (const auto &[name, n] : runs) {
+        EXPECT_EQ(n, name == "A.everywhere" ? 2 : 1) << name;
+    }
+    EXPECT_EQ(runs.size(), 7u);
+    for (std::size_t rank = 0; rank < num_ranks; ++rank) {
+        EXPECT_EQ(counts[rank].passed(), 5) << rank;
+        EXPECT_EQ(counts[rank].failed(), 2) << rank;
+        EXPECT_EQ(worst[rank], std::optional(Fortest::Test::Status::FAIL)) << rank;
+        EXPECT_EQ(failing_suites[rank], 2) << rank;
+    }
+    EXPECT_THAT(output[0].str(), HasSubstr("Test failed: t2"));
+    EXPECT_THAT(output[0].str(), HasSubstr("Collective test failed: everywhere"));
+    EXPECT_THAT(output[1].str(), Not(HasSubstr("Running test")));
+
+    {
+        SqliteDb db(path);
+        SqliteStmt rows(db.get(), "SELECT COUNT(*), SUM(status = 'FAIL') FROM results;");
+        ASSERT_TRUE(rows.step());
+        EXPECT_EQ(sqlite3_column_int64(rows.get(), 0), 7);
+        EXPECT_EQ(sqlite3_column_int64(rows.get(), 1), 2);
+        SqliteStmt runs_stmt(db.get(), "SELECT COUNT(*) FROM runs;");
+        ASSERT_TRUE(runs_stmt.step());
+        EXPECT_EQ(sqlite3_column_int64(runs_stmt.get(), 0), 1);
+    }
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @test Behavior: Every rank takes the memory usage of the rank that ran a
+ * test, including a negative growth, instead of the zeros of the others.
+ */
+TEST(DistributedSessionBehavior, RanksKeepNegativeMemoryGrowth) {
+    constexpr std::size_t num_ranks = 2;
+    constexpr std::size_t buffer_bytes = 64 << 20;
+    ThreadRanks ranks(num_ranks);
+    std::vector<std::vector<char>> buffers(num_ranks);
+    std::vector<Fortest::TestTiming> timings(num_ranks);
+
+    auto rank_main = [&](std::size_t rank) {
+        std::ostringstream output;
+        auto logger = std::make_shared<Fortest::Logger>(output);
+        Fortest::Assert<Fortest::Logger> assert_obj{static_cast<std::ostream &>(output)};
+        Fortest::TestSession<Fortest::Logger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.track_memory = true, .results_db = ""});
+        session.set_distribution(std::make_shared<ThreadRank>(ranks, rank));
+        session.add_test_suite("Memory");
+        // Whichever rank runs the test releases a buffer it touched before.
+        buffers[rank].assign(buffer_bytes, 1);
+        session.add_test("Memory", "release", [&, rank](void *, void *, void *) {
+            std::vector<char>().swap(buffers[rank]);
+            assert_obj.assert_true(true);
+        });
+
+        session.run(logger);
+
+        timings[rank] = session.get_test_suite_timings("Memory").at("release");
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t rank = 0; rank < num_ranks; ++rank) threads.emplace_back(rank_main, rank);
+    for (auto &thread : threads) thread.join();
+
+    for (std::size_t rank = 0; rank < num_ranks; ++rank) {
+        EXPECT_TRUE(timings[rank].memory.measured) << rank;
+        EXPECT_LT(timings[rank].memory.rss_delta_bytes, -static_cast<std::int64_t>(buffer_bytes / 2)) << rank;
+        EXPECT_GT(timings[rank].body_ns, 0) << rank;
+    }
+}
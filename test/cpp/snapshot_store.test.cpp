@@ -0,0 +1,170 @@
+#include "snapshot_store.hpp"
+#include "assert.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Logger keeping the last message, to check assertion reports.
+    class LastMessageLogger {
+    public:
+        inline static std::string last;
+
+        static void log(const std::string &message, const std::string &, const std::optional<std::string> & = std::nullopt) {
+            last = message;
+        }
+    };
+
+    /// Store in a fresh directory, removed with the fixture.
+    class SnapshotStoreTest : public ::testing::Test {
+    protected:
+        std::filesystem::path directory = std::filesystem::path("snapshot_store_test") /
+                                          ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        Fortest::SnapshotStore store{directory};
+
+        void SetUp() override { std::filesystem::remove_all(directory); }
+        void TearDown() override { std::filesystem::remove_all(directory); }
+    };
+
+    std::vector<double> smooth_field(std::size_t n) {
+        std::vector<double> values(n);
+        for (std::size_t i = 0; i < n; ++i) values[i] = 300.0 + std::sin(static_cast<double>(i) * 1e-3);
+        return values;
+    }
+}
+
+/**
+ * @brief Behavior: The first check records the array, later checks compare with it.
+ */
+TEST_F(SnapshotStoreTest, RecordsThenCompares) {
+    const std::vector<double> values{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    const std::int64_t shape[] = {2, 3};
+
+    const auto first = store.check<double>("field", values, shape);
+    EXPECT_TRUE(first.recorded);
+    EXPECT_TRUE(first.error.empty());
+    EXPECT_TRUE(std::filesystem::exists(store.path_of("field")));
+
+    const auto second = store.check<double>("field", values, shape);
+    EXPECT_FALSE(second.recorded);
+    EXPECT_TRUE(second.error.empty());
+    EXPECT_EQ(second.comparison.size, 6u);
+    EXPECT_TRUE(second.comparison.passed());
+}
+
+/**
+ * @brief Behavior: Mismatches in several chunks are reported with offsets into the whole array.
+ */
+TEST_F(SnapshotStoreTest, ReportsMismatchesAcrossChunks) {
+    store.configure(directory, false, 4 * sizeof(double));
+    std::vector<double> values = smooth_field(20);
+    const std::int64_t shape[] = {20};
+    ASSERT_TRUE(store.check<double>("chunks", values, shape).recorded);
+
+    const std::vector<double> recorded = values;
+    values[1] += 1.0;
+    values[13] += 2.0;
+    values[19] += 1e-9;
+    const auto check = store.check<double>("chunks", values, shape, 1e-6);
+
+    EXPECT_TRUE(check.error.empty());
+    EXPECT_EQ(check.comparison.size, 20u);
+    EXPECT_EQ(check.comparison.mismatches, 2u);
+    EXPECT_DOUBLE_EQ(check.comparison.max_abs_error, 2.0);
+    ASSERT_EQ(check.comparison.first_failures.size(), 2u);
+    EXPECT_EQ(check.comparison.first_failures[0], 1u);
+    EXPECT_EQ(check.comparison.first_failures[1], 13u);
+    ASSERT_EQ(check.expected_at_failures.size(), 2u);
+    EXPECT_EQ(check.expected_at_failures[0], recorded[1]);
+    EXPECT_EQ(check.expected_at_failures[1], recorded[13]);
+}
+
+/**
+ * @brief Behavior: A snapshot of another shape or element type is an error, not a comparison.
+ */
+TEST_F(SnapshotStoreTest, ShapeAndTypeMismatchesAreErrors) {
+    const std::vector<float> values(6, 1.0f);
+    const std::int64_t shape[] = {2, 3};
+    const std::int64_t other_shape[] = {3, 2};
+    ASSERT_TRUE(store.check<float>("typed", values, shape).recorded);
+
+    const auto reshaped = store.check<float>("typed", values, other_shape);
+    EXPECT_NE(reshaped.error.find("(2,3)"), std::string::npos);
+
+    const std::vector<double> doubles(6, 1.0);
+    EXPECT_FALSE(store.check<double>("typed", doubles, shape).error.empty());
+}
+
+/**
+ * @brief Behavior: In update mode every check records the array anew.
+ */
+TEST_F(SnapshotStoreTest, UpdateModeOverwrites) {
+    const std::int64_t shape[] = {3};
+    const std::vector<int> old_values{1, 2, 3};
+    const std::vector<int> new_values{4, 5, 6};
+    ASSERT_TRUE(store.check<int>("counts", old_values, shape).recorded);
+
+    store.configure(directory, true);
+    EXPECT_TRUE(store.check<int>("counts", new_values, shape).recorded);
+
+    store.configure(directory, false);
+    EXPECT_TRUE(store.check<int>("counts", new_values, shape).comparison.passed());
+    EXPECT_FALSE(store.check<int>("counts", old_values, shape).comparison.passed());
+}
+
+/**
+ * @brief Behavior: Complex values and smooth fields round-trip; with zlib the file is compressed.
+ */
+TEST_F(SnapshotStoreTest, RoundTripsCompressedChunks) {
+    const std::vector<double> field = smooth_field(1 << 16);
+    const std::int64_t shape[] = {256, 256};
+    store.configure(directory, false, 1 << 14);
+    ASSERT_TRUE(store.check<double>("field", field, shape).recorded);
+    EXPECT_TRUE(store.check<double>("field", field, shape).comparison.passed());
+#ifdef FORTEST_HAVE_ZLIB
+    EXPECT_LT(std::filesystem::file_size(store.path_of("field")), field.size() * sizeof(double));
+#endif
+
+    std::vector<std::complex<float>> waves(1000);
+    for (std::size_t i = 0; i < waves.size(); ++i) waves[i] = {static_cast<float>(i), -static_cast<float>(i)};
+    const std::int64_t wave_shape[] = {1000};
+    ASSERT_TRUE(store.check<std::complex<float>>("waves", waves, wave_shape).recorded);
+    EXPECT_TRUE(store.check<std::complex<float>>("waves", waves, wave_shape).comparison.passed());
+}
+
+/**
+ * @brief Behavior: A truncated snapshot file is reported, not read past its end.
+ */
+TEST_F(SnapshotStoreTest, CorruptFileIsAnError) {
+    const std::vector<double> values = smooth_field(100);
+    const std::int64_t shape[] = {100};
+    ASSERT_TRUE(store.check<double>("broken", values, shape).recorded);
+    std::filesystem::resize_file(store.path_of("broken"), 20);
+
+    EXPECT_FALSE(store.check<double>("broken", values, shape).error.empty());
+}
+
+/**
+ * @brief Behavior: assert_matches_snapshot counts one assertion per check and names failing elements.
+ */
+TEST_F(SnapshotStoreTest, AssertionReportsDifferences) {
+    Fortest::Assert<LastMessageLogger, Fortest::RuntimeVerbosity> check;
+    std::vector<double> values{1.0, 2.0, 3.0, 4.0};
+    const std::int64_t shape[] = {2, 2};
+
+    check.assert_matches_snapshot<double>("matrix", values, 0, 0, Fortest::Verbosity::ALL, shape, store);
+    EXPECT_NE(LastMessageLogger::last.find("recorded"), std::string::npos);
+
+    values[3] = 4.5;
+    check.assert_matches_snapshot<double>("matrix", values, 0, 0, Fortest::Verbosity::ALL, shape, store);
+    EXPECT_NE(LastMessageLogger::last.find("(2,2) expected 4"), std::string::npos) << LastMessageLogger::last;
+
+    EXPECT_EQ(check.get_num_passed(), 1);
+    EXPECT_EQ(check.get_num_failed(), 1);
+}
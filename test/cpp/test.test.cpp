@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
+#include <latch>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using ::testing::HasSubstr;
 
@@ -263,3 +267,143 @@ TEST_F(TestFixture, MultipleAddFixtureOverridesPrevious) {
     delete arg1;
     delete arg2;
 }
+
+/**
+ * @brief Behavior: A run records setup, body and teardown wall times separately.
+ */
+TEST_F(TestFixture, RunRecordsPhaseDurations) {
+    using namespace std::chrono_literals;
+    auto fixture = std::make_shared<Fortest::Fixture<void>>(
+        [](void *) { std::this_thread::sleep_for(2ms); },
+        [](void *) { std::this_thread::sleep_for(3ms); },
+        nullptr, Fortest::Scope::Test);
+
+    Fortest::Test test("timed", [](void *, void *, void *) {
+        std::this_thread::sleep_for(5ms);
+    });
+    test.add_fixture(fixture);
+    test.run(logger, assert_obj);
+
+    const auto &timing = test.get_timing();
+    EXPECT_GE(timing.setup_ns, 2'000'000);
+    EXPECT_GE(timing.body_ns, 5'000'000);
+    EXPECT_GE(timing.teardown_ns, 3'000'000);
+    EXPECT_GE(timing.cpu_ns, 0);
+    // Sleeping does not consume CPU time.
+    EXPECT_LT(timing.cpu_ns, timing.body_ns);
+    EXPECT_EQ(timing.total_ns(), timing.setup_ns + timing.body_ns + timing.teardown_ns);
+}
+
+/**
+ * @brief Behavior: Without PerfCounters enabled a run counts no hardware events.
+ */
+TEST_F(TestFixture, RunCountsNoEventsByDefault) {
+    Fortest::Test test("plain", [](void *, void *, void *) {});
+    test.run(logger, assert_obj);
+    EXPECT_FALSE(test.get_timing().counters.measured());
+    EXPECT_THAT(test.get_timing().summary(), ::testing::Not(HasSubstr("cycles")));
+}
+
+/**
+ * @brief Behavior: With PerfCounters enabled the body's events are counted where the kernel allows it.
+ */
+TEST_F(TestFixture, RunCountsEventsWhenEnabled) {
+    Fortest::PerfCounters::configure({.enabled = true});
+    if (!Fortest::PerfCounters::available()) {
+        Fortest::PerfCounters::configure({});
+        GTEST_SKIP() << "perf_event_open is not permitted here";
+    }
+    Fortest::Test test("counted", [](void *, void *, void *) {
+        volatile double sum = 0.0;
+        for (int i = 0; i < 100000; ++i) sum = sum + i;
+    });
+    test.run(logger, assert_obj);
+    Fortest::PerfCounters::configure({});
+
+    const auto &counters = test.get_timing().counters;
+    ASSERT_TRUE(counters.measured());
+    if (counters.has(Fortest::PerfCounts::Instructions)) {
+        EXPECT_GT(counters[Fortest::PerfCounts::Instructions], 100000);
+    }
+    EXPECT_THAT(test.get_timing().summary(), HasSubstr("; "));
+}
+
+/**
+ * @brief Behavior: Counts of several runs add up, and the summary shows the counted events only.
+ */
+TEST(PerfCountsBehavior, AccumulatesAndSummarizesCountedEvents) {
+    Fortest::PerfCounts a;
+    a.values[Fortest::PerfCounts::Cycles] = 1000;
+    a.values[Fortest::PerfCounts::Instructions] = 2000;
+    a.counted = (1U << Fortest::PerfCounts::Cycles) | (1U << Fortest::PerfCounts::Instructions);
+    Fortest::PerfCounts b;
+    b.values[Fortest::PerfCounts::CacheMisses] = 10;
+    b.counted = 1U << Fortest::PerfCounts::CacheMisses;
+
+    a += b;
+    EXPECT_EQ(a[Fortest::PerfCounts::Cycles], 1000);
+    EXPECT_TRUE(a.has(Fortest::PerfCounts::CacheMisses));
+    EXPECT_FALSE(a.has(Fortest::PerfCounts::Flops));
+
+    const std::string summary = a.summary(640);
+    EXPECT_THAT(summary, HasSubstr("cycles 1e+03"));
+    EXPECT_THAT(summary, HasSubstr("IPC 2.00"));
+    EXPECT_THAT(summary, HasSubstr("LLC misses 10"));
+    EXPECT_THAT(summary, HasSubstr("~1 GB/s"));
+    EXPECT_THAT(summary, ::testing::Not(HasSubstr("flops")));
+    EXPECT_EQ(Fortest::PerfCounts{}.summary(640), "");
+}
+
+/**
+ * @brief Behavior: With memory tracking on a run records the resident growth and peak of its body.
+ */
+TEST_F(TestFixture, RunTracksMemoryWhenEnabled) {
+    Fortest::Test untracked("untracked", [](void *, void *, void *) {});
+    untracked.run(logger, assert_obj);
+    EXPECT_FALSE(untracked.get_timing().memory.measured);
+
+    Fortest::MemoryTracking::configure(true);
+    std::int64_t growth = -1;
+    Fortest::Test tracked("tracked", [&](void *, void *, void *) {
+        std::vector<char> block(32 << 20);
+        for (std::size_t i = 0; i < block.size(); i += 4096) block[i] = 1;
+        growth = Fortest::MemoryTracking::peak_growth_bytes();
+    });
+    tracked.run(logger, assert_obj);
+    Fortest::MemoryTracking::configure(false);
+
+    const auto &memory = tracked.get_timing().memory;
+    ASSERT_TRUE(memory.measured);
+    if (memory.peak_rss_bytes == 0) GTEST_SKIP() << "no procfs";
+    EXPECT_GE(growth, 16 << 20);
+    EXPECT_GE(memory.peak_rss_bytes, 32 << 20);
+    EXPECT_THAT(tracked.get_timing().summary(), HasSubstr("MiB"));
+}
+
+/**
+ * @brief Behavior: Tests whose bodies overlap in one process report their peak as not measured.
+ */
+TEST_F(TestFixture, OverlappingRunsDoNotMeasureThePeak) {
+    Fortest::MemoryTracking::configure(true);
+    std::latch both_started(2);
+    std::int64_t limited = 0;
+    const auto body = [&](void *, void *, void *) {
+        both_started.arrive_and_wait();
+        limited = assert_obj.assert_max_memory(std::int64_t{1} << 40);
+    };
+    Fortest::Test first("first", body);
+    Fortest::Test second("second", [&](void *, void *, void *) { both_started.arrive_and_wait(); });
+    std::thread other([&] { second.run(logger, assert_obj); });
+    first.run(logger, assert_obj);
+    other.join();
+    Fortest::MemoryTracking::configure(false);
+
+    for (const auto *test : {&first, &second}) {
+        const auto &memory = test->get_timing().memory;
+        ASSERT_TRUE(memory.measured);
+        EXPECT_FALSE(memory.has_peak());
+        EXPECT_THAT(memory.summary(), HasSubstr("peak not measured"));
+    }
+    EXPECT_EQ(limited, Fortest::MemoryUsage::peak_not_measured);
+    EXPECT_EQ(assert_obj.get_num_failed(), 1);
+}
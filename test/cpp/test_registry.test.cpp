@@ -0,0 +1,138 @@
+#include "name_table.hpp"
+#include "test_registry.hpp"
+#include "test_suite.hpp"
+#include "assert.hpp"
+#include "logging.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ::testing::ElementsAre;
+
+/**
+ * @test Behavior: Interning a name twice returns the same id.
+ */
+TEST(NameTableBehavior, InternsEachNameOnce) {
+    Fortest::NameTable names;
+
+    const auto [first, added_first] = names.intern("alpha");
+    const auto [second, added_second] = names.intern("beta");
+    const auto [again, added_again] = names.intern(std::string("alpha"));
+
+    EXPECT_TRUE(added_first);
+    EXPECT_TRUE(added_second);
+    EXPECT_FALSE(added_again);
+    EXPECT_EQ(first, 0u);
+    EXPECT_EQ(second, 1u);
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(names.size(), 2u);
+    EXPECT_EQ(names.name(second), "beta");
+}
+
+/**
+ * @test Behavior: Lookups find interned names and nothing else.
+ */
+TEST(NameTableBehavior, FindsByView) {
+    Fortest::NameTable names;
+    names.intern("suite_a");
+    const char buffer[] = "suite_b and more";
+
+    EXPECT_FALSE(names.find(std::string_view(buffer, 7)).has_value());
+    names.intern(std::string_view(buffer, 7));
+    EXPECT_EQ(names.find("suite_b"), std::optional<Fortest::NameId>(1u));
+    EXPECT_EQ(names.find("suite_a"), std::optional<Fortest::NameId>(0u));
+}
+
+/**
+ * @test Behavior: Stored names stay valid while many more are added.
+ */
+TEST(NameTableBehavior, ManyNamesKeepTheirIds) {
+    Fortest::NameTable names;
+    names.reserve(100000);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(names.intern("case_" + std::to_string(i)).first, static_cast<Fortest::NameId>(i));
+    }
+    for (int i = 0; i < 100000; i += 997) {
+        EXPECT_EQ(names.find("case_" + std::to_string(i)), std::optional<Fortest::NameId>(i));
+        EXPECT_EQ(names.name(i), "case_" + std::to_string(i));
+    }
+}
+
+/**
+ * @test Behavior: sorted() orders ids by name, not by insertion.
+ */
+TEST(NameTableBehavior, SortedOrdersByName) {
+    Fortest::NameTable names;
+    names.intern("gamma");
+    names.intern("alpha");
+    names.intern("beta");
+
+    EXPECT_THAT(names.sorted(), ElementsAre(1u, 2u, 0u));
+}
+
+/**
+ * @test Behavior: The registry keeps the first of two tests with the same name.
+ */
+TEST(TestRegistryBehavior, DuplicateNameKeepsFirstTest) {
+    Fortest::TestRegistry registry;
+    int called = 0;
+
+    const auto id = registry.add_test("t", [&](void *, void *, void *) { called = 1; });
+    const auto dup = registry.add_test("t", [&](void *, void *, void *) { called = 2; });
+
+    EXPECT_EQ(id, dup);
+    EXPECT_EQ(registry.num_tests(), 1u);
+    registry.body(id)(nullptr, nullptr, nullptr);
+    EXPECT_EQ(called, 1);
+    EXPECT_EQ(registry.status(id), Fortest::Test::Status::NONE);
+}
+
+/**
+ * @test Behavior: Results are stored per id, and parameterized tests have their own ids.
+ */
+TEST(TestRegistryBehavior, StoresResultsById) {
+    Fortest::TestRegistry registry;
+    const auto a = registry.add_test("a", [](void *, void *, void *) {});
+    const auto b = registry.add_test("b", [](void *, void *, void *) {});
+    const auto p = registry.add_parameterized("a", [](void *, void *, void *, int) {}, {1, 2, 3});
+
+    registry.set_result(b, Fortest::Test::Status::FAIL, Fortest::TestTiming{.body_ns = 42});
+
+    EXPECT_EQ(registry.status(a), Fortest::Test::Status::NONE);
+    EXPECT_EQ(registry.status(b), Fortest::Test::Status::FAIL);
+    EXPECT_EQ(registry.timing(b).body_ns, 42);
+    EXPECT_EQ(p, 0u);
+    EXPECT_EQ(registry.find_parameterized("a"), std::optional<Fortest::TestRegistry::Id>(p));
+    EXPECT_THAT(registry.parameterized(p).get_parameters(), ElementsAre(1, 2, 3));
+    EXPECT_FALSE(registry.find_test("c").has_value());
+}
+
+/**
+ * @test Behavior: Thousands of tests share the suite's fixture and report by name.
+ */
+TEST(TestRegistryBehavior, SuiteFixtureIsSharedByAllTests) {
+    std::ostringstream buffer;
+    auto logger = std::make_shared<Fortest::Logger>(buffer);
+    Fortest::Assert<Fortest::Logger> asserter(static_cast<std::ostream &>(buffer));
+    Fortest::TestSuite<Fortest::Logger> suite("Big", asserter);
+
+    int value = 7;
+    constexpr int num_tests = 5000;
+    suite.reserve(num_tests);
+    for (int i = 0; i < num_tests; ++i) {
+        suite.add_test("t" + std::to_string(i), [&asserter, i](void *, void *args, void *) {
+            asserter.assert_equal(*static_cast<int *>(args), i == 1234 ? 8 : 7);
+        });
+    }
+    suite.add_fixture(Fortest::Fixture<void>(nullptr, nullptr, &value, Fortest::Scope::Suite));
+
+    suite.run(logger);
+
+    EXPECT_EQ(suite.get_registry().num_tests(), static_cast<std::size_t>(num_tests));
+    EXPECT_EQ(suite.get_status("t0"), std::optional(Fortest::Test::Status::PASS));
+    EXPECT_EQ(suite.get_status("t1234"), std::optional(Fortest::Test::Status::FAIL));
+    EXPECT_FALSE(suite.get_status("missing").has_value());
+}
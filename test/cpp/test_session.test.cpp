@@ -3,7 +3,18 @@
 #include "logging.hpp"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <latch>
+#include <thread>
+#include <mutex>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
 using ::testing::HasSubstr;
 
@@ -63,6 +74,85 @@ TEST_F(TestSessionBehavior, AddTestToUnknownSuiteThrows) {
     );
 }
 
+/**
+ * @brief Behavior: Names may be views into a larger, unterminated buffer.
+ */
+TEST_F(TestSessionBehavior, RegistersNamesFromStringViews) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    const char buffer[] = {'S', 'u', 'i', 't', 'e', 't', 'e', 's', 't', ' ', ' '};
+    const std::string_view suite(buffer, 5);
+    const std::string_view test(buffer + 5, 4);
+
+    session.add_test_suite(suite);
+    session.add_test(suite, test, [](void *, void *, void *) {});
+    session.run(logger);
+
+    auto statuses = session.get_test_suite_status("Suite");
+    ASSERT_EQ(statuses.size(), 1u);
+    EXPECT_EQ(statuses["test"], Fortest::Test::Status::PASS);
+}
+
+namespace {
+    void passing_body(void *, void *, void *) {}
+}
+
+/**
+ * @brief Behavior: A table of tests registers like add_test() per row; an unknown suite adds none.
+ */
+TEST_F(TestSessionBehavior, AddsTablesOfTests) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.add_test_suite("A");
+    session.add_test_suite("B");
+    session.add_test("A", "existing", &passing_body);
+    const Fortest::TestRecord table[] = {
+        {"A", "first", &passing_body},
+        {"A", "second", &passing_body},
+        {"B", "first", &passing_body},
+        {"A", "third", &passing_body},
+        {"A", "first", &passing_body},
+    };
+    session.add_tests(table);
+
+    EXPECT_EQ(session.find_suite("A").get_registry().num_tests(), 4u);
+    EXPECT_EQ(session.find_suite("B").get_registry().num_tests(), 1u);
+    EXPECT_EQ(session.get_status_counts().not_run(), 5);
+
+    const Fortest::TestRecord unknown[] = {{"B", "second", &passing_body}, {"C", "first", &passing_body}};
+    EXPECT_THROW(session.add_tests(unknown), std::runtime_error);
+    EXPECT_EQ(session.find_suite("B").get_registry().num_tests(), 1u);
+
+    session.run(logger);
+    EXPECT_EQ(session.get_status_counts().passed(), 5);
+}
+
+/**
+ * @brief Behavior: The session counts tests per status and suites with failures.
+ */
+TEST_F(TestSessionBehavior, CountsStatusesAndFailingSuites) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 3});
+    for (const char *name : {"A", "B", "C"}) {
+        auto &suite = session.add_test_suite(name);
+        suite.add_test("ok", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+    }
+    session.add_test("B", "bad", [&](void *, void *, void *) { assert_obj.assert_true(false); });
+    session.add_parameterized_test("C", "sweep", [&](void *, void *, void *, int idx) {
+        assert_obj.assert_true(idx != 7);
+    }, {5, 6, 7, 8});
+
+    EXPECT_EQ(session.get_status_counts().not_run(), 5);
+    EXPECT_EQ(session.get_num_failing_suites(), 0);
+
+    session.run(logger);
+
+    const auto counts = session.get_status_counts();
+    EXPECT_EQ(counts.passed(), 3);
+    EXPECT_EQ(counts.failed(), 2);
+    EXPECT_EQ(counts.total(), 5);
+    EXPECT_EQ(session.get_num_failing_suites(), 2);
+    EXPECT_EQ(session.find_suite("C").get_status("sweep"), std::optional(Fortest::Test::Status::FAIL));
+}
+
 /**
  * @brief Behavior: Session-level fixture setup and teardown run once per session.
  */
@@ -328,3 +418,841 @@ TEST_F(TestSessionBehavior, SessionFixtureAppliesToParameterizedTests) {
     EXPECT_EQ(statuses["uses_fixture"], Fortest::Test::Status::PASS);
 }
 
+/**
+ * @brief Behavior: With several workers every test still gets its own status.
+ */
+TEST_F(TestSessionBehavior, ParallelRunKeepsPerTestStatuses) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 4});
+
+    for (int s = 0; s < 4; ++s) {
+        auto &suite = session.add_test_suite("Suite" + std::to_string(s));
+        for (int t = 0; t < 25; ++t) {
+            const bool pass = (t % 3) != 0;
+            suite.add_test("t" + std::to_string(t), [&, pass](void *, void *, void *) {
+                for (int i = 0; i < 100; ++i) {
+                    assert_obj.assert_true(true);
+                }
+                assert_obj.assert_true(pass);
+            });
+        }
+    }
+
+    session.run(logger);
+
+    for (int s = 0; s < 4; ++s) {
+        auto statuses = session.get_test_suite_status("Suite" + std::to_string(s));
+        for (int t = 0; t < 25; ++t) {
+            const auto expected = (t % 3) != 0
+                                      ? Fortest::Test::Status::PASS
+                                      : Fortest::Test::Status::FAIL;
+            EXPECT_EQ(statuses["t" + std::to_string(t)], expected);
+        }
+    }
+}
+
+/**
+ * @brief Behavior: With several workers, a failure on a thread bound to the test's context
+ * fails that test alone, and its message is in the test's report.
+ */
+TEST_F(TestSessionBehavior, ParallelRunCountsAssertionsOfTestThreads) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 2, .results_db = ""});
+    std::latch both_running(2);
+    const auto spawn = [&](bool condition) {
+        return [&, condition](void *, void *, void *) {
+            both_running.arrive_and_wait();
+            assert_obj.assert_true(true);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&, condition, context = Fortest::AssertContext::current()] {
+                    Fortest::AssertContext::Binding binding(context);
+                    assert_obj.assert_true(condition);
+                });
+            }
+            for (auto &thread: threads) thread.join();
+        };
+    };
+    auto &suite = session.add_test_suite("Threads");
+    suite.add_test("spawned_fail", spawn(false));
+    suite.add_test("spawned_pass", spawn(true));
+
+    session.run(logger);
+
+    const auto statuses = session.get_test_suite_status("Threads");
+    EXPECT_EQ(statuses.at("spawned_fail"), Fortest::Test::Status::FAIL);
+    EXPECT_EQ(statuses.at("spawned_pass"), Fortest::Test::Status::PASS);
+    const std::string output = buffer.str();
+    const auto failed = output.find("Test failed: spawned_fail");
+    ASSERT_NE(failed, std::string::npos);
+    EXPECT_NE(output.find("thread 4: condition is false", failed), std::string::npos);
+}
+
+/**
+ * @brief Behavior: The cases of one parameterized test are shared by the
+ * workers, each case runs once, and the statuses end up in the test.
+ */
+TEST_F(TestSessionBehavior, ParallelRunShardsParameterizedCases) {
+    constexpr int num_cases = 2000;
+    std::vector<std::atomic<int>> runs(num_cases);
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 4});
+    auto &suite = session.add_test_suite("Sweep");
+    suite.register_parameterized_test("cases", [&](void *, void *, void *, int idx) {
+        runs[idx - 1].fetch_add(1);
+        {
+            std::lock_guard lock(mutex);
+            if (std::find(threads.begin(), threads.end(), std::this_thread::get_id()) == threads.end()) {
+                threads.push_back(std::this_thread::get_id());
+            }
+        }
+        // Uneven cost: every seventh case takes longer.
+        std::this_thread::sleep_for(std::chrono::microseconds(idx % 7 == 0 ? 200 : 1));
+        assert_obj.assert_true(idx % 100 != 0);
+    }, Fortest::ParameterSpace::range(1, num_cases));
+
+    session.run(logger);
+
+    for (int k = 0; k < num_cases; ++k) ASSERT_EQ(runs[k].load(), 1) << "case " << k;
+    EXPECT_GT(threads.size(), 1u);
+
+    const auto &ptest = suite.get_registry().parameterized(0);
+    EXPECT_EQ(ptest.get_status_counts().passed(), num_cases - num_cases / 100);
+    EXPECT_EQ(ptest.get_status(300), Fortest::ParameterizedTest::Status::FAIL);
+    EXPECT_EQ(ptest.get_status(301), Fortest::ParameterizedTest::Status::PASS);
+    EXPECT_EQ(suite.get_status("cases"), std::optional(Fortest::Test::Status::FAIL));
+    EXPECT_EQ(session.get_status_counts().failed(), 1);
+    EXPECT_THAT(get_output(), HasSubstr("Parameterized test failed: cases"));
+}
+
+/**
+ * @brief Behavior: With a distributed case source each process runs only
+ * the chunks it draws, and the merge after the run completes the test.
+ */
+TEST_F(TestSessionBehavior, DistributedCasesMergeAfterTheRun) {
+    // Stands in for another process that runs the odd cases and reports them as passed.
+    class EvenCases final : public Fortest::CaseDistributor {
+        std::atomic<std::size_t> m_next{0};
+        std::size_t m_num_cases;
+
+    public:
+        explicit EvenCases(std::size_t num_cases) : m_num_cases(num_cases) {}
+
+        std::optional<Fortest::CaseChunk> next() override {
+            const std::size_t k = m_next.fetch_add(2);
+            if (k >= m_num_cases) return std::nullopt;
+            return Fortest::CaseChunk{k, k + 1};
+        }
+
+        [[nodiscard]] bool is_distributed() const noexcept override { return true; }
+
+        void merge(Fortest::ParameterizedTest &test) override {
+            auto statuses = test.get_case_statuses();
+            for (std::size_t k = 1; k < statuses.size(); k += 2) {
+                statuses[k] = Fortest::ParameterizedTest::Status::PASS;
+            }
+            test.assign_results(std::move(statuses), test.get_total_timing());
+        }
+    };
+
+    for (const std::size_t workers : {1u, 3u}) {
+        std::vector<int> ran;
+        std::mutex mutex;
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.num_workers = workers});
+        session.set_case_distribution([](std::size_t num_cases, std::size_t, std::size_t) {
+            return std::make_unique<EvenCases>(num_cases);
+        });
+        auto &suite = session.add_test_suite("Shared");
+        suite.register_parameterized_test("cases", [&](void *, void *, void *, int idx) {
+            std::lock_guard lock(mutex);
+            ran.push_back(idx);
+        }, {10, 11, 12, 13, 14});
+
+        session.run(logger);
+
+        std::sort(ran.begin(), ran.end());
+        EXPECT_EQ(ran, (std::vector<int>{10, 12, 14}));
+        const auto &ptest = suite.get_registry().parameterized(0);
+        EXPECT_EQ(ptest.get_status_counts().passed(), 5);
+        EXPECT_EQ(suite.get_status("cases"), std::optional(Fortest::Test::Status::PASS));
+        EXPECT_EQ(session.get_status_counts().passed(), 1);
+    }
+}
+
+/**
+ * @brief Behavior: In a parallel run, fixtures still wrap the tests that use them.
+ */
+TEST_F(TestSessionBehavior, ParallelRunKeepsFixtureOrdering) {
+    std::mutex mutex;
+    std::vector<std::string> events;
+    auto record = [&](const std::string &event) {
+        std::lock_guard lock(mutex);
+        events.push_back(event);
+    };
+
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 3});
+    session.add_fixture(Fortest::Fixture<void>(
+        [&](void *) { record("session_setup"); },
+        [&](void *) { record("session_teardown"); },
+        nullptr, Fortest::Scope::Session));
+
+    for (const std::string name : {"A", "B"}) {
+        auto &suite = session.add_test_suite(name);
+        suite.add_fixture(Fortest::Fixture<void>(
+            [&, name](void *) { record(name + "_setup"); },
+            [&, name](void *) { record(name + "_teardown"); },
+            nullptr, Fortest::Scope::Suite));
+        for (int t = 0; t < 5; ++t) {
+            suite.add_test("t" + std::to_string(t), [&, name](void *, void *, void *) {
+                record(name + "_test");
+            });
+        }
+    }
+
+    session.run(logger);
+
+    auto position = [&](const std::string &event) {
+        return std::find(events.begin(), events.end(), event) - events.begin();
+    };
+    ASSERT_EQ(events.size(), 16u);
+    EXPECT_EQ(events.front(), "session_setup");
+    EXPECT_EQ(events.back(), "session_teardown");
+    for (const std::string name : {"A", "B"}) {
+        const auto setup = position(name + "_setup");
+        const auto teardown = position(name + "_teardown");
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            if (events[i] == name + "_test") {
+                EXPECT_LT(setup, static_cast<std::ptrdiff_t>(i));
+                EXPECT_GT(teardown, static_cast<std::ptrdiff_t>(i));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Behavior: With process isolation a crashing or hanging test is
+ * reported as CRASH or TIMEOUT and the other tests still run.
+ */
+TEST_F(TestSessionBehavior, IsolatedRunContainsCrashesAndTimeouts) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{
+        .num_workers = 2,
+        .isolation = Fortest::RunOptions::Isolation::Process,
+        .timeout_seconds = 0.5});
+
+    auto &suite = session.add_test_suite("Isolated");
+    suite.add_test("crash", [](void *, void *, void *) { std::raise(SIGSEGV); });
+    suite.add_test("fail", [&](void *, void *, void *) { assert_obj.assert_true(false); });
+    suite.add_test("hang", [](void *, void *, void *) {
+        std::this_thread::sleep_for(std::chrono::seconds(30));
+    });
+    suite.add_test("pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+    suite.register_parameterized_test("param", [&](void *, void *, void *, int idx) {
+        if (idx == 2) std::abort();
+        assert_obj.assert_true(true);
+    }, {1, 2, 3});
+
+    session.run(logger);
+
+    auto statuses = session.get_test_suite_status("Isolated");
+    EXPECT_EQ(statuses["crash"], Fortest::Test::Status::CRASH);
+    EXPECT_EQ(statuses["fail"], Fortest::Test::Status::FAIL);
+    EXPECT_EQ(statuses["hang"], Fortest::Test::Status::TIMEOUT);
+    EXPECT_EQ(statuses["pass"], Fortest::Test::Status::PASS);
+    EXPECT_EQ(statuses["param"], Fortest::Test::Status::CRASH);
+    EXPECT_THAT(get_output(), HasSubstr("[PASS] Test passed: param [param=3]"));
+    EXPECT_THAT(get_output(), HasSubstr("[CRASH] Test crashed: param [param=2]"));
+
+    const auto counts = session.get_status_counts();
+    EXPECT_EQ(counts[Fortest::Test::Status::CRASH], 2);
+    EXPECT_EQ(counts[Fortest::Test::Status::TIMEOUT], 1);
+    EXPECT_EQ(counts[Fortest::Test::Status::FAIL], 1);
+    EXPECT_EQ(counts.passed(), 1);
+    EXPECT_EQ(counts.not_run(), 0);
+    EXPECT_EQ(session.get_num_failing_suites(), 1);
+}
+
+/**
+ * @brief Behavior: Suite fixtures wrap isolated tests and are torn down by the parent.
+ */
+TEST_F(TestSessionBehavior, IsolatedRunKeepsSuiteFixture) {
+    int setups = 0;
+    int teardowns = 0;
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.isolation = Fortest::RunOptions::Isolation::Process});
+
+    auto &suite = session.add_test_suite("Fixtured");
+    suite.add_fixture(Fortest::Fixture<void>(
+        [&](void *) { ++setups; }, [&](void *) { ++teardowns; },
+        nullptr, Fortest::Scope::Suite));
+    suite.add_test("sees_setup", [&](void *, void *, void *) { assert_obj.assert_true(setups == 1); });
+
+    session.run(logger);
+
+    EXPECT_EQ(session.get_test_suite_status("Fixtured")["sees_setup"], Fortest::Test::Status::PASS);
+    EXPECT_EQ(setups, 1);
+    EXPECT_EQ(teardowns, 1);
+}
+
+/**
+ * @brief Behavior: Durations measured in a forked child reach the parent.
+ */
+TEST_F(TestSessionBehavior, IsolatedRunReportsChildDurations) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.isolation = Fortest::RunOptions::Isolation::Process});
+
+    auto &suite = session.add_test_suite("Timed");
+    suite.add_test("sleepy", [](void *, void *, void *) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+    session.run(logger);
+
+    const auto timings = session.get_test_suite_timings("Timed");
+    ASSERT_EQ(timings.count("sleepy"), 1u);
+    EXPECT_GE(timings.at("sleepy").body_ns, 5'000'000);
+    EXPECT_THAT(get_output(), HasSubstr("Test passed: sleepy ("));
+}
+
+/**
+ * @brief Behavior: A session writes all suites into one database, one run per run().
+ */
+TEST_F(TestSessionBehavior, RunRecordsResultsInOneDatabase) {
+    const std::string path = "test_session_results.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.get_options().results_db = path;
+    for (const std::string name : {"A", "B"}) {
+        auto &suite = session.add_test_suite(name);
+        suite.add_test("pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+        suite.register_parameterized_test("param", [&](void *, void *, void *, int idx) {
+            assert_obj.assert_true(idx != 2);
+        }, {1, 2});
+    }
+    session.run(logger);
+    session.run(logger);
+
+    {
+        SqliteDb db(path);
+        SqliteStmt counts(db.get(),
+                          "SELECT (SELECT COUNT(*) FROM runs), (SELECT COUNT(*) FROM suites),"
+                          " (SELECT COUNT(*) FROM tests), (SELECT COUNT(*) FROM results);");
+        ASSERT_TRUE(counts.step());
+        EXPECT_EQ(sqlite3_column_int64(counts.get(), 0), 2);
+        EXPECT_EQ(sqlite3_column_int64(counts.get(), 1), 2);
+        EXPECT_EQ(sqlite3_column_int64(counts.get(), 2), 6);
+        EXPECT_EQ(sqlite3_column_int64(counts.get(), 3), 12);
+
+        SqliteStmt failed(db.get(),
+                          "SELECT suites.name, tests.name FROM results"
+                          " JOIN tests ON tests.id = results.test_id"
+                          " JOIN suites ON suites.id = tests.suite_id"
+                          " WHERE status = 'FAIL' AND run_id = 1 ORDER BY suites.name;");
+        ASSERT_TRUE(failed.step());
+        EXPECT_STREQ(failed.column_text(0), "A");
+        EXPECT_STREQ(failed.column_text(1), "param [param=2]");
+    }
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: Reports from the options and added reporters receive every result as it finishes.
+ */
+TEST_F(TestSessionBehavior, RunWritesReports) {
+    const std::string path = "test_session_report.jsonl";
+    std::remove(path.c_str());
+    auto extra = std::make_shared<Fortest::ResultBuffer>();
+
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 2, .results_db = "", .reports = "jsonl:" + path});
+    session.add_reporter(extra);
+    auto &suite = session.add_test_suite("Reported");
+    suite.add_test("pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+    suite.register_parameterized_test("param", [&](void *, void *, void *, int idx) {
+        assert_obj.assert_true(idx != 2);
+    }, {1, 2, 3});
+    session.run(logger);
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_THAT(lines.front(), HasSubstr("session_start"));
+    EXPECT_THAT(lines.back(), HasSubstr("\"tests\":4,\"failures\":1"));
+    EXPECT_EQ(extra->take().size(), 4u);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Behavior: Added event sinks see the session, suite, test and assertion events of a run.
+ */
+TEST_F(TestSessionBehavior, RunPublishesEvents) {
+    auto counter = std::make_shared<Fortest::EventCounter>();
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 2, .results_db = ""});
+    session.add_event_sink(counter);
+    auto &suite = session.add_test_suite("Events");
+    suite.add_test("pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+    suite.register_parameterized_test("param", [&](void *, void *, void *, int idx) {
+        assert_obj.assert_true(idx != 2);
+    }, {1, 2, 3});
+    session.run(logger);
+
+    EXPECT_EQ(counter->suites(), 1);
+    EXPECT_EQ(counter->passed(), 3);
+    EXPECT_EQ(counter->failed(), 1);
+    EXPECT_EQ(counter->failed_assertions(), 1);
+    EXPECT_FALSE(Fortest::EventBus::global().has_subscribers());
+}
+
+/**
+ * @brief Behavior: Parallel runs start the tests with the longest expected duration first.
+ */
+TEST_F(TestSessionBehavior, ParallelRunStartsLongestTestsFirst) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 2, .results_db = ""});
+    session.set_cost_model([](std::string_view, std::string_view test) -> std::optional<double> {
+        if (test == "unknown") return std::nullopt;
+        return std::stod(std::string(test.substr(1)));
+    });
+
+    std::mutex mutex;
+    std::vector<std::string> started;
+    const std::vector<std::string> names = {"t1", "t30", "unknown", "t5", "t2"};
+    std::atomic<int> arrived{0};
+    for (const std::string suite : {"A", "B"}) session.add_test_suite(suite);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        session.add_test(i % 2 ? "B" : "A", names[i], [&, name = names[i]](void *, void *, void *) {
+            {
+                std::lock_guard lock(mutex);
+                started.push_back(name);
+            }
+            // Keep both workers busy with the first two tests.
+            if (arrived.fetch_add(1) < 2) {
+                while (arrived.load() < 2) std::this_thread::yield();
+            }
+            assert_obj.assert_true(true);
+        });
+    }
+    session.run(logger);
+
+    ASSERT_EQ(started.size(), names.size());
+    // The unknown test is charged the mean of the others, 9.5 ms.
+    EXPECT_THAT(std::vector(started.begin(), started.begin() + 2),
+                ::testing::UnorderedElementsAre("t30", "unknown"));
+}
+
+/**
+ * @brief Behavior: Rerun modes repeat the failed and new tests, optionally before the others.
+ */
+TEST_F(TestSessionBehavior, RerunRepeatsFailedAndNewTests) {
+    const std::string path = "test_session_rerun.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    std::vector<std::string> ran;
+    const auto run_session = [&](Fortest::RunOptions::Rerun rerun, bool with_new_test) {
+        ran.clear();
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.rerun = rerun, .results_db = path});
+        auto &suite = session.add_test_suite("Suite");
+        for (const std::string name : {"a_pass", "b_fail", "c_pass"}) {
+            suite.add_test(name, [&, name](void *, void *, void *) {
+                ran.push_back(name);
+                assert_obj.assert_true(name != "b_fail");
+            });
+        }
+        suite.register_parameterized_test("d_param", [&](void *, void *, void *, int idx) {
+            if (idx == 0) ran.push_back("d_param");
+            assert_obj.assert_true(idx != 1);
+        }, {0, 1});
+        if (with_new_test) {
+            suite.add_test("e_new", [&](void *, void *, void *) {
+                ran.push_back("e_new");
+                assert_obj.assert_true(true);
+            });
+        }
+        session.run(logger);
+        return session.get_status_counts();
+    };
+
+    run_session(Fortest::RunOptions::Rerun::All, false);
+    EXPECT_EQ(ran.size(), 4u);
+
+    const auto counts = run_session(Fortest::RunOptions::Rerun::FailedOnly, true);
+    EXPECT_EQ(ran, (std::vector<std::string>{"b_fail", "e_new", "d_param"}));
+    EXPECT_EQ(counts.failed(), 2);
+    EXPECT_EQ(counts.not_run(), 2);
+    EXPECT_THAT(get_output(), HasSubstr("Running 3 failed or new tests"));
+
+    run_session(Fortest::RunOptions::Rerun::FailedFirst, true);
+    EXPECT_EQ(ran, (std::vector<std::string>{"b_fail", "d_param", "a_pass", "c_pass", "e_new"}));
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: Skipping unchanged suites runs only the failing tests of suites with the same fingerprint.
+ */
+TEST_F(TestSessionBehavior, SkipUnchangedRunsChangedSuites) {
+    const std::string path = "test_session_unchanged.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    std::vector<std::string> ran;
+    const auto run_session = [&](const std::string &fingerprint) {
+        ran.clear();
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.skip_unchanged = true, .results_db = path});
+        for (const std::string suite_name : {"Changing", "Stable"}) {
+            auto &suite = session.add_test_suite(suite_name);
+            suite.set_fingerprint(suite_name == "Changing" ? fingerprint : "stable");
+            for (const std::string name : {"pass", "fail"}) {
+                suite.add_test(name, [&, name, suite_name](void *, void *, void *) {
+                    ran.push_back(suite_name + "." + name);
+                    assert_obj.assert_true(name == "pass");
+                });
+            }
+        }
+        session.run(logger);
+    };
+
+    run_session("v1");
+    EXPECT_EQ(ran.size(), 4u);
+    run_session("v1");
+    EXPECT_EQ(ran, (std::vector<std::string>{"Changing.fail", "Stable.fail"}));
+    run_session("v2");
+    EXPECT_EQ(ran, (std::vector<std::string>{"Changing.fail", "Changing.pass", "Stable.fail"}));
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: A cacheable test that passed with the same code, inputs and flags is reported as CACHED.
+ */
+TEST_F(TestSessionBehavior, CacheSkipsUnchangedPassingTests) {
+    const std::string path = "test_session_cache.sqlite";
+    const std::string input = "test_session_cache.input";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+    const auto write_input = [&](const char *text) { std::ofstream(input) << text; };
+    write_input("mesh v1");
+
+    std::vector<std::string> ran;
+    const auto run_session = [&](bool use_cache, const std::string &flags) {
+        ran.clear();
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.use_cache = use_cache, .results_db = path});
+        auto &suite = session.add_test_suite("Suite");
+        suite.set_fingerprint("code");
+        for (const std::string name : {"deterministic", "failing", "plain"}) {
+            suite.add_test(name, [&, name](void *, void *, void *) {
+                ran.push_back(name);
+                assert_obj.assert_true(name != "failing");
+            });
+        }
+        suite.set_cacheable("deterministic", {input}, flags);
+        suite.set_cacheable("failing");
+        session.run(logger);
+        return session.get_status_counts();
+    };
+
+    run_session(true, "-O2");
+    EXPECT_EQ(ran.size(), 3u);
+
+    const auto counts = run_session(true, "-O2");
+    EXPECT_EQ(ran, (std::vector<std::string>{"failing", "plain"}));
+    EXPECT_EQ(counts.cached(), 1);
+    EXPECT_EQ(counts.passed(), 1);
+    EXPECT_THAT(get_output(), HasSubstr("Test cached: deterministic"));
+
+    run_session(false, "-O2");
+    EXPECT_EQ(ran.size(), 3u);
+    run_session(true, "-O3");
+    EXPECT_EQ(ran.size(), 3u);
+    write_input("mesh v2");
+    run_session(true, "-O3");
+    EXPECT_EQ(ran.size(), 3u);
+    run_session(true, "-O3");
+    EXPECT_EQ(ran, (std::vector<std::string>{"failing", "plain"}));
+
+    std::remove(input.c_str());
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: A failure under a cache key, even in a forced run, makes the next cached run run the test.
+ */
+TEST_F(TestSessionBehavior, CacheRunsTestsWhoseLatestResultFailed) {
+    const std::string path = "test_session_cache_failed.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    int runs = 0;
+    bool passing = true;
+    const auto run_session = [&](bool use_cache) {
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.use_cache = use_cache, .results_db = path});
+        auto &suite = session.add_test_suite("Suite");
+        suite.set_fingerprint("code");
+        suite.add_test("flaky", [&](void *, void *, void *) {
+            ++runs;
+            assert_obj.assert_true(passing);
+        });
+        suite.set_cacheable("flaky");
+        session.run(logger);
+        return session.get_test_suite_status("Suite").at("flaky");
+    };
+
+    EXPECT_EQ(run_session(true), Fortest::Test::Status::PASS);
+    passing = false;
+    EXPECT_EQ(run_session(false), Fortest::Test::Status::FAIL);
+    EXPECT_EQ(run_session(true), Fortest::Test::Status::FAIL);
+    EXPECT_EQ(runs, 3);
+    passing = true;
+    EXPECT_EQ(run_session(true), Fortest::Test::Status::PASS);
+    EXPECT_EQ(run_session(true), Fortest::Test::Status::CACHED);
+    EXPECT_EQ(runs, 4);
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: A name filter runs only matching tests and never sets up filtered-out suites.
+ */
+TEST_F(TestSessionBehavior, FilterSkipsUnmatchedSuitesAndFixtures) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.filter = "Mesh.*-*.slow", .results_db = ""});
+
+    std::vector<std::string> ran;
+    int heavy_setups = 0;
+    for (const std::string suite_name : {"Mesh", "Heavy"}) {
+        auto &suite = session.add_test_suite(suite_name);
+        for (const std::string name : {"fast", "slow"}) {
+            suite.add_test(name, [&, name, suite_name](void *, void *, void *) {
+                ran.push_back(suite_name + "." + name);
+                assert_obj.assert_true(true);
+            });
+        }
+    }
+    session.add_fixture("Heavy", Fortest::Fixture<void>(
+        [&](void *) { ++heavy_setups; }, [](void *) {}, nullptr, Fortest::Scope::Suite));
+    session.run(logger);
+
+    EXPECT_EQ(ran, (std::vector<std::string>{"Mesh.fast"}));
+    EXPECT_EQ(heavy_setups, 0);
+    EXPECT_EQ(session.get_status_counts().not_run(), 3);
+    EXPECT_THAT(get_output(), HasSubstr("Running 1 selected tests"));
+    EXPECT_THAT(get_output(), ::testing::Not(HasSubstr("Running test suite: Heavy")));
+}
+
+/**
+ * @brief Behavior: A benchmark's statistics are logged and stored with its result, also from a child process.
+ */
+TEST_F(TestSessionBehavior, BenchmarkRecordsStatistics) {
+    const std::string path = "test_session_benchmark.sqlite";
+    for (const auto isolation : {Fortest::RunOptions::Isolation::Thread, Fortest::RunOptions::Isolation::Process}) {
+        for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{.isolation = isolation, .results_db = path});
+        session.add_test_suite("Perf");
+        int test_setups = 0;
+        session.add_fixture("Perf", Fortest::Fixture<void>(
+            [&](void *) { ++test_setups; }, [](void *) {}, nullptr, Fortest::Scope::Test));
+        volatile int sink = 0;
+        session.add_benchmark("Perf", "increment", [&](void *, void *, void *) { sink = sink + 1; },
+                              Fortest::BenchmarkOptions{.repetitions = 3, .min_time_seconds = 0.003,
+                                                        .items_per_call = 4.0});
+        session.run(logger);
+
+        const auto stats = session.get_benchmark_stats("Perf", "increment");
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->repetitions, 3u);
+        EXPECT_GT(stats->iterations, 1u);
+        EXPECT_GT(stats->throughput, 0.0);
+        EXPECT_EQ(session.get_test_suite_status("Perf").at("increment"), Fortest::Test::Status::PASS);
+        EXPECT_THAT(get_output(), HasSubstr("Benchmark increment (median "));
+        if (isolation == Fortest::RunOptions::Isolation::Thread) EXPECT_EQ(test_setups, 1);
+
+        {
+            SqliteDb db(path);
+            SqliteStmt row(db.get(),
+                           "SELECT benchmarks.repetitions, benchmarks.iterations, benchmarks.median_ns"
+                           " FROM benchmarks JOIN results ON results.id = benchmarks.result_id"
+                           " WHERE results.status = 'PASS';");
+            ASSERT_TRUE(row.step());
+            EXPECT_EQ(sqlite3_column_int64(row.get(), 0), 3);
+            EXPECT_EQ(sqlite3_column_int64(row.get(), 1), static_cast<std::int64_t>(stats->iterations));
+            EXPECT_DOUBLE_EQ(sqlite3_column_double(row.get(), 2), stats->median_ns);
+        }
+        clear_output();
+    }
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: With a baseline, a benchmark fails once it is much slower than its past passing runs.
+ */
+TEST_F(TestSessionBehavior, BenchmarkFailsWhenSlowerThanBaseline) {
+    const std::string path = "test_session_baseline.sqlite";
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+    bool slow = false;
+    volatile int sink = 0;
+    const auto run_once = [&] {
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{
+            .regression = {.max_slowdown_percent = 25.0}, .results_db = path});
+        session.add_test_suite("Perf");
+        session.add_benchmark("Perf", "kernel", [&](void *, void *, void *) {
+            if (slow) std::this_thread::sleep_for(std::chrono::microseconds(200));
+            sink = sink + 1;
+        }, Fortest::BenchmarkOptions{.repetitions = 5, .min_time_seconds = 0.005});
+        session.run(logger);
+        return session.get_test_suite_status("Perf").at("kernel");
+    };
+
+    EXPECT_EQ(run_once(), Fortest::Test::Status::PASS); // No baseline yet
+    slow = true;
+    EXPECT_EQ(run_once(), Fortest::Test::Status::FAIL);
+    EXPECT_THAT(get_output(), HasSubstr("benchmark kernel is slower than its baseline"));
+    for (const char *suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+}
+
+/**
+ * @brief Behavior: Fail-fast stops at the first failure, leaves later tests NONE and still tears fixtures down.
+ */
+TEST_F(TestSessionBehavior, FailFastStopsAfterFirstFailure) {
+    for (const auto isolation : {Fortest::RunOptions::Isolation::Thread,
+                                 Fortest::RunOptions::Isolation::Process}) {
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{
+            .isolation = isolation, .max_failures = 1, .results_db = ""});
+        int teardowns = 0;
+
+        auto &first = session.add_test_suite("First");
+        first.add_test("a_fail", [&](void *, void *, void *) { assert_obj.assert_true(false); });
+        first.add_test("b_pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+        first.register_parameterized_test("c_param", [&](void *, void *, void *, int) {
+            assert_obj.assert_true(true);
+        }, {1, 2});
+        session.add_test_suite("Second").add_test("pass", [&](void *, void *, void *) {
+            assert_obj.assert_true(true);
+        });
+        session.add_fixture("First", Fortest::Fixture<void>(
+            [](void *) {}, [&](void *) { ++teardowns; }, nullptr, Fortest::Scope::Suite));
+        session.add_fixture(Fortest::Fixture<void>(
+            [](void *) {}, [&](void *) { ++teardowns; }, nullptr, Fortest::Scope::Session));
+
+        session.run(logger);
+
+        auto first_statuses = session.get_test_suite_status("First");
+        EXPECT_EQ(first_statuses["a_fail"], Fortest::Test::Status::FAIL);
+        EXPECT_EQ(first_statuses["b_pass"], Fortest::Test::Status::NONE);
+        EXPECT_EQ(first_statuses["c_param"], Fortest::Test::Status::NONE);
+        EXPECT_EQ(session.get_test_suite_status("Second")["pass"], Fortest::Test::Status::NONE);
+        EXPECT_TRUE(session.stopped_early());
+        EXPECT_EQ(teardowns, 2);
+    }
+    EXPECT_THAT(get_output(), HasSubstr("Stopped after 1 failed tests"));
+}
+
+/**
+ * @brief Behavior: A failure budget lets that many tests fail before the run stops.
+ */
+TEST_F(TestSessionBehavior, MaxFailuresAllowsThatManyFailures) {
+    for (const std::size_t workers : {1u, 2u}) {
+        Fortest::TestSession<OStreamLogger> session(assert_obj);
+        session.set_options(Fortest::RunOptions{
+            .num_workers = workers, .max_failures = 2, .results_db = ""});
+        std::atomic<int> started = 0;
+
+        auto &suite = session.add_test_suite("Budget");
+        for (const char *name : {"a", "b", "c", "d", "e"}) {
+            suite.add_test(name, [&](void *, void *, void *) {
+                ++started;
+                assert_obj.assert_true(false);
+            });
+        }
+
+        session.run(logger);
+
+        const auto counts = session.get_status_counts();
+        EXPECT_GE(counts[Fortest::Test::Status::FAIL], 2);
+        EXPECT_LE(counts[Fortest::Test::Status::FAIL], static_cast<int>(1 + workers));
+        EXPECT_EQ(counts[Fortest::Test::Status::FAIL], started.load());
+        EXPECT_TRUE(session.stopped_early());
+    }
+}
+
+/**
+ * @brief Behavior: Without a budget, or with failures below it, every test runs.
+ */
+TEST_F(TestSessionBehavior, RunWithinBudgetDoesNotStop) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.max_failures = 2, .results_db = ""});
+    auto &suite = session.add_test_suite("Suite");
+    suite.add_test("fail", [&](void *, void *, void *) { assert_obj.assert_true(false); });
+    suite.add_test("pass", [&](void *, void *, void *) { assert_obj.assert_true(true); });
+
+    session.run(logger);
+
+    EXPECT_EQ(session.get_test_suite_status("Suite")["pass"], Fortest::Test::Status::PASS);
+    EXPECT_FALSE(session.stopped_early());
+}
+
+/**
+ * @brief Behavior: Fixtures are set up by the first test that runs, so unused ones are never set up.
+ */
+TEST_F(TestSessionBehavior, FixturesAreSetUpOnFirstUse) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.filter = "Used.*", .results_db = ""});
+    std::vector<std::string> events;
+
+    session.add_test_suite("Used").add_test("test", [&](void *, void *, void *) {
+        events.emplace_back("test");
+    });
+    session.add_test_suite("Unused").add_test("test", [&](void *, void *, void *) {});
+    session.add_fixture(Fortest::Fixture<void>(
+        [&](void *) { events.emplace_back("session setup"); },
+        [&](void *) { events.emplace_back("session teardown"); }, nullptr, Fortest::Scope::Session));
+    for (const char *suite : {"Used", "Unused"}) {
+        session.add_fixture(suite, Fortest::Fixture<void>(
+            [&, suite](void *) { events.emplace_back(std::string(suite) + " setup"); },
+            [&, suite](void *) { events.emplace_back(std::string(suite) + " teardown"); }, nullptr,
+            Fortest::Scope::Suite));
+    }
+
+    session.run(logger);
+    EXPECT_EQ(events, (std::vector<std::string>{"session setup", "Used setup", "test", "Used teardown",
+                                                "session teardown"}));
+
+    events.clear();
+    session.get_options().filter = "None.*";
+    session.run(logger);
+    EXPECT_TRUE(events.empty());
+}
+
+/**
+ * @brief Behavior: In a parallel run a suite fixture is released once its suite is done, not at the end.
+ */
+TEST_F(TestSessionBehavior, ParallelRunReleasesSuiteFixtureEarly) {
+    Fortest::TestSession<OStreamLogger> session(assert_obj);
+    session.set_options(Fortest::RunOptions{.num_workers = 2, .results_db = ""});
+    std::atomic<bool> released = false;
+
+    session.add_test_suite("A").add_test("quick", [&](void *, void *, void *) {
+        assert_obj.assert_true(true);
+    });
+    session.add_fixture("A", Fortest::Fixture<void>(
+        [](void *) {}, [&](void *) { released = true; }, nullptr, Fortest::Scope::Suite));
+    session.add_test_suite("B").add_test("slow", [&](void *, void *, void *) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!released && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert_obj.assert_true(released.load());
+    });
+
+    session.run(logger);
+
+    EXPECT_EQ(session.get_test_suite_status("B")["slow"], Fortest::Test::Status::PASS);
+}
@@ -3,7 +3,11 @@
 #include "logging.hpp"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
+#include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using ::testing::HasSubstr;
 
@@ -187,6 +191,29 @@ TEST_F(TestSuiteBehavior, ParameterizedTestAllPass) {
     EXPECT_THAT(out, HasSubstr("Parameterized test passed: all_pass"));
 }
 
+/**
+ * @brief Behavior: A scheduled parameterized test is announced once, when its first job runs.
+ */
+TEST_F(TestSuiteBehavior, ScheduledParameterizedTestLogsStartWhenRun) {
+    Fortest::TestSuite<OStreamLogger> ts("ParamSuite", assert_obj);
+    ts.register_parameterized_test("shared", [&](void*, void*, void*, int) { assert_obj.assert_true(true); },
+                                   {0, 1, 2, 3});
+
+    auto jobs = ts.schedule_jobs(2, logger);
+    ASSERT_EQ(jobs.size(), 2u);
+    EXPECT_THAT(get_output(), ::testing::Not(HasSubstr("Running parameterized test")));
+
+    for (auto &job : jobs) job.task();
+    // One start line for the test, before the lines of its four cases.
+    const std::string out = get_output();
+    const std::string start = "Running parameterized test: shared";
+    std::vector<std::size_t> lines;
+    for (auto pos = out.find(start); pos != std::string::npos; pos = out.find(start, pos + 1)) lines.push_back(pos);
+    ASSERT_EQ(lines.size(), 5u) << out;
+    EXPECT_NE(out.compare(lines[0] + start.size(), 2, " ["), 0);
+    EXPECT_EQ(out.compare(lines[1] + start.size(), 2, " ["), 0);
+}
+
 /**
  * @brief Behavior: Parameterized tests inherit suite fixtures just like regular tests.
  */
@@ -216,3 +243,139 @@ TEST_F(TestSuiteBehavior, ParameterizedTestInheritsSuiteFixture) {
     auto statuses = ts.get_statuses();
     EXPECT_EQ(statuses.at("fixture_check"), Fortest::Test::Status::PASS);
 }
+
+/**
+ * @brief Behavior: Status counts follow every run, in the suite and in its parent counter.
+ */
+TEST_F(TestSuiteBehavior, StatusCountsFollowRuns) {
+    Fortest::StatusCounter session_counts;
+    Fortest::TestSuite<OStreamLogger> ts("Counted", assert_obj, &session_counts);
+    bool fail_param = true;
+
+    ts.add_test("pass", [&](void*, void*, void*) { assert_obj.assert_true(true); });
+    ts.add_test("fail", [&](void*, void*, void*) { assert_obj.assert_true(false); });
+    ts.register_parameterized_test("sweep", [&](void*, void*, void*, int idx) {
+        assert_obj.assert_true(!(fail_param && idx == 1));
+    }, {0, 1, 2});
+
+    EXPECT_EQ(ts.get_status_counts().not_run(), 3);
+    EXPECT_FALSE(ts.has_failures());
+
+    ts.run(logger);
+    EXPECT_EQ(ts.get_status_counts().passed(), 1);
+    EXPECT_EQ(ts.get_status_counts().failed(), 2);
+    EXPECT_TRUE(ts.has_failures());
+    EXPECT_EQ(session_counts.failing_children(), 1);
+
+    fail_param = false;
+    ts.run(logger);
+    EXPECT_EQ(ts.get_status_counts().passed(), 2);
+    EXPECT_EQ(ts.get_status_counts().failed(), 1);
+    EXPECT_EQ(session_counts.counts().total(), 3);
+    EXPECT_EQ(session_counts.failing_children(), 1);
+}
+
+/**
+ * @brief Behavior: A test that overruns its timeout and then returns is recorded as TIMEOUT.
+ */
+TEST_F(TestSuiteBehavior, CooperativeTestTimesOut) {
+    Fortest::TestSuite<OStreamLogger> ts("Timed", assert_obj);
+    ts.add_test("solver", [&](void*, void*, void*) {
+        while (!Fortest::TestCancellation::requested()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert_obj.assert_true(true);
+    });
+    ts.add_test("quick", [&](void*, void*, void*) { assert_obj.assert_true(true); });
+    ts.register_parameterized_test("sweep", [&](void*, void*, void*, int idx) {
+        while (idx == 1 && !Fortest::TestCancellation::requested()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert_obj.assert_true(true);
+    }, {0, 1});
+    ts.set_timeout(0.05);
+    ts.set_test_timeout("quick", 0.0);
+
+    ts.run(logger);
+
+    const auto statuses = ts.get_statuses();
+    EXPECT_EQ(statuses.at("solver"), Fortest::Test::Status::TIMEOUT);
+    EXPECT_EQ(statuses.at("quick"), Fortest::Test::Status::PASS);
+    EXPECT_EQ(statuses.at("sweep"), Fortest::Test::Status::TIMEOUT);
+    EXPECT_EQ(ts.get_status_counts().failed(), 2);
+    EXPECT_THAT(get_output(), HasSubstr("Test timed out: solver"));
+    EXPECT_FALSE(Fortest::TestCancellation::requested());
+}
+
+/**
+ * @brief Behavior: Timeouts resolve from the test, then the suite, then the session default.
+ */
+TEST_F(TestSuiteBehavior, TimeoutsResolveByPrecedence) {
+    Fortest::TestSuite<OStreamLogger> ts("Limits", assert_obj);
+    ts.add_test("plain", [](void*, void*, void*) {});
+    ts.add_test("own", [](void*, void*, void*) {});
+    ts.register_parameterized_test("sweep", [](void*, void*, void*, int) {}, {0, 1});
+
+    EXPECT_EQ(ts.get_timeout("plain"), std::nullopt);
+    ts.set_default_timeout(60.0, 1.0);
+    ts.set_test_timeout("own", 5.0);
+    ts.set_test_timeout("sweep", 2.0);
+    EXPECT_EQ(ts.get_timeout("plain"), 60.0);
+    EXPECT_EQ(ts.get_timeout("own"), 5.0);
+    EXPECT_EQ(ts.get_timeout("sweep"), 2.0);
+    ts.set_timeout(10.0);
+    EXPECT_EQ(ts.get_timeout("plain"), 10.0);
+    EXPECT_EQ(ts.get_timeout("own"), 5.0);
+    EXPECT_EQ(ts.get_timeout("missing"), std::nullopt);
+    EXPECT_THROW(ts.set_test_timeout("missing", 1.0), std::runtime_error);
+}
+
+/**
+ * @brief Behavior: A test that ignores its timeout is recorded and ends the process.
+ */
+TEST_F(TestSuiteBehavior, HungTestIsRecordedBeforeExit) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    class Rows : public Fortest::ResultConsumer {
+    public:
+        using ResultConsumer::push;
+        void push(Fortest::ResultRow row) override { rows.push_back(std::move(row)); }
+        void flush() override {
+            for (const auto &row : rows) std::cerr << "row " << row.test_name << " " << row.status << "\n";
+        }
+        std::vector<Fortest::ResultRow> rows;
+    };
+    EXPECT_EXIT({
+        Rows rows;
+        Fortest::TestSuite<OStreamLogger> ts("Hung", assert_obj);
+        ts.add_test("done", [](void*, void*, void*) {});
+        ts.add_test("spin", [](void*, void*, void*) {
+            std::this_thread::sleep_for(std::chrono::seconds(30));
+        });
+        ts.set_default_timeout(0.05, 0.05);
+        ts.run(std::make_shared<Fortest::Logger>(std::cerr), &rows);
+    }, ::testing::ExitedWithCode(Fortest::TimeoutGuard::hang_exit_code),
+       "row done PASS\nrow spin TIMEOUT");
+}
+
+/**
+ * @brief Behavior: A child counter whose failures are fixed stops counting as failing.
+ */
+TEST(StatusCounterBehavior, FailingChildrenTrackTransitions) {
+    using Status = Fortest::Test::Status;
+    Fortest::StatusCounter parent;
+    Fortest::StatusCounter child(&parent);
+
+    child.add(Status::NONE);
+    child.add(Status::NONE);
+    child.move(Status::NONE, Status::FAIL);
+    child.move(Status::NONE, Status::CRASH);
+    EXPECT_EQ(parent.failing_children(), 1);
+    EXPECT_EQ(parent.failed(), 2);
+
+    child.move(Status::FAIL, Status::PASS);
+    EXPECT_EQ(parent.failing_children(), 1);
+    child.move(Status::CRASH, Status::PASS);
+    EXPECT_EQ(parent.failing_children(), 0);
+    EXPECT_EQ(parent.counts().passed(), 2);
+    EXPECT_EQ(child.counts().summary<Status>(), Status::PASS);
+}
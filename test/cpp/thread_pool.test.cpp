@@ -0,0 +1,108 @@
+#include "thread_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Behavior: Every submitted task runs exactly once before wait() returns.
+ */
+TEST(ThreadPoolBehavior, RunsEverySubmittedTask) {
+    Fortest::ThreadPool pool(4);
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&] { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait();
+
+    EXPECT_EQ(count.load(), 1000);
+}
+
+/**
+ * @brief Behavior: A pool asked for zero workers still starts one.
+ */
+TEST(ThreadPoolBehavior, ZeroWorkersStartsOne) {
+    Fortest::ThreadPool pool(0);
+    EXPECT_EQ(pool.size(), 1u);
+
+    bool called = false;
+    pool.submit([&] { called = true; });
+    pool.wait();
+    EXPECT_TRUE(called);
+}
+
+/**
+ * @brief Behavior: Tasks may submit further tasks, which wait() also covers.
+ */
+TEST(ThreadPoolBehavior, TasksCanSubmitTasks) {
+    Fortest::ThreadPool pool(3);
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&] {
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&] { count.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    pool.wait();
+
+    EXPECT_EQ(count.load(), 100);
+}
+
+/**
+ * @brief Behavior: Tasks run on worker threads, not on the submitting thread.
+ */
+TEST(ThreadPoolBehavior, TasksRunOnWorkers) {
+    Fortest::ThreadPool pool(2);
+    std::mutex mutex;
+    std::set<std::size_t> indices;
+
+    for (int i = 0; i < 50; ++i) {
+        pool.submit([&] {
+            std::lock_guard lock(mutex);
+            indices.insert(Fortest::ThreadPool::worker_index());
+        });
+    }
+    pool.wait();
+
+    EXPECT_EQ(Fortest::ThreadPool::worker_index(), Fortest::ThreadPool::npos);
+    for (auto idx : indices) {
+        EXPECT_LT(idx, pool.size());
+    }
+}
+
+/**
+ * @brief Behavior: The first task exception is rethrown by wait() after all tasks ran.
+ */
+TEST(ThreadPoolBehavior, WaitRethrowsTaskException) {
+    Fortest::ThreadPool pool(2);
+    std::atomic<int> count{0};
+
+    pool.submit([] { throw std::runtime_error("boom"); });
+    for (int i = 0; i < 20; ++i) {
+        pool.submit([&] { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(count.load(), 20);
+}
+
+/**
+ * @brief Behavior: Ordered tasks are dealt out so each worker starts with the earliest.
+ */
+TEST(ThreadPoolBehavior, SubmitOrderedStartsTasksInOrder) {
+    Fortest::ThreadPool pool(1);
+    std::vector<int> order;
+    std::vector<Fortest::ThreadPool::Task> tasks;
+    for (int i = 0; i < 5; ++i) tasks.push_back([&, i] { order.push_back(i); });
+    pool.submit_ordered(std::move(tasks));
+    pool.wait();
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
@@ -0,0 +1,82 @@
+#include "watchdog.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Behavior: An armed alarm runs once its deadline has passed.
+ */
+TEST(WatchdogBehavior, AlarmFiresAtDeadline) {
+    Fortest::Watchdog watchdog;
+    std::atomic<bool> fired{false};
+    const auto start = Fortest::Watchdog::Clock::now();
+    Fortest::Watchdog::Clock::time_point fired_at;
+
+    watchdog.arm(start + 50ms, [&] {
+        fired_at = Fortest::Watchdog::Clock::now();
+        fired = true;
+    });
+    for (int i = 0; i < 500 && !fired; ++i) std::this_thread::sleep_for(2ms);
+
+    ASSERT_TRUE(fired);
+    EXPECT_GE(fired_at - start, 50ms);
+}
+
+/**
+ * @brief Behavior: A disarmed alarm never runs, and later alarms still do.
+ */
+TEST(WatchdogBehavior, DisarmedAlarmDoesNotFire) {
+    Fortest::Watchdog watchdog;
+    std::atomic<int> fired{0};
+
+    const auto id = watchdog.arm(Fortest::Watchdog::Clock::now() + 30ms, [&] { fired += 1; });
+    watchdog.arm(Fortest::Watchdog::Clock::now() + 60ms, [&] { fired += 10; });
+    watchdog.disarm(id);
+    for (int i = 0; i < 500 && fired == 0; ++i) std::this_thread::sleep_for(2ms);
+
+    EXPECT_EQ(fired, 10);
+}
+
+/**
+ * @brief Behavior: A guard raises the cancellation flag of its thread once the timeout passes.
+ */
+TEST(TimeoutGuardBehavior, ExpiryRequestsCancellation) {
+    Fortest::Watchdog watchdog;
+    bool hung = false;
+    {
+        Fortest::TimeoutGuard guard(0.02, 10.0, [&] { hung = true; }, watchdog);
+        EXPECT_FALSE(Fortest::TestCancellation::requested());
+        while (!Fortest::TestCancellation::requested()) std::this_thread::sleep_for(1ms);
+        EXPECT_TRUE(guard.expired());
+    }
+    EXPECT_FALSE(Fortest::TestCancellation::requested());
+    EXPECT_FALSE(hung);
+}
+
+/**
+ * @brief Behavior: The hang handler runs if the test outlives the grace period.
+ */
+TEST(TimeoutGuardBehavior, HangHandlerRunsAfterGrace) {
+    Fortest::Watchdog watchdog;
+    std::atomic<bool> hung{false};
+    Fortest::TimeoutGuard guard(0.01, 0.02, [&] { hung = true; }, watchdog);
+    for (int i = 0; i < 500 && !hung; ++i) std::this_thread::sleep_for(2ms);
+    EXPECT_TRUE(hung);
+}
+
+/**
+ * @brief Behavior: Without a timeout the guard arms nothing and never cancels.
+ */
+TEST(TimeoutGuardBehavior, ZeroTimeoutDisablesGuard) {
+    Fortest::Watchdog watchdog;
+    bool hung = false;
+    Fortest::TimeoutGuard guard(0.0, 0.0, [&] { hung = true; }, watchdog);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(guard.expired());
+    EXPECT_FALSE(Fortest::TestCancellation::requested());
+    EXPECT_FALSE(hung);
+}
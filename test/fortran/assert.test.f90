@@ -6,8 +6,11 @@
 !> `assert_false`. Unlike fixture-based tests, no shared state is
 !> initialized or reset between runs.
 module test_assert_no_fixture_mod
-    use iso_c_binding, only : c_ptr
-    use fortest_assert, only : assert_equal, assert_not_equal, assert_true, assert_false
+    use iso_c_binding, only : c_ptr, c_int64_t, c_double
+    use fortest_assert, only : assert_equal, assert_not_equal, assert_true, assert_false, &
+            assert_max_memory, assert_matches_snapshot, array_report_t, assert_context, &
+            bind_assert_context, unbind_assert_context
+    use fortest_test_session, only : cancellation_requested
     implicit none
 contains
 
@@ -98,6 +101,63 @@ contains
         call assert_equal(trim(str1) // " " // trim(str2), "Hello World")
     end subroutine test_assert_equal_string
 
+    !> @test Verify that trailing blanks of fixed-length buffers are ignored.
+    subroutine test_assert_equal_string_padded(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        character(len = 64) :: buffer
+        buffer = "Hello World"
+        call assert_equal(buffer, "Hello World")
+        call assert_not_equal(buffer(1:5), buffer(7:11))
+        call assert_equal(buffer(12:), "")
+    end subroutine test_assert_equal_string_padded
+
+    !> @test Verify element-wise equality of two integer vectors.
+    subroutine test_assert_equal_int_array(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        integer :: i, squares(100)
+        squares = [(i * i, i = 1, 100)]
+        call assert_equal([(i * i, i = 1, 100)], squares)
+    end subroutine test_assert_equal_int_array
+
+    !> @test Verify a double matrix within tolerance and the returned report.
+    subroutine test_assert_equal_double_matrix(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        double precision :: expected(33, 17), actual(33, 17)
+        type(array_report_t) :: report
+        call random_number(expected)
+        actual = expected + 1.0d-9
+        call assert_equal(expected, actual, abs_tol=1.0d-8, report=report)
+        call assert_true(report%mismatches == 0_c_int64_t)
+        call assert_true(report%size == 33_c_int64_t * 17_c_int64_t)
+        call assert_true(report%max_abs_error > 0.0d0 .and. report%max_abs_error < 1.0d-8)
+    end subroutine test_assert_equal_double_matrix
+
+    !> @test Verify element-wise equality of rank-3 real and complex arrays.
+    subroutine test_assert_equal_rank3_arrays(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        real :: field(4, 5, 6)
+        complex :: waves(4, 5, 6)
+        call random_number(field)
+        waves = cmplx(field, 2.0 * field)
+        call assert_equal(field, field * 1.000001, rel_tol=1.0e-5)
+        call assert_equal(waves, conjg(conjg(waves)))
+    end subroutine test_assert_equal_rank3_arrays
+
+    !> @test Verify that a field matches the snapshot recorded by its first check.
+    subroutine test_assert_matches_snapshot(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        double precision :: field(40, 25)
+        integer :: i, j
+        type(array_report_t) :: report
+        field = reshape([((sin(0.1d0 * i) * cos(0.2d0 * j), i = 1, 40), j = 1, 25)], shape(field))
+        call assert_matches_snapshot("assert_fortran_field", field)
+        call assert_matches_snapshot("assert_fortran_field", field * (1.0d0 + 1.0d-12), rel_tol=1.0d-10, &
+                report=report)
+        call assert_true(report%size == 1000_c_int64_t)
+        call assert_true(report%mismatches == 0_c_int64_t)
+        call assert_matches_snapshot("assert_fortran_counts", [(i, i = 1, 10)])
+    end subroutine test_assert_matches_snapshot
+
     !> @test Verify that 2 + 3 ≠ 4 (integer inequality).
     subroutine test_assert_not_equal_int(t_ptr, ts_ptr, s_ptr)
         type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
@@ -180,6 +240,37 @@ contains
         call assert_false(condition)
     end subroutine test_assert_false
 
+    !> @test Verify that filling a 1 MiB array stays below a 1 GiB memory limit.
+    subroutine test_assert_max_memory(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        real(8), allocatable :: work(:)
+        allocate(work(131072))
+        work = 1.0d0
+        call assert_equal(sum(work), 131072.0d0)
+        call assert_max_memory(1073741824_c_int64_t)
+        deallocate(work)
+    end subroutine test_assert_max_memory
+
+    !> @test Verify that assertions still count after binding and unbinding the test's context.
+    subroutine test_assert_context_binding(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        type(c_ptr) :: context
+        context = assert_context()
+        call bind_assert_context(context)
+        call assert_true(.true.)
+        call unbind_assert_context()
+        call assert_equal(1 + 1, 2)
+    end subroutine test_assert_context_binding
+
+    subroutine test_cancellation_not_requested(t_ptr, ts_ptr, s_ptr)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        integer :: iteration
+        do iteration = 1, 1000
+            if (cancellation_requested()) exit
+        end do
+        call assert_equal(iteration, 1001)
+    end subroutine test_cancellation_not_requested
+
 end module test_assert_no_fixture_mod
 
 
@@ -202,6 +293,11 @@ program test_assert_no_fixture
     call test_session%register_test("test_suite", "test_assert_equal_double_abs_tol", test_assert_equal_double_abs_tol)
     call test_session%register_test("test_suite", "test_assert_equal_double_rel_tol", test_assert_equal_double_rel_tol)
     call test_session%register_test("test_suite", "test_assert_equal_string", test_assert_equal_string)
+    call test_session%register_test("test_suite", "test_assert_equal_string_padded", test_assert_equal_string_padded)
+    call test_session%register_test("test_suite", "test_assert_equal_int_array", test_assert_equal_int_array)
+    call test_session%register_test("test_suite", "test_assert_equal_double_matrix", test_assert_equal_double_matrix)
+    call test_session%register_test("test_suite", "test_assert_equal_rank3_arrays", test_assert_equal_rank3_arrays)
+    call test_session%register_test("test_suite", "test_assert_matches_snapshot", test_assert_matches_snapshot)
 
     ! Inequality tests
     call test_session%register_test("test_suite", "test_assert_not_equal_int", test_assert_not_equal_int)
@@ -215,6 +311,12 @@ program test_assert_no_fixture
     call test_session%register_test("test_suite", "test_assert_true", test_assert_true)
     call test_session%register_test("test_suite", "test_assert_false", test_assert_false)
 
+    ! Resource tests
+    call test_session%register_test("test_suite", "test_assert_max_memory", test_assert_max_memory)
+    call test_session%register_test("test_suite", "test_assert_context_binding", test_assert_context_binding)
+    call test_session%register_test("test_suite", "test_cancellation_not_requested", &
+            test_cancellation_not_requested, timeout = 60.0_c_double)
+
     call test_session%run()
     call test_session%finalize()
 end program test_assert_no_fixture
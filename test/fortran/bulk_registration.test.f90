@@ -0,0 +1,37 @@
+!> @brief Driver registering its tests with the generated table.
+!>
+!> This program:
+!> 1. Registers both suites and their three tests with register_all_tests.
+!> 2. Runs them and checks that all passed.
+!> 3. Checks that a test absent from the table was not registered.
+program test_bulk_registration
+   use fortest_registration, only: register_all_tests
+   use fortest_test_session
+   use fortest_test_suite, only: test_suite_t
+   implicit none
+   type(test_session_t) :: test_session
+   type(test_suite_t), pointer :: suite_ptr
+
+   call test_session%set_results_db("test_bulk_registration.sqlite")
+   call register_all_tests(test_session)
+   call test_session%run()
+   if (test_session%get_status() /= 0) then
+      call exit(1)
+   end if
+
+   suite_ptr => test_session%get_test_suite("test_bulk_registration_mod")
+   if (.not. associated(suite_ptr)) then
+      call exit(1)
+   end if
+   if (suite_ptr%get_test_timing("test_table_twice") /= 0) then
+      call exit(1)
+   end if
+   if (suite_ptr%get_test_timing("not_a_test") == 0) then
+      call exit(1)
+   end if
+   suite_ptr => test_session%get_test_suite("test_bulk_registration_more_mod")
+   if (suite_ptr%get_test_timing("test_table_add") /= 0) then
+      call exit(1)
+   end if
+
+end program test_bulk_registration
@@ -0,0 +1,51 @@
+!> @brief Tests registered through a table generated by fortest-register.
+!>
+!> @details
+!> Only the subroutines marked `@test` are registered; the helper is
+!> not a test and must not end up in the table.
+module test_bulk_registration_mod
+   use iso_c_binding, only: c_ptr
+   use fortest_assert, only: assert_equal, assert_true
+   implicit none
+contains
+
+   !> @test Verify that 2 + 3 = 5.
+   subroutine test_table_add(t_ptr, ts_ptr, s_ptr)
+      type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+      call assert_equal(twice(2) + 1, 5)
+   end subroutine test_table_add
+
+   !> @test Verify that the helper doubles its argument.
+   subroutine test_table_twice(t_ptr, ts_ptr, s_ptr)
+      type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+      call assert_equal(twice(21), 42)
+   end subroutine test_table_twice
+
+   !> @brief Helper of the tests: twice `n`.
+   integer function twice(n)
+      integer, intent(in) :: n
+      twice = 2 * n
+   end function twice
+
+   !> @brief Not a test: fails if it is ever registered and run.
+   subroutine not_a_test(t_ptr, ts_ptr, s_ptr)
+      type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+      call assert_true(.false.)
+   end subroutine not_a_test
+
+end module test_bulk_registration_mod
+
+!> @brief Second suite, for a table spanning several modules.
+module test_bulk_registration_more_mod
+   use iso_c_binding, only: c_ptr
+   use fortest_assert, only: assert_equal
+   implicit none
+contains
+
+   !> @test Same procedure name as in another module; the table renames it.
+   subroutine test_table_add(t_ptr, ts_ptr, s_ptr)
+      type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+      call assert_equal(1 + 1, 2)
+   end subroutine test_table_add
+
+end module test_bulk_registration_more_mod
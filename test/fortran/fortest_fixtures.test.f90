@@ -120,12 +120,26 @@ contains
       call assert_equal(s%x, 1)
    end subroutine
 
+   ! --- Tests for golden data fixtures ---
+   !> Verify that the mapped golden data file is visible as a Fortran array
+   subroutine test_golden_data_mapped(t_ptr, ts_ptr, s_ptr)
+      use fortest_test_session, only: golden_data_t
+      use iso_c_binding, only: c_double, c_associated
+      type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+      type(golden_data_t), pointer :: golden
+      real(c_double), pointer :: reference(:)
+      call c_f_pointer(ts_ptr, golden)
+      call assert_equal(c_associated(golden%data), .true.)
+      call c_f_pointer(golden%data, reference, [golden%nbytes / 8])
+      call assert_equal(reference, [1.0_c_double, 2.0_c_double, 3.0_c_double])
+   end subroutine
+
 end module test_fortest_fixtures_mod
 
 program test_fortest_fixtures
-   use fortest_test_session, only: test_session_t
+   use fortest_test_session, only: test_session_t, golden_data_t
    use test_fortest_fixtures_mod
-   use iso_c_binding, only: c_ptr, c_loc
+   use iso_c_binding, only: c_ptr, c_loc, c_double
    implicit none
 
    !> This test program verifies fixture scoping rules:
@@ -143,6 +157,8 @@ program test_fortest_fixtures
    type(test_fixture_t), target :: test_fixture
    type(suite_fixture_t), target :: suite_fixture
    type(session_fixture_t), target :: session_fixture
+   type(golden_data_t), target :: golden
+   integer :: golden_unit
 
    test_fixture_ptr   = c_loc(test_fixture)
    suite_fixture_ptr  = c_loc(suite_fixture)
@@ -233,6 +249,25 @@ program test_fortest_fixtures
          test_name       = "cc_test_fixture_third", &
          test            = test_third_test_fixture_reset)
 
+   ! Suite D: golden data mapped read-only from a file
+   open(newunit = golden_unit, file = "fortest_golden.bin", access = "stream", &
+         form = "unformatted", status = "replace")
+   write(golden_unit) [1.0_c_double, 2.0_c_double, 3.0_c_double]
+   close(golden_unit)
+
+   call test_session%register_test_suite( &
+         test_suite_name = "d_golden_data_suite")
+
+   call test_session%register_golden_data( &
+         path            = "fortest_golden.bin", &
+         golden          = golden, &
+         test_suite_name = "d_golden_data_suite")
+
+   call test_session%register_test( &
+         test_suite_name = "d_golden_data_suite", &
+         test_name       = "da_golden_data_mapped", &
+         test            = test_golden_data_mapped)
+
    call test_session%run()
    call test_session%finalize()
 end program test_fortest_fixtures
@@ -7,9 +7,15 @@
 
 module test_fortest_parameterized_tests_mod
     use fortest_assert, only : assert_equal
+    use fortest_test_session, only : parameter_range_t, parameter_coordinate
     use iso_c_binding, only : c_ptr, c_f_pointer, c_int
     implicit none
 
+    !> Ranges of the grid test: i = 1, 2, 3 and j = 2, 4
+    type(parameter_range_t), parameter :: grid(2) = [ &
+            parameter_range_t(1_c_int, 3_c_int, 1_c_int), &
+            parameter_range_t(2_c_int, 4_c_int, 2_c_int)]
+
     !> Fixture type storing arrays of expected values
     type :: param_fixture_t
         integer(c_int), allocatable :: expected(:)
@@ -61,17 +67,35 @@ contains
         call assert_equal(idx <= t%upper_bound(idx + 1), .true.)
     end subroutine test_param_fixture_upper_bound
 
+    !> Check values received from a strided range
+    subroutine test_param_range_values(t_ptr, ts_ptr, s_ptr, idx) bind(C)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        integer(c_int), value :: idx
+
+        call assert_equal(mod(idx, 5_c_int), 0_c_int)
+    end subroutine test_param_range_values
+
+    !> Check that case numbers of a product decode to its coordinates
+    subroutine test_param_grid(t_ptr, ts_ptr, s_ptr, idx) bind(C)
+        type(c_ptr), value :: t_ptr, ts_ptr, s_ptr
+        integer(c_int), value :: idx
+
+        call assert_equal(parameter_coordinate(grid, idx, 1), mod(idx, 3_c_int) + 1_c_int)
+        call assert_equal(parameter_coordinate(grid, idx, 2), 2_c_int * (idx / 3_c_int + 1_c_int))
+    end subroutine test_param_grid
+
 end module test_fortest_parameterized_tests_mod
 
 !-------------------------------------------------------------
 ! Program: Register and run the parameterized fixture tests
 !-------------------------------------------------------------
 program test_fortest_parameterized_tests
-    use fortest_test_session, only : test_session_t
+    use fortest_test_session, only : test_session_t, parameter_range_t
     use test_fortest_parameterized_tests_mod, only : &
             param_fixture_t, &
             setup_param_fixture, teardown_param_fixture, &
-            test_param_fixture_expected, test_param_fixture_upper_bound
+            test_param_fixture_expected, test_param_fixture_upper_bound, &
+            test_param_range_values, test_param_grid, grid
     use iso_c_binding, only : c_ptr, c_loc, c_int
     implicit none
 
@@ -113,6 +137,21 @@ program test_fortest_parameterized_tests
             test = test_param_fixture_upper_bound, &
             params = params)
 
+    ! Register tests over ranges, which are never expanded into arrays
+    call test_session%register_test_suite("param_range_suite")
+
+    call test_session%register_parameterized_test(&
+            test_suite_name = "param_range_suite", &
+            test_name = "test_range_values", &
+            test = test_param_range_values, &
+            range = parameter_range_t(5_c_int, 50_c_int, 5_c_int))
+
+    call test_session%register_parameterized_test(&
+            test_suite_name = "param_range_suite", &
+            test_name = "test_grid", &
+            test = test_param_grid, &
+            ranges = grid)
+
     ! Run the session
     call test_session%run()
     call test_session%finalize()
@@ -60,10 +60,15 @@ end module test_finalize_test_session_mod
 program test_assert_no_fixture
    use test_finalize_test_session_mod, only: test_add_passes, test_subtract_passes, test_add_fails, test_subtract_fails
    use fortest_test_session
+   use fortest_test_suite, only: test_suite_t
+   use iso_c_binding, only: c_double
    implicit none
    type(test_suite_t)   :: test_suite
    type(test_session_t) :: test_session
+   type(test_suite_t), pointer :: suite_ptr
+   real(c_double) :: setup, body, teardown, cpu
 
+   call test_session%set_results_db("test_finalize_test_session.sqlite")
    call test_session%register_test_suite("test_finalize_test_session")
 
    call test_session%register_test("test_finalize_test_session", "test_add_passes", test_add_passes)
@@ -90,4 +95,17 @@ program test_assert_no_fixture
       call exit(1)
    end if
 
+   ! Timings of the last run are queryable; unknown tests report an error.
+   suite_ptr => test_session%get_test_suite("test_finalize_test_session")
+   if (suite_ptr%get_test_timing("test_add_passes", setup, body, teardown, cpu) /= 0) then
+      call exit(1)
+   end if
+   if (setup < 0.0_c_double .or. body <= 0.0_c_double .or. teardown < 0.0_c_double &
+         .or. cpu < 0.0_c_double) then
+      call exit(1)
+   end if
+   if (suite_ptr%get_test_timing("no_such_test") == 0) then
+      call exit(1)
+   end if
+
 end program test_assert_no_fixture
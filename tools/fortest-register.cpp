@@ -0,0 +1,202 @@
+// Generates a Fortran registration table from test sources.
+//
+// Every subroutine documented with `!> @test` in a module of the given
+// sources becomes a row of a static table, registered by a single
+// `register_tests` call. The suite of a test is its module's name, or
+// the name given with --suite.
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct FoundTest {
+        std::string module;    //!< Module defining the test procedure
+        std::string procedure; //!< Name of the test procedure
+        std::string suite;     //!< Suite it is registered in
+    };
+
+    void print_help() {
+        std::cout << "Usage: fortest-register [OPTION]... SOURCE...\n\n"
+                  << "Write a Fortran module whose register_all_tests(session) registers every\n"
+                  << "subroutine marked `!> @test` in a module of the SOURCE files.\n\n"
+                  << "Options:\n"
+                  << "  -o FILE          Output file (default: standard output)\n"
+                  << "  --module NAME    Name of the generated module (default: fortest_registration)\n"
+                  << "  --suite NAME     Register all tests in suite NAME (default: the module name)\n"
+                  << "  --help           Show this help message\n";
+    }
+
+    bool starts_test_doc(const std::string &line) {
+        static const std::regex marker(R"(^\s*!(>|!)\s*@test\b)");
+        return std::regex_search(line, marker);
+    }
+
+    bool is_comment_or_blank(const std::string &line) {
+        for (const char c : line) {
+            if (c == '!') return true;
+            if (!std::isspace(static_cast<unsigned char>(c))) return false;
+        }
+        return true;
+    }
+
+    /// Scan one source file, appending its tests to `tests`.
+    bool scan(const std::string &path, const std::string &suite, std::vector<FoundTest> &tests) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "fortest-register: cannot read " << path << "\n";
+            return false;
+        }
+        static const std::regex module_start(R"(^\s*module\s+(\w+)\s*(!.*)?$)", std::regex::icase);
+        static const std::regex module_end(R"(^\s*end\s*module\b)", std::regex::icase);
+        static const std::regex subroutine(
+            R"(^\s*(?:(?:pure|impure|elemental|recursive|module)\s+)*subroutine\s+(\w+))", std::regex::icase);
+
+        std::string module;
+        bool marked = false;
+        int line_number = 0;
+        for (std::string line; std::getline(in, line);) {
+            ++line_number;
+            std::smatch match;
+            if (starts_test_doc(line)) {
+                marked = true;
+            } else if (is_comment_or_blank(line)) {
+                continue;
+            } else if (std::regex_search(line, match, module_start)) {
+                module = match[1];
+                marked = false;
+            } else if (std::regex_search(line, module_end)) {
+                module.clear();
+                marked = false;
+            } else if (std::regex_search(line, match, subroutine)) {
+                if (marked && module.empty()) {
+                    std::cerr << path << ":" << line_number << ": test " << match[1]
+                              << " is not in a module and is skipped\n";
+                } else if (marked) {
+                    tests.push_back({module, match[1], suite.empty() ? module : suite});
+                }
+                marked = false;
+            } else {
+                marked = false;
+            }
+        }
+        return true;
+    }
+
+    std::string quoted(const std::string &name) { return "\"" + name + "\""; }
+
+    std::string generate(const std::vector<FoundTest> &tests, const std::string &module_name,
+                         const std::vector<std::string> &sources) {
+        std::vector<std::string> suites;
+        std::set<std::string> seen;
+        std::size_t suite_width = 1;
+        std::size_t name_width = 1;
+        for (const auto &test : tests) {
+            if (seen.insert(test.suite).second) suites.push_back(test.suite);
+            suite_width = std::max(suite_width, test.suite.size());
+            name_width = std::max(name_width, test.procedure.size());
+        }
+
+        std::ostringstream out;
+        out << "! Generated by fortest-register from";
+        for (const auto &source : sources) out << " " << source;
+        out << "; do not edit.\n"
+            << "!> @brief Registration table of " << tests.size() << " tests in " << suites.size() << " suites.\n"
+            << "module " << module_name << "\n"
+            << "    use iso_c_binding, only : c_funptr, c_funloc\n"
+            << "    use fortest_test_session, only : test_session_t\n";
+        // Procedures are renamed, so equal names in different modules cannot clash.
+        for (std::size_t i = 0; i < tests.size(); ++i) {
+            out << "    use " << tests[i].module << ", only : fortest_test_" << i + 1 << " => "
+                << tests[i].procedure << "\n";
+        }
+        out << "    implicit none\n"
+            << "    private\n\n"
+            << "    public :: register_all_tests\n\n"
+            << "    integer, parameter :: num_suites = " << suites.size() << "\n"
+            << "    integer, parameter :: num_tests = " << tests.size() << "\n"
+            << "    character(len = " << suite_width << ") :: suite_names(num_suites)\n"
+            << "    character(len = " << suite_width << ") :: test_suite_names(num_tests)\n"
+            << "    character(len = " << name_width << ") :: test_names(num_tests)\n\n";
+        for (std::size_t i = 0; i < suites.size(); ++i) {
+            out << "    data suite_names(" << i + 1 << ") / " << quoted(suites[i]) << " /\n";
+        }
+        for (std::size_t i = 0; i < tests.size(); ++i) {
+            out << "    data test_suite_names(" << i + 1 << "), test_names(" << i + 1 << ") / "
+                << quoted(tests[i].suite) << ", " << quoted(tests[i].procedure) << " /\n";
+        }
+        out << "\ncontains\n\n"
+            << "    !> @brief Register the suites and tests of the table with `session`.\n"
+            << "    subroutine register_all_tests(session)\n"
+            << "        class(test_session_t), intent(inout) :: session\n"
+            << "        type(c_funptr) :: tests(num_tests)\n"
+            << "        integer :: i\n\n"
+            << "        do i = 1, num_suites\n"
+            << "            call session%register_test_suite(trim(suite_names(i)))\n"
+            << "        end do\n";
+        for (std::size_t i = 0; i < tests.size(); ++i) {
+            out << "        tests(" << i + 1 << ") = c_funloc(fortest_test_" << i + 1 << ")\n";
+        }
+        out << "        call session%register_tests(test_suite_names, test_names, tests)\n"
+            << "    end subroutine register_all_tests\n\n"
+            << "end module " << module_name << "\n";
+        return out.str();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::string output;
+    std::string module_name = "fortest_registration";
+    std::string suite;
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_help();
+            return 0;
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--module" && i + 1 < argc) {
+            module_name = argv[++i];
+        } else if (arg == "--suite" && i + 1 < argc) {
+            suite = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << "\n\n";
+            print_help();
+            return 1;
+        } else {
+            sources.push_back(arg);
+        }
+    }
+    if (sources.empty()) {
+        print_help();
+        return 1;
+    }
+
+    std::vector<FoundTest> tests;
+    for (const auto &source : sources) {
+        if (!scan(source, suite, tests)) return 1;
+    }
+    const std::string text = generate(tests, module_name, sources);
+    if (output.empty()) {
+        std::cout << text;
+        return 0;
+    }
+
+    // Leave an unchanged file alone, so that its dependents are not rebuilt.
+    std::ifstream existing(output);
+    std::ostringstream previous;
+    previous << existing.rdbuf();
+    if (existing && previous.str() == text) return 0;
+    std::ofstream out(output);
+    if (!(out << text)) {
+        std::cerr << "fortest-register: cannot write " << output << "\n";
+        return 1;
+    }
+    return 0;
+}